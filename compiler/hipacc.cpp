@@ -87,17 +87,35 @@ void printUsage() {
     << "                          Code names for for OpenCL on Intel Xeon Phi devices are:\n"
     << "                            'KnightsCorner' for Knights Corner Many Integrated Cores architecture.\n"
     << "  -explore-config         Emit code that explores all possible kernel configuration and print its performance\n"
+    << "                          For C/C++, the number of threads is explored\n"
+    << "  -tuning-db <file>       Select kernel configurations from the tuning database <file>\n"
+    << "                          Together with -explore-config, the best configuration found is added to <file>\n"
     << "  -use-config <nxm>       Emit code that uses a configuration of nxm threads, e.g. 128x1\n"
+    << "                          For C/C++, tiles of nxm pixels are processed at a time (cache blocking)\n"
     << "  -time-kernels           Emit code that executes each kernel multiple times to get accurate timings\n"
+    << "  -print-cost-model       Print the roofline cost model used to select memory and code generation options\n"
+    << "                          for each kernel - for CUDA/OpenCL only\n"
     << "  -use-textures <o>       Enable/disable usage of textures (cached) in CUDA/OpenCL to read/write image pixels - for GPU devices only\n"
     << "                          Valid values for CUDA on NVIDIA devices: 'off', 'Linear1D', 'Linear2D', 'Array2D', and 'Ldg'\n"
     << "                          Valid values for OpenCL: 'off' and 'Array2D'\n"
     << "  -use-local <o>          Enable/disable usage of shared/local memory in CUDA/OpenCL to stage image pixels to scratchpad\n"
     << "                          Valid values: 'on' and 'off'\n"
-    << "  -vectorize <o>          Enable/disable vectorization of generated CUDA/OpenCL code\n"
+    << "  -vectorize <o>          Enable/disable vectorization of generated CUDA/OpenCL/C++ code\n"
     << "                          Valid values: 'on' and 'off'\n"
+    << "  -fuse-kernels           Fuse producer/consumer kernels so that intermediate images are not written to memory\n"
+    << "                          For C/C++ only, the producer computes the rows required by the consumer block-wise\n"
+    << "  -separate-masks <o>     Enable/disable decomposition of separable (rank-1) constant masks into column and row sums - for C/C++ only\n"
+    << "                          Valid values: 'on', 'off', and 'exact' (integer masks are only decomposed if the result is bit-exact)\n"
+    << "  -running-sums <o>       Enable/disable running sums for box filters and SUM reductions over rectangular Domains\n"
+    << "                          Valid values: 'on' and 'off' (default: only if the result is bit-exact, i.e. for integer sums)\n"
     << "  -pixels-per-thread <n>  Specify how many pixels should be calculated per thread\n"
+    << "                          For C/C++, n adjacent pixels are calculated per loop iteration\n"
+    << "  -register-window <o>    Enable/disable register windows for multiple pixels per thread - for CUDA/OpenCL only\n"
+    << "                          Each thread calculates vertically adjacent pixels and loads each window row once\n"
+    << "                          Valid values: 'on' and 'off'\n"
     << "  -target-II <n>          Specify target Initiation Interval for Vivado\n"
+    << "  -runtime-size           Iterate over the runtime image size instead of the maximum size - for Vivado only\n"
+    << "                          Line buffers are still sized for the maximum image size\n"
     << "  -rs-package <string>    Specify Renderscript package name. (default: \"org.hipacc.rs\")\n"
     << "  -o <file>               Write output to <file>\n"
     << "  --help                  Display available options\n"
@@ -208,6 +226,12 @@ int main(int argc, char *argv[]) {
       compilerOptions.setExploreConfig(USER_ON);
       continue;
     }
+    if (StringRef(argv[i]) == "-tuning-db") {
+      assert(i<(argc-1) && "Mandatory file name for -tuning-db switch missing.");
+      compilerOptions.setTuningDatabase(argv[i+1]);
+      ++i;
+      continue;
+    }
     if (StringRef(argv[i]) == "-use-config") {
       assert(i<(argc-1) && "Mandatory configuration specification for -use-config switch missing.");
       int x=0, y=0, ret=0;
@@ -225,6 +249,18 @@ int main(int argc, char *argv[]) {
       compilerOptions.setTimeKernels(USER_ON);
       continue;
     }
+    if (StringRef(argv[i]) == "-print-cost-model") {
+      compilerOptions.setPrintCostModel(USER_ON);
+      continue;
+    }
+    if (StringRef(argv[i]) == "-runtime-size") {
+      compilerOptions.setRuntimeSize(USER_ON);
+      continue;
+    }
+    if (StringRef(argv[i]) == "-fuse-kernels") {
+      compilerOptions.setFuseKernels(USER_ON);
+      continue;
+    }
     if (StringRef(argv[i]) == "-use-textures") {
       assert(i<(argc-1) && "Mandatory texture memory specification for -use-textures switch missing.");
       if (StringRef(argv[i+1]) == "off") {
@@ -273,6 +309,50 @@ int main(int argc, char *argv[]) {
       ++i;
       continue;
     }
+    if (StringRef(argv[i]) == "-separate-masks") {
+      assert(i<(argc-1) && "Mandatory decomposition specification for -separate-masks switch missing.");
+      if (StringRef(argv[i+1]) == "off") {
+        compilerOptions.setSeparateMasks(USER_OFF);
+      } else if (StringRef(argv[i+1]) == "on") {
+        compilerOptions.setSeparateMasks(USER_ON);
+      } else if (StringRef(argv[i+1]) == "exact") {
+        compilerOptions.setSeparateMasks(USER_ON, true);
+      } else {
+        llvm::errs() << "ERROR: Expected valid decomposition specification for -separate-masks switch.\n\n";
+        printUsage();
+        return EXIT_FAILURE;
+      }
+      ++i;
+      continue;
+    }
+    if (StringRef(argv[i]) == "-running-sums") {
+      assert(i<(argc-1) && "Mandatory running sums specification for -running-sums switch missing.");
+      if (StringRef(argv[i+1]) == "off") {
+        compilerOptions.setRunningSums(USER_OFF);
+      } else if (StringRef(argv[i+1]) == "on") {
+        compilerOptions.setRunningSums(USER_ON);
+      } else {
+        llvm::errs() << "ERROR: Expected valid running sums specification for -running-sums switch.\n\n";
+        printUsage();
+        return EXIT_FAILURE;
+      }
+      ++i;
+      continue;
+    }
+    if (StringRef(argv[i]) == "-register-window") {
+      assert(i<(argc-1) && "Mandatory register window specification for -register-window switch missing.");
+      if (StringRef(argv[i+1]) == "off") {
+        compilerOptions.setRegisterWindow(USER_OFF);
+      } else if (StringRef(argv[i+1]) == "on") {
+        compilerOptions.setRegisterWindow(USER_ON);
+      } else {
+        llvm::errs() << "ERROR: Expected valid register window specification for -register-window switch.\n\n";
+        printUsage();
+        return EXIT_FAILURE;
+      }
+      ++i;
+      continue;
+    }
     if (StringRef(argv[i]) == "-pixels-per-thread") {
       assert(i<(argc-1) && "Mandatory integer parameter for -pixels-per-thread switch missing.");
       std::istringstream buffer(argv[i+1]);
@@ -393,7 +473,14 @@ int main(int argc, char *argv[]) {
     }
   }
   // Invalid specification for kernel configuration
-  if (compilerOptions.useKernelConfig(USER_ON)) {
+  if (compilerOptions.useKernelConfig(USER_ON) &&
+      (compilerOptions.getKernelConfigX() < 1 ||
+       compilerOptions.getKernelConfigY() < 1)) {
+    llvm::errs() << "ERROR: Invalid kernel configuration: configuration must be at least 1x1!\n\n";
+    printUsage();
+    return EXIT_FAILURE;
+  }
+  if (compilerOptions.useKernelConfig(USER_ON) && !compilerOptions.emitC99()) {
     if (compilerOptions.getKernelConfigX()*compilerOptions.getKernelConfigY() >
         (int)targetDevice.max_threads_per_block) {
       llvm::errs() << "ERROR: Invalid kernel configuration: maximum threads for target device are "
@@ -416,6 +503,53 @@ int main(int argc, char *argv[]) {
                  << "  Local memory disabled!\n";
     compilerOptions.setLocalMemory(USER_OFF);
   }
+  // Kernel fusion is only supported for C/C++
+  if (compilerOptions.fuseKernels(USER_ON) && !compilerOptions.emitC99()) {
+    llvm::errs() << "Warning: kernel fusion is only supported for C/C++!\n"
+                 << "  Kernel fusion disabled!\n";
+    compilerOptions.setFuseKernels(USER_OFF);
+  }
+  // Decomposition of separable masks is only supported for C/C++
+  if (compilerOptions.separateMasks(USER_ON) && !compilerOptions.emitC99()) {
+    llvm::errs() << "Warning: decomposition of separable masks is only supported for C/C++!\n"
+                 << "  Decomposition disabled!\n";
+    compilerOptions.setSeparateMasks(USER_OFF);
+  }
+  // Register windows are only supported for CUDA and OpenCL
+  if (compilerOptions.registerWindow(USER_ON) &&
+      !(compilerOptions.emitCUDA() || compilerOptions.emitOpenCL())) {
+    llvm::errs() << "Warning: register windows are only supported for CUDA and OpenCL!\n"
+                 << "  Register windows disabled!\n";
+    compilerOptions.setRegisterWindow(USER_OFF);
+  }
+  // Register windows are only used for fixed kernel configurations
+  if (compilerOptions.registerWindow(USER_ON) &&
+      compilerOptions.exploreConfig(USER_ON)) {
+    llvm::errs() << "Warning: register windows are not supported for configuration exploration!\n"
+                 << "  Register windows disabled!\n";
+    compilerOptions.setRegisterWindow(USER_OFF);
+  }
+  // Runtime image resolution is only supported for Vivado
+  if (compilerOptions.runtimeSize(USER_ON) && !compilerOptions.emitVivado()) {
+    llvm::errs() << "Warning: runtime image resolution is only supported for Vivado!\n"
+                 << "  Runtime image resolution disabled!\n";
+    compilerOptions.setRuntimeSize(USER_OFF);
+  }
+  // Tuning database is only supported for C/C++, CUDA, and OpenCL
+  if (compilerOptions.useTuningDatabase() &&
+      !(compilerOptions.emitC99() || compilerOptions.emitCUDA() ||
+        compilerOptions.emitOpenCL())) {
+    llvm::errs() << "Warning: tuning database is only supported for C/C++, CUDA, and OpenCL!\n"
+                 << "  Tuning database disabled!\n";
+    compilerOptions.setTuningDatabase("");
+  }
+  // Cost model is only used for CUDA and OpenCL
+  if (compilerOptions.printCostModel(USER_ON) &&
+      !(compilerOptions.emitCUDA() || compilerOptions.emitOpenCL())) {
+    llvm::errs() << "Warning: cost model is only supported for CUDA and OpenCL!\n"
+                 << "  Report of cost model disabled!\n";
+    compilerOptions.setPrintCostModel(USER_OFF);
+  }
   if (compilerOptions.timeKernels(USER_ON) &&
       compilerOptions.exploreConfig(USER_ON)) {
     // kernels are timed internally by the runtime in case of exploration
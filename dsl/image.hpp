@@ -57,17 +57,20 @@ enum class Interpolate : uint8_t {
 template<typename data_t>
 class Image {
     private:
-        const int width_, height_;
+        const int width_, height_, stride_;
         data_t *array;
+        bool own_array;
         size_t *refcount;
 
-        data_t &pixel(const int x, const int y) { return array[y*width_ + x]; }
+        data_t &pixel(const int x, const int y) { return array[y*stride_ + x]; }
 
     public:
         Image(const int width, const int height, data_t *init) :
             width_(width),
             height_(height),
+            stride_(width),
             array(new data_t[width*height]),
+            own_array(true),
             refcount(new size_t(1))
         {
             std::copy(init, init + width*height, array);
@@ -76,16 +79,33 @@ class Image {
         Image(const int width, const int height) :
             width_(width),
             height_(height),
+            stride_(width),
             array(new data_t[width*height]),
+            own_array(true),
             refcount(new size_t(1))
         {
             std::fill(array, array + width*height, 0);
         }
 
+        // use host memory with the given stride (in pixels) without copies;
+        // mem has to stay valid during the lifetime of the image
+        Image(const int width, const int height, data_t *mem, const int stride) :
+            width_(width),
+            height_(height),
+            stride_(stride),
+            array(mem),
+            own_array(false),
+            refcount(new size_t(1))
+        {
+            assert(stride >= width && "Stride has to be at least the image width!");
+        }
+
         Image(const Image &image) :
             width_(image.width_),
             height_(image.height_),
+            stride_(image.stride_),
             array(image.array),
+            own_array(image.own_array),
             refcount(image.refcount)
         {
             ++(*refcount);
@@ -96,7 +116,7 @@ class Image {
             if (array != nullptr &&
                 *refcount == 0) {
               delete refcount;
-              delete[] array;
+              if (own_array) delete[] array;
               array = nullptr;
             }
         }
@@ -106,10 +126,13 @@ class Image {
 
         data_t *data() { return array; }
 
+        // other is dense host memory of width*height pixels, as for
+        // hipaccWriteMemory in the runtime
         Image &operator=(data_t *other) {
+            if (other == array) return *this;
             for (int y=0; y<height_; ++y) {
                 for (int x=0; x<width_; ++x) {
-                    array[y*width_ + x] = other[y*width_ + x];
+                    array[y*stride_ + x] = other[y*width_ + x];
                 }
             }
 
@@ -136,9 +159,31 @@ class Image {
         }
 
     template<typename> friend class Accessor;
+    template<typename in_t, typename sum_t>
+    friend void integral_image(Image<in_t> &in, Image<sum_t> &out);
 };
 
 
+// compute the integral image (summed-area table) of in: out has to be one
+// pixel larger than in in each dimension, out(x, y) is the sum of all pixels
+// of in left of x and above y, and the first row and column are zero; box sums
+// are read using four lookups, see Accessor::box_sum()
+template<typename in_t, typename sum_t>
+void integral_image(Image<in_t> &in, Image<sum_t> &out) {
+    assert(out.width() == in.width() + 1 && out.height() == in.height() + 1 &&
+            "Integral image has to be one pixel larger than the input image!");
+    for (int x=0; x<out.width(); ++x) out.pixel(x, 0) = 0;
+    for (int y=0; y<in.height(); ++y) {
+        sum_t sum = 0;
+        out.pixel(0, y+1) = 0;
+        for (int x=0; x<in.width(); ++x) {
+            sum += in.pixel(x, y);
+            out.pixel(x+1, y+1) = out.pixel(x+1, y) + sum;
+        }
+    }
+}
+
+
 template<typename data_t>
 class BoundaryCondition {
     private:
@@ -432,17 +477,18 @@ class AccessorBase {
     protected:
         const int width_, height_;
         const int offset_x_, offset_y_;
-        ElementIterator *EI;
 
-        void setEI(ElementIterator *ei) { EI = ei; }
+        void setEI(ElementIterator *ei) { IteratorBinding::set(this, ei); }
+        ElementIterator *getEI() const {
+            return (ElementIterator *)IteratorBinding::get(this);
+        }
 
     public:
         AccessorBase(const int width, const int height, const int offset_x, const int offset_y) :
             width_(width),
             height_(height),
             offset_x_(offset_x),
-            offset_y_(offset_y),
-            EI(nullptr)
+            offset_y_(offset_y)
         {}
 
     template<typename> friend class Kernel;
@@ -463,7 +509,7 @@ class Accessor : public AccessorBase, BoundaryCondition<data_t>, Interpolation<d
         using Interpolation<data_t>::imode;
 
         data_t &interpolate(const int x, const int y, const int xf=0, const int yf=0) {
-            return interpolate(EI, offset_x_, offset_y_, width_, height_, x, y, xf, yf);
+            return interpolate(getEI(), offset_x_, offset_y_, width_, height_, x, y, xf, yf);
         }
 
         virtual data_t &pixel_bh(int x, int y) override {
@@ -533,16 +579,19 @@ class Accessor : public AccessorBase, BoundaryCondition<data_t>, Interpolation<d
         {}
 
         data_t &operator()(void) {
+            ElementIterator *EI = getEI();
             assert(EI && "ElementIterator not set!");
             return interpolate(EI->x(), EI->y());
         }
 
         data_t &operator()(const int xf, const int yf) {
+            ElementIterator *EI = getEI();
             assert(EI && "ElementIterator not set!");
             return interpolate(EI->x(), EI->y(), xf, yf);
         }
 
         data_t &operator()(MaskBase &M) {
+            ElementIterator *EI = getEI();
             assert(EI && "ElementIterator not set!");
             return interpolate(EI->x(), EI->y(), M.x(), M.y());
         }
@@ -568,14 +617,27 @@ class Accessor : public AccessorBase, BoundaryCondition<data_t>, Interpolation<d
             }
         }
 
+        // sum of the pixels in [xf0, xf1] x [yf0, yf1] relative to the
+        // current pixel, read from an integral image (see integral_image());
+        // the Accessor has to cover the offsets xf0 ... xf1+1, yf0 ... yf1+1
+        data_t box_sum(const int xf0, const int yf0, const int xf1, const int yf1) {
+            data_t br = (*this)(xf1+1, yf1+1);
+            data_t bl = (*this)(xf0, yf1+1);
+            data_t tr = (*this)(xf1+1, yf0);
+            data_t tl = (*this)(xf0, yf0);
+            return br - bl - tr + tl;
+        }
+
         // low-level access methods
         data_t &pixel_at(const int x, const int y) {
+            ElementIterator *EI = getEI();
             assert(EI && "ElementIterator not set!");
             // x and y refer to the area defined by the Accessor
             return img.pixel(x + offset_x_, y + offset_y_);
         }
 
         int x(void) {
+            ElementIterator *EI = getEI();
             assert(EI && "ElementIterator not set!");
             switch (imode) {
                 case Interpolate::NO: return  EI->x() - EI->offset_x();
@@ -585,6 +647,7 @@ class Accessor : public AccessorBase, BoundaryCondition<data_t>, Interpolation<d
         }
 
         int y(void) {
+            ElementIterator *EI = getEI();
             assert(EI && "ElementIterator not set!");
             switch (imode) {
                 case Interpolate::NO: return  EI->y() - EI->offset_y();
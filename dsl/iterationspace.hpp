@@ -28,6 +28,9 @@
 #ifndef __ITERATIONSPACE_HPP__
 #define __ITERATIONSPACE_HPP__
 
+#include <utility>
+#include <vector>
+
 #include "image.hpp"
 
 namespace hipacc {
@@ -61,6 +64,7 @@ class IterationSpaceBase {
             protected:
                 const int min_x, min_y;
                 const int max_x, max_y;
+                const int end_y;
                 const IterationSpaceBase *iteration_space;
                 Coordinate coord;
 
@@ -72,10 +76,25 @@ class IterationSpaceBase {
                     min_y(offset_y),
                     max_x(offset_x+width),
                     max_y(offset_y+height),
+                    end_y(offset_y+height),
                     iteration_space(iteration_space),
                     coord(offset_x, offset_y)
                 {}
 
+                // iterate only over rows [lower_y, upper_y) of the block
+                ElementIterator(const int width, const int height,
+                                const int offset_x, const int offset_y,
+                                const IterationSpaceBase *iteration_space,
+                                const int lower_y, const int upper_y) :
+                    min_x(offset_x),
+                    min_y(offset_y),
+                    max_x(offset_x+width),
+                    max_y(offset_y+height),
+                    end_y(upper_y),
+                    iteration_space(lower_y < upper_y ? iteration_space : nullptr),
+                    coord(offset_x, lower_y)
+                {}
+
                 // increment so we iterate over elements in a block
                 ElementIterator &operator++() {
                     if (iteration_space) {
@@ -83,7 +102,7 @@ class IterationSpaceBase {
                         if (coord.x >= max_x) {
                             coord.x = min_x;
                             coord.y++;
-                            if (coord.y >= max_y) {
+                            if (coord.y >= end_y) {
                                 iteration_space = nullptr;
                             }
                         }
@@ -104,6 +123,10 @@ class IterationSpaceBase {
         ElementIterator begin() const {
             return ElementIterator(width_, height_, offset_x_, offset_y_, this);
         }
+        ElementIterator begin(const int lower_y, const int upper_y) const {
+            return ElementIterator(width_, height_, offset_x_, offset_y_, this,
+                                   lower_y, upper_y);
+        }
         ElementIterator end() const { return ElementIterator(); }
 
         int width()    const { return width_; }
@@ -141,6 +164,40 @@ class IterationSpace : public IterationSpaceBase {
 
 // provide shortcut for ElementIterator
 using ElementIterator = IterationSpaceBase::ElementIterator;
+
+
+// Iterators bound to Accessors, Masks, and Domains: bindings are stored per
+// thread so that a kernel can be executed by several threads at a time
+class IteratorBinding {
+    private:
+        typedef std::vector<std::pair<const void *, void *>> BindingList;
+
+        static BindingList &bindings() {
+            static thread_local BindingList bindings;
+            return bindings;
+        }
+
+    public:
+        static void set(const void *owner, void *iter) {
+            BindingList &list = bindings();
+            for (auto it=list.begin(); it!=list.end(); ++it) {
+                if (it->first == owner) {
+                    if (iter) it->second = iter;
+                    else list.erase(it);
+                    return;
+                }
+            }
+            if (iter) list.push_back(std::make_pair(owner, iter));
+        }
+
+        static void *get(const void *owner) {
+            BindingList &list = bindings();
+            for (auto it=list.rbegin(); it!=list.rend(); ++it) {
+                if (it->first == owner) return it->second;
+            }
+            return nullptr;
+        }
+};
 } // end namespace hipacc
 
 #endif // __ITERATIONSPACE_HPP__
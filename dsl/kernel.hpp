@@ -28,6 +28,9 @@
 #ifndef __KERNEL_HPP__
 #define __KERNEL_HPP__
 
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
 #include <vector>
 
 #include "iterationspace.hpp"
@@ -42,6 +45,40 @@ double hipacc_time_ms() {
     return ((double)(tv.tv_sec) * 1e+3 + (double)(tv.tv_usec) * 1e-3);
 }
 
+// get number of threads used to execute kernels: HIPACC_NUM_THREADS or the
+// number of hardware threads
+int hipacc_num_threads() {
+    const char *env = getenv("HIPACC_NUM_THREADS");
+    if (env) {
+        int num_threads = atoi(env);
+        if (num_threads > 0) return num_threads;
+    }
+    unsigned int num_threads = std::thread::hardware_concurrency();
+    return num_threads ? num_threads : 1;
+}
+
+// select the value of the given rank using the min/max operations of Batcher's
+// odd-even merge sort network: this works lane-wise for vector types and
+// matches the sorting network generated for Reduce::MEDIAN
+template<typename T>
+T hipacc_select_rank(std::vector<T> &values, const size_t rank) {
+    const int n = values.size();
+    for (int p=1; p<n; p<<=1) {
+        for (int k=p; k>=1; k>>=1) {
+            for (int j=k%p; j+k<n; j+=2*k) {
+                for (int i=0; i<std::min(k, n-j-k); ++i) {
+                    if ((i+j)/(2*p) == (i+j+k)/(2*p)) {
+                        T lo = hipacc::math::min(values[i+j], values[i+j+k]);
+                        values[i+j+k] = hipacc::math::max(values[i+j], values[i+j+k]);
+                        values[i+j] = lo;
+                    }
+                }
+            }
+        }
+    }
+    return values[rank];
+}
+
 
 template<typename data_t>
 class Kernel {
@@ -50,26 +87,16 @@ class Kernel {
         Accessor<data_t> out_acc;
         std::vector<AccessorBase *> images;
         data_t reduction_result;
-        bool break_iteration;
 
-    public:
-        Kernel(IterationSpace<data_t> &iteration_space) :
-            iteration_space(iteration_space),
-            out_acc(iteration_space.img,
-                    iteration_space.width(), iteration_space.height(),
-                    iteration_space.offset_x(), iteration_space.offset_y())
-        {}
-
-        virtual ~Kernel() {}
-        virtual void kernel() = 0;
-        virtual data_t reduce(data_t left, data_t right) { return left; }
-
-        void add_accessor(AccessorBase *acc) { images.push_back(acc); }
+        static bool &break_iteration() {
+            static thread_local bool break_iteration = false;
+            return break_iteration;
+        }
 
-        void execute() {
-            double time0, time1;
+        // apply kernel to rows [lower_y, upper_y) of the iteration space
+        void execute_rows(const int lower_y, const int upper_y) {
             auto end  = iteration_space.end();
-            auto iter = iteration_space.begin();
+            auto iter = iteration_space.begin(lower_y, upper_y);
 
             // register input accessors
             for (auto ei=images.begin(), ie=images.end(); ei!=ie; ++ei) {
@@ -79,14 +106,11 @@ class Kernel {
             // register output accessors
             out_acc.setEI(&iter);
 
-            // advance iterator and apply kernel to whole iteration space
-            time0 = hipacc_time_ms();
+            // advance iterator and apply kernel to the rows
             while (iter != end) {
                 kernel();
                 ++iter;
             }
-            time1 = hipacc_time_ms();
-            hipacc_last_timing = time1 - time0;
 
             // de-register input accessors
             for (auto ei=images.begin(), ie=images.end(); ei!=ie; ++ei) {
@@ -95,8 +119,52 @@ class Kernel {
             }
             // de-register output accessor
             out_acc.setEI(nullptr);
+        }
+
+    public:
+        Kernel(IterationSpace<data_t> &iteration_space) :
+            iteration_space(iteration_space),
+            out_acc(iteration_space.img,
+                    iteration_space.width(), iteration_space.height(),
+                    iteration_space.offset_x(), iteration_space.offset_y())
+        {}
+
+        virtual ~Kernel() {}
+        virtual void kernel() = 0;
+        virtual data_t reduce(data_t left, data_t right) { return left; }
+
+        void add_accessor(AccessorBase *acc) { images.push_back(acc); }
 
-            // apply reduction
+        void execute() {
+            double time0, time1;
+            const int lower_y = iteration_space.offset_y();
+            const int upper_y = lower_y + iteration_space.height();
+            const int num_threads = std::max(1,
+                    std::min(hipacc_num_threads(), iteration_space.height()));
+
+            // apply kernel to whole iteration space: each thread processes a
+            // band of rows using its own iterator; every output pixel is
+            // computed exactly once, so results do not depend on the number
+            // of threads
+            time0 = hipacc_time_ms();
+            if (num_threads == 1) {
+                execute_rows(lower_y, upper_y);
+            } else {
+                std::vector<std::thread> threads;
+                const int rows = (iteration_space.height() + num_threads - 1) /
+                                 num_threads;
+                for (int y=lower_y; y<upper_y; y+=rows) {
+                    threads.emplace_back(&Kernel::execute_rows, this, y,
+                                         std::min(y+rows, upper_y));
+                }
+                for (auto &thread : threads) {
+                    thread.join();
+                }
+            }
+            time1 = hipacc_time_ms();
+            hipacc_last_timing = time1 - time0;
+
+            // apply reduction in iteration order
             reduce();
         }
 
@@ -138,12 +206,12 @@ class Kernel {
         }
 
         int x(void) {
-            assert(out_acc.EI!=ElementIterator() && "ElementIterator not set!");
+            assert(out_acc.getEI() && "ElementIterator not set!");
             return out_acc.x();
         }
 
         int y(void) {
-            assert(out_acc.EI!=ElementIterator() && "ElementIterator not set!");
+            assert(out_acc.getEI() && "ElementIterator not set!");
             return out_acc.y();
         }
 
@@ -155,14 +223,14 @@ class Kernel {
         template <typename Function>
         void iterate(Domain &domain, const Function &fun);
         void break_iterate() {
-          break_iteration = true;
+          break_iteration() = true;
         }
 };
 
 
 template <typename data_t> template <typename data_m, typename Function>
 auto Kernel<data_t>::convolve(Mask<data_m> &mask, Reduce mode, const Function& fun) -> decltype(fun()) {
-    break_iteration = false;
+    break_iteration() = false;
     auto end  = mask.end();
     auto iter = mask.begin();
 
@@ -173,30 +241,37 @@ auto Kernel<data_t>::convolve(Mask<data_m> &mask, Reduce mode, const Function& f
     auto result = fun();
 
     // advance iterator and apply kernel to remaining iteration space
-    while (++iter != end && !break_iteration) {
-        switch (mode) {
-            case Reduce::SUM:
+    switch (mode) {
+        case Reduce::SUM:
+            while (++iter != end && !break_iteration()) {
                 result += fun();
-                break;
-            case Reduce::MIN:
-                {
+            }
+            break;
+        case Reduce::MIN:
+            while (++iter != end && !break_iteration()) {
                 auto tmp = fun();
                 result = hipacc::math::min(tmp, result);
-                }
-                break;
-            case Reduce::MAX:
-                {
+            }
+            break;
+        case Reduce::MAX:
+            while (++iter != end && !break_iteration()) {
                 auto tmp = fun();
                 result = hipacc::math::max(tmp, result);
-                }
-                break;
-            case Reduce::PROD:
+            }
+            break;
+        case Reduce::PROD:
+            while (++iter != end && !break_iteration()) {
                 result *= fun();
-                break;
-            case Reduce::MEDIAN:
-                assert(0 && "HipaccMEDIAN not implemented yet!");
-                break;
-        }
+            }
+            break;
+        case Reduce::MEDIAN: {
+            // lower median of all values
+            std::vector<decltype(result)> values(1, result);
+            while (++iter != end && !break_iteration()) {
+                values.push_back(fun());
+            }
+            result = hipacc_select_rank(values, (values.size() - 1) / 2);
+            break; }
     }
 
     // de-register mask
@@ -208,7 +283,7 @@ auto Kernel<data_t>::convolve(Mask<data_m> &mask, Reduce mode, const Function& f
 
 template <typename data_t> template <typename Function>
 auto Kernel<data_t>::reduce(Domain &domain, Reduce mode, const Function &fun) -> decltype(fun()) {
-    break_iteration = false;
+    break_iteration() = false;
     auto end  = domain.end();
     auto iter = domain.begin();
 
@@ -219,28 +294,37 @@ auto Kernel<data_t>::reduce(Domain &domain, Reduce mode, const Function &fun) ->
     auto result = fun();
 
     // advance iterator and apply kernel to remaining iteration space
-    while (++iter != end && !break_iteration) {
-        switch (mode) {
-            case Reduce::SUM:
+    switch (mode) {
+        case Reduce::SUM:
+            while (++iter != end && !break_iteration()) {
                 result += fun();
-                break;
-            case Reduce::MIN: {
+            }
+            break;
+        case Reduce::MIN:
+            while (++iter != end && !break_iteration()) {
                 auto tmp = fun();
                 result = hipacc::math::min(tmp, result);
-                }
-              break;
-            case Reduce::MAX: {
+            }
+            break;
+        case Reduce::MAX:
+            while (++iter != end && !break_iteration()) {
                 auto tmp = fun();
                 result = hipacc::math::max(tmp, result);
-                }
-                break;
-            case Reduce::PROD:
+            }
+            break;
+        case Reduce::PROD:
+            while (++iter != end && !break_iteration()) {
                 result *= fun();
-                break;
-            case Reduce::MEDIAN:
-                assert(0 && "HipaccMEDIAN not implemented yet!");
-                break;
-        }
+            }
+            break;
+        case Reduce::MEDIAN: {
+            // lower median of all values
+            std::vector<decltype(result)> values(1, result);
+            while (++iter != end && !break_iteration()) {
+                values.push_back(fun());
+            }
+            result = hipacc_select_rank(values, (values.size() - 1) / 2);
+            break; }
     }
 
     // de-register domain
@@ -252,7 +336,7 @@ auto Kernel<data_t>::reduce(Domain &domain, Reduce mode, const Function &fun) ->
 
 template <typename data_t> template <typename Function>
 void Kernel<data_t>::iterate(Domain &domain, const Function &fun) {
-    break_iteration = false;
+    break_iteration() = false;
     auto end  = domain.end();
     auto iter = domain.begin();
 
@@ -260,7 +344,7 @@ void Kernel<data_t>::iterate(Domain &domain, const Function &fun) {
     domain.setDI(&iter);
 
     // advance iterator and apply kernel to iteration space
-    while (iter != end && !break_iteration) {
+    while (iter != end && !break_iteration()) {
         fun();
         ++iter;
     }
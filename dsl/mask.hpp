@@ -148,33 +148,35 @@ class Domain : public MaskBase {
         };
 
     protected:
-        DomainIterator *DI;
+        DomainIterator *getDI() const {
+            return (DomainIterator *)IteratorBinding::get(this);
+        }
 
     public:
         Domain(const int size_x, const int size_y) :
-            MaskBase(size_x, size_y),
-            DI(nullptr) {}
+            MaskBase(size_x, size_y) {}
 
         template <int size_y, int size_x>
         Domain(const uchar (&domain)[size_y][size_x]) :
-            MaskBase(size_x, size_y),
-            DI(nullptr) {}
+            MaskBase(size_x, size_y) {}
 
         Domain(const MaskBase &mask) :
-            MaskBase(mask),
-            DI(nullptr) {}
+            MaskBase(mask) {}
 
         Domain(const Domain &domain) :
-            MaskBase(domain),
-            DI(domain.DI) {}
+            MaskBase(domain) {
+            setDI(domain.getDI());
+        }
 
-        ~Domain() {}
+        ~Domain() { setDI(nullptr); }
 
         virtual int x() override {
+            DomainIterator *DI = getDI();
             assert(DI && "DomainIterator for Domain not set!");
             return DI->x() - size_x_/2;
         }
         virtual int y() override {
+            DomainIterator *DI = getDI();
             assert(DI && "DomainIterator for Domain not set!");
             return DI->y() - size_y_/2;
         }
@@ -215,7 +217,7 @@ class Domain : public MaskBase {
             }
         }
 
-        void setDI(DomainIterator *di) { DI = di; }
+        void setDI(DomainIterator *di) { IteratorBinding::set(this, di); }
         DomainIterator begin() const {
             return DomainIterator(size_x_, size_y_, &iteration_space,
                                   domain_space);
@@ -227,9 +229,12 @@ class Domain : public MaskBase {
 template<typename data_t>
 class Mask : public MaskBase {
     private:
-        ElementIterator *EI;
         data_t *array;
 
+        ElementIterator *getEI() const {
+            return (ElementIterator *)IteratorBinding::get(this);
+        }
+
         template <int size_y, int size_x>
         void init(const data_t (&mask)[size_y][size_x]) {
             for (int y=0; y<size_y; ++y) {
@@ -250,7 +255,6 @@ class Mask : public MaskBase {
         template <int size_y, int size_x>
         Mask(const data_t (&mask)[size_y][size_x]) :
             MaskBase(size_x, size_y),
-            EI(nullptr),
             array(new data_t[size_x*size_y])
         {
             init(mask);
@@ -264,6 +268,7 @@ class Mask : public MaskBase {
         }
 
         ~Mask() {
+            setEI(nullptr);
             if (array != nullptr) {
               delete[] array;
               array = nullptr;
@@ -271,15 +276,18 @@ class Mask : public MaskBase {
         }
 
         int x() {
+            ElementIterator *EI = getEI();
             assert(EI && "ElementIterator for Mask not set!");
             return EI->x() - size_x_/2;
         }
         int y() {
+            ElementIterator *EI = getEI();
             assert(EI && "ElementIterator for Mask not set!");
             return EI->y() - size_y_/2;
         }
 
         data_t &operator()(void) {
+            ElementIterator *EI = getEI();
             assert(EI && "ElementIterator for Mask not set!");
             return array[EI->y()*size_x_ + EI->x()];
         }
@@ -294,7 +302,7 @@ class Mask : public MaskBase {
             return array[(D.y()+D.size_y()/2)*size_x_ + D.x()+D.size_x()/2];
         }
 
-        void setEI(ElementIterator *ei) { EI = ei; }
+        void setEI(ElementIterator *ei) { IteratorBinding::set(this, ei); }
         ElementIterator begin() const {
             return ElementIterator(size_x_, size_y_, 0, 0, &iteration_space);
         }
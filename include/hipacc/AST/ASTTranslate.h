@@ -49,6 +49,9 @@
 #include "hipacc/DSL/ClassRepresentation.h"
 #include "hipacc/Vectorization/SIMDTypes.h"
 
+#include <map>
+#include <tuple>
+
 
 //===----------------------------------------------------------------------===//
 // Statement/expression transformations
@@ -104,10 +107,42 @@ class ASTTranslate : public StmtVisitor<ASTTranslate, Stmt *> {
     SmallVector<LabelDecl *, 4> breakLabels;
     SmallVector<bool, 4> containsBreak;
 
+    // C/C++: state of convolutions that slide along the row (column sums of
+    // separable Masks, median histograms), shared by all code variants of the
+    // kernel body and declared at function scope
+    struct SlidingVars {
+      VarDecl *cols, *sum, *next_x, *next_y;
+      VarDecl *hist, *median, *below;
+    };
+    llvm::DenseMap<CXXMemberCallExpr *, SlidingVars> slidingVars;
+    SmallVector<Stmt *, 16> slidingDeclStmts;
+
+    // pixels read from Accessors at constant offsets are loaded once per scope
+    // and reused by later reads, e.g. by the unrolled iterations of several
+    // convolutions over the same Accessor; border handling indices are shared
+    // by all loads at the same x or y offset
+    struct LoadValue {
+      CompoundStmt *scope;
+      DeclRefExpr *value;
+    };
+    std::map<std::tuple<HipaccAccessor *, int64_t, int64_t>, LoadValue>
+      loadCache;
+    std::map<std::tuple<HipaccAccessor *, int64_t, bool>, LoadValue>
+      borderIdxCache;
+    SmallVector<CompoundStmt *, 16> activeCStmts;
+    CompoundStmt *loadScope, *dedupScope;
+    // CUDA/OpenCL: scope of the register window shared by the vertically
+    // adjacent pixels of a thread and the row of the current pixel within
+    CompoundStmt *windowScope;
+    int windowRow;
+    unsigned numLoadsReused, numIndicesReused;
+
     DeclRefExpr *bh_start_left, *bh_start_right, *bh_start_top,
                 *bh_start_bottom, *bh_fall_back;
     DeclRefExpr *outputImage;
     DeclRefExpr *retValRef;
+    // C/C++: first row of the fused image held in the row buffer
+    DeclRefExpr *fusedRowLo;
     Expr *writeImageRHS;
     NamespaceDecl *hipaccNS, *hipaccMathNS;
     TypedefDecl *samplerTy;
@@ -166,6 +201,14 @@ class ASTTranslate : public StmtVisitor<ASTTranslate, Stmt *> {
     void initRenderscript(SmallVector<Stmt *, 16> &kernelBody);
     void updateTileVars();
     Expr *addCastToInt(Expr *E);
+    Expr *accessImage(DeclRefExpr *LHS, HipaccAccessor *Acc, MemoryAccess
+        mem_acc, Expr *offset_x=nullptr, Expr *offset_y=nullptr);
+    bool isScopeActive(CompoundStmt *scope);
+    CompoundStmt *getLoadScope(HipaccAccessor *Acc, MemoryAccess mem_acc, bool
+        shared);
+    DeclRefExpr *lookupBorderIndex(HipaccAccessor *Acc, Expr *offset, bool x);
+    void addBorderIndex(HipaccAccessor *Acc, Expr *offset, bool x, DeclRefExpr
+        *idx);
     Expr *stripLiteralOperand(Expr *operand1, Expr *operand2, int val);
     Expr *stripLiteralOperand(Expr *operand1, Expr *operand2, double val);
     FunctionDecl *cloneFunction(FunctionDecl *FD);
@@ -251,6 +294,30 @@ class ASTTranslate : public StmtVisitor<ASTTranslate, Stmt *> {
         *stmt);
     Stmt *addBreakCheck(DeclRefExpr *break_var, Stmt *stmt);
     bool searchForBreakIterate(Stmt *S);
+    bool isWindowExpr(Stmt *S, HipaccMask *Mask);
+    bool isMaskCall(Expr *E, HipaccMask *Mask);
+    Expr *accessArrayAt(DeclRefExpr *array, Expr *idx);
+    VarDecl *createSlidingDecl(std::string name, QualType QT, Expr *init);
+    SlidingVars &getSlidingVars(CXXMemberCallExpr *E);
+    Expr *getSlidingCheck(SlidingVars &vars);
+    void addSlidingUpdate(SlidingVars &vars, CompoundStmt *outer);
+    Expr *cloneWindowAt(Expr *window, int x, int y, SmallVector<Stmt *, 16>
+        &stmts);
+    Expr *getSeparableWindow(LambdaExpr *LE, HipaccMask *Mask);
+    void addSeparableConvolution(CXXMemberCallExpr *E, HipaccMask *Mask, Expr
+        *window, DeclRefExpr *tmp_var, CompoundStmt *outer);
+    Expr *getBoxWindow(LambdaExpr *LE, HipaccMask *Mask, Reduce mode, Expr
+        *&coeff);
+    void addBoxSum(CXXMemberCallExpr *E, HipaccMask *Mask, Expr *window, Expr
+        *coeff, DeclRefExpr *tmp_var, CompoundStmt *outer);
+    Expr *getCoefficientWindow(LambdaExpr *LE, HipaccMask *Mask);
+    void addCoefficientConvolution(HipaccMask *Mask, Expr *window, DeclRefExpr
+        *tmp_var, CompoundStmt *outer);
+    Expr *getMedianWindow(LambdaExpr *LE, HipaccMask *Mask);
+    void addMedianHistogram(CXXMemberCallExpr *E, HipaccMask *Mask, Expr
+        *window, DeclRefExpr *tmp_var, CompoundStmt *outer);
+    void addMedianNetwork(DeclRefExpr *values, size_t num_values, size_t rank,
+        CompoundStmt *outer);
     Expr *convertConvolution(CXXMemberCallExpr *E);
 
     // Interpolation.cpp
@@ -276,6 +343,7 @@ class ASTTranslate : public StmtVisitor<ASTTranslate, Stmt *> {
     Expr *accessMem(DeclRefExpr *LHS, HipaccAccessor *Acc, MemoryAccess mem_acc,
         Expr *offset_x=nullptr, Expr *offset_y=nullptr);
     Expr *accessMem2DAt(DeclRefExpr *LHS, Expr *idx_x, Expr *idx_y);
+    bool isFusedImage(DeclRefExpr *LHS);
     Expr *accessMemArrAt(DeclRefExpr *LHS, Expr *stride, Expr *idx_x, Expr
         *idx_y);
     Expr *accessMemAllocAt(DeclRefExpr *LHS, MemoryAccess mem_acc,
@@ -339,6 +407,12 @@ class ASTTranslate : public StmtVisitor<ASTTranslate, Stmt *> {
       convTmp(nullptr),
       convIdxX(0),
       convIdxY(0),
+      loadScope(nullptr),
+      dedupScope(nullptr),
+      windowScope(nullptr),
+      windowRow(0),
+      numLoadsReused(0),
+      numIndicesReused(0),
       bh_start_left(nullptr),
       bh_start_right(nullptr),
       bh_start_top(nullptr),
@@ -346,6 +420,7 @@ class ASTTranslate : public StmtVisitor<ASTTranslate, Stmt *> {
       bh_fall_back(nullptr),
       outputImage(nullptr),
       retValRef(nullptr),
+      fusedRowLo(nullptr),
       writeImageRHS(nullptr),
       tileVars(),
       lidYRef(nullptr),
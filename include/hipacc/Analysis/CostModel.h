@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2012, University of Erlangen-Nuremberg
+// Copyright (c) 2012, Siemens AG
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//===--- CostModel.h - Roofline Cost Model for Kernels --------------------===//
+//
+// This provides an analytical roofline model that estimates per output pixel
+// whether a kernel is bound by computation or by memory bandwidth on the
+// target device.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _COST_MODEL_H_
+#define _COST_MODEL_H_
+
+#include "hipacc/Device/TargetDescription.h"
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/SmallVector.h>
+
+#include <string>
+
+namespace clang {
+namespace hipacc {
+// image read by the kernel
+struct RooflineImage {
+  std::string name;
+  unsigned pixel_size;
+  // window read for each output pixel
+  unsigned size_x, size_y;
+  float loads;
+};
+
+// estimate for one output pixel
+struct RooflineEstimate {
+  float ops;
+  float bytes;
+  // predicted execution time in ms per megapixel
+  float time;
+  bool memory_bound;
+
+  float getIntensity() const { return bytes > 0 ? ops/bytes : 0; }
+};
+
+class HipaccCostModel {
+  private:
+    HipaccDevice &device;
+    float ops;
+    unsigned store_bytes;
+    llvm::SmallVector<RooflineImage, 16> images;
+
+  public:
+    // ops: operations and store_bytes: bytes written per output pixel
+    HipaccCostModel(HipaccDevice &device, float ops, unsigned store_bytes) :
+      device(device),
+      ops(ops),
+      store_bytes(store_bytes),
+      images()
+    {}
+
+    void addImage(RooflineImage image) { images.push_back(image); }
+    llvm::ArrayRef<RooflineImage> getImages() const { return images; }
+    bool hasWindows() const;
+
+    // operations per byte where compute and memory bound meet
+    float getRidgePoint() const {
+      return device.peak_gops / device.peak_bandwidth;
+    }
+
+    // local memory required to stage the windows of all images for a block
+    unsigned getLocalMemorySize(unsigned bsx, unsigned bsy, unsigned ppt)
+      const;
+
+    // estimate for a block of bsx x bsy threads computing ppt pixels each;
+    // windows are read once per block if staged in local memory or read via
+    // the texture cache
+    RooflineEstimate estimate(unsigned bsx, unsigned bsy, unsigned ppt, bool
+        local, bool texture, unsigned vector_width) const;
+};
+} // end namespace hipacc
+} // end namespace clang
+
+#endif  // _COST_MODEL_H_
+
+// vim: set ts=2 sw=2 sts=2 et ai:
@@ -28,6 +28,7 @@
 //===------------- HostDataDeps.h - Track data dependencies ---------------===//
 //
 // This file implements tracking of data dependencies to generate vivado streams
+// and to find producer/consumer kernels that can be fused
 //
 //===----------------------------------------------------------------------===//
 
@@ -69,6 +70,11 @@ class DependencyTracker : public StmtVisitor<DependencyTracker> {
     llvm::DenseMap<ValueDecl *, HipaccIterationSpace *> iterDeclMap_;
     llvm::DenseMap<ValueDecl *, HipaccBoundaryCondition *> bcDeclMap_;
 
+    // set if the statement was handled as DSL declaration or kernel call
+    bool tracked;
+
+    void trackHostAccess(Stmt *S);
+
   public:
     DependencyTracker(ASTContext &Context,
                       AnalysisDeclContext &analysisContext,
@@ -85,13 +91,17 @@ class DependencyTracker : public StmtVisitor<DependencyTracker> {
           if (!elem.getAs<CFGStmt>()) continue;
 
           const Stmt *S = elem.castAs<CFGStmt>().getStmt();
+          currentBlock = block;
+          tracked = false;
           this->Visit(const_cast<Stmt*>(S));
+          if (!tracked) trackHostAccess(const_cast<Stmt*>(S));
         }
       }
       if (DEBUG) std::cout << std::endl;
     }
 
     void VisitDeclStmt(DeclStmt *S);
+    void VisitCXXConstructExpr(CXXConstructExpr *E);
     void VisitCXXMemberCallExpr(CXXMemberCallExpr *E);
 };
 
@@ -128,8 +138,25 @@ class HostDataDeps : public ManagedAnalysis {
     std::vector<Space*> spaces_;
     std::vector<Process*> processes_;
 
+    // kernel calls and host statements accessing images in program order;
+    // statements with lambdas are recorded as barrier (no process, no image)
+    struct Event {
+      const CFGBlock *block;
+      Process *proc;
+      Image *image;
+    };
+    std::vector<Event> events_;
+    // false if the program uses constructs that are not tracked (Pyramids)
+    bool supported;
+
+    // fused producer/consumer kernels
+    llvm::DenseMap<ValueDecl *, ValueDecl *> fusedConsumer_;
+    llvm::DenseMap<ValueDecl *, ValueDecl *> fusedProducer_;
+
     unsigned int outId, tmpId;
     std::vector<Node*> schedule;
+    // depth of each stream declared within the dataflow region
+    std::map<std::string, size_t> streamDepths;
 
     // inner class definitions
     class IterationSpace {
@@ -174,6 +201,14 @@ class HostDataDeps : public ManagedAnalysis {
           return acc->getName();
         }
 
+        unsigned getSizeX() {
+          return acc->getSizeX();
+        }
+
+        unsigned getSizeY() {
+          return acc->getSizeY();
+        }
+
         Image *getImage() {
           return image;
         }
@@ -207,6 +242,10 @@ class HostDataDeps : public ManagedAnalysis {
           return img->getName();
         }
 
+        unsigned getSizeX() {
+          return img->getSizeX();
+        }
+
         std::string getTypeStr(size_t ppt) {
           return ASTNode::createVivadoTypeStr(img, ppt);
         }
@@ -215,18 +254,37 @@ class HostDataDeps : public ManagedAnalysis {
     class Kernel {
       private:
         std::string name;
+        ValueDecl *VD;
         IterationSpace *iter;
         std::vector<Accessor*> accs;
+        // result type of the reduce function, empty if there is none
+        std::string reduceType;
 
       public:
-        Kernel(std::string name, IterationSpace *iter)
-            : name(name), iter(iter) {
+        Kernel(std::string name, ValueDecl *VD, IterationSpace *iter)
+            : name(name), VD(VD), iter(iter) {
         }
 
         std::string getName() {
           return name;
         }
 
+        bool isReduction() {
+          return !reduceType.empty();
+        }
+
+        std::string getReduceTypeStr() {
+          return reduceType;
+        }
+
+        void setReduceTypeStr(std::string type) {
+          reduceType = type;
+        }
+
+        ValueDecl *getDecl() {
+          return VD;
+        }
+
         IterationSpace *getIterationSpace() {
           return iter;
         }
@@ -303,6 +361,12 @@ class HostDataDeps : public ManagedAnalysis {
           return dstProcess;
         }
 
+        // output of a global reduction, consumed by the reduce process only
+        bool isReduction() {
+          return srcProcess && srcProcess->getKernel()->isReduction() &&
+                 dstProcess.empty();
+        }
+
         void setSrcProcess(Process *proc) {
           IterationSpace *iter = proc->getKernel()->getIterationSpace();
           assert(iter->getImage() == image && "IterationSpace Image mismatch");
@@ -369,6 +433,9 @@ class HostDataDeps : public ManagedAnalysis {
       return std::find(vec.begin(), vec.end(), item) != vec.end();
     }
 
+    HostDataDeps() : supported(true) {
+    }
+
     ~HostDataDeps() {
       freeVector(spaces_);
       freeVector(processes_);
@@ -379,7 +446,11 @@ class HostDataDeps : public ManagedAnalysis {
     void addKernel(ValueDecl *KVD, ValueDecl *ISVD, std::vector<ValueDecl*> AVDS);
     void addAccessor(ValueDecl *AVD, HipaccAccessor *acc, ValueDecl* IVD);
     void addIterationSpace(ValueDecl *ISVD, HipaccIterationSpace *iter, ValueDecl *IVD);
-    void runKernel(ValueDecl *VD);
+    void runKernel(ValueDecl *VD, const CFGBlock *block);
+    void accessImage(ValueDecl *VD, const CFGBlock *block);
+    void addBarrier(const CFGBlock *block);
+    bool isFusible(size_t producer, size_t consumer);
+    void findFusibleKernels();
 
     void dump(Process *proc);
     void dump(Space *space);
@@ -387,13 +458,20 @@ class HostDataDeps : public ManagedAnalysis {
 
     std::vector<Space*> getInputSpaces();
     std::vector<Space*> getOutputSpaces();
+    std::vector<Space*> getReductionSpaces();
+    std::string getReduceResult(Kernel *kernel) {
+      return "_red" + kernel->getName();
+    }
     std::string createStream(Space *s);
     void markProcess(Process *t);
     void markSpace(Space *s);
     void createSchedule();
+    size_t getGroupDelay(Process *proc, size_t width);
+    void computeStreamDepths();
+    std::string printStreamDepths();
     std::string getEntrySignature(
         std::map<std::string,std::vector<std::pair<std::string,std::string>>> args,
-        bool withTypes=false);
+        bool withTypes=false, std::string img="");
     std::string prettyPrint(
         std::map<std::string,std::vector<std::pair<std::string,std::string>>> args,
         bool print=false);
@@ -412,6 +490,18 @@ class HostDataDeps : public ManagedAnalysis {
     std::string getInputStream(ValueDecl *VD);
     std::string getOutputStream(ValueDecl *VD);
     std::string getStreamDecl(ValueDecl *VD);
+    // variable returning the result of a reduction from the entry function
+    std::string getReduceResult(ValueDecl *KVD) {
+      return kernelMap_.count(KVD) ? getReduceResult(kernelMap_[KVD]) : "";
+    }
+    // kernel fused into the given producer kernel, or nullptr
+    ValueDecl *getFusedConsumer(ValueDecl *KVD) {
+      return fusedConsumer_.lookup(KVD);
+    }
+    // kernel fused into the given consumer kernel, or nullptr
+    ValueDecl *getFusedProducer(ValueDecl *KVD) {
+      return fusedProducer_.lookup(KVD);
+    }
 
     static HostDataDeps *parse(ASTContext &Context,
         AnalysisDeclContext &analysisContext,
@@ -428,7 +518,12 @@ class HostDataDeps : public ManagedAnalysis {
         std::cout << std::endl;
       }
 
-      dataDeps.createSchedule();
+      if (compilerOptions.emitVivado()) {
+        dataDeps.createSchedule();
+      }
+      if (compilerOptions.fuseKernels()) {
+        dataDeps.findFusibleKernels();
+      }
 
       return &dataDeps;
     }
@@ -79,6 +79,13 @@ class KernelStatistics : public ManagedAnalysis {
     MemoryPattern getMemPattern(const FieldDecl *FD);
     VectorInfo getVectorizeInfo(const VarDecl *VD);
     KernelType getKernelType();
+    // static counts of operations and memory accesses in the kernel body
+    unsigned getNumOps();
+    unsigned getNumSFUOps();
+    unsigned getNumImgLoads(const FieldDecl *FD);
+    unsigned getNumImgStores();
+    unsigned getNumMaskLoads();
+    void addDeduplicatedLoads(unsigned num_loads, unsigned num_indices);
 
     virtual ~KernelStatistics();
 
@@ -72,6 +72,7 @@ class CompilerOptions {
     // target code features
     CompilerOption explore_config;
     CompilerOption time_kernels;
+    CompilerOption print_cost_model;
     // target code features - may be selected by the framework
     CompilerOption kernel_config;
     CompilerOption align_memory;
@@ -79,13 +80,20 @@ class CompilerOptions {
     CompilerOption local_memory;
     CompilerOption multiple_pixels;
     CompilerOption vectorize_kernels;
+    CompilerOption fuse_kernels;
+    CompilerOption separate_masks;
+    CompilerOption running_sums;
+    CompilerOption register_window;
+    CompilerOption runtime_size;
     // user defined values for target code features
     int kernel_config_x, kernel_config_y;
     int align_bytes;
     int pixels_per_thread;
     Texture texture_type;
     std::string rs_package_name;
+    std::string tuning_db;
     int target_ii;
+    bool exact_separation;
 
     void getOptionAsString(CompilerOption option, int val=-1) {
       switch (option) {
@@ -114,19 +122,27 @@ class CompilerOptions {
       target_device(Device::Fermi_20),
       explore_config(OFF),
       time_kernels(OFF),
+      print_cost_model(OFF),
       kernel_config(AUTO),
       align_memory(AUTO),
       texture_memory(AUTO),
       local_memory(AUTO),
       multiple_pixels(AUTO),
       vectorize_kernels(OFF),
+      fuse_kernels(OFF),
+      separate_masks(OFF),
+      running_sums(AUTO),
+      register_window(OFF),
+      runtime_size(OFF),
       kernel_config_x(128),
       kernel_config_y(1),
       align_bytes(0),
       pixels_per_thread(1),
       texture_type(Texture::None),
       rs_package_name("org.hipacc.rs"),
-      target_ii(1)
+      tuning_db(),
+      target_ii(1),
+      exact_separation(false)
     {}
 
     bool emitC99() { return target_lang == Language::C99; }
@@ -154,6 +170,10 @@ class CompilerOptions {
       if (time_kernels & option) return true;
       return false;
     }
+    bool printCostModel(CompilerOption option=(CompilerOption)(ON|USER_ON)) {
+      if (print_cost_model & option) return true;
+      return false;
+    }
     bool useKernelConfig(CompilerOption option=(CompilerOption)(ON|USER_ON)) {
       if (kernel_config & option) return true;
       return false;
@@ -188,16 +208,48 @@ class CompilerOptions {
       if (multiple_pixels & option) return true;
       return false;
     }
+    bool fuseKernels(CompilerOption option=(CompilerOption)(ON|USER_ON)) {
+      if (fuse_kernels & option) return true;
+      return false;
+    }
+    bool separateMasks(CompilerOption option=(CompilerOption)(ON|USER_ON)) {
+      if (separate_masks & option) return true;
+      return false;
+    }
+    bool exactSeparation() { return exact_separation; }
+    bool runningSums(CompilerOption option=(CompilerOption)(AUTO|ON|USER_ON)) {
+      if (running_sums & option) return true;
+      return false;
+    }
+    bool registerWindow(CompilerOption option=(CompilerOption)(ON|USER_ON)) {
+      if (register_window & option) return true;
+      return false;
+    }
+    bool runtimeSize(CompilerOption option=(CompilerOption)(ON|USER_ON)) {
+      if (runtime_size & option) return true;
+      return false;
+    }
     int getPixelsPerThread() { return pixels_per_thread; }
     std::string getRSPackageName() { return rs_package_name; }
+    bool useTuningDatabase() { return !tuning_db.empty(); }
+    std::string getTuningDatabase() { return tuning_db; }
     int getTargetII() { return target_ii; }
 
     void setTargetLang(Language lang) { target_lang = lang; }
     void setTargetDevice(Device td) { target_device = td; }
     void setExploreConfig(CompilerOption o) { explore_config = o; }
     void setTimeKernels(CompilerOption o) { time_kernels = o; }
+    void setPrintCostModel(CompilerOption o) { print_cost_model = o; }
     void setLocalMemory(CompilerOption o) { local_memory = o; }
     void setVectorizeKernels(CompilerOption o) { vectorize_kernels = o; }
+    void setFuseKernels(CompilerOption o) { fuse_kernels = o; }
+    void setSeparateMasks(CompilerOption o, bool exact=false) {
+      separate_masks = o;
+      exact_separation = exact;
+    }
+    void setRunningSums(CompilerOption o) { running_sums = o; }
+    void setRegisterWindow(CompilerOption o) { register_window = o; }
+    void setRuntimeSize(CompilerOption o) { runtime_size = o; }
 
     void setTextureMemory(Texture type) {
       texture_type = type;
@@ -231,6 +283,10 @@ class CompilerOptions {
       target_ii = ii;
     }
 
+    void setTuningDatabase(std::string file) {
+      tuning_db = file;
+    }
+
     std::string getTargetPrefix() {
       switch (target_lang) {
         case Language::Vivado:
@@ -264,6 +320,8 @@ class CompilerOptions {
       getOptionAsString(explore_config);
       llvm::errs() << "\n  Automatic timing of kernel executions: ";
       getOptionAsString(time_kernels);
+      llvm::errs() << "\n  Report of roofline cost model: ";
+      getOptionAsString(print_cost_model);
 
       llvm::errs() << "\n  Kernel execution configuration: ";
       getOptionAsString(kernel_config);
@@ -287,6 +345,22 @@ class CompilerOptions {
       getOptionAsString(multiple_pixels, pixels_per_thread);
       llvm::errs() << "\n  Vectorization of kernels: ";
       getOptionAsString(vectorize_kernels);
+      llvm::errs() << "\n  Fusion of producer/consumer kernels: ";
+      getOptionAsString(fuse_kernels);
+      llvm::errs() << "\n  Decomposition of separable constant masks: ";
+      getOptionAsString(separate_masks);
+      if (separateMasks() && exact_separation) {
+        llvm::errs() << ": bit-exact for integer masks";
+      }
+      llvm::errs() << "\n  Running sums for box filters and rectangular Domains: ";
+      getOptionAsString(running_sums);
+      llvm::errs() << "\n  Register window for multiple pixels per thread: ";
+      getOptionAsString(register_window);
+      llvm::errs() << "\n  Runtime image resolution for Vivado HLS: ";
+      getOptionAsString(runtime_size);
+      llvm::errs() << "\n  Tuning database: ";
+      if (useTuningDatabase()) llvm::errs() << "'" << tuning_db << "'";
+      else llvm::errs() << "DISABLED";
       llvm::errs() << "\n\n";
     }
 };
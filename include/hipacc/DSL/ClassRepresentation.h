@@ -37,6 +37,7 @@
 #include "hipacc/Analysis/KernelStatistics.h"
 #include "hipacc/Config/CompilerOptions.h"
 #include "hipacc/Device/TargetDescription.h"
+#include "hipacc/Device/TuningDatabase.h"
 
 #include <clang/AST/ASTContext.h>
 
@@ -143,13 +144,30 @@ class HipaccMemory : public HipaccSize {
 class HipaccImage : public HipaccMemory {
   private:
     ASTContext &Ctx;
+    // host memory used directly by the image (C/C++ only)
+    std::string host_mem_str;
+    std::string stride_str;
 
   public:
     HipaccImage(ASTContext &Ctx, VarDecl *VD, QualType QT) :
       HipaccMemory(VD, VD->getNameAsString(), QT),
-      Ctx(Ctx)
+      Ctx(Ctx),
+      host_mem_str(),
+      stride_str()
     {}
 
+    void bindHostMemory(std::string mem, unsigned stride) {
+      host_mem_str = mem;
+      stride_str = std::to_string(stride);
+    }
+    bool isBoundToHostMemory() { return !host_mem_str.empty(); }
+    const std::string &getHostMemStr() { return host_mem_str; }
+    // number of pixels from one row to the next
+    std::string getStrideStr() {
+      if (stride_str.empty()) return getSizeXStr();
+      return stride_str;
+    }
+
     unsigned getPixelSize() { return Ctx.getTypeSize(type)/8; }
     std::string getTextureType();
     std::string getImageReadFunction();
@@ -293,6 +311,12 @@ class HipaccMask : public HipaccMemory {
     std::string hostMemName;
     bool *domain_space;
     HipaccMask *copy_mask;
+    // rank-1 decomposition of constant masks: mask(x, y) = col(y) * row(x)
+    bool is_separable;
+    bool is_separable_int;
+    SmallVector<double, 16> row_coeffs, col_coeffs;
+    // constant masks with all coefficients equal
+    bool is_box;
 
   public:
     HipaccMask(VarDecl *VD, QualType QT, MaskType type) :
@@ -304,7 +328,12 @@ class HipaccMask : public HipaccMemory {
       kernels(0),
       hostMemName(),
       domain_space(nullptr),
-      copy_mask(nullptr)
+      copy_mask(nullptr),
+      is_separable(false),
+      is_separable_int(false),
+      row_coeffs(),
+      col_coeffs(),
+      is_box(false)
     {}
 
     ~HipaccMask() {
@@ -369,6 +398,22 @@ class HipaccMask : public HipaccMemory {
     HipaccMask *getCopyMask() {
       return copy_mask;
     }
+    void calcSeparability(ASTContext &Ctx, bool exact);
+    bool isSeparable() { return is_separable; }
+    // factors are integral and reproduce the integer mask exactly
+    bool isSeparableInt() { return is_separable_int; }
+    double getRowCoeff(size_t x) { return row_coeffs[x]; }
+    double getColCoeff(size_t y) { return col_coeffs[y]; }
+    void calcBox(ASTContext &Ctx);
+    // constant Masks with equal coefficients and fully defined constant Domains
+    bool isBox() {
+      if (!isDomain()) return is_box;
+      if (!is_constant || !domain_space) return false;
+      for (size_t i=0; i<size_x*size_y; ++i) {
+        if (!domain_space[i]) return false;
+      }
+      return true;
+    }
 };
 
 
@@ -587,6 +632,16 @@ class HipaccKernel : public HipaccKernelFeatures {
     unsigned max_size_x_undef, max_size_y_undef;
     unsigned num_threads_x, num_threads_y;
     unsigned num_reg, num_lmem, num_smem, num_cmem;
+    // C/C++: tile size for cache blocking (0 disables tiling) and number of
+    // threads (0 selects all threads of the runtime)
+    unsigned tile_size_x, tile_size_y;
+    unsigned num_host_threads;
+    // C/C++: intermediate image of a fused kernel pair, whose rows are
+    // addressed relative to the row buffer of the fused launch
+    HipaccImage *fused_image;
+    // "<kernel hash> <target>" identifying the kernel in the tuning database
+    std::string tuning_key;
+    bool tuned;
 
     void calcSizes();
     void calcConfig();
@@ -628,7 +683,15 @@ class HipaccKernel : public HipaccKernelFeatures {
       num_reg(0),
       num_lmem(0),
       num_smem(0),
-      num_cmem(0)
+      num_cmem(0),
+      tile_size_x(options.emitC99() && options.useKernelConfig(USER_ON) ?
+          options.getKernelConfigX() : 0),
+      tile_size_y(options.emitC99() && options.useKernelConfig(USER_ON) ?
+          options.getKernelConfigY() : 0),
+      num_host_threads(0),
+      fused_image(nullptr),
+      tuning_key(),
+      tuned(false)
     {
       switch (options.getTargetLang()) {
         default: break;
@@ -751,6 +814,15 @@ class HipaccKernel : public HipaccKernelFeatures {
     }
 
     void setDefaultConfig();
+    // select local memory, textures, and pixels per thread not specified by
+    // the user according to the roofline cost model
+    void setCostModelConfig();
+    void setTunedConfig(const HipaccTuningEntry &entry);
+    // compile time configuration as stored in the tuning database
+    std::string getTuningConfig();
+    void setTuningKey(std::string key) { tuning_key = key; }
+    const std::string &getTuningKey() const { return tuning_key; }
+    bool isTuned() { return tuned; }
 
     void printStats() {
       llvm::errs() << "Statistics for Kernel '" << fileName << "'\n";
@@ -781,6 +853,11 @@ class HipaccKernel : public HipaccKernelFeatures {
     }
     unsigned getNumThreadsX() { return num_threads_x; }
     unsigned getNumThreadsY() { return num_threads_y; }
+    unsigned getTileSizeX() { return tile_size_x; }
+    unsigned getTileSizeY() { return tile_size_y; }
+    unsigned getNumHostThreads() { return num_host_threads; }
+    void setFusedImage(HipaccImage *img) { fused_image = img; }
+    HipaccImage *getFusedImage() { return fused_image; }
     unsigned getNumThreadsReduce() {
       return default_num_threads_x*default_num_threads_y;
     }
@@ -234,6 +234,12 @@ class HipaccDevice : public HipaccDeviceOptions {
     unsigned num_alus;
     unsigned num_sfus;
 
+    // roofline model: peak single precision performance (GOP/s) and memory
+    // bandwidth (GB/s) of a representative device; SIMD width of the ALUs
+    float peak_gops;
+    float peak_bandwidth;
+    unsigned simd_width;
+
   public:
     HipaccDevice(CompilerOptions &options) :
       HipaccDeviceOptions(options),
@@ -241,7 +247,10 @@ class HipaccDevice : public HipaccDeviceOptions {
       max_threads_per_warp(32),
       max_blocks_per_multiprocessor(8),
       num_alus(0),
-      num_sfus(0)
+      num_sfus(0),
+      peak_gops(1000),
+      peak_bandwidth(100),
+      simd_width(1)
     {
       switch (target_device) {
         case Device::Tesla_10:
@@ -254,6 +263,8 @@ class HipaccDevice : public HipaccDeviceOptions {
           max_register_per_thread = 124;
           num_alus = 8;
           num_sfus = 2;
+          peak_gops = 346;      // GeForce GTS 8800
+          peak_bandwidth = 64;
           break;
         case Device::Tesla_12:
         case Device::Tesla_13:
@@ -265,6 +276,8 @@ class HipaccDevice : public HipaccDeviceOptions {
           max_register_per_thread = 124;
           num_alus = 8;
           num_sfus = 2;
+          peak_gops = 933;      // GeForce GTX 280
+          peak_bandwidth = 141;
           break;
         case Device::Fermi_20:
           max_threads_per_block = 1024;
@@ -275,6 +288,8 @@ class HipaccDevice : public HipaccDeviceOptions {
           max_register_per_thread = 63;
           num_alus = 32;
           num_sfus = 4;
+          peak_gops = 1030;     // Tesla C2050
+          peak_bandwidth = 144;
           break;
         case Device::Fermi_21:
           max_threads_per_block = 1024;
@@ -285,6 +300,8 @@ class HipaccDevice : public HipaccDeviceOptions {
           max_register_per_thread = 63;
           num_alus = 48;
           num_sfus = 8;
+          peak_gops = 1263;     // GeForce GTX 560 Ti
+          peak_bandwidth = 128;
           break;
         case Device::Kepler_30:
         case Device::Kepler_35:
@@ -299,6 +316,13 @@ class HipaccDevice : public HipaccDeviceOptions {
           num_alus = 192;
           num_sfus = 32;
           // plus 8 CUDA FP64 cores according to andatech
+          if (target_device==Device::Kepler_30) {
+            peak_gops = 3090;   // GeForce GTX 680
+            peak_bandwidth = 192;
+          } else {
+            peak_gops = 3520;   // Tesla K20
+            peak_bandwidth = 208;
+          }
           break;
         case Device::Evergreen:
         case Device::NorthernIsland:
@@ -315,6 +339,14 @@ class HipaccDevice : public HipaccDeviceOptions {
           max_total_shared_memory = 32768;
           num_alus = 4; // 5 on 58; 4 on 69
           num_sfus = 1; // 1 sfu -> 1 alu
+          if (target_device==Device::Evergreen) {
+            peak_gops = 2720;   // Radeon HD 5870
+            peak_bandwidth = 154;
+          } else {
+            peak_gops = 2703;   // Radeon HD 6970
+            peak_bandwidth = 176;
+          }
+          simd_width = 4;
           break;
         case Device::Midgard:
           max_threads_per_warp = 4,
@@ -326,6 +358,9 @@ class HipaccDevice : public HipaccDeviceOptions {
           max_total_shared_memory = 32768;
           num_alus = 4; // vector 4
           num_sfus = 1; // just a guess
+          peak_gops = 68;       // Mali-T604
+          peak_bandwidth = 12.8f;
+          simd_width = 4;
           break;
         case Device::KnightsCorner:
           max_threads_per_warp = 4,
@@ -337,6 +372,9 @@ class HipaccDevice : public HipaccDeviceOptions {
           max_total_shared_memory = 32768;
           num_alus = 16; // 512 bit vector units - for single precision
           num_sfus = 0;
+          peak_gops = 2022;     // Xeon Phi 5110P
+          peak_bandwidth = 320;
+          simd_width = 16;
           break;
       }
     }
@@ -0,0 +1,85 @@
+//
+// Copyright (c) 2012, University of Erlangen-Nuremberg
+// Copyright (c) 2012, Siemens AG
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+//===--- TuningDatabase.h - Database of tuned kernel configurations ------===//
+//
+// This provides the database of kernel configurations found by configuration
+// exploration, keyed by kernel hash, target, and iteration space size.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _TUNING_DATABASE_H
+#define _TUNING_DATABASE_H
+
+#include "hipacc/Config/CompilerOptions.h"
+
+#include <string>
+#include <vector>
+
+namespace clang {
+namespace hipacc {
+// configuration stored in the tuning database, one entry per line:
+//   <kernel hash> <target> <width>x<height> <time in ms> <key>=<value> ...
+// values not specified are -1 (tex: empty)
+struct HipaccTuningEntry {
+  std::string hash, target;
+  unsigned width, height;
+  float time;
+  // block size (CUDA/OpenCL) or tile size (C/C++)
+  int bsx, bsy;
+  int ppt;
+  // number of threads (C/C++)
+  int threads;
+  // local memory threshold and texture types per kernel type (CUDA/OpenCL)
+  int lmem;
+  std::string tex;
+};
+
+class HipaccTuningDatabase {
+  private:
+    std::vector<HipaccTuningEntry> entries;
+
+  public:
+    HipaccTuningDatabase() : entries() {}
+
+    // read all entries from file, returns false if the file can't be read
+    bool load(std::string file);
+
+    // entry for the kernel key ("<kernel hash> <target>"): the entry for the
+    // given size is preferred, otherwise the entry closest in number of
+    // pixels is returned; a size of 0 matches the entry with the largest size
+    const HipaccTuningEntry *lookup(std::string key, unsigned width, unsigned
+        height) const;
+
+    // key identifying the kernel (given as string) on the target
+    static std::string getKey(std::string kernel, CompilerOptions &options);
+};
+} // end namespace hipacc
+} // end namespace clang
+
+#endif  // _TUNING_DATABASE_H
+
+// vim: set ts=2 sw=2 sts=2 et ai:
@@ -59,6 +59,12 @@ class CreateHostStrings {
       indent = std::string(cur_indent, ' ');
     }
 
+    void writeLaunchInfo(HipaccKernel *K, std::string &resultStr);
+    void writeKernelArguments(HipaccKernel *K, HipaccImage *Img, std::string
+        mem, std::string &resultStr);
+    void addAccessorBytes(HipaccKernel *K, HipaccImage *Img, std::string
+        &readStr, std::string &writtenStr);
+
   public:
     CreateHostStrings(CompilerOptions &options, HipaccDevice &device) :
       options(options),
@@ -90,10 +96,14 @@ class CreateHostStrings {
         MemoryTransferDirection direction, std::string &resultStr);
     void writeMemoryTransferDomainFromMask(HipaccMask *Domain,
         HipaccMask *Mask, std::string &resultStr);
+    void writeIntegralImage(HipaccImage *In, HipaccImage *Out, std::string
+        &resultStr);
     void writeMemoryRelease(HipaccMemory *Mem, std::string &resultStr,
         bool isPyramid=false);
     void writeKernelCall(std::string kernelName, HipaccKernelClass *KC,
         HipaccKernel *K, std::string &resultStr);
+    void writeFusedKernelCall(HipaccKernel *P, HipaccKernel *C,
+        HipaccAccessor *Acc, unsigned halo, std::string &resultStr);
     void writeReduceCall(HipaccKernelClass *KC, HipaccKernel *K, std::string
         &resultStr);
     void writeInterpolationDefinition(HipaccKernel *K, HipaccAccessor *Acc,
@@ -167,8 +167,20 @@ void ASTTranslate::initCPU(SmallVector<Stmt *, 16> &kernelBody, Stmt *S) {
         createIntegerLiteral(Ctx, 0));
   }
 
-  // C/C++: int gid_y = offset_y;
-  if (Kernel->getIterationSpace()->getOffsetYDecl()) {
+  // C/C++: int gid_y = gid_y_start;
+  // the runtime distributes bands [gid_y_start, gid_y_end) of rows to threads
+  VarDecl *gid_y_start = nullptr, *gid_y_end = nullptr;
+  if (!compilerOptions.emitVivado()) {
+    gid_y_start = createVarDecl(Ctx, kernelDecl, "gid_y_start", Ctx.IntTy);
+    gid_y_end = createVarDecl(Ctx, kernelDecl, "gid_y_end", Ctx.IntTy);
+    gid_y = createVarDecl(Ctx, kernelDecl, "gid_y", Ctx.IntTy,
+        createDeclRefExpr(Ctx, gid_y_start));
+    // rows of a fused image are held in a buffer starting at fused_row_lo
+    if (Kernel->getFusedImage()) {
+      fusedRowLo = createDeclRefExpr(Ctx, createVarDecl(Ctx, kernelDecl,
+            "fused_row_lo", Ctx.IntTy));
+    }
+  } else if (Kernel->getIterationSpace()->getOffsetYDecl()) {
     gid_y = createVarDecl(Ctx, kernelDecl, "gid_y", Ctx.IntTy,
         getOffsetYDecl(Kernel->getIterationSpace()));
   } else {
@@ -176,12 +188,26 @@ void ASTTranslate::initCPU(SmallVector<Stmt *, 16> &kernelBody, Stmt *S) {
         createIntegerLiteral(Ctx, 0));
   }
 
+  // C/C++: cache blocking using tiles of the user-defined or tuned
+  // configuration
+  //   int tile_x = offset_x; int tile_y = gid_y_start;
+  //   int gid_x = tile_x;    int gid_y = tile_y;
+  VarDecl *tile_x = nullptr, *tile_y = nullptr;
+  int32_t tile_size_x = Kernel->getTileSizeX();
+  int32_t tile_size_y = Kernel->getTileSizeY();
+  if (!compilerOptions.emitVivado() && tile_size_x && tile_size_y) {
+    tile_x = createVarDecl(Ctx, kernelDecl, "tile_x", Ctx.IntTy,
+        gid_x->getInit());
+    tile_y = createVarDecl(Ctx, kernelDecl, "tile_y", Ctx.IntTy,
+        gid_y->getInit());
+    gid_x->setInit(createDeclRefExpr(Ctx, tile_x));
+    gid_y->setInit(createDeclRefExpr(Ctx, tile_y));
+  }
+
   // add gid_x and gid_y statements
   DeclContext *DC = FunctionDecl::castToDeclContext(kernelDecl);
   DC->addDecl(gid_x);
   DC->addDecl(gid_y);
-  DeclStmt *gid_x_stmt = createDeclStmt(Ctx, gid_x);
-  DeclStmt *gid_y_stmt = createDeclStmt(Ctx, gid_y);
 
   tileVars.global_id_x = createDeclRefExpr(Ctx, gid_x);
   tileVars.global_id_y = createDeclRefExpr(Ctx, gid_y);
@@ -196,20 +222,16 @@ void ASTTranslate::initCPU(SmallVector<Stmt *, 16> &kernelBody, Stmt *S) {
   tileVars.local_size_y = createIntegerLiteral(Ctx, 0);
 
   // check if we need border handling
+  bool kernel_x = false;
+  bool kernel_y = false;
   if (KernelClass->getKernelType() != UserOperator) {
     for (auto img : KernelClass->getImgFields()) {
       HipaccAccessor *Acc = Kernel->getImgFromMapping(img);
 
       // check if we need border handling
       if (Acc->getBoundaryMode() != Boundary::UNDEFINED) {
-        if (Acc->getSizeX() > 1) {
-            bh_variant.borders.left = 1;
-            bh_variant.borders.right = 1;
-        }
-        if (Acc->getSizeY() > 1) {
-            bh_variant.borders.top = 1;
-            bh_variant.borders.bottom = 1;
-        }
+        if (Acc->getSizeX() > 1) kernel_x = true;
+        if (Acc->getSizeY() > 1) kernel_y = true;
       }
     }
   }
@@ -219,42 +241,211 @@ void ASTTranslate::initCPU(SmallVector<Stmt *, 16> &kernelBody, Stmt *S) {
     VarDecl *output = createVarDecl(Ctx, kernelDecl, "VivadoDummyOutputVal",
         Kernel->getIterationSpace()->getImage()->getType());
     retValRef = createDeclRefExpr(Ctx, output);
-  }
-  // convert the function body to kernel syntax
-  Stmt *clonedStmt = Clone(S);
-  assert(isa<CompoundStmt>(clonedStmt) && "CompoundStmt for kernel function body expected!");
 
-  if (compilerOptions.emitVivado()) {
+    bh_variant.borders.left = kernel_x;
+    bh_variant.borders.right = kernel_x;
+    bh_variant.borders.top = kernel_y;
+    bh_variant.borders.bottom = kernel_y;
+
+    // convert the function body to kernel syntax
+    Stmt *clonedStmt = Clone(S);
+    assert(isa<CompoundStmt>(clonedStmt) && "CompoundStmt for kernel function body expected!");
+
     kernelBody.push_back(clonedStmt);
-  } else {
+    return;
+  }
+
+  Expr *upper_x = getWidthDecl(Kernel->getIterationSpace());
+  Expr *upper_y = createDeclRefExpr(Ctx, gid_y_end);
+  if (Kernel->getIterationSpace()->getOffsetXDecl()) {
+    upper_x = createBinaryOperator(Ctx, upper_x,
+        getOffsetXDecl(Kernel->getIterationSpace()), BO_Add, Ctx.IntTy);
+  }
+
+  // upper-(n-1): upper bound for processing n consecutive pixels
+  auto createUpper = [&] (Expr *upper, int32_t n) -> Expr * {
+    if (n == 1) return upper;
+    return createBinaryOperator(Ctx, createParenExpr(Ctx, upper),
+        createIntegerLiteral(Ctx, n-1), BO_Sub, Ctx.IntTy);
+  };
+
+  // gid<upper-(n-1) && gid<tile+tile_size-(n-1)
+  auto createCond = [&] (Expr *gid, Expr *upper, VarDecl *tile, int32_t
+      tile_size, int32_t n) -> Expr * {
+    Expr *cond = createBinaryOperator(Ctx, gid, createUpper(upper, n), BO_LT,
+        Ctx.BoolTy);
+    if (tile) {
+      Expr *tile_end = createBinaryOperator(Ctx, createDeclRefExpr(Ctx, tile),
+          createIntegerLiteral(Ctx, tile_size), BO_Add, Ctx.IntTy);
+      cond = createBinaryOperator(Ctx, cond, createBinaryOperator(Ctx, gid,
+            createUpper(tile_end, n), BO_LT, Ctx.BoolTy), BO_LAnd, Ctx.BoolTy);
+    }
+    return cond;
+  };
+
+  // for (; gid_x<upper; gid_x++) {
+  //     body with border handling for the given borders
+  // }
+  auto createLoopX = [&] (Expr *upper, bool left, bool right, bool top, bool
+      bottom) -> Stmt * {
+    bh_variant.borderVal = 0;
+    bh_variant.borders.left = left;
+    bh_variant.borders.right = right;
+    bh_variant.borders.top = top;
+    bh_variant.borders.bottom = bottom;
+
+    // clear all stored decls before cloning, otherwise existing VarDecls will
+    // be reused and we will miss declarations
+    KernelDeclMap.clear();
+
+    // convert the function body to kernel syntax
+    Stmt *clonedStmt = Clone(S);
+    assert(isa<CompoundStmt>(clonedStmt) && "CompoundStmt for kernel function body expected!");
+
+    bh_variant.borderVal = 0;
+
+    return createForStmt(Ctx, nullptr, createCond(tileVars.global_id_x, upper,
+          tile_x, tile_size_x, 1), createUnaryOperator(Ctx,
+          tileVars.global_id_x, UO_PostInc, tileVars.global_id_x->getType()),
+        clonedStmt);
+  };
+
+  // multiple pixels per thread: compute adjacent pixels in one iteration so
+  // that loads of overlapping window columns are kept in registers
+  int32_t ppt = 1;
+  if (compilerOptions.multiplePixelsPerThread(USER_ON) || Kernel->isTuned()) {
+    ppt = Kernel->getPixelsPerThread();
+  }
+
+  // for (; gid_x<upper-(N-1); gid_x+=N) {
+  //     { body: gid_x+0 } ... { body: gid_x+N-1 }
+  // }
+  // for (; gid_x<upper; gid_x++) {
+  //     body: remaining pixels
+  // }
+  auto addUnrolledLoopX = [&] (SmallVector<Stmt *, 16> &rowBody, Expr *upper,
+      bool top, bool bottom) {
+    if (ppt == 1) {
+      rowBody.push_back(createLoopX(upper, false, false, top, bottom));
+      return;
+    }
+
+    Expr *gid_x_ref = tileVars.global_id_x;
+    SmallVector<Stmt *, 16> laneBody;
+    for (int32_t lane=0; lane<ppt; ++lane) {
+      bh_variant.borderVal = 0;
+      bh_variant.borders.top = top;
+      bh_variant.borders.bottom = bottom;
+
+      // lane > 0 computes pixel gid_x+lane
+      if (lane) {
+        tileVars.global_id_x = createParenExpr(Ctx, createBinaryOperator(Ctx,
+              gid_x_ref, createIntegerLiteral(Ctx, lane), BO_Add, Ctx.IntTy));
+      }
+
+      KernelDeclMap.clear();
+      Stmt *clonedStmt = Clone(S);
+      assert(isa<CompoundStmt>(clonedStmt) && "CompoundStmt for kernel function body expected!");
+      laneBody.push_back(clonedStmt);
+    }
+    tileVars.global_id_x = gid_x_ref;
+    bh_variant.borderVal = 0;
+
+    rowBody.push_back(createForStmt(Ctx, nullptr, createCond(gid_x_ref, upper,
+            tile_x, tile_size_x, ppt), createCompoundAssignOperator(Ctx,
+            gid_x_ref, createIntegerLiteral(Ctx, ppt), BO_AddAssign,
+            Ctx.IntTy), createCompoundStmt(Ctx, laneBody)));
+    rowBody.push_back(createLoopX(upper, false, false, top, bottom));
+  };
+
+  // {
+  //     int gid_x = offset_x;
+  //     for (; gid_x<bh_start_left; gid_x++)  { body: left border }
+  //     for (; gid_x<bh_start_right; gid_x++) { body: no border }
+  //     for (; gid_x<is_width+offset_x; gid_x++) { body: right border }
+  // }
+  auto createRow = [&] (bool top, bool bottom) -> Stmt * {
+    SmallVector<Stmt *, 16> rowBody;
+    rowBody.push_back(createDeclStmt(Ctx, gid_x));
+    if (kernel_x) {
+      rowBody.push_back(createLoopX(getBHStartLeft(), true, false, top,
+            bottom));
+      addUnrolledLoopX(rowBody, getBHStartRight(), top, bottom);
+      rowBody.push_back(createLoopX(upper_x, false, true, top, bottom));
+    } else {
+      addUnrolledLoopX(rowBody, upper_x, top, bottom);
+    }
+    return createCompoundStmt(Ctx, rowBody);
+  };
+
+  // for (int gid_y=gid_y_start; gid_y<gid_y_end; gid_y++) {
+  //     row
+  // }
+  auto createLoopY = [&] (Stmt *row) -> Stmt * {
+    return createForStmt(Ctx, createDeclStmt(Ctx, gid_y),
+        createCond(tileVars.global_id_y, upper_y, tile_y, tile_size_y, 1),
+        createUnaryOperator(Ctx, tileVars.global_id_y, UO_PostInc,
+          tileVars.global_id_y->getType()), row);
+  };
+
+  // for (int tile_y=gid_y_start; tile_y<gid_y_end; tile_y+=TY) {
+  //     for (int tile_x=offset_x; tile_x<is_width+offset_x; tile_x+=TX) {
+  //         loop nest, bounds limited to the tile
+  //     }
+  // }
+  auto createTileLoops = [&] (Stmt *nest) -> Stmt * {
+    if (!tile_x) return nest;
+    Expr *tile_x_ref = createDeclRefExpr(Ctx, tile_x);
+    Expr *tile_y_ref = createDeclRefExpr(Ctx, tile_y);
+    Stmt *loop_x = createForStmt(Ctx, createDeclStmt(Ctx, tile_x),
+        createBinaryOperator(Ctx, tile_x_ref, upper_x, BO_LT, Ctx.BoolTy),
+        createCompoundAssignOperator(Ctx, tile_x_ref, createIntegerLiteral(Ctx,
+            tile_size_x), BO_AddAssign, Ctx.IntTy), nest);
+    return createForStmt(Ctx, createDeclStmt(Ctx, tile_y),
+        createBinaryOperator(Ctx, tile_y_ref, upper_y, BO_LT, Ctx.BoolTy),
+        createCompoundAssignOperator(Ctx, tile_y_ref, createIntegerLiteral(Ctx,
+            tile_size_y), BO_AddAssign, Ctx.IntTy), loop_x);
+  };
+
+  if (!kernel_x && !kernel_y) {
     //
-    // for (int gid_y=offset_y; gid_y<is_height+offset_y; gid_y++) {
-    //     for (int gid_x=offset_x; gid_x<is_width+offset_x; gid_x++) {
+    // for (int gid_y=gid_y_start; gid_y<gid_y_end; gid_y++) {
+    //     int gid_x = offset_x;
+    //     for (; gid_x<is_width+offset_x; gid_x++) {
     //         body
     //     }
     // }
     //
-    Expr *upper_x = getWidthDecl(Kernel->getIterationSpace());
-    Expr *upper_y = getHeightDecl(Kernel->getIterationSpace());
-    if (Kernel->getIterationSpace()->getOffsetXDecl()) {
-      upper_x = createBinaryOperator(Ctx, upper_x,
-          getOffsetXDecl(Kernel->getIterationSpace()), BO_Add, Ctx.IntTy);
-    }
-    if (Kernel->getIterationSpace()->getOffsetYDecl()) {
-      upper_y = createBinaryOperator(Ctx, upper_y,
-          getOffsetYDecl(Kernel->getIterationSpace()), BO_Add, Ctx.IntTy);
-    }
-    ForStmt *innerLoop = createForStmt(Ctx, gid_x_stmt, createBinaryOperator(Ctx,
-          tileVars.global_id_x, upper_x, BO_LT, Ctx.BoolTy),
-        createUnaryOperator(Ctx, tileVars.global_id_x, UO_PostInc,
-          tileVars.global_id_x->getType()), clonedStmt);
-    ForStmt *outerLoop = createForStmt(Ctx, gid_y_stmt, createBinaryOperator(Ctx,
-          tileVars.global_id_y, upper_y, BO_LT, Ctx.BoolTy),
-        createUnaryOperator(Ctx, tileVars.global_id_y, UO_PostInc,
-          tileVars.global_id_y->getType()), innerLoop);
+    kernelBody.push_back(createTileLoops(createLoopY(createRow(false,
+            false))));
+    return;
+  }
 
-    kernelBody.push_back(outerLoop);
+  // specialize the loop nest for the interior, the border strips, and the
+  // corners of the iteration space; bh_start_* are computed by the runtime
+  Stmt *rowsBH = nullptr;
+  if (kernel_y) {
+    // if (gid_y < bh_start_top) row: top border
+    // else if (gid_y >= bh_start_bottom) row: bottom border
+    // else row: no border
+    rowsBH = createIfStmt(Ctx, createBinaryOperator(Ctx, tileVars.global_id_y,
+          getBHStartTop(), BO_LT, Ctx.BoolTy), createRow(true, false),
+        createIfStmt(Ctx, createBinaryOperator(Ctx, tileVars.global_id_y,
+            getBHStartBottom(), BO_GE, Ctx.BoolTy), createRow(false, true),
+          createRow(false, false)));
+  } else {
+    rowsBH = createRow(false, false);
   }
+
+  // fall back: in case the image is too small, use code variant with border
+  // handling for all borders
+  SmallVector<Stmt *, 16> rowFB;
+  rowFB.push_back(createDeclStmt(Ctx, gid_x));
+  rowFB.push_back(createLoopX(upper_x, kernel_x, kernel_x, kernel_y,
+        kernel_y));
+
+  kernelBody.push_back(createTileLoops(createIfStmt(Ctx, getBHFallBack(),
+        createLoopY(createCompoundStmt(Ctx, rowFB)), createLoopY(rowsBH))));
 }
 
 
@@ -655,6 +846,11 @@ Stmt *ASTTranslate::Hipacc(Stmt *S) {
     case Language::Vivado:
     case Language::C99:
       initCPU(kernelBody, S);
+      kernelBody.insert(kernelBody.begin(), slidingDeclStmts.begin(),
+          slidingDeclStmts.end());
+      if (numLoadsReused || numIndicesReused)
+        KernelClass->getKernelStatistics().addDeduplicatedLoads(numLoadsReused,
+            numIndicesReused);
       return createCompoundStmt(Ctx, kernelBody);
       break;
     case Language::CUDA:
@@ -1254,6 +1450,19 @@ Stmt *ASTTranslate::Hipacc(Stmt *S) {
       }
     }
 
+    // register window: each thread calculates vertically adjacent pixels,
+    // which share the loads of overlapping window rows - rows are loaded in
+    // front of the first pixel using them and kept in registers
+    bool reg_window = compilerOptions.registerWindow() &&
+                      Kernel->getPixelsPerThread() > 1;
+    SmallVector<Stmt *, 16> windowBody;
+    if (reg_window) {
+      windowScope = createCompoundStmt(Ctx, ArrayRef<Stmt *>());
+      activeCStmts.push_back(windowScope);
+      loadCache.clear();
+      borderIdxCache.clear();
+    }
+
     for (size_t p=0; p<Kernel->getPixelsPerThread(); ++p) {
       // clear all stored decls before cloning, otherwise existing
       // VarDecls will be reused and we will miss declarations
@@ -1262,7 +1471,22 @@ Stmt *ASTTranslate::Hipacc(Stmt *S) {
       // calculate multiple pixels per thread
       SmallVector<Stmt *, 16> pptBody;
 
-      if (p==0) {
+      if (reg_window) {
+        // staging to shared memory is strided by local_size_y, the pixels
+        // of a thread are adjacent:
+        // lid_y*ppt + p and gid_y + lid_y*(ppt-1) + p
+        lidYRef = createBinaryOperator(Ctx, createBinaryOperator(Ctx,
+              tileVars.local_id_y, createIntegerLiteral(Ctx,
+                (int32_t)Kernel->getPixelsPerThread()), BO_Mul, Ctx.IntTy),
+            createIntegerLiteral(Ctx, (int32_t)p), BO_Add, Ctx.IntTy);
+        gidYRef = createBinaryOperator(Ctx, tileVars.global_id_y,
+            createBinaryOperator(Ctx, createBinaryOperator(Ctx,
+                tileVars.local_id_y, createIntegerLiteral(Ctx,
+                  (int32_t)Kernel->getPixelsPerThread()-1), BO_Mul,
+                Ctx.IntTy), createIntegerLiteral(Ctx, (int32_t)p), BO_Add,
+              Ctx.IntTy), BO_Add, Ctx.IntTy);
+        windowRow = p;
+      } else if (p==0) {
         // initialize lid_y and gid_y
         lidYRef = tileVars.local_id_y;
         gidYRef = tileVars.global_id_y;
@@ -1314,6 +1538,20 @@ Stmt *ASTTranslate::Hipacc(Stmt *S) {
       }
 
 
+      if (reg_window) {
+        for (size_t i=0; i<preStmts.size();) {
+          if (preCStmt[i]==windowScope) {
+            windowBody.push_back(preStmts[i]);
+            preStmts.erase(preStmts.begin() + i);
+            preCStmt.erase(preCStmt.begin() + i);
+          } else {
+            ++i;
+          }
+        }
+        windowBody.append(pptBody.begin(), pptBody.end());
+        continue;
+      }
+
       // add iteration space checking in case we have padded images and/or
       // padded block/grid configurations
       if (check_bop) {
@@ -1326,6 +1564,20 @@ Stmt *ASTTranslate::Hipacc(Stmt *S) {
       }
     }
 
+    if (reg_window) {
+      activeCStmts.pop_back();
+      windowScope = nullptr;
+      windowRow = 0;
+
+      // the register window is only loaded within the iteration space
+      if (check_bop) {
+        labelBody.push_back(createIfStmt(Ctx, check_bop,
+              createCompoundStmt(Ctx, windowBody)));
+      } else {
+        labelBody.append(windowBody.begin(), windowBody.end());
+      }
+    }
+
     // add label statement if needed (boundary handling), else add body
     if (border_handling) {
       LabelStmt *LS = createLabelStmt(Ctx, LDS[ld_count++],
@@ -1355,6 +1607,10 @@ Stmt *ASTTranslate::Hipacc(Stmt *S) {
     kernelBody.push_back(createReturnStmt(Ctx, result));
   }
 
+  if (numLoadsReused || numIndicesReused)
+    KernelClass->getKernelStatistics().addDeduplicatedLoads(numLoadsReused,
+        numIndicesReused);
+
   CompoundStmt *CS = createCompoundStmt(Ctx, kernelBody);
 
   return CS;
@@ -1490,23 +1746,29 @@ Stmt *ASTTranslate::VisitCompoundStmtTranslate(CompoundStmt *S) {
   CompoundStmt *result = new (Ctx) CompoundStmt(Ctx, MultiStmtArg(),
       S->getLBracLoc(), S->getLBracLoc());
 
+  // a new copy of the kernel body starts: loads of previous copies are not
+  // visible anymore
+  if (activeCStmts.empty()) {
+    loadCache.clear();
+    borderIdxCache.clear();
+  }
+  activeCStmts.push_back(S);
+
   SmallVector<Stmt *, 16> body;
   for (auto stmt : S->body()) {
     curCStmt = S;
     Stmt *newS = Clone(stmt);
     curCStmt = S;
 
-    if (preStmts.size()) {
-      size_t num_stmts = 0;
-      for (size_t i=0, e=preStmts.size(); i!=e; ++i) {
-        if (preCStmt[i]==S) {
-          body.push_back(preStmts[i]);
-          num_stmts++;
-        }
-      }
-      for (size_t i=0; i<num_stmts; ++i) {
-        preStmts.pop_back();
-        preCStmt.pop_back();
+    // statements for enclosing scopes (e.g. deduplicated loads) may be
+    // interleaved with the statements for this scope
+    for (size_t i=0; i<preStmts.size();) {
+      if (preCStmt[i]==S) {
+        body.push_back(preStmts[i]);
+        preStmts.erase(preStmts.begin() + i);
+        preCStmt.erase(preCStmt.begin() + i);
+      } else {
+        ++i;
       }
     }
 
@@ -1528,6 +1790,7 @@ Stmt *ASTTranslate::VisitCompoundStmtTranslate(CompoundStmt *S) {
   }
 
   result->setStmts(Ctx, body.data(), body.size());
+  activeCStmts.pop_back();
 
   return result;
 }
@@ -2229,37 +2492,6 @@ Expr *ASTTranslate::VisitCXXOperatorCallExprTranslate(CXXOperatorCallExpr *E) {
   if (auto acc = Kernel->getImgFromMapping(FD)) {
     MemoryAccess mem_acc = KernelClass->getMemAccess(FD);
 
-    // Images are ParmVarDecls
-    bool use_shared = false;
-    DeclRefExpr *DRE = nullptr;
-    if (!Kernel->vectorize()) { // Images are replaced by local pointers
-      ParmVarDecl *PVD = dyn_cast_or_null<ParmVarDecl>(LHS->getDecl());
-      assert(PVD && "Image variable must be a ParmVarDecl!");
-
-      if (KernelDeclMapShared[PVD]) {
-        // shared/local memory
-        use_shared = true;
-        VarDecl *VD = KernelDeclMapShared[PVD];
-        DRE = createDeclRefExpr(Ctx, VD);
-      }
-    }
-
-    Expr *SY, *TX;
-    if (acc->getSizeX() > 1) {
-      if (compilerOptions.exploreConfig()) {
-        TX = tileVars.local_size_x;
-      } else {
-        TX = createIntegerLiteral(Ctx, (int)Kernel->getNumThreadsX());
-      }
-    } else {
-      TX = createIntegerLiteral(Ctx, 0);
-    }
-    if (acc->getSizeY() > 1) {
-      SY = createIntegerLiteral(Ctx, (int)acc->getSizeY()/2);
-    } else {
-      SY = createIntegerLiteral(Ctx, 0);
-    }
-
     HipaccMask *Mask = nullptr;
     int mask_idx_x = 0, mask_idx_y = 0;
     switch (E->getNumArgs()) {
@@ -2268,11 +2500,7 @@ Expr *ASTTranslate::VisitCXXOperatorCallExprTranslate(CXXOperatorCallExpr *E) {
         break;
       case 1:
         // 0: -> (this *) Image Class
-        if (use_shared) {
-          result = accessMemShared(DRE, TX, SY);
-        } else {
-          result = accessMem(LHS, acc, mem_acc);
-        }
+        result = accessImage(LHS, acc, mem_acc);
         break;
       case 2:
         // 0: -> (this *) Image Class
@@ -2320,24 +2548,7 @@ Expr *ASTTranslate::VisitCXXOperatorCallExprTranslate(CXXOperatorCallExpr *E) {
           offset_y = Clone(E->getArg(2));
         }
 
-        if (use_shared) {
-          result = accessMemShared(DRE, createBinaryOperator(Ctx, offset_x,
-                TX, BO_Add, Ctx.IntTy), createBinaryOperator(Ctx, offset_y,
-                  SY, BO_Add, Ctx.IntTy));
-        } else {
-          switch (mem_acc) {
-            case READ_ONLY:
-              if (bh_variant.borderVal && !compilerOptions.emitVivado()) {
-                return addBorderHandling(LHS, offset_x, offset_y, acc);
-              }
-              // fall through
-            case WRITE_ONLY:
-            case READ_WRITE:
-            case UNDEFINED:
-              result = accessMem(LHS, acc, mem_acc, offset_x, offset_y);
-              break;
-          }
-        }
+        result = accessImage(LHS, acc, mem_acc, offset_x, offset_y);
         break;
     }
   }
@@ -2348,6 +2559,167 @@ Expr *ASTTranslate::VisitCXXOperatorCallExprTranslate(CXXOperatorCallExpr *E) {
 }
 
 
+// access the Image bound to Accessor acc at the given offsets relative to the
+// current pixel, or at the current pixel if no offsets are given
+Expr *ASTTranslate::accessImage(DeclRefExpr *LHS, HipaccAccessor *acc,
+    MemoryAccess mem_acc, Expr *offset_x, Expr *offset_y) {
+  // Images are ParmVarDecls
+  bool use_shared = false;
+  DeclRefExpr *DRE = nullptr;
+  if (!Kernel->vectorize()) { // Images are replaced by local pointers
+    ParmVarDecl *PVD = dyn_cast_or_null<ParmVarDecl>(LHS->getDecl());
+    assert(PVD && "Image variable must be a ParmVarDecl!");
+
+    if (KernelDeclMapShared[PVD]) {
+      // shared/local memory
+      use_shared = true;
+      VarDecl *VD = KernelDeclMapShared[PVD];
+      DRE = createDeclRefExpr(Ctx, VD);
+    }
+  }
+
+  Expr *SY, *TX;
+  if (acc->getSizeX() > 1) {
+    if (compilerOptions.exploreConfig()) {
+      TX = tileVars.local_size_x;
+    } else {
+      TX = createIntegerLiteral(Ctx, (int)Kernel->getNumThreadsX());
+    }
+  } else {
+    TX = createIntegerLiteral(Ctx, 0);
+  }
+  if (acc->getSizeY() > 1) {
+    SY = createIntegerLiteral(Ctx, (int)acc->getSizeY()/2);
+  } else {
+    SY = createIntegerLiteral(Ctx, 0);
+  }
+
+  if (!offset_x) {
+    if (use_shared) return accessMemShared(DRE, TX, SY);
+    return accessMem(LHS, acc, mem_acc);
+  }
+
+  auto read = [&] () -> Expr * {
+    if (use_shared) {
+      return accessMemShared(DRE, createBinaryOperator(Ctx, offset_x, TX,
+            BO_Add, Ctx.IntTy), createBinaryOperator(Ctx, offset_y, SY,
+              BO_Add, Ctx.IntTy));
+    }
+    switch (mem_acc) {
+      case READ_ONLY:
+        if (bh_variant.borderVal && !compilerOptions.emitVivado()) {
+          return addBorderHandling(LHS, offset_x, offset_y, acc);
+        }
+        // fall through
+      case WRITE_ONLY:
+      case READ_WRITE:
+      case UNDEFINED:
+        break;
+    }
+    return accessMem(LHS, acc, mem_acc, offset_x, offset_y);
+  };
+
+  llvm::APSInt dx, dy;
+  CompoundStmt *scope = getLoadScope(acc, mem_acc, use_shared);
+  if (!scope || !offset_x->EvaluateAsInt(dx, Ctx) ||
+      !offset_y->EvaluateAsInt(dy, Ctx))
+    return read();
+
+  // reuse the pixel if it was loaded before in this or an enclosing scope
+  auto key = std::make_tuple(acc, dx.getSExtValue(), dy.getSExtValue() +
+      windowRow);
+  auto it = loadCache.find(key);
+  if (it != loadCache.end() && isScopeActive(it->second.scope)) {
+    numLoadsReused++;
+    return it->second.value;
+  }
+
+  // otherwise, load the pixel into a temporary variable in the load scope
+  CompoundStmt *cur = curCStmt;
+  curCStmt = dedupScope = scope;
+  Expr *value = read();
+  curCStmt = cur;
+  dedupScope = nullptr;
+
+  DeclRefExpr *value_ref = dyn_cast<DeclRefExpr>(value);
+  if (!value_ref) {
+    std::string pix_str("_pix" + std::to_string(literalCount++));
+    VarDecl *pix_decl = createVarDecl(Ctx, kernelDecl, pix_str,
+        acc->getImage()->getType(), value);
+    DeclContext *DC = FunctionDecl::castToDeclContext(kernelDecl);
+    DC->addDecl(pix_decl);
+    preStmts.push_back(createDeclStmt(Ctx, pix_decl));
+    preCStmt.push_back(scope);
+    value_ref = createDeclRefExpr(Ctx, pix_decl);
+  }
+  loadCache[key] = { scope, value_ref };
+
+  return value_ref;
+}
+
+
+bool ASTTranslate::isScopeActive(CompoundStmt *scope) {
+  return std::find(activeCStmts.begin(), activeCStmts.end(), scope) !=
+    activeCStmts.end();
+}
+
+
+// get the scope pixels read from Accessor Acc are loaded to, or nullptr if
+// loads cannot be deduplicated: loads from global memory are only moved for
+// read-only Accessors with boundary handling, so that they never read out of
+// bounds, and loads within convolutions are moved in front of the outermost
+// convolution; loads in the kernel body are shared by all pixels of the
+// register window
+CompoundStmt *ASTTranslate::getLoadScope(HipaccAccessor *Acc, MemoryAccess
+    mem_acc, bool shared) {
+  if (mem_acc != READ_ONLY || compilerOptions.emitVivado() ||
+      (!shared && Acc->getBoundaryMode() == Boundary::UNDEFINED) ||
+      (Kernel->vectorize() && !compilerOptions.emitC99()))
+    return nullptr;
+
+  // statements are not added to the current scope, e.g. by sliding windows
+  if (activeCStmts.empty() || curCStmt != activeCStmts.back()) return nullptr;
+
+  // break_iterate() jumps across the loads moved in front of later iterations
+  CompoundStmt *scope = curCStmt;
+  if (convMask || !redDomains.empty()) {
+    for (auto contains_break : containsBreak)
+      if (contains_break) return nullptr;
+    scope = loadScope;
+  }
+
+  if (windowScope && activeCStmts.size() > 1 && scope == activeCStmts[1])
+    return windowScope;
+
+  return scope;
+}
+
+
+DeclRefExpr *ASTTranslate::lookupBorderIndex(HipaccAccessor *Acc, Expr
+    *offset, bool x) {
+  llvm::APSInt val;
+  if (!dedupScope || !offset->EvaluateAsInt(val, Ctx)) return nullptr;
+
+  auto it = borderIdxCache.find(std::make_tuple(Acc, val.getSExtValue() +
+        (x ? 0 : windowRow), x));
+  if (it == borderIdxCache.end() || !isScopeActive(it->second.scope))
+    return nullptr;
+
+  numIndicesReused++;
+  return it->second.value;
+}
+
+
+void ASTTranslate::addBorderIndex(HipaccAccessor *Acc, Expr *offset, bool x,
+    DeclRefExpr *idx) {
+  llvm::APSInt val;
+  if (!dedupScope || !offset->EvaluateAsInt(val, Ctx)) return;
+
+  borderIdxCache[std::make_tuple(Acc, val.getSExtValue() + (x ? 0 : windowRow),
+      x)] = { dedupScope, idx };
+}
+
+
 Expr *ASTTranslate::VisitCXXMemberCallExprTranslate(CXXMemberCallExpr *E) {
   assert(isa<MemberExpr>(E->getCallee()) &&
       "Hipacc: Stumbled upon unsupported expression or statement: CXXMemberCallExpr");
@@ -2508,6 +2880,33 @@ Expr *ASTTranslate::VisitCXXMemberCallExprTranslate(CXXMemberCallExpr *E) {
         auto LHS = cast<DeclRefExpr>(Clone(ME->getBase()->IgnoreImpCasts()));
         return mem_at_fun(acc, LHS, mem_acc);
       }
+
+      // Acc.box_sum(x0, y0, x1, y1) method -> four reads of the integral image
+      // Acc(x1+1, y1+1) - Acc(x0, y1+1) - Acc(x1+1, y0) + Acc(x0, y0)
+      if (ME->getMemberNameInfo().getAsString() == "box_sum") {
+        assert(E->getNumArgs()==4 &&
+               "x0, y0, x1, and y1 arguments for box_sum() required!");
+        auto LHS = cast<DeclRefExpr>(Clone(ME->getBase()->IgnoreImpCasts()));
+        auto corner = [&] (unsigned arg_x, unsigned arg_y) -> Expr * {
+          Expr *offset_x = Clone(E->getArg(arg_x));
+          Expr *offset_y = Clone(E->getArg(arg_y));
+          if (arg_x==2)
+            offset_x = createBinaryOperator(Ctx, offset_x,
+                createIntegerLiteral(Ctx, 1), BO_Add, Ctx.IntTy);
+          if (arg_y==3)
+            offset_y = createBinaryOperator(Ctx, offset_y,
+                createIntegerLiteral(Ctx, 1), BO_Add, Ctx.IntTy);
+          return accessImage(LHS, acc, mem_acc, offset_x, offset_y);
+        };
+
+        QualType QT = E->getType();
+        Expr *result = createBinaryOperator(Ctx, corner(2, 3), corner(0, 3),
+            BO_Sub, QT);
+        result = createBinaryOperator(Ctx, result, corner(2, 1), BO_Sub, QT);
+        result = createBinaryOperator(Ctx, result, corner(0, 1), BO_Add, QT);
+
+        return createParenExpr(Ctx, result);
+      }
     }
 
     if (auto mask = Kernel->getMaskFromMapping(FD)) {
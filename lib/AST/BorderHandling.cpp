@@ -212,21 +212,35 @@ Expr *ASTTranslate::addBorderHandling(DeclRefExpr *LHS, Expr *local_offset_x,
     }
   }
 
-  // add temporary variables for updated idx_x and idx_y
+  // add temporary variables for updated idx_x and idx_y; deduplicated loads
+  // reuse the (already clamped) indices of previous loads at the same offset
+  DeclRefExpr *reuse_x = nullptr, *reuse_y = nullptr;
   if (local_offset_x) {
-    VarDecl *tmp_x = createVarDecl(Ctx, kernelDecl, gidx_str, Ctx.IntTy, idx_x);
-    DC->addDecl(tmp_x);
-    idx_x = createDeclRefExpr(Ctx, tmp_x);
-    bhStmts.push_back(createDeclStmt(Ctx, tmp_x));
-    bhCStmt.push_back(curCStmt);
+    if ((reuse_x = lookupBorderIndex(Acc, local_offset_x, true))) {
+      idx_x = reuse_x;
+    } else {
+      VarDecl *tmp_x = createVarDecl(Ctx, kernelDecl, gidx_str, Ctx.IntTy,
+          idx_x);
+      DC->addDecl(tmp_x);
+      idx_x = createDeclRefExpr(Ctx, tmp_x);
+      bhStmts.push_back(createDeclStmt(Ctx, tmp_x));
+      bhCStmt.push_back(curCStmt);
+      addBorderIndex(Acc, local_offset_x, true, cast<DeclRefExpr>(idx_x));
+    }
   }
 
   if (local_offset_y) {
-    VarDecl *tmp_y = createVarDecl(Ctx, kernelDecl, gidy_str, Ctx.IntTy, idx_y);
-    DC->addDecl(tmp_y);
-    idx_y = createDeclRefExpr(Ctx, tmp_y);
-    bhStmts.push_back(createDeclStmt(Ctx, tmp_y));
-    bhCStmt.push_back(curCStmt);
+    if ((reuse_y = lookupBorderIndex(Acc, local_offset_y, false))) {
+      idx_y = reuse_y;
+    } else {
+      VarDecl *tmp_y = createVarDecl(Ctx, kernelDecl, gidy_str, Ctx.IntTy,
+          idx_y);
+      DC->addDecl(tmp_y);
+      idx_y = createDeclRefExpr(Ctx, tmp_y);
+      bhStmts.push_back(createDeclStmt(Ctx, tmp_y));
+      bhCStmt.push_back(curCStmt);
+      addBorderIndex(Acc, local_offset_y, false, cast<DeclRefExpr>(idx_y));
+    }
   }
 
   if (Acc->getBoundaryMode() == Boundary::CONSTANT) {
@@ -328,21 +342,21 @@ Expr *ASTTranslate::addBorderHandling(DeclRefExpr *LHS, Expr *local_offset_x,
     }
 
     if (upperFun) {
-      if (bh_variant.borders.right && local_offset_x) {
+      if (bh_variant.borders.right && local_offset_x && !reuse_x) {
         bhStmts.push_back((*this.*upperFun)(Acc, idx_x, upperX, true));
         bhCStmt.push_back(curCStmt);
       }
-      if (bh_variant.borders.bottom && local_offset_y) {
+      if (bh_variant.borders.bottom && local_offset_y && !reuse_y) {
         bhStmts.push_back((*this.*upperFun)(Acc, idx_y, upperY, false));
         bhCStmt.push_back(curCStmt);
       }
     }
     if (lowerFun) {
-      if (bh_variant.borders.left && local_offset_x) {
+      if (bh_variant.borders.left && local_offset_x && !reuse_x) {
         bhStmts.push_back((*this.*lowerFun)(Acc, idx_x, lowerX, true));
         bhCStmt.push_back(curCStmt);
       }
-      if (bh_variant.borders.top && local_offset_y) {
+      if (bh_variant.borders.top && local_offset_y && !reuse_y) {
         bhStmts.push_back((*this.*lowerFun)(Acc, idx_y, lowerY, false));
         bhCStmt.push_back(curCStmt);
       }
@@ -29,7 +29,8 @@
 //
 //===----------------------------------------------------------------------===//
 
-// includes for numeric_limits
+// includes for fabs and numeric_limits
+#include <cmath>
 #include <limits>
 
 #include "hipacc/AST/ASTTranslate.h"
@@ -38,6 +39,10 @@ using namespace clang;
 using namespace hipacc;
 using namespace ASTNode;
 
+// C/C++: Masks with at least this many elements compute the median of 8-bit
+// values from a sliding histogram instead of a sorting network
+static const size_t MEDIAN_HISTOGRAM_SIZE = 49;
+
 
 // create expression for convolutions
 Stmt *ASTTranslate::getConvolutionStmt(Reduce mode, DeclRefExpr *tmp_var,
@@ -79,8 +84,24 @@ Stmt *ASTTranslate::getConvolutionStmt(Reduce mode, DeclRefExpr *tmp_var,
       result = createCompoundAssignOperator(Ctx, tmp_var, ret_val, BO_MulAssign,
           tmp_var->getType());
       break;
-    case Reduce::MEDIAN:
-      assert(0 && "Unsupported convolution mode.");
+    case Reduce::MEDIAN: {
+      // red[i] = val; the median is selected after the last iteration
+      size_t idx = 0;
+      if (convMask && tmp_var == convTmp) {
+        idx = convIdxY*convMask->getSizeX() + convIdxX;
+      } else {
+        HipaccMask *Domain = redDomains.back();
+        for (int y=0; y<=redIdxY.back(); ++y) {
+          for (int x=0; x<(int)Domain->getSizeX(); ++x) {
+            if (y == redIdxY.back() && x == redIdxX.back()) break;
+            if (Domain->isDomainDefined(x, y)) ++idx;
+          }
+        }
+      }
+      result = createBinaryOperator(Ctx, accessArrayAt(tmp_var,
+            createIntegerLiteral(Ctx, (int32_t)idx)), ret_val, BO_Assign,
+          ret_val->getType());
+      break; }
   }
 
   return result;
@@ -266,6 +287,873 @@ bool ASTTranslate::searchForBreakIterate(Stmt *S) {
 }
 
 
+// check if the expression only depends on the position within the Mask, that
+// is, Accessors are read at the Mask position and no variables are referenced
+bool ASTTranslate::isWindowExpr(Stmt *S, HipaccMask *Mask) {
+  if (auto E = dyn_cast<Expr>(S)) S = E->IgnoreParenImpCasts();
+
+  if (isa<IntegerLiteral>(S) || isa<FloatingLiteral>(S) ||
+      isa<CharacterLiteral>(S))
+    return true;
+
+  if (auto OCE = dyn_cast<CXXOperatorCallExpr>(S)) {
+    // Accessor operator(Mask)
+    if (OCE->getOperator() != OO_Call || OCE->getNumArgs() != 2) return false;
+    auto acc = dyn_cast<MemberExpr>(OCE->getArg(0)->IgnoreImpCasts());
+    auto msk = dyn_cast<MemberExpr>(OCE->getArg(1)->IgnoreImpCasts());
+    if (!acc || !msk || !isa<FieldDecl>(acc->getMemberDecl()) ||
+        !isa<FieldDecl>(msk->getMemberDecl()))
+      return false;
+    return Kernel->getImgFromMapping(cast<FieldDecl>(acc->getMemberDecl())) &&
+           Kernel->getMaskFromMapping(cast<FieldDecl>(msk->getMemberDecl())) ==
+           Mask;
+  }
+
+  // calls to free functions, e.g. math or conversion functions
+  if (auto CE = dyn_cast<CallExpr>(S)) {
+    if (isa<CXXMemberCallExpr>(CE) || !CE->getDirectCallee()) return false;
+    for (auto arg : CE->arguments()) {
+      if (!isWindowExpr(arg, Mask)) return false;
+    }
+    return true;
+  }
+
+  if (auto BO = dyn_cast<BinaryOperator>(S)) {
+    if (BO->isAssignmentOp() || BO->getOpcode() == BO_Comma) return false;
+    return isWindowExpr(BO->getLHS(), Mask) && isWindowExpr(BO->getRHS(), Mask);
+  }
+  if (auto UO = dyn_cast<UnaryOperator>(S)) {
+    if (UO->isIncrementDecrementOp()) return false;
+    return isWindowExpr(UO->getSubExpr(), Mask);
+  }
+  if (auto CE = dyn_cast<CastExpr>(S)) {
+    return isWindowExpr(CE->getSubExpr(), Mask);
+  }
+
+  return false;
+}
+
+
+// check if the expression is a call to the Mask: mask()
+bool ASTTranslate::isMaskCall(Expr *E, HipaccMask *Mask) {
+  auto OCE = dyn_cast<CXXOperatorCallExpr>(E->IgnoreParenImpCasts());
+  if (!OCE || OCE->getOperator() != OO_Call || OCE->getNumArgs() != 1)
+    return false;
+  auto ME = dyn_cast<MemberExpr>(OCE->getArg(0)->IgnoreImpCasts());
+  auto FD = ME ? dyn_cast<FieldDecl>(ME->getMemberDecl()) : nullptr;
+  return FD && Kernel->getMaskFromMapping(FD) == Mask;
+}
+
+
+// get the returned expression of lambda-functions consisting of a single
+// return statement
+static Expr *getReturnValue(LambdaExpr *LE) {
+  auto body = dyn_cast<CompoundStmt>(LE->getBody());
+  if (!body || body->size() != 1) return nullptr;
+  auto ret = dyn_cast<ReturnStmt>(*body->body_begin());
+  if (!ret) return nullptr;
+  return ret->getRetValue();
+}
+
+
+// C/C++: check if the convolution can be computed from column sums, i.e. the
+// lambda-function returns 'mask() * window' for a separable constant Mask;
+// returns the window expression
+Expr *ASTTranslate::getSeparableWindow(LambdaExpr *LE, HipaccMask *Mask) {
+  if (!compilerOptions.emitC99() || !compilerOptions.separateMasks() ||
+      convMode != Reduce::SUM || !Mask->isSeparable() || Kernel->vectorize())
+    return nullptr;
+
+  Expr *ret_val = getReturnValue(LE);
+  if (!ret_val) return nullptr;
+  auto mul = dyn_cast<BinaryOperator>(ret_val->IgnoreParenImpCasts());
+  if (!mul || mul->getOpcode() != BO_Mul) return nullptr;
+
+  Expr *window = nullptr;
+  if (isMaskCall(mul->getLHS(), Mask)) window = mul->getRHS();
+  else if (isMaskCall(mul->getRHS(), Mask)) window = mul->getLHS();
+  if (!window || !isWindowExpr(window, Mask)) return nullptr;
+
+  // approximated factors are applied in floating point, which is not
+  // possible for integer vector types
+  QualType QT = LE->getCallOperator()->getReturnType();
+  if (!Mask->isSeparableInt() && QT->isVectorType() &&
+      !QT->getAs<VectorType>()->getElementType()->isRealFloatingType())
+    return nullptr;
+
+  return window;
+}
+
+
+// access element idx of a local array: array[idx]
+Expr *ASTTranslate::accessArrayAt(DeclRefExpr *array, Expr *idx) {
+  QualType QT = Ctx.getAsConstantArrayType(array->getType())->getElementType();
+
+  return new (Ctx) ArraySubscriptExpr(createImplicitCastExpr(Ctx,
+        Ctx.getPointerType(QT), CK_ArrayToPointerDecay, array, nullptr,
+        VK_RValue), idx, QT, VK_LValue, OK_Ordinary, SourceLocation());
+}
+
+
+// C/C++: declare state of a sliding convolution at function scope
+VarDecl *ASTTranslate::createSlidingDecl(std::string name, QualType QT, Expr
+    *init) {
+  DeclContext *DC = FunctionDecl::castToDeclContext(kernelDecl);
+  VarDecl *VD = createVarDecl(Ctx, kernelDecl, name +
+      std::to_string(literalCount++), QT, init);
+  DC->addDecl(VD);
+  slidingDeclStmts.push_back(createDeclStmt(Ctx, VD));
+
+  return VD;
+}
+
+
+// C/C++: the state of a sliding convolution is declared once per convolve
+// call, so that all code variants of the kernel body use the same state; the
+// next pixel expected by the state is tracked in _nextx/_nexty
+ASTTranslate::SlidingVars &ASTTranslate::getSlidingVars(CXXMemberCallExpr *E) {
+  SlidingVars &vars = slidingVars[E];
+  if (!vars.next_x) {
+    vars.next_x = createSlidingDecl("_nextx", Ctx.IntTy,
+        createIntegerLiteral(Ctx, -1));
+    vars.next_y = createSlidingDecl("_nexty", Ctx.IntTy,
+        createIntegerLiteral(Ctx, -1));
+  }
+
+  return vars;
+}
+
+
+// C/C++: the state has to be initialized at the start of a row or after
+// skipped pixels: gid_x != _nextx || gid_y != _nexty
+Expr *ASTTranslate::getSlidingCheck(SlidingVars &vars) {
+  return createBinaryOperator(Ctx, createBinaryOperator(Ctx,
+        tileVars.global_id_x, createDeclRefExpr(Ctx, vars.next_x), BO_NE,
+        Ctx.BoolTy), createBinaryOperator(Ctx, tileVars.global_id_y,
+        createDeclRefExpr(Ctx, vars.next_y), BO_NE, Ctx.BoolTy), BO_LOr,
+      Ctx.BoolTy);
+}
+
+
+// C/C++: _nextx = gid_x + 1; _nexty = gid_y;
+void ASTTranslate::addSlidingUpdate(SlidingVars &vars, CompoundStmt *outer) {
+  preStmts.push_back(createBinaryOperator(Ctx, createDeclRefExpr(Ctx,
+          vars.next_x), createBinaryOperator(Ctx, tileVars.global_id_x,
+          createIntegerLiteral(Ctx, 1), BO_Add, Ctx.IntTy), BO_Assign,
+        Ctx.IntTy));
+  preCStmt.push_back(outer);
+  preStmts.push_back(createBinaryOperator(Ctx, createDeclRefExpr(Ctx,
+          vars.next_y), tileVars.global_id_y, BO_Assign, Ctx.IntTy));
+  preCStmt.push_back(outer);
+}
+
+
+// clone the window expression at Mask/Domain position (x, y); statements added
+// for border handling are moved to stmts
+Expr *ASTTranslate::cloneWindowAt(Expr *window, int x, int y,
+    SmallVector<Stmt *, 16> &stmts) {
+  CompoundStmt *bhCStmt = createCompoundStmt(Ctx, ArrayRef<Stmt *>());
+  CompoundStmt *cur = curCStmt;
+  curCStmt = bhCStmt;
+  if (convMask) {
+    convIdxX = x;
+    convIdxY = y;
+  } else {
+    redIdxX.push_back(x);
+    redIdxY.push_back(y);
+  }
+  Expr *result = createParenExpr(Ctx, Clone(window));
+  if (!convMask) {
+    redIdxX.pop_back();
+    redIdxY.pop_back();
+  }
+  curCStmt = cur;
+  LambdaDeclMap.clear();
+
+  for (size_t i=0; i<preStmts.size();) {
+    if (preCStmt[i] == bhCStmt) {
+      stmts.push_back(preStmts[i]);
+      preStmts.erase(preStmts.begin() + i);
+      preCStmt.erase(preCStmt.begin() + i);
+    } else {
+      ++i;
+    }
+  }
+
+  return result;
+}
+
+
+// C/C++: compute the convolution of a separable constant Mask from column
+// sums; only the column entering the Mask is summed up, the sums of the other
+// columns are reused from the previous pixel of the row:
+//   if (gid_x != _nextx || gid_y != _nexty) {
+//     _sepv[0] = col(0)*window(0, 0) + ... + col(sy-1)*window(0, sy-1);
+//     ...
+//   }
+//   _sepv[sx-1] = col(0)*window(sx-1, 0) + ... ;
+//   _tmp += row(0)*_sepv[0] + ... + row(sx-1)*_sepv[sx-1];
+//   _sepv[0] = _sepv[1]; ...
+//   _nextx = gid_x + 1; _nexty = gid_y;
+void ASTTranslate::addSeparableConvolution(CXXMemberCallExpr *E, HipaccMask
+    *Mask, Expr *window, DeclRefExpr *tmp_var, CompoundStmt *outer) {
+  int size_x = Mask->getSizeX(), size_y = Mask->getSizeY();
+
+  // approximated factors of integer masks are applied in floating point
+  QualType QT = tmp_var->getType();
+  if (!Mask->isSeparableInt() && !QT->isVectorType() &&
+      !QT->isRealFloatingType())
+    QT = Ctx.FloatTy;
+  QualType CT = QT;
+  if (QT->isVectorType()) CT = QT->getAs<VectorType>()->getElementType();
+
+  auto createCoeff = [&] (double coeff) -> Expr * {
+    if (Mask->isSeparableInt())
+      return createIntegerLiteral(Ctx, (int32_t)coeff);
+    if (CT->isSpecificBuiltinType(BuiltinType::Float))
+      return FloatingLiteral::Create(Ctx, llvm::APFloat((float)coeff), false,
+          CT, SourceLocation());
+    return FloatingLiteral::Create(Ctx, llvm::APFloat(coeff), false, CT,
+        SourceLocation());
+  };
+
+  SlidingVars &vars = getSlidingVars(E);
+  if (!vars.cols) {
+    vars.cols = createSlidingDecl("_sepv", Ctx.getConstantArrayType(QT,
+          llvm::APInt(32, size_x), ArrayType::Normal, 0), nullptr);
+  }
+  auto colAt = [&] (int x) -> Expr * {
+    return accessArrayAt(createDeclRefExpr(Ctx, vars.cols),
+        createIntegerLiteral(Ctx, x));
+  };
+  auto readColAt = [&] (int x) -> Expr * {
+    return createImplicitCastExpr(Ctx, QT, CK_LValueToRValue, colAt(x),
+        nullptr, VK_RValue);
+  };
+
+  // _sepv[x] = col(0)*window(x, 0) + ... + col(sy-1)*window(x, sy-1);
+  auto createColumnSum = [&] (int x) -> Stmt * {
+    SmallVector<Stmt *, 16> stmts;
+    Expr *sum = nullptr;
+    for (int y=0; y<size_y; ++y) {
+      double coeff = Mask->getColCoeff(y);
+      if (coeff == 0) continue;
+
+      Expr *term = cloneWindowAt(window, x, y, stmts);
+      if (coeff != 1)
+        term = createBinaryOperator(Ctx, createCoeff(coeff), term, BO_Mul, QT);
+      sum = sum ? createBinaryOperator(Ctx, sum, term, BO_Add, QT) : term;
+    }
+    if (!sum) sum = getInitExpr(Reduce::SUM, QT);
+    stmts.push_back(createBinaryOperator(Ctx, colAt(x), sum, BO_Assign, QT));
+    return createCompoundStmt(Ctx, stmts);
+  };
+
+  auto addStmt = [&] (Stmt *S) {
+    preStmts.push_back(S);
+    preCStmt.push_back(outer);
+  };
+
+  // sum up all columns at the start of a row or after skipped pixels
+  SmallVector<Stmt *, 16> initCols;
+  for (int x=0; x<size_x-1; ++x) initCols.push_back(createColumnSum(x));
+  addStmt(createIfStmt(Ctx, getSlidingCheck(vars), createCompoundStmt(Ctx,
+          initCols)));
+  addStmt(createColumnSum(size_x-1));
+
+  // _tmp += row(0)*_sepv[0] + ... + row(sx-1)*_sepv[sx-1];
+  Expr *sum = nullptr;
+  for (int x=0; x<size_x; ++x) {
+    double coeff = Mask->getRowCoeff(x);
+    if (coeff == 0) continue;
+
+    Expr *term = readColAt(x);
+    if (coeff != 1)
+      term = createBinaryOperator(Ctx, createCoeff(coeff), term, BO_Mul, QT);
+    sum = sum ? createBinaryOperator(Ctx, sum, term, BO_Add, QT) : term;
+  }
+  addStmt(getConvolutionStmt(Reduce::SUM, tmp_var, sum));
+
+  // slide the column sums for the next pixel
+  for (int x=0; x<size_x-1; ++x) {
+    addStmt(createBinaryOperator(Ctx, colAt(x), readColAt(x+1), BO_Assign,
+          QT));
+  }
+  addSlidingUpdate(vars, outer);
+}
+
+
+// check if the convolution or reduction sums up the window with a common
+// coefficient, i.e. the lambda-function returns 'mask() * window' for a box
+// Mask or 'window' for a fully defined Domain; returns the window expression
+// and the coefficient (nullptr for Domains)
+Expr *ASTTranslate::getBoxWindow(LambdaExpr *LE, HipaccMask *Mask, Reduce
+    mode, Expr *&coeff) {
+  coeff = nullptr;
+  if (mode != Reduce::SUM || !compilerOptions.runningSums() || !Mask->isBox())
+    return nullptr;
+
+  Expr *ret_val = getReturnValue(LE);
+  if (!ret_val) return nullptr;
+
+  Expr *window = nullptr;
+  if (Mask->isDomain()) {
+    window = ret_val;
+  } else {
+    auto mul = dyn_cast<BinaryOperator>(ret_val->IgnoreParenImpCasts());
+    if (!mul || mul->getOpcode() != BO_Mul) return nullptr;
+    if (isMaskCall(mul->getLHS(), Mask)) {
+      coeff = mul->getLHS();
+      window = mul->getRHS();
+    } else if (isMaskCall(mul->getRHS(), Mask)) {
+      coeff = mul->getRHS();
+      window = mul->getLHS();
+    }
+  }
+  if (!window || !isWindowExpr(window, Mask)) return nullptr;
+
+  // reassociating the sum is only bit-exact for integer arithmetic
+  QualType QT = LE->getCallOperator()->getReturnType();
+  if (QT->isVectorType()) QT = QT->getAs<VectorType>()->getElementType();
+  if (!compilerOptions.runningSums(USER_ON) && (!QT->isIntegerType() ||
+        !window->getType()->isIntegerType() ||
+        (coeff && !Mask->getType()->isIntegerType())))
+    return nullptr;
+
+  if (compilerOptions.emitC99() && !Kernel->vectorize()) return window;
+
+  // other targets: only a common coefficient != 1 can be factored out
+  Expr::EvalResult val;
+  if (!coeff || !Mask->getInitExpr(0, 0)->EvaluateAsRValue(val, Ctx))
+    return nullptr;
+  if (val.Val.isInt() && val.Val.getInt() == 1) return nullptr;
+  if (val.Val.isFloat() && val.Val.getFloat().isExactlyValue(1.0))
+    return nullptr;
+
+  return window;
+}
+
+
+// compute the sum of a box Mask or fully defined Domain; C/C++ updates the sum
+// while sliding along the row: the sums of the last sx columns are kept in a
+// ring buffer and only the column entering the Mask is summed up, so that the
+// costs per pixel do not depend on the width of the Mask:
+//   if (gid_x != _nextx || gid_y != _nexty) {
+//     _boxsum = 0;
+//     _boxv[(gid_x+x)%sx] = window(x, 0) + ... + window(x, sy-1);
+//     _boxsum += _boxv[(gid_x+x)%sx];
+//     _boxv[(gid_x+sx-1)%sx] = 0;
+//   }
+//   int _slot = (gid_x+sx-1)%sx;
+//   _boxsum -= _boxv[_slot];
+//   _boxv[_slot] = window(sx-1, 0) + ... + window(sx-1, sy-1);
+//   _boxsum += _boxv[_slot];
+//   _tmp += coeff * _boxsum;
+//   _nextx = gid_x + 1; _nexty = gid_y;
+// pixels of other targets are not processed in order, here the window is
+// summed up and multiplied once: _tmp += coeff * (window(0, 0) + ...);
+void ASTTranslate::addBoxSum(CXXMemberCallExpr *E, HipaccMask *Mask, Expr
+    *window, Expr *coeff, DeclRefExpr *tmp_var, CompoundStmt *outer) {
+  int size_x = Mask->getSizeX(), size_y = Mask->getSizeY();
+  QualType QT = tmp_var->getType();
+
+  auto addStmt = [&] (Stmt *S) {
+    preStmts.push_back(S);
+    preCStmt.push_back(outer);
+  };
+  auto addSum = [&] (Expr *sum) {
+    if (coeff) {
+      SmallVector<Stmt *, 16> stmts;
+      sum = createBinaryOperator(Ctx, cloneWindowAt(coeff, 0, 0, stmts), sum,
+          BO_Mul, QT);
+    }
+    addStmt(getConvolutionStmt(Reduce::SUM, tmp_var, sum));
+  };
+
+  // window(x, 0) + ... + window(x, sy-1)
+  auto createColumnSum = [&] (int x, SmallVector<Stmt *, 16> &stmts) -> Expr * {
+    Expr *sum = nullptr;
+    for (int y=0; y<size_y; ++y) {
+      Expr *term = cloneWindowAt(window, x, y, stmts);
+      sum = sum ? createBinaryOperator(Ctx, sum, term, BO_Add, QT) : term;
+    }
+    return sum;
+  };
+
+  if (!compilerOptions.emitC99() || Kernel->vectorize()) {
+    SmallVector<Stmt *, 16> stmts;
+    Expr *sum = nullptr;
+    for (int x=0; x<size_x; ++x) {
+      Expr *col = createColumnSum(x, stmts);
+      sum = sum ? createBinaryOperator(Ctx, sum, col, BO_Add, QT) : col;
+    }
+    for (auto stmt : stmts) addStmt(stmt);
+    addSum(createParenExpr(Ctx, sum));
+    return;
+  }
+
+  SlidingVars &vars = getSlidingVars(E);
+  if (!vars.sum) {
+    vars.cols = createSlidingDecl("_boxv", Ctx.getConstantArrayType(QT,
+          llvm::APInt(32, size_x), ArrayType::Normal, 0), nullptr);
+    vars.sum = createSlidingDecl("_boxsum", QT, nullptr);
+  }
+  auto DRE = [&] (VarDecl *VD) -> DeclRefExpr * {
+    return createDeclRefExpr(Ctx, VD);
+  };
+  auto read = [&] (Expr *E) -> Expr * {
+    return createImplicitCastExpr(Ctx, E->getType(), CK_LValueToRValue, E,
+        nullptr, VK_RValue);
+  };
+  // _boxv[(gid_x+x)%sx]
+  auto createSlot = [&] (int x) -> Expr * {
+    return createBinaryOperator(Ctx, createParenExpr(Ctx,
+          createBinaryOperator(Ctx, tileVars.global_id_x,
+            createIntegerLiteral(Ctx, x), BO_Add, Ctx.IntTy)),
+        createIntegerLiteral(Ctx, size_x), BO_Rem, Ctx.IntTy);
+  };
+  auto colAt = [&] (Expr *slot) -> Expr * {
+    return accessArrayAt(DRE(vars.cols), slot);
+  };
+
+  // sum up all columns at the start of a row or after skipped pixels; the
+  // slot of the entering column is cleared, it is subtracted below
+  SmallVector<Stmt *, 16> initSum;
+  initSum.push_back(createBinaryOperator(Ctx, DRE(vars.sum),
+        getInitExpr(Reduce::SUM, QT), BO_Assign, QT));
+  for (int x=0; x<size_x-1; ++x) {
+    SmallVector<Stmt *, 16> stmts;
+    Expr *col = createColumnSum(x, stmts);
+    stmts.push_back(createBinaryOperator(Ctx, colAt(createSlot(x)), col,
+          BO_Assign, QT));
+    stmts.push_back(createCompoundAssignOperator(Ctx, DRE(vars.sum),
+          read(colAt(createSlot(x))), BO_AddAssign, QT));
+    initSum.push_back(createCompoundStmt(Ctx, stmts));
+  }
+  initSum.push_back(createBinaryOperator(Ctx, colAt(createSlot(size_x-1)),
+        getInitExpr(Reduce::SUM, QT), BO_Assign, QT));
+  addStmt(createIfStmt(Ctx, getSlidingCheck(vars), createCompoundStmt(Ctx,
+          initSum)));
+
+  // replace the column leaving the Mask by the entering column
+  SmallVector<Stmt *, 16> stmts;
+  DeclContext *DC = FunctionDecl::castToDeclContext(kernelDecl);
+  VarDecl *slot = createVarDecl(Ctx, kernelDecl, "_slot" +
+      std::to_string(literalCount++), Ctx.IntTy, createSlot(size_x-1));
+  DC->addDecl(slot);
+  stmts.push_back(createDeclStmt(Ctx, slot));
+  stmts.push_back(createCompoundAssignOperator(Ctx, DRE(vars.sum),
+        read(colAt(read(DRE(slot)))), BO_SubAssign, QT));
+  Expr *col = createColumnSum(size_x-1, stmts);
+  stmts.push_back(createBinaryOperator(Ctx, colAt(read(DRE(slot))), col,
+        BO_Assign, QT));
+  stmts.push_back(createCompoundAssignOperator(Ctx, DRE(vars.sum),
+        read(colAt(read(DRE(slot)))), BO_AddAssign, QT));
+  addStmt(createCompoundStmt(Ctx, stmts));
+
+  addSum(read(DRE(vars.sum)));
+  addSlidingUpdate(vars, outer);
+}
+
+
+// check if the convolution can be specialized for the coefficients of a
+// constant Mask, i.e. the lambda-function returns 'mask() * window' and all
+// coefficients evaluate to constants; returns the window expression
+Expr *ASTTranslate::getCoefficientWindow(LambdaExpr *LE, HipaccMask *Mask) {
+  if (convMode != Reduce::SUM || !Mask->isConstant()) return nullptr;
+
+  Expr *ret_val = getReturnValue(LE);
+  if (!ret_val) return nullptr;
+  auto mul = dyn_cast<BinaryOperator>(ret_val->IgnoreParenImpCasts());
+  if (!mul || mul->getOpcode() != BO_Mul) return nullptr;
+
+  Expr *window = nullptr;
+  if (isMaskCall(mul->getLHS(), Mask)) window = mul->getRHS();
+  else if (isMaskCall(mul->getRHS(), Mask)) window = mul->getLHS();
+  if (!window || !isWindowExpr(window, Mask)) return nullptr;
+
+  for (size_t y=0; y<Mask->getSizeY(); ++y) {
+    for (size_t x=0; x<Mask->getSizeX(); ++x) {
+      Expr::EvalResult val;
+      if (!Mask->getInitExpr(x, y)->EvaluateAsRValue(val, Ctx) ||
+          !(val.Val.isInt() || val.Val.isFloat()))
+        return nullptr;
+    }
+  }
+
+  return window;
+}
+
+
+// convolution specialized for the coefficients of a constant Mask: taps with
+// coefficient 0 are skipped including their loads and taps with coefficient
+// +-1 are added or subtracted; for integer arithmetic, taps with the same
+// coefficient are summed up before the multiplication, which is replaced by a
+// shift for powers of two and unsigned windows:
+//   _tmp += c * (window(x0, y0) + window(x1, y1) + ...);
+//   _tmp -= (window(x2, y2) + ...) << 1;
+//   _tmp += window(x3, y3);
+// floating-point taps are not reassociated and kept in order
+void ASTTranslate::addCoefficientConvolution(HipaccMask *Mask, Expr *window,
+    DeclRefExpr *tmp_var, CompoundStmt *outer) {
+  QualType QT = tmp_var->getType();
+  QualType WT = window->getType();
+  auto getElementType = [] (QualType T) -> QualType {
+    if (T->isVectorType()) return T->getAs<VectorType>()->getElementType();
+    return T;
+  };
+  QualType ET = getElementType(QT), WET = getElementType(WT);
+  QualType MT = Mask->getType();
+
+  bool is_int = MT->isIntegerType() && WET->isIntegerType() &&
+                ET->isIntegerType();
+  // the product of a floating-point coefficient 1 and an integer window is
+  // rounded when converted back to an integer result
+  bool fold_one = !MT->isRealFloatingType() || WET->isRealFloatingType() ||
+                  ET->isRealFloatingType();
+  // shifts are only used for scalar windows that cannot be negative
+  bool use_shift = is_int && !QT->isVectorType() && !WT->isVectorType() &&
+    window->IgnoreParenImpCasts()->getType()->isUnsignedIntegerType();
+  // taps with equal coefficients are summed in the result type: scalar window
+  // values are converted, vector windows need the result type already
+  bool is_scalar = !QT->isVectorType() && !WT->isVectorType();
+  bool group_taps = is_int &&
+    (is_scalar || Ctx.hasSameUnqualifiedType(QT, WT));
+  bool convert_taps = is_scalar && !Ctx.hasSameUnqualifiedType(QT, WT);
+
+  struct TapGroup {
+    double coeff;
+    Expr *init;
+    SmallVector<std::pair<int, int>, 16> taps;
+  };
+  SmallVector<TapGroup, 16> groups;
+  for (int y=0; y<(int)Mask->getSizeY(); ++y) {
+    for (int x=0; x<(int)Mask->getSizeX(); ++x) {
+      Expr::EvalResult val;
+      Mask->getInitExpr(x, y)->EvaluateAsRValue(val, Ctx);
+      double coeff = val.Val.isInt() ?
+        (double)val.Val.getInt().getSExtValue() :
+        val.Val.getFloat().convertToDouble();
+      if (coeff == 0) continue;
+
+      TapGroup *group = nullptr;
+      if (group_taps) {
+        for (auto &G : groups) {
+          if (G.coeff == coeff) group = &G;
+        }
+      }
+      if (!group) {
+        groups.push_back(TapGroup{ coeff, Mask->getInitExpr(x, y), {} });
+        group = &groups.back();
+      }
+      group->taps.push_back(std::make_pair(x, y));
+    }
+  }
+
+  for (auto &G : groups) {
+    SmallVector<Stmt *, 16> stmts;
+    Expr *sum = nullptr;
+    QualType ST = G.taps.size() > 1 ? QT : WT;
+    for (auto tap : G.taps) {
+      Expr *term = cloneWindowAt(window, tap.first, tap.second, stmts);
+      if (G.taps.size() > 1 && convert_taps) {
+        term = createCStyleCastExpr(Ctx, QT, CK_IntegralCast,
+            createParenExpr(Ctx, term), nullptr,
+            Ctx.getTrivialTypeSourceInfo(QT));
+      }
+      sum = sum ? createBinaryOperator(Ctx, sum, term, BO_Add, ST) : term;
+    }
+    if (G.taps.size() > 1) sum = createParenExpr(Ctx, sum);
+
+    double mag = std::fabs(G.coeff);
+    int shift = 0;
+    while (shift < 30 && (double)(1 << shift) < mag) ++shift;
+    bool subtract = false;
+    if (mag == 1 && fold_one) {
+      subtract = G.coeff < 0;
+    } else if (use_shift && (double)(1 << shift) == mag) {
+      sum = createParenExpr(Ctx, createBinaryOperator(Ctx, sum,
+            createIntegerLiteral(Ctx, shift), BO_Shl, ST));
+      subtract = G.coeff < 0;
+    } else {
+      sum = createBinaryOperator(Ctx, Clone(G.init), sum, BO_Mul, QT);
+    }
+
+    for (auto stmt : stmts) {
+      preStmts.push_back(stmt);
+      preCStmt.push_back(outer);
+    }
+    if (subtract) {
+      preStmts.push_back(createCompoundAssignOperator(Ctx, tmp_var, sum,
+            BO_SubAssign, QT));
+    } else {
+      preStmts.push_back(getConvolutionStmt(Reduce::SUM, tmp_var, sum));
+    }
+    preCStmt.push_back(outer);
+  }
+}
+
+
+// C/C++: check if the median can be computed from a histogram, i.e. the
+// lambda-function returns an 8-bit unsigned window expression and the Mask is
+// large enough so that updating the histogram is cheaper than sorting
+Expr *ASTTranslate::getMedianWindow(LambdaExpr *LE, HipaccMask *Mask) {
+  if (!compilerOptions.emitC99() || convMode != Reduce::MEDIAN ||
+      Kernel->vectorize() ||
+      Mask->getSizeX()*Mask->getSizeY() < MEDIAN_HISTOGRAM_SIZE)
+    return nullptr;
+
+  QualType QT = LE->getCallOperator()->getReturnType();
+  if (!QT->isSpecificBuiltinType(BuiltinType::UChar) &&
+      !QT->isSpecificBuiltinType(BuiltinType::Char_U))
+    return nullptr;
+
+  Expr *window = getReturnValue(LE);
+  if (!window || !isWindowExpr(window, Mask)) return nullptr;
+
+  return window;
+}
+
+
+// C/C++: compute the median from a histogram of the window that slides along
+// the row; the values of the last sx columns are kept in a ring buffer, the
+// column entering the Mask replaces the column leaving it:
+//   if (gid_x != _nextx || gid_y != _nexty) {
+//     for (int _i=0; _i<256; ++_i) _medhist[_i] = 0;
+//     _medhist[0] = sy; _medring[(gid_x+sx-1)%sx*sy + y] = 0;
+//     _medhist[_medring[(gid_x+x)%sx*sy + y] = window(x, y)]++;
+//     _med = 0; _medbelow = 0;
+//   }
+//   int _slot = (gid_x+sx-1)%sx*sy;
+//   _medhist[_medring[_slot+y]]--; _medbelow -= _medring[_slot+y] < _med;
+//   _medring[_slot+y] = window(sx-1, y);
+//   _medhist[_medring[_slot+y]]++; _medbelow += _medring[_slot+y] < _med;
+//   while (_medbelow > rank) { _med--; _medbelow -= _medhist[_med]; }
+//   while (_medbelow + _medhist[_med] <= rank) {
+//     _medbelow += _medhist[_med]; _med++;
+//   }
+//   _tmp = _med;
+//   _nextx = gid_x + 1; _nexty = gid_y;
+void ASTTranslate::addMedianHistogram(CXXMemberCallExpr *E, HipaccMask *Mask,
+    Expr *window, DeclRefExpr *tmp_var, CompoundStmt *outer) {
+  int size_x = Mask->getSizeX(), size_y = Mask->getSizeY();
+  int rank = (size_x*size_y - 1) / 2;
+  QualType QT = tmp_var->getType();
+
+  SlidingVars &vars = getSlidingVars(E);
+  if (!vars.hist) {
+    vars.cols = createSlidingDecl("_medring", Ctx.getConstantArrayType(QT,
+          llvm::APInt(32, size_x*size_y), ArrayType::Normal, 0), nullptr);
+    vars.hist = createSlidingDecl("_medhist", Ctx.getConstantArrayType(
+          Ctx.IntTy, llvm::APInt(32, 256), ArrayType::Normal, 0), nullptr);
+    vars.median = createSlidingDecl("_med", Ctx.IntTy, nullptr);
+    vars.below = createSlidingDecl("_medbelow", Ctx.IntTy, nullptr);
+  }
+  auto DRE = [&] (VarDecl *VD) -> DeclRefExpr * {
+    return createDeclRefExpr(Ctx, VD);
+  };
+  auto read = [&] (Expr *E) -> Expr * {
+    return createImplicitCastExpr(Ctx, E->getType(), CK_LValueToRValue, E,
+        nullptr, VK_RValue);
+  };
+  // _medring[(gid_x+x)%sx*sy + y]
+  auto ringAt = [&] (Expr *slot, int y) -> Expr * {
+    return accessArrayAt(DRE(vars.cols), createBinaryOperator(Ctx, slot,
+          createIntegerLiteral(Ctx, y), BO_Add, Ctx.IntTy));
+  };
+  auto createSlot = [&] (int x) -> Expr * {
+    Expr *idx = createParenExpr(Ctx, createBinaryOperator(Ctx,
+          tileVars.global_id_x, createIntegerLiteral(Ctx, x), BO_Add,
+          Ctx.IntTy));
+    return createBinaryOperator(Ctx, createBinaryOperator(Ctx, idx,
+          createIntegerLiteral(Ctx, size_x), BO_Rem, Ctx.IntTy),
+        createIntegerLiteral(Ctx, size_y), BO_Mul, Ctx.IntTy);
+  };
+  auto histAt = [&] (Expr *idx) -> Expr * {
+    return accessArrayAt(DRE(vars.hist), idx);
+  };
+  auto createBelow = [&] (Expr *val, BinaryOperator::Opcode opc) -> Expr * {
+    return createCompoundAssignOperator(Ctx, DRE(vars.below),
+        createBinaryOperator(Ctx, read(val), read(DRE(vars.median)), BO_LT,
+          Ctx.BoolTy), opc, Ctx.IntTy);
+  };
+
+  auto addStmt = [&] (Stmt *S) {
+    preStmts.push_back(S);
+    preCStmt.push_back(outer);
+  };
+
+  // build the histogram at the start of a row or after skipped pixels; the
+  // slot of the entering column holds zeros, which are removed again below
+  SmallVector<Stmt *, 16> initHist;
+  DeclContext *DC = FunctionDecl::castToDeclContext(kernelDecl);
+  VarDecl *idx = createVarDecl(Ctx, kernelDecl, "_i" +
+      std::to_string(literalCount++), Ctx.IntTy, createIntegerLiteral(Ctx, 0));
+  DC->addDecl(idx);
+  initHist.push_back(createForStmt(Ctx, createDeclStmt(Ctx, idx),
+        createBinaryOperator(Ctx, DRE(idx), createIntegerLiteral(Ctx, 256),
+          BO_LT, Ctx.BoolTy), createUnaryOperator(Ctx, DRE(idx), UO_PreInc,
+          Ctx.IntTy), createBinaryOperator(Ctx, histAt(read(DRE(idx))),
+          createIntegerLiteral(Ctx, 0), BO_Assign, Ctx.IntTy)));
+  initHist.push_back(createBinaryOperator(Ctx, histAt(createIntegerLiteral(Ctx,
+            0)), createIntegerLiteral(Ctx, size_y), BO_Assign, Ctx.IntTy));
+  for (int y=0; y<size_y; ++y) {
+    initHist.push_back(createBinaryOperator(Ctx, ringAt(createSlot(size_x-1),
+            y), createIntegerLiteral(Ctx, 0), BO_Assign, QT));
+  }
+  for (int x=0; x<size_x-1; ++x) {
+    SmallVector<Stmt *, 16> stmts;
+    for (int y=0; y<size_y; ++y) {
+      Expr *val = cloneWindowAt(window, x, y, stmts);
+      stmts.push_back(createUnaryOperator(Ctx, histAt(createBinaryOperator(Ctx,
+                ringAt(createSlot(x), y), val, BO_Assign, QT)), UO_PostInc,
+            Ctx.IntTy));
+    }
+    initHist.push_back(createCompoundStmt(Ctx, stmts));
+  }
+  initHist.push_back(createBinaryOperator(Ctx, DRE(vars.median),
+        createIntegerLiteral(Ctx, 0), BO_Assign, Ctx.IntTy));
+  initHist.push_back(createBinaryOperator(Ctx, DRE(vars.below),
+        createIntegerLiteral(Ctx, 0), BO_Assign, Ctx.IntTy));
+  addStmt(createIfStmt(Ctx, getSlidingCheck(vars), createCompoundStmt(Ctx,
+          initHist)));
+
+  // replace the column leaving the Mask by the entering column
+  SmallVector<Stmt *, 16> stmts;
+  VarDecl *slot = createVarDecl(Ctx, kernelDecl, "_slot" +
+      std::to_string(literalCount++), Ctx.IntTy, createSlot(size_x-1));
+  DC->addDecl(slot);
+  stmts.push_back(createDeclStmt(Ctx, slot));
+  for (int y=0; y<size_y; ++y) {
+    Expr *val = cloneWindowAt(window, size_x-1, y, stmts);
+    stmts.push_back(createUnaryOperator(Ctx, histAt(read(ringAt(read(DRE(slot)),
+                y))), UO_PostDec, Ctx.IntTy));
+    stmts.push_back(createBelow(ringAt(read(DRE(slot)), y), BO_SubAssign));
+    stmts.push_back(createBinaryOperator(Ctx, ringAt(read(DRE(slot)), y), val,
+          BO_Assign, QT));
+    stmts.push_back(createUnaryOperator(Ctx, histAt(read(ringAt(read(DRE(slot)),
+                y))), UO_PostInc, Ctx.IntTy));
+    stmts.push_back(createBelow(ringAt(read(DRE(slot)), y), BO_AddAssign));
+  }
+  addStmt(createCompoundStmt(Ctx, stmts));
+
+  // move the median until 'rank' values are below and the median bin
+  // contains the value of the given rank
+  Expr *median = read(DRE(vars.median));
+  Expr *below = read(DRE(vars.below));
+  Expr *rank_lit = createIntegerLiteral(Ctx, rank);
+  SmallVector<Stmt *, 16> down;
+  down.push_back(createUnaryOperator(Ctx, DRE(vars.median), UO_PostDec,
+        Ctx.IntTy));
+  down.push_back(createCompoundAssignOperator(Ctx, DRE(vars.below),
+        read(histAt(median)), BO_SubAssign, Ctx.IntTy));
+  addStmt(createWhileStmt(Ctx, nullptr, createBinaryOperator(Ctx, below,
+          rank_lit, BO_GT, Ctx.BoolTy), createCompoundStmt(Ctx, down)));
+  SmallVector<Stmt *, 16> up;
+  up.push_back(createCompoundAssignOperator(Ctx, DRE(vars.below),
+        read(histAt(median)), BO_AddAssign, Ctx.IntTy));
+  up.push_back(createUnaryOperator(Ctx, DRE(vars.median), UO_PostInc,
+        Ctx.IntTy));
+  addStmt(createWhileStmt(Ctx, nullptr, createBinaryOperator(Ctx,
+          createBinaryOperator(Ctx, below, read(histAt(median)), BO_Add,
+            Ctx.IntTy), rank_lit, BO_LE, Ctx.BoolTy), createCompoundStmt(Ctx,
+            up)));
+
+  addStmt(createBinaryOperator(Ctx, tmp_var, median, BO_Assign, QT));
+  addSlidingUpdate(vars, outer);
+}
+
+
+// select the value of the given rank from values[0..num_values) using a
+// sorting network of min/max operations (Batcher's odd-even merge sort);
+// compare-exchange operations that do not contribute to the selected value
+// are removed and only the required min or max of the others is computed
+void ASTTranslate::addMedianNetwork(DeclRefExpr *values, size_t num_values,
+    size_t rank, CompoundStmt *outer) {
+  struct CompareExchange {
+    size_t lo, hi;
+    bool min, max;
+  };
+  int n = num_values;
+
+  SmallVector<CompareExchange, 128> network;
+  for (int p=1; p<n; p<<=1) {
+    for (int k=p; k>=1; k>>=1) {
+      for (int j=k%p; j+k<n; j+=2*k) {
+        for (int i=0; i<std::min(k, n-j-k); ++i) {
+          if ((i+j)/(2*p) == (i+j+k)/(2*p))
+            network.push_back({ (size_t)(i+j), (size_t)(i+j+k), true, true });
+        }
+      }
+    }
+  }
+
+  // prune backwards, starting from the selected value
+  SmallVector<bool, 128> needed(num_values, false);
+  needed[rank] = true;
+  SmallVector<CompareExchange, 128> pruned;
+  for (auto it=network.rbegin(), ie=network.rend(); it!=ie; ++it) {
+    CompareExchange ce = *it;
+    ce.min = needed[ce.lo];
+    ce.max = needed[ce.hi];
+    if (!ce.min && !ce.max) continue;
+    needed[ce.lo] = needed[ce.hi] = true;
+    pruned.push_back(ce);
+  }
+
+  QualType QT = Ctx.getAsConstantArrayType(values->getType())->getElementType();
+  FunctionDecl *min_fun = lookup<FunctionDecl>(std::string("min"), QT,
+      hipaccMathNS);
+  FunctionDecl *max_fun = lookup<FunctionDecl>(std::string("max"), QT,
+      hipaccMathNS);
+  assert(min_fun && max_fun && "could not lookup 'min'/'max'");
+
+  DeclContext *DC = FunctionDecl::castToDeclContext(kernelDecl);
+  VarDecl *tmp_decl = createVarDecl(Ctx, kernelDecl, "_tmp" +
+      std::to_string(literalCount++), QT, nullptr);
+  DC->addDecl(tmp_decl);
+  preStmts.push_back(createDeclStmt(Ctx, tmp_decl));
+  preCStmt.push_back(outer);
+
+  auto valueAt = [&] (size_t i) -> Expr * {
+    return accessArrayAt(values, createIntegerLiteral(Ctx, (int32_t)i));
+  };
+  auto createCall = [&] (FunctionDecl *fun, size_t lo, size_t hi) -> Expr * {
+    SmallVector<Expr *, 16> args;
+    args.push_back(createImplicitCastExpr(Ctx, QT, CK_LValueToRValue,
+          valueAt(lo), nullptr, VK_RValue));
+    args.push_back(createImplicitCastExpr(Ctx, QT, CK_LValueToRValue,
+          valueAt(hi), nullptr, VK_RValue));
+    return createFunctionCall(Ctx, fun, args);
+  };
+
+  for (auto it=pruned.rbegin(), ie=pruned.rend(); it!=ie; ++it) {
+    SmallVector<Stmt *, 3> stmts;
+    if (it->min && it->max) {
+      // _tmp = min(v[lo], v[hi]); v[hi] = max(v[lo], v[hi]); v[lo] = _tmp;
+      DeclRefExpr *tmp = createDeclRefExpr(Ctx, tmp_decl);
+      stmts.push_back(createBinaryOperator(Ctx, tmp, createCall(min_fun,
+              it->lo, it->hi), BO_Assign, QT));
+      stmts.push_back(createBinaryOperator(Ctx, valueAt(it->hi),
+            createCall(max_fun, it->lo, it->hi), BO_Assign, QT));
+      stmts.push_back(createBinaryOperator(Ctx, valueAt(it->lo),
+            createImplicitCastExpr(Ctx, QT, CK_LValueToRValue, tmp, nullptr,
+              VK_RValue), BO_Assign, QT));
+    } else if (it->min) {
+      stmts.push_back(createBinaryOperator(Ctx, valueAt(it->lo),
+            createCall(min_fun, it->lo, it->hi), BO_Assign, QT));
+    } else {
+      stmts.push_back(createBinaryOperator(Ctx, valueAt(it->hi),
+            createCall(max_fun, it->lo, it->hi), BO_Assign, QT));
+    }
+    for (auto stmt : stmts) {
+      preStmts.push_back(stmt);
+      preCStmt.push_back(outer);
+    }
+  }
+}
+
+
 // check if we have a convolve/reduce/iterate method and convert it
 Expr *ASTTranslate::convertConvolution(CXXMemberCallExpr *E) {
   enum class Method : uint8_t {
@@ -395,21 +1283,72 @@ Expr *ASTTranslate::convertConvolution(CXXMemberCallExpr *E) {
     }
   }
 
+  // median: the values of all iterations are stored and sorted afterwards
+  bool median = (method==Method::Convolve && convMode==Reduce::MEDIAN) ||
+                (method==Method::Reduce && redModes.back()==Reduce::MEDIAN);
+  size_t num_values = 0;
+  if (median) {
+    if (Mask->isDomain() && !Mask->isConstant()) {
+      unsigned DiagIDMedian = Diags.getCustomDiagID(DiagnosticsEngine::Error,
+          "Median reductions require a constant Domain.");
+      Diags.Report(E->getArg(0)->getExprLoc(), DiagIDMedian);
+      exit(EXIT_FAILURE);
+    }
+    if (searchForBreakIterate(LE->getBody())) {
+      unsigned DiagIDMedian = Diags.getCustomDiagID(DiagnosticsEngine::Error,
+          "break_iterate() is not supported for median reductions.");
+      Diags.Report(LE->getBody()->getLocStart(), DiagIDMedian);
+      exit(EXIT_FAILURE);
+    }
+    for (size_t y=0; y<Mask->getSizeY(); ++y) {
+      for (size_t x=0; x<Mask->getSizeX(); ++x) {
+        if (!Mask->isDomain() || Mask->isDomainDefined(x, y)) ++num_values;
+      }
+    }
+    assert(num_values && "Median of empty Domain.");
+  }
+
+  // sums over box Masks and fully defined Domains use running sums; C/C++:
+  // convolutions with separable constant Masks reuse column sums and large
+  // median filters use a sliding histogram; other convolutions with constant
+  // Masks are specialized for their coefficients
+  Expr *box_window = nullptr, *box_coeff = nullptr;
+  Expr *sep_window = nullptr, *hist_window = nullptr;
+  Expr *coeff_window = nullptr;
+  switch (method) {
+    case Method::Convolve:
+      box_window = getBoxWindow(LE, Mask, convMode, box_coeff);
+      if (!box_window) sep_window = getSeparableWindow(LE, Mask);
+      if (!box_window && !sep_window)
+        coeff_window = getCoefficientWindow(LE, Mask);
+      hist_window = getMedianWindow(LE, Mask);
+      if (hist_window) median = false;
+      break;
+    case Method::Reduce:
+      box_window = getBoxWindow(LE, Mask, redModes.back(), box_coeff);
+      break;
+    case Method::Iterate: break;
+  }
+
   // init temporary variable depending on aggregation mode
   Expr *init = nullptr;
+  QualType QT = LE->getCallOperator()->getReturnType();
   switch (method) {
     case Method::Convolve:
-      init = getInitExpr(convMode, LE->getCallOperator()->getReturnType());
+      if (convMode != Reduce::MEDIAN) init = getInitExpr(convMode, QT);
       break;
     case Method::Reduce:
-      init = getInitExpr(redModes.back(),
-          LE->getCallOperator()->getReturnType());
+      if (redModes.back() != Reduce::MEDIAN)
+        init = getInitExpr(redModes.back(), QT);
       break;
     case Method::Iterate: break;
   }
+  if (median) {
+    QT = Ctx.getConstantArrayType(QT, llvm::APInt(32, num_values),
+        ArrayType::Normal, 0);
+  }
   std::string tmp_lit("_tmp" + std::to_string(literalCount++));
-  VarDecl *tmp_decl = createVarDecl(Ctx, kernelDecl, tmp_lit,
-      LE->getCallOperator()->getReturnType(), init);
+  VarDecl *tmp_decl = createVarDecl(Ctx, kernelDecl, tmp_lit, QT, init);
   DeclContext *DC = FunctionDecl::castToDeclContext(kernelDecl);
   DC->addDecl(tmp_decl);
   DeclRefExpr *tmp_dre = createDeclRefExpr(Ctx, tmp_decl);
@@ -426,6 +1365,14 @@ Expr *ASTTranslate::convertConvolution(CXXMemberCallExpr *E) {
   // introduce temporary for holding the convolution/reduction result
   CompoundStmt *outerCompountStmt = curCStmt;
 
+  // pixels loaded within the lambda-function are deduplicated in front of the
+  // outermost convolution
+  bool outermost = !convMask && redDomains.empty();
+  if (outermost) {
+    loadScope = !activeCStmts.empty() && curCStmt == activeCStmts.back() ?
+      curCStmt : nullptr;
+  }
+
   switch (method) {
     case Method::Convolve:
       convTmp = tmp_dre;
@@ -444,52 +1391,67 @@ Expr *ASTTranslate::convertConvolution(CXXMemberCallExpr *E) {
       break;
   }
 
-  // unroll Mask/Domain
-  for (size_t y=0; y<Mask->getSizeY(); ++y) {
-    for (size_t x=0; x<Mask->getSizeX(); ++x) {
-      bool doIterate = true;
+  if (box_window) {
+    addBoxSum(E, Mask, box_window, box_coeff, tmp_dre, outerCompountStmt);
+  } else if (sep_window) {
+    addSeparableConvolution(E, Mask, sep_window, tmp_dre, outerCompountStmt);
+  } else if (hist_window) {
+    addMedianHistogram(E, Mask, hist_window, tmp_dre, outerCompountStmt);
+  } else if (coeff_window) {
+    addCoefficientConvolution(Mask, coeff_window, tmp_dre, outerCompountStmt);
+  } else {
+    // unroll Mask/Domain
+    for (size_t y=0; y<Mask->getSizeY(); ++y) {
+      for (size_t x=0; x<Mask->getSizeX(); ++x) {
+        bool doIterate = true;
 
-      if (Mask->isDomain() && Mask->isConstant() &&
-          !Mask->isDomainDefined(x, y)) {
-        doIterate = false;
-      }
+        if (Mask->isDomain() && Mask->isConstant() &&
+            !Mask->isDomainDefined(x, y)) {
+          doIterate = false;
+        }
 
-      if (doIterate) {
-        Stmt *iteration = nullptr;
-        switch (method) {
-          case Method::Convolve:
-            convIdxX = x;
-            convIdxY = y;
-            iteration = Clone(LE->getBody());
-            break;
-          case Method::Reduce:
-          case Method::Iterate:
-            redIdxX.push_back(x);
-            redIdxY.push_back(y);
-            iteration = Clone(LE->getBody());
-            // add check if this iteration point should be processed - the
-            // DeclRefExpr for the Domain is retrieved when visiting the
-            // MemberExpr
-            if (!Mask->isConstant()) {
-              // set Domain as being used within Kernel
-              Kernel->setUsed(FD->getNameAsString());
-              iteration = addDomainCheck(Mask,
-                  dyn_cast_or_null<DeclRefExpr>(VisitMemberExpr(ME)),
-                  iteration);
-            }
-            redIdxX.pop_back();
-            redIdxY.pop_back();
-            break;
+        if (doIterate) {
+          Stmt *iteration = nullptr;
+          switch (method) {
+            case Method::Convolve:
+              convIdxX = x;
+              convIdxY = y;
+              iteration = Clone(LE->getBody());
+              break;
+            case Method::Reduce:
+            case Method::Iterate:
+              redIdxX.push_back(x);
+              redIdxY.push_back(y);
+              iteration = Clone(LE->getBody());
+              // add check if this iteration point should be processed - the
+              // DeclRefExpr for the Domain is retrieved when visiting the
+              // MemberExpr
+              if (!Mask->isConstant()) {
+                // set Domain as being used within Kernel
+                Kernel->setUsed(FD->getNameAsString());
+                iteration = addDomainCheck(Mask,
+                    dyn_cast_or_null<DeclRefExpr>(VisitMemberExpr(ME)),
+                    iteration);
+              }
+              redIdxX.pop_back();
+              redIdxY.pop_back();
+              break;
+          }
+          preStmts.push_back(iteration);
+          preCStmt.push_back(outerCompountStmt);
+          // clear decls added while cloning last iteration
+          LambdaDeclMap.clear();
         }
-        preStmts.push_back(iteration);
-        preCStmt.push_back(outerCompountStmt);
-        // clear decls added while cloning last iteration
-        LambdaDeclMap.clear();
       }
     }
   }
 
+  // select the median after the last iteration
+  size_t rank = (num_values - 1) / 2;
+  if (median) addMedianNetwork(tmp_dre, num_values, rank, outerCompountStmt);
+
   // reset global variables
+  if (outermost) loadScope = nullptr;
   switch (method) {
     case Method::Convolve:
       convMask = nullptr;
@@ -520,6 +1482,12 @@ Expr *ASTTranslate::convertConvolution(CXXMemberCallExpr *E) {
     case Method::Convolve:
     case Method::Reduce:
       // add ICE for CodeGen
+      if (median) {
+        return createImplicitCastExpr(Ctx,
+            LE->getCallOperator()->getReturnType(), CK_LValueToRValue,
+            accessArrayAt(tmp_dre, createIntegerLiteral(Ctx, (int32_t)rank)),
+            nullptr, VK_RValue);
+      }
       return createImplicitCastExpr(Ctx, LE->getCallOperator()->getReturnType(),
           CK_LValueToRValue, tmp_dre, nullptr, VK_RValue);
     case Method::Iterate:
@@ -259,6 +259,23 @@ Expr *ASTTranslate::accessMemArrAt(DeclRefExpr *LHS, Expr *stride, Expr *idx_x,
 }
 
 
+// check if LHS is the intermediate image of a fused kernel launch
+bool ASTTranslate::isFusedImage(DeclRefExpr *LHS) {
+  if (!fusedRowLo) return false;
+
+  std::string name(LHS->getNameInfo().getAsString());
+  auto deviceArgNames = Kernel->getDeviceArgNames();
+  auto deviceArgFields = Kernel->getDeviceArgFields();
+  for (size_t i=0; i<deviceArgNames.size(); ++i) {
+    if (deviceArgNames[i] != name) continue;
+    HipaccAccessor *Acc = Kernel->getImgFromMapping(deviceArgFields[i]);
+    return Acc && Acc->getImage() == Kernel->getFusedImage();
+  }
+
+  return false;
+}
+
+
 // access 2D memory array at given index
 Expr *ASTTranslate::accessMem2DAt(DeclRefExpr *LHS, Expr *idx_x, Expr *idx_y) {
   QualType QT = LHS->getType();
@@ -267,6 +284,12 @@ Expr *ASTTranslate::accessMem2DAt(DeclRefExpr *LHS, Expr *idx_x, Expr *idx_y) {
   // mark image as being used within the kernel
   Kernel->setUsed(LHS->getNameInfo().getAsString());
 
+  // rows of a fused image are addressed relative to the row buffer
+  if (isFusedImage(LHS)) {
+    idx_y = createBinaryOperator(Ctx, createParenExpr(Ctx, idx_y), fusedRowLo,
+        BO_Sub, Ctx.IntTy);
+  }
+
   Expr *result = new (Ctx) ArraySubscriptExpr(createImplicitCastExpr(Ctx, QT,
         CK_LValueToRValue, LHS, nullptr, VK_RValue), idx_y,
         QT->getPointeeType(), VK_LValue, OK_Ordinary, SourceLocation());
@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2012, University of Erlangen-Nuremberg
+// Copyright (c) 2012, Siemens AG
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//===--- CostModel.cpp - Roofline Cost Model for Kernels ------------------===//
+//
+// This file implements an analytical roofline model that estimates per output
+// pixel whether a kernel is bound by computation or by memory bandwidth on the
+// target device.
+//
+//===----------------------------------------------------------------------===//
+
+#include "hipacc/Analysis/CostModel.h"
+
+#include <algorithm>
+
+using namespace clang;
+using namespace hipacc;
+
+// operations of each thread to compute its index and check the iteration space
+static const float ThreadOps = 8.0f;
+// operations to stage one pixel in local memory
+static const float StagingOps = 2.0f;
+
+
+bool HipaccCostModel::hasWindows() const {
+  for (auto &img : images) {
+    if (img.size_x*img.size_y > 1) return true;
+  }
+
+  return false;
+}
+
+
+unsigned HipaccCostModel::getLocalMemorySize(unsigned bsx, unsigned bsy,
+    unsigned ppt) const {
+  unsigned size = 0;
+
+  for (auto &img : images) {
+    if (img.size_x*img.size_y > 1) {
+      size += img.pixel_size * (bsx + img.size_x - 1) *
+              (bsy*ppt + img.size_y - 1);
+    }
+  }
+
+  return size;
+}
+
+
+RooflineEstimate HipaccCostModel::estimate(unsigned bsx, unsigned bsy,
+    unsigned ppt, bool local, bool texture, unsigned vector_width) const {
+  RooflineEstimate est;
+  float block_pixels = bsx*bsy*ppt;
+
+  est.ops = ops + ThreadOps/ppt;
+  est.bytes = store_bytes;
+  for (auto &img : images) {
+    if (img.size_x*img.size_y > 1 && (local || texture)) {
+      // pixels shared by the windows of neighboring pixels are read only
+      // once per block
+      float pixels = (bsx + img.size_x - 1) * (bsy*ppt + img.size_y - 1) /
+                     block_pixels;
+      est.bytes += img.pixel_size * pixels;
+      if (local) est.ops += StagingOps * pixels;
+    } else {
+      est.bytes += img.pixel_size * img.loads;
+    }
+  }
+
+  // scalar code uses only one lane of SIMD ALUs
+  float gops = device.peak_gops * std::min(vector_width, device.simd_width) /
+               device.simd_width;
+
+  // GOP/s and GB/s correspond to operations and bytes per ms and megapixel
+  float compute = est.ops / gops;
+  float memory = est.bytes / device.peak_bandwidth;
+  est.time = std::max(compute, memory);
+  est.memory_bound = memory > compute;
+
+  return est;
+}
+
+// vim: set ts=2 sw=2 sts=2 et ai:
@@ -28,14 +28,49 @@
 //===----------- HostDataDeps.cpp - Track data dependencies ---------------===//
 //
 // This file implements tracking of data dependencies to generate vivado streams
+// and to find producer/consumer kernels that can be fused
 //
 //===----------------------------------------------------------------------===//
 
 #include "hipacc/Analysis/HostDataDeps.h"
 
+#include <iomanip>
+
+#include <clang/AST/RecursiveASTVisitor.h>
+
 namespace clang {
 namespace hipacc {
 
+namespace {
+// collect images referenced by a host statement, including lambda bodies
+class ImageUseFinder : public RecursiveASTVisitor<ImageUseFinder> {
+  private:
+    llvm::DenseMap<ValueDecl *, HipaccImage *> &imgDeclMap;
+
+  public:
+    std::vector<ValueDecl *> images;
+    bool hasLambda;
+
+    ImageUseFinder(llvm::DenseMap<ValueDecl *, HipaccImage *> &imgDeclMap)
+        : imgDeclMap(imgDeclMap), hasLambda(false) {
+    }
+
+    bool VisitDeclRefExpr(DeclRefExpr *E) {
+      if (imgDeclMap.count(E->getDecl()) &&
+          std::find(images.begin(), images.end(), E->getDecl()) ==
+          images.end()) {
+        images.push_back(E->getDecl());
+      }
+      return true;
+    }
+
+    bool VisitLambdaExpr(LambdaExpr *E) {
+      hasLambda = true;
+      return true;
+    }
+};
+}
+
 
 void DependencyTracker::VisitDeclStmt(DeclStmt *S) {
   for (auto DI=S->decl_begin(), DE=S->decl_end(); DI!=DE; ++DI) {
@@ -57,6 +92,7 @@ void DependencyTracker::VisitDeclStmt(DeclStmt *S) {
         imgDeclMap_[VD] = Img;
 
         dataDeps.addImage(VD, Img);
+        tracked = true;
 
         break;
       }
@@ -98,6 +134,7 @@ void DependencyTracker::VisitDeclStmt(DeclStmt *S) {
             BC = new HipaccBoundaryCondition(VD, Img);
 
             dataDeps.addBoundaryCondition(VD, BC, DRE->getDecl());
+            tracked = true;
           }
         }
 
@@ -185,8 +222,17 @@ void DependencyTracker::VisitDeclStmt(DeclStmt *S) {
         // store Accessor definition
         accDeclMap_[VD] = Acc;
 
+        if (!dataDeps.compilerOptions.emitVivado() &&
+            (DRE == nullptr || (!dataDeps.imgMap_.count(DRE->getDecl()) &&
+                                !dataDeps.bcMap_.count(DRE->getDecl())))) {
+          // not tracked, e.g. based on a Pyramid
+          dataDeps.supported = false;
+          break;
+        }
+
         assert(DRE != nullptr && "First Accessor argument is not a BC or Image");
         dataDeps.addAccessor(VD, Acc, DRE->getDecl());
+        tracked = true;
 
         break;
       }
@@ -216,6 +262,7 @@ void DependencyTracker::VisitDeclStmt(DeclStmt *S) {
             IS = new HipaccIterationSpace(VD, Img, false);
 
             dataDeps.addIterationSpace(VD, IS, DRE->getDecl());
+            tracked = true;
           }
         }
 
@@ -261,15 +308,26 @@ void DependencyTracker::VisitDeclStmt(DeclStmt *S) {
                 << " " << varName
                 << std::endl;
 
-        CXXConstructExpr *CCE = dyn_cast<CXXConstructExpr>(VD->getInit());
+        CXXConstructExpr *CCE = dyn_cast_or_null<CXXConstructExpr>(
+            VD->getInit());
 
-        if (isa<DeclRefExpr>(CCE->getArg(0))) {
+        if (CCE && CCE->getNumArgs() && isa<DeclRefExpr>(CCE->getArg(0))) {
           DeclRefExpr *DRE = dyn_cast<DeclRefExpr>(CCE->getArg(0));
           if (iterDeclMap_.count(DRE->getDecl())) {
             if (DEBUG) std::cout << "    -> Based on IterationSpace: "
                     << DRE->getNameInfo().getAsString() << std::endl;
           }
 
+          if (!dataDeps.compilerOptions.emitVivado() &&
+              !dataDeps.iterMap_.count(DRE->getDecl())) {
+            // not tracked, e.g. based on a Pyramid
+            if (compilerClasses.isTypeOfTemplateClass(DRE->getType(),
+                  compilerClasses.IterationSpace)) {
+              dataDeps.supported = false;
+            }
+            break;
+          }
+
           std::vector<ValueDecl*> accs;
           for (auto it = ++(CCE->arg_begin()); it != CCE->arg_end(); ++it) {
             if (isa<DeclRefExpr>(*it)) {
@@ -283,6 +341,7 @@ void DependencyTracker::VisitDeclStmt(DeclStmt *S) {
             }
           }
           dataDeps.addKernel(VD, DRE->getDecl(), accs);
+          tracked = true;
 
           break;
         }
@@ -292,6 +351,20 @@ void DependencyTracker::VisitDeclStmt(DeclStmt *S) {
 }
 
 
+void DependencyTracker::VisitCXXConstructExpr(CXXConstructExpr *E) {
+  // constructor arguments of DSL objects are tracked at their declaration
+  QualType QT = E->getType();
+  if (compilerClasses.isTypeOfTemplateClass(QT, compilerClasses.Image) ||
+      compilerClasses.isTypeOfTemplateClass(QT,
+        compilerClasses.BoundaryCondition) ||
+      compilerClasses.isTypeOfTemplateClass(QT, compilerClasses.Accessor) ||
+      compilerClasses.isTypeOfTemplateClass(QT,
+        compilerClasses.IterationSpace)) {
+    tracked = true;
+  }
+}
+
+
 void DependencyTracker::VisitCXXMemberCallExpr(CXXMemberCallExpr *E) {
   Expr *Ex = E->getCallee();
   if (isa<MemberExpr>(Ex)) {
@@ -309,7 +382,13 @@ void DependencyTracker::VisitCXXMemberCallExpr(CXXMemberCallExpr *E) {
           if (DEBUG) std::cout << "  Tracked Kernel call: "
                   << className << " " << varName
                   << std::endl;
-          dataDeps.runKernel(DRE->getDecl());
+          tracked = true;
+          if (!dataDeps.compilerOptions.emitVivado() &&
+              !dataDeps.kernelMap_.count(DRE->getDecl())) {
+            dataDeps.supported = false;
+            return;
+          }
+          dataDeps.runKernel(DRE->getDecl(), currentBlock);
         }
       }
     }
@@ -317,6 +396,23 @@ void DependencyTracker::VisitCXXMemberCallExpr(CXXMemberCallExpr *E) {
 }
 
 
+void DependencyTracker::trackHostAccess(Stmt *S) {
+  ImageUseFinder finder(imgDeclMap_);
+  finder.TraverseStmt(S);
+
+  for (auto it = finder.images.begin(); it != finder.images.end(); ++it) {
+    if (DEBUG) std::cout << "  Tracked host access to Image: "
+            << (*it)->getNameAsString() << std::endl;
+    dataDeps.accessImage(*it, currentBlock);
+  }
+
+  // lambdas may access images or run kernels at any time
+  if (finder.hasLambda) {
+    dataDeps.addBarrier(currentBlock);
+  }
+}
+
+
 void HostDataDeps::addImage(ValueDecl *VD, HipaccImage *img) {
   assert(!imgMap_.count(VD) && "Duplicate Image declaration");
   imgMap_[VD] = new Image(img);
@@ -339,11 +435,17 @@ void HostDataDeps::addKernel(
   kernel = new Kernel(
       KVD->getType()->getAsCXXRecordDecl()->getNameAsString()
           .append(KVD->getNameAsString()),
-      iterMap_[ISVD]);
+      KVD, iterMap_[ISVD]);
   for (auto it = AVDS.begin(); it != AVDS.end(); ++it) {
     assert(accMap_.count(*it) && "Accessor was not declared");
     kernel->addAccessor(accMap_[*it]);
   }
+  // global operator: the user class overrides the reduce function
+  for (auto method : KVD->getType()->getAsCXXRecordDecl()->methods()) {
+    if (method->getNameAsString() == "reduce") {
+      kernel->setReduceTypeStr(method->getReturnType().getAsString());
+    }
+  }
   kernelMap_[KVD] = kernel;
 }
 
@@ -376,7 +478,7 @@ void HostDataDeps::addIterationSpace(
 }
 
 
-void HostDataDeps::runKernel(ValueDecl *VD) {
+void HostDataDeps::runKernel(ValueDecl *VD, const CFGBlock *block) {
   assert(kernelMap_.count(VD) && "Kernel was not declared");
 
   Kernel *kernel = kernelMap_[VD];
@@ -387,6 +489,7 @@ void HostDataDeps::runKernel(ValueDecl *VD) {
   space->setSrcProcess(proc);
   spaces_.push_back(space);
   processes_.push_back(proc);
+  events_.push_back({ block, proc, nullptr });
 
   // Set process to destination for all predecessor spaces:
   std::vector<Accessor*> accs = kernel->getAccessors();
@@ -428,6 +531,88 @@ void HostDataDeps::runKernel(ValueDecl *VD) {
 }
 
 
+void HostDataDeps::accessImage(ValueDecl *VD, const CFGBlock *block) {
+  assert(imgMap_.count(VD) && "Image was not declared");
+  events_.push_back({ block, nullptr, imgMap_[VD] });
+}
+
+
+void HostDataDeps::addBarrier(const CFGBlock *block) {
+  events_.push_back({ block, nullptr, nullptr });
+}
+
+
+// The producer can be executed band-wise together with the consumer if the
+// consumer is the only reader of the produced image, no other statement
+// between both kernel calls accesses images, and the produced image is not
+// accessed by the host or by kernels in other basic blocks
+bool HostDataDeps::isFusible(size_t producer, size_t consumer) {
+  Event &pe = events_[producer];
+  Event &ce = events_[consumer];
+  if (pe.proc == nullptr || ce.proc == nullptr || pe.block != ce.block ||
+      consumer != producer + 1) {
+    return false;
+  }
+
+  Kernel *pk = pe.proc->getKernel();
+  Kernel *ck = ce.proc->getKernel();
+  if (pk == ck) return false;
+
+  Space *space = pe.proc->getOutSpace();
+  Image *img = space->getImage();
+  Image *out = ce.proc->getOutSpace()->getImage();
+  std::vector<Process*> dst = space->getDstProcesses();
+  if (dst.size() != 1 || dst[0] != ce.proc) return false;
+  if (ck->getAccessors(img).size() != 1 || out == img) return false;
+
+  // the consumer must not write images read by the producer
+  if (!pk->getAccessors(img).empty() || !pk->getAccessors(out).empty()) {
+    return false;
+  }
+
+  for (auto it = events_.begin(); it != events_.end(); ++it) {
+    if (it->proc == nullptr) {
+      if (it->image == img) return false;
+      continue;
+    }
+    // both kernels are executed only here
+    Kernel *k = it->proc->getKernel();
+    if (it->proc != pe.proc && it->proc != ce.proc && (k == pk || k == ck)) {
+      return false;
+    }
+    if (it->block != pe.block &&
+        (k->getIterationSpace()->getImage() == img ||
+         !k->getAccessors(img).empty())) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+void HostDataDeps::findFusibleKernels() {
+  if (!supported) return;
+
+  for (size_t i = 0; i + 1 < events_.size(); ++i) {
+    if (!isFusible(i, i + 1)) continue;
+
+    ValueDecl *producer = events_[i].proc->getKernel()->getDecl();
+    ValueDecl *consumer = events_[i + 1].proc->getKernel()->getDecl();
+    if (fusedConsumer_.count(producer) || fusedProducer_.count(producer) ||
+        fusedConsumer_.count(consumer) || fusedProducer_.count(consumer)) {
+      continue;
+    }
+
+    if (DEBUG) std::cout << "  Fusible kernels: "
+            << events_[i].proc->getKernel()->getName() << " -> "
+            << events_[i + 1].proc->getKernel()->getName() << std::endl;
+    fusedConsumer_[producer] = consumer;
+    fusedProducer_[consumer] = producer;
+  }
+}
+
+
 void HostDataDeps::dump(Process *proc) {
   std::cout << " <- " << proc->getKernel()->getName();
 
@@ -504,7 +689,18 @@ std::vector<HostDataDeps::Space*> HostDataDeps::getInputSpaces() {
 std::vector<HostDataDeps::Space*> HostDataDeps::getOutputSpaces() {
   std::vector<Space*> ret;
   for (auto it = spaces_.rbegin(); it != spaces_.rend(); ++it) {
-    if ((*it)->getDstProcesses().empty()) {
+    if ((*it)->getDstProcesses().empty() && !(*it)->isReduction()) {
+      ret.push_back(*it);
+    }
+  }
+  return ret;
+}
+
+
+std::vector<HostDataDeps::Space*> HostDataDeps::getReductionSpaces() {
+  std::vector<Space*> ret;
+  for (auto it = spaces_.rbegin(); it != spaces_.rend(); ++it) {
+    if ((*it)->isReduction()) {
       ret.push_back(*it);
     }
   }
@@ -517,7 +713,7 @@ std::string HostDataDeps::createStream(Space *s) {
 
   if (s->getSrcProcess() == nullptr && s->stream.empty()) {
     stream = "_strm" + s->getImage()->getName();
-  } else if (s->getDstProcesses().empty()) {
+  } else if (s->getDstProcesses().empty() && !s->isReduction()) {
     std::ostringstream var;
     var << "_strmOut" << outId;
     ++outId;
@@ -559,7 +755,7 @@ void HostDataDeps::markProcess(Process *t) {
 
 void HostDataDeps::markSpace(Space *s) {
   if (s->getDstProcesses().empty()) {
-    // output space
+    // output space or input of a reduce process
     s->stream = createStream(s);
   }
 
@@ -579,21 +775,118 @@ void HostDataDeps::createSchedule() {
   for (auto it = outSpaces.begin(); it != outSpaces.end(); ++it) {
     markSpace(*it);
   }
+
+  // reduce processes are sinks as well
+  std::vector<Space*> redSpaces = getReductionSpaces();
+  for (auto it = redSpaces.begin(); it != redSpaces.end(); ++it) {
+    markSpace(*it);
+  }
+}
+
+
+// Number of stream elements a process consumes before it produces its first
+// output: the line buffer is filled up to the center row of the window.
+size_t HostDataDeps::getGroupDelay(Process *proc, size_t width) {
+  unsigned sizeX = 1, sizeY = 1;
+  std::vector<Accessor*> accs = proc->getKernel()->getAccessors();
+  for (auto it = accs.begin(); it != accs.end(); ++it) {
+    sizeX = std::max(sizeX, (*it)->getSizeX());
+    sizeY = std::max(sizeY, (*it)->getSizeY());
+  }
+
+  // with vectorization, each stream element carries ppt pixels
+  size_t ppt = compilerOptions.getPixelsPerThread();
+  return (sizeY/2) * ((width + ppt - 1) / ppt) + (sizeX/2 + ppt - 1) / ppt;
+}
+
+
+// Size the channels of the dataflow region: a process with multiple inputs
+// consumes them in lockstep, so the channels on paths with smaller group
+// delay have to buffer the difference to the slowest path. All other channels
+// keep the minimal depth, which maps to shift registers instead of BRAM.
+void HostDataDeps::computeStreamDepths() {
+  const size_t minDepth = 2;
+
+  // image width as seen by the processes (HIPACC_MAX_WIDTH)
+  size_t ppt = compilerOptions.getPixelsPerThread();
+  size_t width = 1;
+  for (auto it = spaces_.begin(); it != spaces_.end(); ++it) {
+    width = std::max(width, (size_t)(*it)->getImage()->getSizeX());
+  }
+  width = ((width + ppt - 1) / ppt) * ppt;
+
+  streamDepths.clear();
+  std::map<Space*, size_t> arrival;
+  std::map<Process*, size_t> start;
+
+  // the reversed schedule visits producers before their consumers
+  for (auto it = schedule.rbegin(); it != schedule.rend(); ++it) {
+    if ((*it)->isSpace()) {
+      Space *s = (Space*)*it;
+      Process *src = s->getSrcProcess();
+      arrival[s] = src ? start[src] + getGroupDelay(src, width) : 0;
+      for (auto it2 = s->cpyStreams.begin();
+                it2 != s->cpyStreams.end(); ++it2) {
+        streamDepths[*it2] = minDepth;
+      }
+    } else {
+      Process *t = (Process*)*it;
+      std::vector<Space*> in = t->getInSpaces();
+      size_t first = 0;
+      for (auto it2 = in.begin(); it2 != in.end(); ++it2) {
+        first = std::max(first, arrival[*it2]);
+      }
+      start[t] = first;
+      if (!t->getOutSpace()->getDstProcesses().empty() ||
+          t->getOutSpace()->isReduction()) {
+        streamDepths[t->outStream] = minDepth;
+      }
+    }
+  }
+
+  for (auto it = processes_.begin(); it != processes_.end(); ++it) {
+    Process *t = *it;
+    std::vector<Space*> in = t->getInSpaces();
+    for (size_t i = 0; i < in.size() && i < t->inStreams.size(); ++i) {
+      auto depth = streamDepths.find(t->inStreams[i]);
+      // streams passed to hipaccRun are not part of the dataflow region
+      if (depth == streamDepths.end()) continue;
+      depth->second = minDepth + start[t] - arrival[in[i]];
+    }
+  }
+}
+
+
+std::string HostDataDeps::printStreamDepths() {
+  std::ostringstream retVal;
+  size_t total = 0;
+
+  retVal << "// Stream depths from group delay analysis:" << std::endl;
+  for (auto it = streamDepths.begin(); it != streamDepths.end(); ++it) {
+    retVal << "//   " << std::left << std::setw(16) << it->first
+           << std::right << std::setw(10) << it->second << std::endl;
+    total += it->second;
+  }
+  retVal << "//   " << std::left << std::setw(16) << "total"
+         << std::right << std::setw(10) << total << std::endl;
+
+  return retVal.str();
 }
 
 
 std::string HostDataDeps::getEntrySignature(
     std::map<std::string,std::vector<std::pair<std::string,std::string>>> args,
-    bool withTypes) {
+    bool withTypes, std::string img) {
   std::ostringstream retVal;
   if (withTypes) {
     retVal << "void ";
   }
   retVal << "hipaccRun(";
+  size_t comma = 0;
 
   std::vector<Space*> out = getOutputSpaces();
   for (auto it = out.begin(); it != out.end(); ++it) {
-    if (it != out.begin()) {
+    if (comma++) {
       retVal << ", ";
     }
     if (withTypes) {
@@ -602,9 +895,24 @@ std::string HostDataDeps::getEntrySignature(
     retVal << (*it)->stream;
   }
 
+  // results of global reductions are returned by reference
+  std::vector<Space*> red = getReductionSpaces();
+  for (auto it = red.begin(); it != red.end(); ++it) {
+    Kernel *kernel = (*it)->getSrcProcess()->getKernel();
+    if (comma++) {
+      retVal << ", ";
+    }
+    if (withTypes) {
+      retVal << kernel->getReduceTypeStr() << " &";
+    }
+    retVal << getReduceResult(kernel);
+  }
+
   std::vector<Space*> in = getInputSpaces();
   for (auto it = in.begin(); it != in.end(); ++it) {
-    retVal << ", ";
+    if (comma++) {
+      retVal << ", ";
+    }
     if (withTypes) {
       retVal << "hls::stream<" << getTypeStr(*it) << " > &";
     }
@@ -621,6 +929,19 @@ std::string HostDataDeps::getEntrySignature(
     }
   }
 
+  // image size is passed at runtime; with vectorization, the processes
+  // round the width up to whole vectors and mask the padding
+  if (compilerOptions.runtimeSize()) {
+    if (comma++) {
+      retVal << ", ";
+    }
+    if (withTypes) {
+      retVal << "int _width, int _height";
+    } else {
+      retVal << img << ".width, " << img << ".height";
+    }
+  }
+
   retVal << ")";
 
   return retVal.str();
@@ -632,11 +953,18 @@ std::string HostDataDeps::prettyPrint(
     bool print) {
   std::ostringstream retVal;
   std::string indent = "";
+  std::string size = compilerOptions.runtimeSize() ?
+      "_width, _height" : "HIPACC_MAX_WIDTH, HIPACC_MAX_HEIGHT";
+
+  computeStreamDepths();
+  retVal << printStreamDepths() << std::endl;
 
   retVal << indent << getEntrySignature(args, true) << " {" << std::endl;
   retVal << "#pragma HLS dataflow" << std::endl;
 
   indent = "  ";
+  // processes run on their own threads in the software emulation
+  retVal << indent << "HIPACC_DATAFLOW_BEGIN" << std::endl;
 
   //int cpyId = 0;
   for (auto it = schedule.rbegin(); it != schedule.rend(); ++it) {
@@ -645,12 +973,14 @@ std::string HostDataDeps::prettyPrint(
       if (s->cpyStreams.size() > 0) {
         for (auto it2 = s->cpyStreams.begin();
                   it2 != s->cpyStreams.end(); ++it2) {
-          retVal << indent << "hls::stream<" << getTypeStr(s) << " > " << *it2 << ";"
-                 << std::endl;
+          retVal << indent << "hls::stream<" << getTypeStr(s) << " > " << *it2
+                 << "(\"" << *it2 << "\");" << std::endl;
+          retVal << indent << "HIPACC_STREAM_DEPTH(" << *it2 << ", "
+                 << streamDepths[*it2] << ")" << std::endl;
         }
 #define NICO_LIB
 #ifdef NICO_LIB
-        retVal << indent << "splitStream";
+        retVal << indent << "HIPACC_DATAFLOW_PROCESS(splitStream";
         if (compilerOptions.getPixelsPerThread() > 1) {
           retVal << "VECT";
         }
@@ -663,7 +993,7 @@ std::string HostDataDeps::prettyPrint(
                   it2 != s->cpyStreams.end(); ++it2) {
           retVal << ", " << *it2;
         }
-        retVal << ", HIPACC_MAX_WIDTH, HIPACC_MAX_HEIGHT);" << std::endl;
+        retVal << ", " << size << "));" << std::endl;
 #else // NICO_LIB
         retVal << indent << "for (int i = 0; i < HIPACC_MAX_WIDTH*HIPACC_MAX_HEIGHT; ++i) {"
                << std::endl;
@@ -696,13 +1026,17 @@ std::string HostDataDeps::prettyPrint(
       }
     } else {
       Process *t = (Process*)*it;
-      if (!t->getOutSpace()->getDstProcesses().empty()) {
+      if (!t->getOutSpace()->getDstProcesses().empty() ||
+          t->getOutSpace()->isReduction()) {
         // do not print out stream (because it is function argument)
         retVal << indent << "hls::stream<"
-               << getTypeStr(t->getOutSpace()) << " > " << t->outStream << ";"
-               << std::endl;
+               << getTypeStr(t->getOutSpace()) << " > " << t->outStream
+               << "(\"" << t->outStream << "\");" << std::endl;
+        retVal << indent << "HIPACC_STREAM_DEPTH(" << t->outStream << ", "
+               << streamDepths[t->outStream] << ")" << std::endl;
       }
-      retVal << indent << "cc" << t->getKernel()->getName() << "Kernel(";
+      retVal << indent << "HIPACC_DATAFLOW_PROCESS(cc"
+             << t->getKernel()->getName() << "Kernel(";
       retVal << t->outStream;
       for (auto it2 = t->inStreams.begin();
                 it2 != t->inStreams.end(); ++it2) {
@@ -715,9 +1049,23 @@ std::string HostDataDeps::prettyPrint(
           retVal << ", " << it2->second;
         }
       }
-      retVal << ", HIPACC_MAX_WIDTH, HIPACC_MAX_HEIGHT);" << std::endl;
+      retVal << ", " << size << "));" << std::endl;
+      if (t->getOutSpace()->isReduction()) {
+        // HIPACC_MAX_WIDTH is padded to whole vectors, the reduction has to
+        // skip the padding of the last vector of a row
+        std::string redSize = size;
+        if (!compilerOptions.runtimeSize()) {
+          redSize = std::to_string(t->getOutSpace()->getImage()->getSizeX()) +
+                    ", HIPACC_MAX_HEIGHT";
+        }
+        retVal << indent << "HIPACC_DATAFLOW_PROCESS(cc"
+               << t->getKernel()->getName() << "Reduce(" << t->outStream
+               << ", " << getReduceResult(t->getKernel())
+               << ", " << redSize << "));" << std::endl;
+      }
     }
   }
+  retVal << indent << "HIPACC_DATAFLOW_END" << std::endl;
 
   indent = "";
   retVal << indent << "}" << std::endl;
@@ -739,7 +1087,7 @@ std::string HostDataDeps::printEntryDecl(
 std::string HostDataDeps::printEntryCall(
     std::map<std::string,std::vector<std::pair<std::string,std::string>>> args,
     std::string img) {
-  return getEntrySignature(args) + ";\n";
+  return getEntrySignature(args, false, img) + ";\n";
 }
 
 
@@ -56,6 +56,7 @@ class KernelStatsImpl {
     AnalysisDeclContext &analysisContext;
     llvm::DenseMap<const FieldDecl *, MemoryAccess> memToAccess;
     llvm::DenseMap<const FieldDecl *, MemoryPattern> memToPattern;
+    llvm::DenseMap<const FieldDecl *, unsigned> memToLoads;
     llvm::DenseMap<const VarDecl *, VectorInfo> declsToVector;
     KernelType kernelType;
 
@@ -70,6 +71,7 @@ class KernelStatsImpl {
     unsigned num_ops, num_sops;
     unsigned num_img_loads, num_img_stores;
     unsigned num_mask_loads, num_mask_stores;
+    unsigned num_img_loads_reused, num_bh_indices_reused;
     VectorInfo curStmtVectorize;
     bool inLambdaFunction;
 
@@ -104,6 +106,8 @@ class KernelStatsImpl {
       num_img_stores(0),
       num_mask_loads(0),
       num_mask_stores(0),
+      num_img_loads_reused(0),
+      num_bh_indices_reused(0),
       curStmtVectorize(SCALAR),
       inLambdaFunction(false)
     {}
@@ -298,6 +302,47 @@ KernelType KernelStatistics::getKernelType() {
 }
 
 
+unsigned KernelStatistics::getNumOps() {
+  return getImpl(impl).num_ops;
+}
+
+
+unsigned KernelStatistics::getNumSFUOps() {
+  return getImpl(impl).num_sops;
+}
+
+
+unsigned KernelStatistics::getNumImgLoads(const FieldDecl *FD) {
+  return getImpl(impl).memToLoads.lookup(FD);
+}
+
+
+unsigned KernelStatistics::getNumImgStores() {
+  return getImpl(impl).num_img_stores;
+}
+
+
+unsigned KernelStatistics::getNumMaskLoads() {
+  return getImpl(impl).num_mask_loads;
+}
+
+
+// loads and border handling indices eliminated when translating the kernel
+void KernelStatistics::addDeduplicatedLoads(unsigned num_loads, unsigned
+    num_indices) {
+  KernelStatsImpl &KS = getImpl(impl);
+  KS.num_img_loads_reused += num_loads;
+  KS.num_bh_indices_reused += num_indices;
+
+  llvm::errs() << "Kernel statistics for '" << KS.name
+               << "' after translation:\n"
+               << "  image loads eliminated: " << KS.num_img_loads_reused
+               << "\n"
+               << "  border handling indices reused: "
+               << KS.num_bh_indices_reused << "\n\n";
+}
+
+
 MemoryPattern TransferFunctions::checkStride(Expr *EX, Expr *EY) {
   bool stride_x=true, stride_y=true;
 
@@ -343,6 +388,7 @@ bool TransferFunctions::checkImageAccess(Expr *E, MemoryAccess mem_acc) {
         if (KS.compilerClasses.isTypeOfTemplateClass(FD->getType(),
               KS.compilerClasses.Accessor)) {
           if (mem_acc & READ_ONLY) KS.num_img_loads++;
+          if (mem_acc & READ_ONLY) KS.memToLoads[FD]++;
           if (mem_acc & WRITE_ONLY) KS.num_img_stores++;
 
           switch (call->getNumArgs()) {
@@ -426,9 +472,26 @@ bool TransferFunctions::checkImageAccess(Expr *E, MemoryAccess mem_acc) {
     }
   }
 
-  // match output(), output_at(), and Accessor->pixel_at() calls
+  // match output(), output_at(), Accessor->pixel_at(), and Accessor->box_sum()
+  // calls
   if (auto call = dyn_cast<CXXMemberCallExpr>(E)) {
     if (auto ME = dyn_cast<MemberExpr>(call->getCallee())) {
+      // box_sum() reads the four corners of a box from an integral image
+      if (ME->getMemberNameInfo().getAsString()=="box_sum") {
+        auto MEAcc = dyn_cast<MemberExpr>(ME->getBase()->IgnoreImpCasts());
+        FieldDecl *FD = MEAcc ? dyn_cast<FieldDecl>(MEAcc->getMemberDecl())
+                              : nullptr;
+        assert(FD && "could not find field");
+
+        KS.num_img_loads += 4;
+        KS.memToLoads[FD] += 4;
+        if (KS.kernelType < LocalOperator) KS.kernelType = LocalOperator;
+        KS.memToAccess[FD] = (MemoryAccess) (KS.memToAccess[FD]|READ_ONLY);
+        KS.memToPattern[FD] = (MemoryPattern) (KS.memToPattern[FD]|STRIDE_XY);
+
+        return true;
+      }
+
       if (ME->getMemberNameInfo().getAsString()=="output" ||
           ME->getMemberNameInfo().getAsString()=="output_at" ||
           ME->getMemberNameInfo().getAsString()=="pixel_at") {
@@ -443,6 +506,7 @@ bool TransferFunctions::checkImageAccess(Expr *E, MemoryAccess mem_acc) {
         assert(FD && "could not find field");
 
         if (mem_acc & READ_ONLY) KS.num_img_loads++;
+        if (mem_acc & READ_ONLY) KS.memToLoads[FD]++;
         if (mem_acc & WRITE_ONLY) KS.num_img_stores++;
 
         MemoryPattern mem_pattern = KS.memToPattern[FD];
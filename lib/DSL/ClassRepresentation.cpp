@@ -32,9 +32,13 @@
 //===----------------------------------------------------------------------===//
 
 #include "hipacc/DSL/ClassRepresentation.h"
+#include "hipacc/Analysis/CostModel.h"
 
 #include <llvm/Support/Format.h>
 
+#include <cmath>
+#include <limits>
+
 #ifdef USE_JIT_ESTIMATE
 #include <cuda_occupancy.h>
 #endif
@@ -226,6 +230,150 @@ void HipaccBoundaryCondition::setConstVal(APValue &val, ASTContext &Ctx) {
 }
 
 
+void HipaccMask::calcSeparability(ASTContext &Ctx, bool exact) {
+  is_separable = is_separable_int = false;
+  row_coeffs.clear();
+  col_coeffs.clear();
+
+  // only 2D constant masks with scalar coefficients benefit from separation
+  if (isDomain() || !is_constant || !init_list || size_x < 2 || size_y < 2)
+    return;
+  if (!type->isIntegerType() && !type->isRealFloatingType()) return;
+
+  // evaluate the coefficients and select the largest one as pivot
+  SmallVector<double, 64> coeffs;
+  size_t pivot_x = 0, pivot_y = 0;
+  double max_coeff = 0;
+  for (size_t y=0; y<size_y; ++y) {
+    for (size_t x=0; x<size_x; ++x) {
+      Expr::EvalResult val;
+      if (!getInitExpr(x, y)->EvaluateAsRValue(val, Ctx)) return;
+
+      double coeff = 0;
+      if (val.Val.isInt()) {
+        coeff = (double)val.Val.getInt().getSExtValue();
+      } else if (val.Val.isFloat()) {
+        llvm::APFloat fval = val.Val.getFloat();
+        if (&fval.getSemantics() == (const llvm::fltSemantics *)
+            &llvm::APFloat::IEEEsingle) {
+          coeff = fval.convertToFloat();
+        } else {
+          coeff = fval.convertToDouble();
+        }
+      } else {
+        return;
+      }
+      coeffs.push_back(coeff);
+
+      if (std::fabs(coeff) > max_coeff) {
+        max_coeff = std::fabs(coeff);
+        pivot_x = x;
+        pivot_y = y;
+      }
+    }
+  }
+  if (max_coeff == 0) return;
+
+  auto coeff = [&] (size_t x, size_t y) { return coeffs[y*size_x + x]; };
+
+  // the pivot row gives the row factors, the pivot column the column factors
+  SmallVector<double, 16> row, col;
+  for (size_t x=0; x<size_x; ++x) row.push_back(coeff(x, pivot_y));
+  for (size_t y=0; y<size_y; ++y)
+    col.push_back(coeff(pivot_x, y) / coeff(pivot_x, pivot_y));
+
+  if (type->isIntegerType()) {
+    // integer factors: divide the pivot row by the gcd of its coefficients,
+    // which makes the column factors of a rank-1 mask integral
+    int64_t gcd = 0;
+    for (size_t x=0; x<size_x; ++x) {
+      int64_t a = (int64_t)std::fabs(row[x]), b = gcd;
+      while (b) { int64_t t = a % b; a = b; b = t; }
+      gcd = a;
+    }
+    if (row[pivot_x] < 0) gcd = -gcd;
+
+    SmallVector<double, 16> int_row, int_col;
+    for (size_t x=0; x<size_x; ++x) int_row.push_back(row[x] / gcd);
+    for (size_t y=0; y<size_y; ++y)
+      int_col.push_back(coeff(pivot_x, y) / int_row[pivot_x]);
+
+    bool is_exact = true;
+    for (size_t y=0; y<size_y && is_exact; ++y) {
+      if (int_col[y] != std::floor(int_col[y]) ||
+          std::fabs(int_col[y]) > std::numeric_limits<int32_t>::max()) {
+        is_exact = false;
+        break;
+      }
+      for (size_t x=0; x<size_x; ++x) {
+        if (int_col[y] * int_row[x] != coeff(x, y)) {
+          is_exact = false;
+          break;
+        }
+      }
+    }
+
+    if (is_exact) {
+      row_coeffs = int_row;
+      col_coeffs = int_col;
+      is_separable = is_separable_int = true;
+      return;
+    }
+
+    // approximated factors change the result of integer masks
+    if (exact) return;
+  }
+
+  // accept rank-1 masks up to the rounding of the given coefficients
+  const double tolerance = 1e-5 * max_coeff;
+  for (size_t y=0; y<size_y; ++y) {
+    for (size_t x=0; x<size_x; ++x) {
+      if (std::fabs(col[y] * row[x] - coeff(x, y)) > tolerance) return;
+    }
+  }
+
+  row_coeffs = row;
+  col_coeffs = col;
+  is_separable = true;
+}
+
+
+void HipaccMask::calcBox(ASTContext &Ctx) {
+  is_box = false;
+
+  if (isDomain() || !is_constant || !init_list) return;
+
+  // all coefficients have to evaluate to the same non-zero value
+  double box_coeff = 0;
+  for (size_t y=0; y<size_y; ++y) {
+    for (size_t x=0; x<size_x; ++x) {
+      Expr::EvalResult val;
+      if (!getInitExpr(x, y)->EvaluateAsRValue(val, Ctx)) return;
+
+      double coeff = 0;
+      if (val.Val.isInt()) {
+        coeff = (double)val.Val.getInt().getSExtValue();
+      } else if (val.Val.isFloat()) {
+        llvm::APFloat fval = val.Val.getFloat();
+        if (&fval.getSemantics() == (const llvm::fltSemantics *)
+            &llvm::APFloat::IEEEsingle) {
+          coeff = fval.convertToFloat();
+        } else {
+          coeff = fval.convertToDouble();
+        }
+      } else {
+        return;
+      }
+
+      if (x == 0 && y == 0) box_coeff = coeff;
+      if (coeff == 0 || coeff != box_coeff) return;
+    }
+  }
+
+  is_box = true;
+}
+
+
 void HipaccKernel::calcSizes() {
   for (auto map : imgMap) {
     // only Accessors with proper border handling mode
@@ -467,6 +615,228 @@ void HipaccKernel::setDefaultConfig() {
   num_threads_y = default_num_threads_y;
 }
 
+static void printRooflineEstimate(const RooflineEstimate &est) {
+  llvm::errs() << llvm::format("%.2f", est.bytes) << " bytes, "
+               << llvm::format("%.2f", est.getIntensity()) << " op/byte -> "
+               << (est.memory_bound ? "memory" : "compute") << " bound, "
+               << llvm::format("%.4f", est.time) << " ms/Mpixel\n";
+}
+
+void HipaccKernel::setCostModelConfig() {
+  KernelStatistics &stats = KC->getKernelStatistics();
+  KernelType type = KC->getKernelType();
+
+  // loads within convolve/reduce/iterate lambdas and loops over the window
+  // are counted once: assume that each pixel of the window is read and scale
+  // the operations accordingly
+  SmallVector<RooflineImage, 16> images;
+  float scale = 1;
+  for (auto map : imgMap) {
+    HipaccAccessor *acc = map.second;
+    unsigned loads = stats.getNumImgLoads(map.first);
+    if (acc == iterationSpace || !loads) continue;
+
+    unsigned size_x = std::max(1u, acc->getSizeX());
+    unsigned size_y = std::max(1u, acc->getSizeY());
+    float reads = loads;
+    if ((KC->getMemPattern(map.first) & (STRIDE_X|STRIDE_Y|STRIDE_XY)) &&
+        size_x*size_y > loads) {
+      reads = size_x*size_y;
+      scale = std::max(scale, reads/loads);
+    }
+    // interpolation reads the neighborhood of each pixel
+    switch (acc->getInterpolationMode()) {
+      case Interpolate::NO:
+      case Interpolate::NN: break;
+      case Interpolate::LF: reads *= 4;  break;
+      case Interpolate::CF: reads *= 16; break;
+      case Interpolate::L3: reads *= 36; break;
+    }
+    images.push_back({ acc->getName(), acc->getImage()->getPixelSize(),
+                       size_x, size_y, reads });
+  }
+
+  // special function units execute fewer operations per cycle than ALUs
+  float sfu_cost = num_sfus ? (float)num_alus/num_sfus : 1;
+  float ops = scale * (stats.getNumOps() + sfu_cost*stats.getNumSFUOps() +
+                       stats.getNumMaskLoads());
+  unsigned store_bytes = std::max(1u, stats.getNumImgStores()) *
+                         iterationSpace->getImage()->getPixelSize();
+
+  HipaccCostModel model(*this, ops, store_bytes);
+  for (auto &img : images) model.addImage(img);
+
+  unsigned bsx = num_threads_x, bsy = num_threads_y;
+  RooflineEstimate base = model.estimate(bsx, bsy, 1, false, false, 1);
+
+  // staging windows in local memory or reading them via the texture cache
+  // pays off only for kernels bound by memory bandwidth; local memory is
+  // scratchpad memory only on NVIDIA and AMD GPUs
+  bool cache = model.hasWindows() && base.memory_bound;
+  if (!options.useLocalMemory((CompilerOption)(USER_ON|USER_OFF)) &&
+      (isNVIDIAGPU() || isAMDGPU())) {
+    if (cache && model.getLocalMemorySize(bsx, bsy, 1) <=
+        max_total_shared_memory/2) {
+      local_memory_threshold = 2;
+    } else {
+      local_memory_threshold = 9999;
+    }
+  }
+  if (options.emitCUDA() &&
+      !options.useTextureMemory((CompilerOption)(USER_ON|USER_OFF))) {
+    Texture tex = require_textures[LocalOperator];
+    if (tex == Texture::None) tex = Texture::Linear1D;
+    require_textures[PointOperator] = Texture::None;
+    require_textures[LocalOperator] = cache ? tex : Texture::None;
+    require_textures[UserOperator] = cache ? tex : Texture::None;
+  }
+  for (auto map : imgMap) calcImgFeature(map.first, map.second);
+
+  bool local = false, texture = false;
+  for (auto map : imgMap) {
+    if (map.second == iterationSpace) continue;
+    if (useLocalMemory(map.second)) local = true;
+    if (useTextureMemory(map.second) != Texture::None) texture = true;
+  }
+
+  // more pixels per thread amortize index computations and the halo of
+  // windows; prefer the smallest number within 5% of the best estimate
+  if (!options.multiplePixelsPerThread((CompilerOption)(USER_ON|USER_OFF)) &&
+      (type == PointOperator || type == LocalOperator)) {
+    SmallVector<std::pair<unsigned, float>, 8> times;
+    float best = std::numeric_limits<float>::max();
+    for (unsigned ppt=1; ppt<=16; ppt*=2) {
+      if (local && model.getLocalMemorySize(bsx, bsy, ppt) >
+          max_total_shared_memory/2) break;
+      float time = model.estimate(bsx, bsy, ppt, local, texture, 1).time;
+      times.push_back(std::make_pair(ppt, time));
+      best = std::min(best, time);
+    }
+    pixels_per_thread[type] = 1;
+    for (auto &time : times) {
+      if (time.second <= best*1.05f) {
+        pixels_per_thread[type] = time.first;
+        break;
+      }
+    }
+  }
+
+  // vectorization is experimental and only enabled by the user, the SIMD
+  // width is reported as recommendation
+  unsigned ppt = getPixelsPerThread();
+  unsigned vector_width = vectorize() ? 4 : 1;
+  RooflineEstimate est = model.estimate(bsx, bsy, ppt, local, texture,
+      vector_width);
+  unsigned simd = 1;
+  if (simd_width > 1 && model.estimate(bsx, bsy, ppt, local, texture,
+        4).time*1.05f < model.estimate(bsx, bsy, ppt, local, texture, 1).time)
+    simd = 4;
+
+  if (!options.printCostModel()) return;
+
+  llvm::errs() << "Cost model for kernel '" << kernelName << "':\n"
+               << "  device: " << getTargetDeviceName() << ", " << peak_gops
+               << " GOP/s, " << peak_bandwidth << " GB/s, ridge point "
+               << llvm::format("%.2f", model.getRidgePoint()) << " op/byte\n"
+               << "  operations per pixel: " << llvm::format("%.1f", ops)
+               << "\n";
+  for (auto &img : model.getImages()) {
+    llvm::errs() << "  image '" << img.name << "': " << img.size_x << "x"
+                 << img.size_y << " window, "
+                 << llvm::format("%.1f", img.loads) << " loads of "
+                 << img.pixel_size << " bytes per pixel\n";
+  }
+  llvm::errs() << "  predicted per pixel without caching: ";
+  printRooflineEstimate(base);
+  llvm::errs() << "  predicted per pixel as configured:   ";
+  printRooflineEstimate(est);
+  llvm::errs() << "  local memory: " << (local ? "on" : "off")
+               << ", textures: ";
+  Texture tex = Texture::None;
+  for (auto map : imgMap) {
+    if (map.second != iterationSpace &&
+        useTextureMemory(map.second) != Texture::None)
+      tex = useTextureMemory(map.second);
+  }
+  switch (tex) {
+    case Texture::None:     llvm::errs() << "off";      break;
+    case Texture::Linear1D: llvm::errs() << "Linear1D"; break;
+    case Texture::Linear2D: llvm::errs() << "Linear2D"; break;
+    case Texture::Array2D:  llvm::errs() << "Array2D";  break;
+    case Texture::Ldg:      llvm::errs() << "Ldg";      break;
+  }
+  llvm::errs() << ", pixels per thread: " << ppt
+               << ", vector width: " << vector_width;
+  if (simd != vector_width)
+    llvm::errs() << " (recommended: " << simd << ")";
+  llvm::errs() << "\n\n";
+}
+
+void HipaccKernel::setTunedConfig(const HipaccTuningEntry &entry) {
+  setDefaultConfig();
+  tuned = true;
+
+  // C/C++ computes one pixel per iteration unless requested otherwise
+  if (KC->getKernelType() != UserOperator) {
+    if (entry.ppt > 0)
+      pixels_per_thread[KC->getKernelType()] = entry.ppt;
+    else if (options.emitC99() && !options.multiplePixelsPerThread(USER_ON))
+      pixels_per_thread[KC->getKernelType()] = 1;
+  }
+
+  if (options.emitC99()) {
+    if (entry.bsx >= 0 && entry.bsy >= 0) {
+      tile_size_x = entry.bsx;
+      tile_size_y = entry.bsy;
+    }
+    if (entry.threads > 0) num_host_threads = entry.threads;
+  } else {
+    if (entry.bsx > 0 && entry.bsy > 0 &&
+        entry.bsx*entry.bsy <= (int)max_threads_per_block) {
+      num_threads_x = entry.bsx;
+      num_threads_y = entry.bsy;
+    }
+
+    // textures and local memory are selected per image
+    if (entry.tex.size() == 4 &&
+        entry.tex.find_first_not_of("01234") == std::string::npos) {
+      KernelType types[] = { PointOperator, LocalOperator, GlobalOperator,
+                             UserOperator };
+      for (size_t i=0; i<4; ++i)
+        require_textures[types[i]] = (Texture)(entry.tex[i] - '0');
+    }
+    if (entry.lmem > 0) local_memory_threshold = entry.lmem;
+    for (auto map : imgMap) calcImgFeature(map.first, map.second);
+  }
+
+  llvm::errs() << "Using configuration from tuning database for kernel '"
+               << kernelName << "' (" << entry.width << "x" << entry.height
+               << ": " << entry.time << " ms)\n";
+}
+
+std::string HipaccKernel::getTuningConfig() {
+  std::string config("ppt=");
+
+  if (options.emitC99()) {
+    // multiple pixels per iteration only if requested
+    if (options.multiplePixelsPerThread(USER_ON) || tuned)
+      config += std::to_string(getPixelsPerThread());
+    else
+      config += "1";
+    config += " bsx=" + std::to_string(tile_size_x);
+    config += " bsy=" + std::to_string(tile_size_y);
+  } else {
+    config += std::to_string(getPixelsPerThread());
+    config += " tex=";
+    for (auto type : { PointOperator, LocalOperator, GlobalOperator,
+                       UserOperator })
+      config += std::to_string((int)require_textures[type]);
+    config += " lmem=" + std::to_string(local_memory_threshold);
+  }
+
+  return config;
+}
+
 void HipaccKernel::addParam(QualType QT1, QualType QT2, QualType QT3,
     std::string typeC, std::string typeO, std::string name, FieldDecl *fd) {
   switch (options.getTargetLang()) {
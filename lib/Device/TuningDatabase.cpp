@@ -0,0 +1,132 @@
+//
+// Copyright (c) 2012, University of Erlangen-Nuremberg
+// Copyright (c) 2012, Siemens AG
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+//===--- TuningDatabase.cpp - Database of tuned kernel configurations ----===//
+//
+// This file implements reading of the tuning database, entries are added by
+// the configuration exploration of the runtime.
+//
+//===----------------------------------------------------------------------===//
+
+#include "hipacc/Device/TuningDatabase.h"
+
+#include <llvm/ADT/StringExtras.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+using namespace clang;
+using namespace hipacc;
+
+
+bool HipaccTuningDatabase::load(std::string file) {
+  std::ifstream is(file.c_str());
+  if (!is) return false;
+
+  std::string line;
+  while (std::getline(is, line)) {
+    std::istringstream ls(line);
+    HipaccTuningEntry entry = { "", "", 0, 0, 0.0f, -1, -1, -1, -1, -1, "" };
+    std::string size, kv;
+    char x = 0;
+
+    // skip comments and malformed lines
+    if (line.empty() || line[0] == '#') continue;
+    if (!(ls >> entry.hash >> entry.target >> size >> entry.time)) continue;
+    std::istringstream ss(size);
+    if (!(ss >> entry.width >> x >> entry.height) || x != 'x') continue;
+
+    while (ls >> kv) {
+      size_t pos = kv.find('=');
+      if (pos == std::string::npos) continue;
+      std::string key(kv.substr(0, pos)), val(kv.substr(pos+1));
+      if (key == "bsx") entry.bsx = atoi(val.c_str());
+      else if (key == "bsy") entry.bsy = atoi(val.c_str());
+      else if (key == "ppt") entry.ppt = atoi(val.c_str());
+      else if (key == "threads") entry.threads = atoi(val.c_str());
+      else if (key == "lmem") entry.lmem = atoi(val.c_str());
+      else if (key == "tex") entry.tex = val;
+    }
+    entries.push_back(entry);
+  }
+
+  return true;
+}
+
+
+const HipaccTuningEntry *HipaccTuningDatabase::lookup(std::string key,
+    unsigned width, unsigned height) const {
+  const HipaccTuningEntry *best = nullptr;
+  double best_dist = 0.0;
+
+  for (auto &entry : entries) {
+    if (entry.hash + " " + entry.target != key) continue;
+
+    // distance in number of pixels on a logarithmic scale
+    double pixels = (double)entry.width * entry.height;
+    double dist = width && height ?
+      std::fabs(std::log((pixels + 1.0) / ((double)width * height + 1.0))) :
+      -pixels;
+    if (!best || dist < best_dist ||
+        (dist == best_dist && entry.time < best->time)) {
+      best = &entry;
+      best_dist = dist;
+    }
+  }
+
+  return best;
+}
+
+
+std::string HipaccTuningDatabase::getKey(std::string kernel, CompilerOptions
+    &options) {
+  // 64-bit FNV-1a
+  uint64_t hash = 14695981039346656037ULL;
+  for (auto c : kernel) {
+    hash ^= (unsigned char)c;
+    hash *= 1099511628211ULL;
+  }
+
+  std::string target;
+  std::string device("-" + std::to_string((int)options.getTargetDevice()));
+  switch (options.getTargetLang()) {
+    case Language::C99:          target = "cc";              break;
+    case Language::CUDA:         target = "cu" + device;     break;
+    case Language::OpenCLACC:    target = "clacc" + device;  break;
+    case Language::OpenCLCPU:    target = "clcpu" + device;  break;
+    case Language::OpenCLGPU:    target = "clgpu" + device;  break;
+    case Language::Renderscript: target = "rs" + device;     break;
+    case Language::Filterscript: target = "fs" + device;     break;
+    case Language::Vivado:       target = "vivado";          break;
+  }
+
+  return llvm::utohexstr(hash) + " " + target;
+}
+
+// vim: set ts=2 sw=2 sts=2 et ai:
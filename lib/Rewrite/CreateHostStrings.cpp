@@ -201,6 +201,13 @@ void CreateHostStrings::writeReductionDeclaration(HipaccKernel *K, std::string
 void CreateHostStrings::writeMemoryAllocation(HipaccImage *Img, std::string
     width, std::string height, std::string host, std::string &resultStr) {
   resultStr += "HipaccImage " + Img->getName() + " = ";
+  if (Img->isBoundToHostMemory()) {
+    // kernels operate directly on the host memory
+    resultStr += "hipaccMapMemory<" + Img->getTypeStr() + ">(";
+    resultStr += host + ", " + width + ", " + height + ", ";
+    resultStr += Img->getStrideStr() + ");";
+    return;
+  }
   switch (options.getTargetLang()) {
     case Language::Vivado:
     case Language::C99:
@@ -269,6 +276,19 @@ void CreateHostStrings::writeMemoryAllocationConstant(HipaccMask *Buf,
 
 void CreateHostStrings::writeMemoryTransfer(HipaccImage *Img, std::string mem,
     MemoryTransferDirection direction, std::string &resultStr) {
+  if (Img->isBoundToHostMemory()) {
+    // no copies required for the host memory used by the image
+    switch (direction) {
+      case HOST_TO_DEVICE:
+        if (mem == Img->getHostMemStr()) return;
+        break;
+      case DEVICE_TO_HOST:
+        resultStr += "(" + Img->getTypeStr() + " *)" + Img->getName() + ".mem;";
+        return;
+      default:
+        break;
+    }
+  }
   switch (direction) {
     case HOST_TO_DEVICE:
       resultStr += "hipaccWriteMemory(";
@@ -408,6 +428,14 @@ void CreateHostStrings::writeMemoryTransferDomainFromMask(
 }
 
 
+void CreateHostStrings::writeIntegralImage(HipaccImage *In, HipaccImage *Out,
+    std::string &resultStr) {
+  resultStr += "hipaccIntegralImage<" + In->getTypeStr() + ", " +
+    Out->getTypeStr() + ">(";
+  resultStr += In->getName() + ", " + Out->getName() + ");";
+}
+
+
 void CreateHostStrings::writeMemoryRelease(HipaccMemory *Mem,
     std::string &resultStr, bool isPyramid) {
   // The same runtime call for all targets, just distinguish between Pyramids
@@ -422,6 +450,87 @@ void CreateHostStrings::writeMemoryRelease(HipaccMemory *Mem,
 }
 
 
+void CreateHostStrings::writeLaunchInfo(HipaccKernel *K, std::string
+    &resultStr) {
+  // hipacc_launch_info
+  resultStr += "hipacc_launch_info " + K->getInfoStr() + "(";
+  resultStr += std::to_string(K->getMaxSizeX()) + ", ";
+  resultStr += std::to_string(K->getMaxSizeY()) + ", ";
+  resultStr += K->getIterationSpace()->getName() + ", ";
+  resultStr += std::to_string(K->getPixelsPerThread()) + ", ";
+  if (K->vectorize()) {
+    // TODO set and calculate per kernel simd width ...
+    resultStr += "4);\n";
+  } else {
+    resultStr += "1);\n";
+  }
+  resultStr += indent;
+}
+
+
+// bytes read and written by the kernel, derived from the accessor sizes;
+// accesses to Img are skipped
+void CreateHostStrings::addAccessorBytes(HipaccKernel *K, HipaccImage *Img,
+    std::string &readStr, std::string &writtenStr) {
+  HipaccKernelClass *KC = K->getKernelClass();
+
+  for (auto arg : KC->getMembers()) {
+    if (arg.kind != HipaccKernelClass::FieldKind::Image &&
+        arg.kind != HipaccKernelClass::FieldKind::IterationSpace) continue;
+    if (!K->getUsed(arg.name)) continue;
+
+    HipaccAccessor *Acc = K->getImgFromMapping(arg.field);
+    if (Img && Acc->getImage() == Img) continue;
+    std::string bytesStr("hipaccAccessorBytes(" + Acc->getName() + ")");
+    if (KC->getMemAccess(arg.field) & READ_ONLY)
+      readStr += (readStr.empty() ? "" : " + ") + bytesStr;
+    if (KC->getMemAccess(arg.field) & WRITE_ONLY)
+      writtenStr += (writtenStr.empty() ? "" : " + ") + bytesStr;
+  }
+}
+
+
+// C/C++ kernel call: arguments for Img are replaced by mem
+void CreateHostStrings::writeKernelArguments(HipaccKernel *K, HipaccImage
+    *Img, std::string mem, std::string &resultStr) {
+  auto argTypeNames = K->getArgTypeNames();
+  auto hostArgNames = K->getHostArgNames();
+
+  resultStr += K->getKernelName() + "(";
+  size_t num_arg = 0;
+  bool first = true;
+  for (auto arg : K->getDeviceArgFields()) {
+    size_t i = num_arg++;
+
+    // skip unused variables
+    if (!K->getUsed(K->getDeviceArgNames()[i])) continue;
+
+    HipaccMask *Mask = K->getMaskFromMapping(arg);
+    if (Mask && Mask->isConstant()) continue;
+
+    HipaccAccessor *Acc = K->getImgFromMapping(arg);
+    if (!first) resultStr += ", ";
+    first = false;
+    if (Acc) {
+      resultStr += "(" + Acc->getImage()->getTypeStr();
+      resultStr += "(*)[" + Acc->getImage()->getStrideStr() + "])";
+      if (Acc->getImage() == Img) {
+        resultStr += mem;
+        continue;
+      }
+    }
+    if (Mask) {
+      resultStr += "(" + argTypeNames[i] + ")";
+    }
+    resultStr += hostArgNames[i];
+    if (Acc || Mask) resultStr += ".mem";
+  }
+  resultStr += ", _gid_y_start, _gid_y_end";
+  if (K->getFusedImage()) resultStr += ", _row_lo";
+  resultStr += ");\n";
+}
+
+
 void CreateHostStrings::writeKernelCall(std::string kernelName,
     HipaccKernelClass *KC, HipaccKernel *K, std::string &resultStr) {
   auto argTypeNames = K->getArgTypeNames();
@@ -455,14 +564,42 @@ void CreateHostStrings::writeKernelCall(std::string kernelName,
   }
   infoStr = K->getInfoStr();
 
-  if (options.exploreConfig() || options.timeKernels()) {
+  // exploration of the block size requires the kernel arguments and memory
+  // information; for C/C++, the number of threads is explored at the launch
+  bool explore = options.exploreConfig() && !options.emitC99();
+  bool explore_c99 = options.exploreConfig() && options.emitC99() &&
+                     !KC->getReduceFunction();
+  // for C/C++, the reduction is fused with the kernel launch
+  bool reduce_c99 = KC->getReduceFunction() && options.emitC99();
+  std::string redTypeStr(K->getIterationSpace()->getImage()->getTypeStr());
+
+  // exploration adds the best configuration to the tuning database
+  std::string tuningStr;
+  if (options.exploreConfig() && options.useTuningDatabase()) {
+    tuningStr = ", \"" + options.getTuningDatabase() + "\", \"";
+    tuningStr += K->getTuningKey() + "\", \"" + K->getTuningConfig() + "\"";
+  }
+
+  // hipaccRecordKernel: bytes read and written are derived from the accessor
+  // sizes, timing from the last launch
+  std::string recordStr, readStr, writtenStr;
+  addAccessorBytes(K, nullptr, readStr, writtenStr);
+  recordStr = "hipaccRecordKernel(\"" + kernelName + "\", " + infoStr + ", ";
+  recordStr += (readStr.empty() ? "0" : readStr) + ", ";
+  recordStr += (writtenStr.empty() ? "0" : writtenStr) + ");\n";
+
+  if (explore || options.timeKernels()) {
+    // the reduction result is used after the timing scope
+    if (reduce_c99) {
+      resultStr += redTypeStr + " " + K->getReduceStr() + ";\n" + indent;
+    }
     inc_indent();
     resultStr += "{\n";
     switch (options.getTargetLang()) {
       case Language::Vivado:
       case Language::C99: break;
       case Language::CUDA:
-        if (options.exploreConfig()) {
+        if (explore) {
           resultStr += indent + "std::vector<void *> _args" + kernelName + ";\n";
           resultStr += indent + "std::vector<hipacc_const_info> _consts" + kernelName + ";\n";
           resultStr += indent + "std::vector<hipacc_tex_info*> _texs" + kernelName + ";\n";
@@ -484,26 +621,18 @@ void CreateHostStrings::writeKernelCall(std::string kernelName,
     resultStr += indent;
   }
 
-  if (!options.emitC99() && !options.emitVivado()) {
-    // hipacc_launch_info
-    resultStr += "hipacc_launch_info " + infoStr + "(";
-    resultStr += std::to_string(K->getMaxSizeX()) + ", ";
-    resultStr += std::to_string(K->getMaxSizeY()) + ", ";
-    resultStr += K->getIterationSpace()->getName() + ", ";
-    resultStr += std::to_string(K->getPixelsPerThread()) + ", ";
-    if (K->vectorize()) {
-      // TODO set and calculate per kernel simd width ...
-      resultStr += "4);\n";
-    } else {
-      resultStr += "1);\n";
-    }
-    resultStr += indent;
+  if (!options.emitVivado()) {
+    writeLaunchInfo(K, resultStr);
   }
 
-  if (!options.exploreConfig()) {
+  if (!explore) {
     switch (options.getTargetLang()) {
-      case Language::Vivado:
-      case Language::C99: break;
+      case Language::Vivado: break;
+      case Language::C99:
+        // hipaccPrepareKernelLaunch
+        resultStr += "hipaccPrepareKernelLaunch(" + infoStr + ");\n\n";
+        resultStr += indent;
+        break;
       case Language::CUDA:
         // dim3 block
         resultStr += "dim3 " + blockStr + "(" + threads_x + ", " + threads_y + ");\n";
@@ -597,7 +726,7 @@ void CreateHostStrings::writeKernelCall(std::string kernelName,
           array_str = "Surface";
         }
         // bind texture and surface
-        if (options.exploreConfig()) {
+        if (explore) {
           std::string lit(std::to_string(literal_count++));
           resultStr += "hipacc_tex_info tex_info" + lit;
           resultStr += "(std::string(\"" + type_str + deviceArgNames[i] + K->getName() + "\"), ";
@@ -639,7 +768,7 @@ void CreateHostStrings::writeKernelCall(std::string kernelName,
         resultStr += indent;
       }
 
-      if (options.exploreConfig() && K->useLocalMemory(Acc)) {
+      if (explore && K->useLocalMemory(Acc)) {
         // store local memory size information for exploration
         resultStr += "_smems" + kernelName + ".push_back(";
         resultStr += "hipacc_smem_info(" + Acc->getSizeXStr() + ", ";
@@ -690,14 +819,14 @@ void CreateHostStrings::writeKernelCall(std::string kernelName,
     std::string img_mem;
     if (Acc || Mask) img_mem = ".mem";
 
-    if (options.exploreConfig() || options.timeKernels()) {
+    if (explore || options.timeKernels()) {
       // add kernel argument
       switch (options.getTargetLang()) {
         case Language::Vivado:
         case Language::C99: break;
         case Language::CUDA:
           resultStr += "_args" + kernelName + ".push_back(";
-          if (options.exploreConfig()) {
+          if (explore) {
             resultStr += "(void *)&" + hostArgNames[i] + img_mem + ");\n";
           } else {
             resultStr += "std::make_pair(sizeof(" + argTypeNames[i];
@@ -739,15 +868,36 @@ void CreateHostStrings::writeKernelCall(std::string kernelName,
         case Language::Vivado:
         case Language::C99:
           if (i==0) {
-            resultStr += "hipaccStartTiming();\n";
-            resultStr += indent;
-            resultStr += kernelName + "(";
+            // rows of the iteration space are processed in parallel bands
+            std::string IS(K->getIterationSpace()->getName());
+            if (!explore_c99) {
+              resultStr += "hipaccStartTiming();\n";
+              resultStr += indent;
+            }
+            if (reduce_c99) {
+              // the output is reduced block-wise while still in cache
+              if (!explore && !options.timeKernels()) {
+                resultStr += redTypeStr + " ";
+              }
+              resultStr += K->getReduceStr() + " = ";
+              resultStr += "hipaccLaunchKernelReduce<" + redTypeStr + ">(";
+            } else if (explore_c99) {
+              resultStr += "hipaccKernelExploration(\"" + kernelName + "\", ";
+              resultStr += IS + ".offset_y, ";
+              resultStr += IS + ".offset_y + " + IS + ".height, ";
+            } else {
+              resultStr += "hipaccLaunchKernel(" + IS + ".offset_y, ";
+              resultStr += IS + ".offset_y + " + IS + ".height, ";
+            }
+            resultStr += "[&] (int _gid_y_start, int _gid_y_end) {\n";
+            inc_indent();
+            resultStr += indent + kernelName + "(";
           } else {
             resultStr += ", ";
           }
           if (Acc) {
             resultStr += "(" + Acc->getImage()->getTypeStr();
-            resultStr += "(*)[" + Acc->getImage()->getSizeXStr() + "])";
+            resultStr += "(*)[" + Acc->getImage()->getStrideStr() + "])";
           }
           if (Mask) {
             resultStr += "(" + argTypeNames[i] + ")";
@@ -791,16 +941,38 @@ void CreateHostStrings::writeKernelCall(std::string kernelName,
     }
   }
   if (options.getTargetLang()==Language::C99) {
-    // close parenthesis for function call
+    // close parenthesis for function call and launch; the row buffer of an
+    // unfused kernel is the whole image
+    resultStr += ", _gid_y_start, _gid_y_end";
+    if (K->getFusedImage()) resultStr += ", 0";
     resultStr += ");\n";
-    resultStr += indent;
-    resultStr += "hipaccStopTiming();\n";
+    dec_indent();
+    if (KC->getReduceFunction()) {
+      resultStr += indent + "}, " + K->getReduceName() + ", ";
+      resultStr += K->getIterationSpace()->getName();
+      if (K->getNumHostThreads()) {
+        resultStr += ", " + std::to_string(K->getNumHostThreads());
+      }
+      resultStr += ");\n";
+    } else if (explore_c99) {
+      resultStr += indent + "}, " + infoStr + tuningStr + ");\n";
+    } else if (K->getNumHostThreads()) {
+      resultStr += indent + "}, " + std::to_string(K->getNumHostThreads());
+      resultStr += ");\n";
+    } else {
+      resultStr += indent + "});\n";
+    }
+    if (!explore_c99) {
+      resultStr += indent;
+      resultStr += "hipaccStopTiming();\n";
+    }
+    resultStr += indent + recordStr;
     resultStr += indent;
   }
   resultStr += "\n" + indent;
 
   // launch kernel
-  if (options.exploreConfig() || options.timeKernels()) {
+  if (explore || options.timeKernels()) {
     switch (options.getTargetLang()) {
       case Language::Vivado:
       case Language::C99: break;
@@ -841,7 +1013,7 @@ void CreateHostStrings::writeKernelCall(std::string kernelName,
         resultStr += ", &ScriptC_" + K->getFileName() + "::forEach_" + kernelName;
     }
     // additional parameters for exploration
-    if (options.exploreConfig()) {
+    if (explore) {
       resultStr += ", _smems" + kernelName;
       if (options.emitCUDA()) {
         resultStr += ", _consts" + kernelName;
@@ -860,12 +1032,14 @@ void CreateHostStrings::writeKernelCall(std::string kernelName,
       if (options.emitRenderscript() || options.emitFilterscript()) {
         resultStr += ", " + gridStr;
       }
+      resultStr += tuningStr;
     } else {
       resultStr += ", " + gridStr;
       resultStr += ", " + blockStr;
       resultStr += ", true";
     }
     resultStr += ");\n";
+    if (options.timeKernels()) resultStr += indent + recordStr;
     dec_indent();
     resultStr += indent + "}\n";
   } else {
@@ -897,10 +1071,63 @@ void CreateHostStrings::writeKernelCall(std::string kernelName,
       resultStr += ", " + blockStr;
       resultStr += ");";
     }
+    if (!options.emitC99()) {
+      resultStr += "\n" + indent + recordStr;
+      resultStr += indent;
+    }
   }
 }
 
 
+// Launch the producer fused with the consumer (C/C++ only): the rows of the
+// intermediate image read by a block of consumer rows are computed into a
+// buffer local to the thread right before the consumer, the intermediate
+// image is not written
+void CreateHostStrings::writeFusedKernelCall(HipaccKernel *P, HipaccKernel *C,
+    HipaccAccessor *Acc, unsigned halo, std::string &resultStr) {
+  HipaccImage *Img = P->getIterationSpace()->getImage();
+  std::string typeStr(Img->getTypeStr());
+  std::string IS(C->getIterationSpace()->getName());
+  std::string recordStr, readStr, writtenStr;
+
+  writeLaunchInfo(P, resultStr);
+  writeLaunchInfo(C, resultStr);
+  resultStr += "hipaccPrepareKernelLaunch(" + P->getInfoStr() + ");\n";
+  resultStr += indent;
+  resultStr += "hipaccPrepareKernelLaunch(" + C->getInfoStr() + ");\n\n";
+  resultStr += indent;
+
+  resultStr += "hipaccStartTiming();\n";
+  resultStr += indent + "hipaccLaunchKernelFused<" + typeStr + ">(";
+  for (auto K : { P, C }) {
+    if (K == C) resultStr += ", ";
+    resultStr += "[&] (" + typeStr + " *_tmp, int _row_lo, ";
+    resultStr += "int _gid_y_start, int _gid_y_end) {\n";
+    inc_indent();
+    resultStr += indent;
+    writeKernelArguments(K, Img, "_tmp", resultStr);
+    dec_indent();
+    resultStr += indent + "}";
+    addAccessorBytes(K, Img, readStr, writtenStr);
+  }
+  resultStr += ", " + Img->getStrideStr();
+  resultStr += ", " + P->getIterationSpace()->getName() + ".height";
+  resultStr += ", " + std::to_string(halo) + ", " + std::to_string(halo);
+  resultStr += ", " + Acc->getName() + ".offset_y - " + IS + ".offset_y";
+  resultStr += ", " + IS + ".offset_y, " + IS + ".offset_y + " + IS;
+  resultStr += ".height);\n";
+  resultStr += indent + "hipaccStopTiming();\n";
+
+  // the fused launch is recorded for the consumer
+  recordStr = "hipaccRecordKernel(\"" + P->getKernelName() + "+";
+  recordStr += C->getKernelName() + "\", " + C->getInfoStr() + ", ";
+  recordStr += (readStr.empty() ? "0" : readStr) + ", ";
+  recordStr += (writtenStr.empty() ? "0" : writtenStr) + ");\n";
+  resultStr += indent + recordStr;
+  resultStr += indent + "\n" + indent;
+}
+
+
 void CreateHostStrings::writeReduceCall(HipaccKernelClass *KC, HipaccKernel *K,
     std::string &resultStr) {
   std::string typeStr(K->getIterationSpace()->getImage()->getTypeStr());
@@ -908,8 +1135,10 @@ void CreateHostStrings::writeReduceCall(HipaccKernelClass *KC, HipaccKernel *K,
 
   // print runtime function name plus name of reduction function
   switch (options.getTargetLang()) {
-    case Language::Vivado:
-    case Language::C99: break;
+    case Language::Vivado: break;
+    case Language::C99:
+      // fused with the kernel launch
+      return;
     case Language::CUDA:
       if (!options.exploreConfig()) {
         // first get texture reference
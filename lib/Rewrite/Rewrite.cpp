@@ -40,6 +40,7 @@
 #include "hipacc/AST/ASTTranslate.h"
 #include "hipacc/Config/CompilerOptions.h"
 #include "hipacc/Device/TargetDescription.h"
+#include "hipacc/Device/TuningDatabase.h"
 #include "hipacc/DSL/CompilerKnownClasses.h"
 #include "hipacc/Rewrite/CreateHostStrings.h"
 #include "hipacc/Analysis/HostDataDeps.h"
@@ -77,6 +78,7 @@ class Rewrite : public ASTConsumer,  public RecursiveASTVisitor<Rewrite> {
     hipacc::Builtin::Context builtins;
     CreateHostStrings stringCreator;
     HostDataDeps *dataDeps;
+    HipaccTuningDatabase tuningDB;
 
     // compiler known/built-in C++ classes
     CompilerKnownClasses compilerClasses;
@@ -91,6 +93,15 @@ class Rewrite : public ASTConsumer,  public RecursiveASTVisitor<Rewrite> {
     llvm::DenseMap<ValueDecl *, HipaccKernel *> KernelDeclMap;
     llvm::DenseMap<ValueDecl *, HipaccMask *> MaskDeclMap;
 
+    // kernel calls of producers that are fused into their consumer if
+    // possible; rewritten at the call of the consumer
+    struct ProducerCall {
+      SourceLocation loc;
+      unsigned length;
+      std::string literals;
+    };
+    llvm::DenseMap<ValueDecl *, ProducerCall> ProducerCallMap;
+
     // store interpolation methods required for CUDA
     SmallVector<std::string, 16> InterpolationDefinitionsGlobal;
 
@@ -113,6 +124,8 @@ class Rewrite : public ASTConsumer,  public RecursiveASTVisitor<Rewrite> {
       targetDevice(options),
       builtins(CI.getASTContext()),
       stringCreator(CreateHostStrings(options, targetDevice)),
+      dataDeps(nullptr),
+      tuningDB(),
       compilerClasses(CompilerKnownClasses()),
       mainFD(nullptr),
       literalCount(0),
@@ -138,6 +151,14 @@ class Rewrite : public ASTConsumer,  public RecursiveASTVisitor<Rewrite> {
       mainFileID = SM.getMainFileID();
       TextRewriter.setSourceMgr(SM, Context.getLangOpts());
       TextRewriteOptions.RemoveLineIfEmpty = true;
+
+      // configurations are added to the database during exploration
+      if (compilerOptions.useTuningDatabase() &&
+          !compilerOptions.exploreConfig() &&
+          !tuningDB.load(compilerOptions.getTuningDatabase())) {
+        llvm::errs() << "Warning: could not read tuning database '"
+                     << compilerOptions.getTuningDatabase() << "'!\n";
+      }
     }
 
     std::string convertToString(Stmt *from) {
@@ -148,7 +169,16 @@ class Rewrite : public ASTConsumer,  public RecursiveASTVisitor<Rewrite> {
       return S.str();
     }
 
+    std::string getTuningKey(HipaccKernelClass *KC, HipaccKernel *K);
+    bool getIterationSpaceSize(HipaccKernel *K, unsigned &width, unsigned
+        &height);
     void setKernelConfiguration(HipaccKernelClass *KC, HipaccKernel *K);
+    void writeKernelCall(HipaccKernel *K, std::string &newStr);
+    void rewriteProducerCall(HipaccKernel *K, bool fused);
+    unsigned getFusionHalo(HipaccKernel *P, HipaccKernel *C,
+        HipaccAccessor *&Acc);
+    void printVivadoReduction(HipaccKernel *K, std::string typeStr,
+        llvm::raw_ostream *OS);
     void printReductionFunction(HipaccKernelClass *KC, HipaccKernel *K,
         PrintingPolicy Policy, llvm::raw_ostream *OS);
     void printKernelFunction(FunctionDecl *D, HipaccKernelClass *KC,
@@ -176,6 +206,9 @@ class Rewrite : public ASTConsumer,  public RecursiveASTVisitor<Rewrite> {
         HipaccKernel *K, PrintingPolicy &Policy, llvm::raw_ostream *OS,
         VivadoParam=None);
     std::map<std::string,std::vector<std::pair<std::string, std::string>>> entryArguments;
+    // set once the entry function has been called on the host, reset by each
+    // kernel execution
+    bool vivadoEntryCalled = false;
     std::string vivadoSizeX;
     std::string vivadoSizeY;
 };
@@ -216,6 +249,11 @@ void Rewrite::HandleTranslationUnit(ASTContext &Context) {
   assert(compilerClasses.Pyramid && "Pyramid class not found!");
   assert(compilerClasses.HipaccEoP && "HipaccEoP class not found!");
 
+  // calls of producer kernels without call of the consumer are not fused
+  while (!ProducerCallMap.empty()) {
+    rewriteProducerCall(KernelDeclMap[ProducerCallMap.begin()->first], false);
+  }
+
   StringRef MainBuf = SM.getBufferData(mainFileID);
   const char *mainFileStart = MainBuf.begin();
   const char *mainFileEnd = MainBuf.end();
@@ -700,8 +738,8 @@ bool Rewrite::VisitDeclStmt(DeclStmt *D) {
       if (compilerClasses.isTypeOfTemplateClass(VD->getType(),
             compilerClasses.Image)) {
         CXXConstructExpr *CCE = dyn_cast<CXXConstructExpr>(VD->getInit());
-        assert((CCE->getNumArgs() == 2 || CCE->getNumArgs() == 3) &&
-               "Image definition requires two or three arguments!");
+        assert((CCE->getNumArgs() >= 2 && CCE->getNumArgs() <= 4) &&
+               "Image definition requires two to four arguments!");
 
         HipaccImage *Img = new HipaccImage(Context, VD,
             compilerClasses.getFirstTemplateType(VD->getType()));
@@ -735,10 +773,28 @@ bool Rewrite::VisitDeclStmt(DeclStmt *D) {
 
         // host memory
         std::string init_str = "NULL";
-        if (CCE->getNumArgs() == 3) {
+        if (CCE->getNumArgs() >= 3) {
           init_str = convertToString(CCE->getArg(2));
         }
 
+        // host memory with stride used directly by the image
+        if (CCE->getNumArgs() == 4) {
+          if (!compilerOptions.emitC99()) {
+            unsigned IDBind = Diags.getCustomDiagID(DiagnosticsEngine::Error,
+                "Binding host memory to Image %0 is only supported for C/C++.");
+            Diags.Report(CCE->getArg(3)->getExprLoc(), IDBind)
+              << Img->getName();
+          } else if (!CCE->getArg(3)->isEvaluatable(Context)) {
+            unsigned IDConstant = Diags.getCustomDiagID(DiagnosticsEngine::Error,
+                "Constant expression for %0 argument of Image %1 required (C/C++ only).");
+            Diags.Report(CCE->getArg(3)->getExprLoc(), IDConstant) << "stride"
+              << Img->getName();
+          } else {
+            Img->bindHostMemory(init_str,
+                CCE->getArg(3)->EvaluateKnownConstInt(Context).getSExtValue());
+          }
+        }
+
         // if vector type, get info
         QualType QT = compilerClasses.getFirstTemplateType(VD->getType());
         bool isVector = false;
@@ -1183,6 +1239,12 @@ bool Rewrite::VisitDeclStmt(DeclStmt *D) {
         }
         Mask->setIsConstant(isMaskConstant);
         Mask->setHostMemName(V->getName());
+        if (isMaskConstant && compilerOptions.separateMasks()) {
+          Mask->calcSeparability(Context, compilerOptions.exactSeparation());
+        }
+        if (isMaskConstant && compilerOptions.runningSums()) {
+          Mask->calcBox(Context);
+        }
       }
 
       HipaccMask *Domain = nullptr;
@@ -1400,7 +1462,21 @@ bool Rewrite::VisitDeclStmt(DeclStmt *D) {
             }
           }
 
+          // kernels of a fusible pair address the intermediate image relative
+          // to the row buffer of the fused launch
+          if (dataDeps && compilerOptions.emitC99()) {
+            ValueDecl *PVD = dataDeps->getFusedProducer(VD);
+            if (dataDeps->getFusedConsumer(VD)) {
+              K->setFusedImage(K->getIterationSpace()->getImage());
+            } else if (PVD && KernelDeclMap.count(PVD)) {
+              K->setFusedImage(
+                  KernelDeclMap[PVD]->getIterationSpace()->getImage());
+            }
+          }
+
           // set kernel configuration
+          if (compilerOptions.useTuningDatabase())
+            K->setTuningKey(getTuningKey(KC, K));
           setKernelConfiguration(KC, K);
 
           // kernel declaration
@@ -1469,6 +1545,9 @@ void Rewrite::createVivadoEntry() {
   *OS << "#define BORDER_FILL_VALUE    0\n";
   *OS << "#define HIPACC_II_TARGET     " << compilerOptions.getTargetII() << "\n";
   *OS << "#define HIPACC_PPT           " << compilerOptions.getPixelsPerThread() << "\n";
+  if (compilerOptions.runtimeSize()) {
+    *OS << "#define HIPACC_RUNTIME_SIZE\n";
+  }
   *OS << "\n";
   *OS << "#include \"hipacc_vivado_types.hpp\"\n";
   *OS << "#include \"hipacc_vivado_filter.hpp\"\n\n";
@@ -1491,7 +1570,7 @@ bool Rewrite::VisitFunctionDecl(FunctionDecl *D) {
     assert(isa<CompoundStmt>(D->getBody()) && "CompoundStmt for main body expected.");
     mainFD = D;
 
-    if (compilerOptions.emitVivado()) {
+    if (compilerOptions.emitVivado() || compilerOptions.fuseKernels()) {
       AnalysisDeclContext AC(0, mainFD);
       dataDeps = HostDataDeps::parse(Context, AC, compilerClasses,
           compilerOptions);
@@ -1820,8 +1899,11 @@ bool Rewrite::VisitBinaryOperator(BinaryOperator *E) {
             typeCast = "(" + getStdIntFromBitWidth(
                   info.elementCount * info.elementWidth) + "*)";
           }
-          // call entry function, which creates current output
-          newStr = dataDeps->printEntryCall(entryArguments, Img->getName());
+          // call entry function, which creates all outputs
+          if (!vivadoEntryCalled) {
+            newStr = dataDeps->printEntryCall(entryArguments, Img->getName());
+            vivadoEntryCalled = true;
+          }
           // TODO: find better solution than embedding stream in mem string
           stringCreator.writeMemoryTransfer(Img,
               stream + ", " + typeCast + DS.str(), DEVICE_TO_HOST, newStr);
@@ -1869,6 +1951,12 @@ bool Rewrite::VisitCXXMemberCallExpr(CXXMemberCallExpr *E) {
         VarDecl *VD = K->getDecl();
         std::string newStr;
 
+        // the first data() or reduced_data() call after the execution runs
+        // the entry function again
+        if (compilerOptions.emitVivado()) {
+          vivadoEntryCalled = false;
+        }
+
         // this was checked before, when the user class was parsed
         CXXConstructExpr *CCE = dyn_cast<CXXConstructExpr>(VD->getInit());
         assert(CCE->getNumArgs()==K->getKernelClass()->getMembers().size() &&
@@ -1878,25 +1966,40 @@ bool Rewrite::VisitCXXMemberCallExpr(CXXMemberCallExpr *E) {
         K->setHostArgNames(llvm::makeArrayRef(CCE->getArgs(),
               CCE->getNumArgs()), newStr, literalCount);
 
+        // get the start location and compute the semi location.
+        SourceLocation startLoc = E->getLocStart();
+        const char *startBuf = SM.getCharacterData(startLoc);
+        const char *semiPtr = strchr(startBuf, ';');
+
+        // producer of a fusible kernel pair: the consumer is not known yet
+        if (dataDeps && dataDeps->getFusedConsumer(VD)) {
+          ProducerCall call = { startLoc, (unsigned)(semiPtr-startBuf+1),
+                                newStr };
+          ProducerCallMap[VD] = call;
+          return true;
+        }
+
+        // consumer of a fusible kernel pair
+        ValueDecl *PVD = dataDeps ? dataDeps->getFusedProducer(VD) : nullptr;
+        if (PVD && ProducerCallMap.count(PVD)) {
+          HipaccKernel *P = KernelDeclMap[PVD];
+          HipaccAccessor *Acc = nullptr;
+          unsigned halo = getFusionHalo(P, K, Acc);
+          rewriteProducerCall(P, Acc != nullptr);
+          if (Acc) {
+            stringCreator.writeFusedKernelCall(P, K, Acc, halo, newStr);
+            TextRewriter.ReplaceText(startLoc, semiPtr-startBuf+1, newStr);
+            return true;
+          }
+        }
+
         //
         // TODO: handle the case when only reduce function is specified
         //
         // create kernel call string
-        stringCreator.writeKernelCall(K->getKernelName(), K->getKernelClass(),
-            K, newStr);
-
-        // create reduce call string
-        if (K->getKernelClass()->getReduceFunction()) {
-          newStr += "\n" + stringCreator.getIndent();
-          stringCreator.writeReductionDeclaration(K, newStr);
-          stringCreator.writeReduceCall(K->getKernelClass(), K, newStr);
-        }
+        writeKernelCall(K, newStr);
 
         // rewrite kernel invocation
-        // get the start location and compute the semi location.
-        SourceLocation startLoc = E->getLocStart();
-        const char *startBuf = SM.getCharacterData(startLoc);
-        const char *semiPtr = strchr(startBuf, ';');
         TextRewriter.ReplaceText(startLoc, semiPtr-startBuf+1, newStr);
       }
     }
@@ -1912,10 +2015,24 @@ bool Rewrite::VisitCXXMemberCallExpr(CXXMemberCallExpr *E) {
         // match for supported member calls
         if (ME->getMemberNameInfo().getAsString() == "reduced_data") {
           HipaccKernel *K = KernelDeclMap[DRE->getDecl()];
+          std::string reduceStr(K->getReduceStr());
+
+          // the result is returned by the entry function
+          if (compilerOptions.emitVivado()) {
+            reduceStr = dataDeps->getReduceResult(DRE->getDecl());
+            if (!vivadoEntryCalled) {
+              std::string entryStr(dataDeps->printEntryCall(entryArguments,
+                    K->getIterationSpace()->getImage()->getName()));
+              // strip ";\n" and evaluate the call as part of the expression
+              entryStr.erase(entryStr.find_last_of(';'));
+              reduceStr = "(" + entryStr + ", " + reduceStr + ")";
+              vivadoEntryCalled = true;
+            }
+          }
 
           // replace member function invocation
           SourceRange range(E->getLocStart(), E->getLocEnd());
-          TextRewriter.ReplaceText(range, K->getReduceStr());
+          TextRewriter.ReplaceText(range, reduceStr);
 
           return true;
         }
@@ -1981,13 +2098,228 @@ bool Rewrite::VisitCallExpr (CallExpr *E) {
         const char *semiPtr = strchr(startBuf, '(');
         TextRewriter.ReplaceText(startLoc, semiPtr-startBuf, "hipaccTraverse");
       }
+
+      // rewrite function calls 'integral_image' to the runtime function
+      if (DRE->getDecl()->getNameAsString() == "integral_image" &&
+          E->getNumArgs() == 2) {
+        HipaccImage *ImgIn = nullptr, *ImgOut = nullptr;
+        for (size_t i=0; i<2; ++i) {
+          auto Arg = dyn_cast<DeclRefExpr>(E->getArg(i)->IgnoreParenCasts());
+          if (Arg && ImgDeclMap.count(Arg->getDecl())) {
+            HipaccImage *Img = ImgDeclMap[Arg->getDecl()];
+            if (i==0) ImgIn = Img;
+            else ImgOut = Img;
+          }
+        }
+        if (!ImgIn || !ImgOut) return true;
+
+        if (compilerOptions.emitVivado() ||
+            compilerOptions.emitRenderscript() ||
+            compilerOptions.emitFilterscript()) {
+          unsigned IDTarget = Diags.getCustomDiagID(DiagnosticsEngine::Error,
+              "Integral images are only supported for C/C++, CUDA, and OpenCL.");
+          Diags.Report(E->getLocStart(), IDTarget);
+          exit(EXIT_FAILURE);
+        }
+        if (ImgIn->getType()->isVectorType() ||
+            ImgOut->getType()->isVectorType()) {
+          unsigned IDVector = Diags.getCustomDiagID(DiagnosticsEngine::Error,
+              "Integral images of vector type are not supported.");
+          Diags.Report(E->getLocStart(), IDVector);
+          exit(EXIT_FAILURE);
+        }
+        // unsigned sums wrap around, but box sums stay exact as long as the
+        // box itself fits into the sum type
+        if (ImgOut->getType()->isSignedIntegerType() &&
+            Context.getTypeSize(ImgOut->getType()) < 64) {
+          unsigned IDOverflow = Diags.getCustomDiagID(
+              DiagnosticsEngine::Warning,
+              "Integral image %0 may overflow, use an unsigned or 64-bit type.");
+          Diags.Report(E->getArg(1)->getExprLoc(), IDOverflow)
+            << ImgOut->getName();
+        }
+
+        std::string newStr;
+        stringCreator.writeIntegralImage(ImgIn, ImgOut, newStr);
+
+        SourceLocation startLoc = E->getLocStart();
+        const char *startBuf = SM.getCharacterData(startLoc);
+        const char *semiPtr = strchr(startBuf, ';');
+        TextRewriter.ReplaceText(startLoc, semiPtr-startBuf+1, newStr);
+      }
+    }
+  }
+  return true;
+}
+
+
+void Rewrite::writeKernelCall(HipaccKernel *K, std::string &newStr) {
+  // create kernel call string
+  stringCreator.writeKernelCall(K->getKernelName(), K->getKernelClass(), K,
+      newStr);
+
+  // create reduce call string
+  if (K->getKernelClass()->getReduceFunction()) {
+    if (compilerOptions.emitVivado()) {
+      // declare result, which is returned by the entry function
+      newStr += K->getKernelClass()->getReduceFunction()->getReturnType()
+        .getAsString() + " " + dataDeps->getReduceResult(K->getDecl()) + ";";
+      return;
     }
+    newStr += "\n" + stringCreator.getIndent();
+    stringCreator.writeReductionDeclaration(K, newStr);
+    stringCreator.writeReduceCall(K->getKernelClass(), K, newStr);
+  }
+}
+
+
+// rewrite the deferred call of a producer kernel, which is removed in case
+// the producer is fused into its consumer
+void Rewrite::rewriteProducerCall(HipaccKernel *K, bool fused) {
+  ProducerCall call = ProducerCallMap[K->getDecl()];
+  ProducerCallMap.erase(K->getDecl());
+
+  std::string newStr(call.literals);
+  if (fused) {
+    newStr += "// " + K->getKernelName() + " is fused into its consumer";
+  } else {
+    writeKernelCall(K, newStr);
+  }
+  TextRewriter.ReplaceText(call.loc, call.length, newStr);
+}
+
+
+// check if producer P can be fused into consumer C: Acc is set to the
+// Accessor of C reading the image produced by P, or to nullptr otherwise.
+// Returns the number of rows C reads above and below each pixel.
+unsigned Rewrite::getFusionHalo(HipaccKernel *P, HipaccKernel *C,
+    HipaccAccessor *&Acc) {
+  Acc = nullptr;
+
+  // kernels are timed and explored one by one
+  if (compilerOptions.exploreConfig() || compilerOptions.timeKernels())
+    return 0;
+
+  for (auto K : { P, C }) {
+    HipaccKernelClass *KC = K->getKernelClass();
+    if (KC->getReduceFunction()) return 0;
+    if (KC->getKernelType() != PointOperator &&
+        KC->getKernelType() != LocalOperator) return 0;
+  }
+
+  // the producer reads its images when the consumer is executed; the
+  // intermediate image is not written and has to cover the iteration space
+  HipaccImage *Img = P->getIterationSpace()->getImage();
+  if (P->getIterationSpace()->isCrop() || Img->isBoundToHostMemory())
+    return 0;
+  // both kernels have to address the image relative to the row buffer
+  if (P->getFusedImage() != Img || C->getFusedImage() != Img) return 0;
+  for (auto img : P->getKernelClass()->getImgFields()) {
+    if (P->getImgFromMapping(img)->getImage()->isBoundToHostMemory())
+      return 0;
+  }
+  if (C->getIterationSpace()->getImage() == Img) return 0;
+
+  // single Accessor of the consumer to the intermediate image
+  HipaccAccessor *ImgAcc = nullptr;
+  FieldDecl *ImgField = nullptr;
+  for (auto img : C->getKernelClass()->getImgFields()) {
+    if (C->getImgFromMapping(img)->getImage() != Img) continue;
+    if (ImgAcc) return 0;
+    ImgAcc = C->getImgFromMapping(img);
+    ImgField = img;
+  }
+  if (!ImgAcc || ImgAcc->isCrop() ||
+      ImgAcc->getInterpolationMode() != Interpolate::NO) return 0;
+
+  unsigned halo = 0;
+  MemoryPattern pattern = C->getKernelClass()->getMemPattern(ImgField);
+  if (pattern & USER_XY) return 0;
+  if (pattern & (STRIDE_Y | STRIDE_XY)) {
+    // rows outside the image are mapped to rows within the halo
+    if (ImgAcc->getSizeY() < 2) return 0;
+    switch (ImgAcc->getBoundaryMode()) {
+      case Boundary::CLAMP:
+      case Boundary::MIRROR:
+      case Boundary::CONSTANT:
+        break;
+      case Boundary::UNDEFINED:
+      case Boundary::REPEAT:
+        return 0;
+    }
+    halo = ImgAcc->getSizeY()/2;
+  }
+
+  Acc = ImgAcc;
+  return halo;
+}
+
+
+// the kernel is identified in the tuning database by a hash of its body and
+// the images it accesses
+std::string Rewrite::getTuningKey(HipaccKernelClass *KC, HipaccKernel *K) {
+  std::string str(KC->getName() + "\n");
+  str += convertToString(KC->getKernelFunction()->getBody());
+
+  for (auto img : KC->getImgFields()) {
+    HipaccAccessor *Acc = K->getImgFromMapping(img);
+    if (!Acc) continue;
+    str += "\n" + Acc->getImage()->getTypeStr();
+    str += " " + std::to_string(Acc->getSizeX());
+    str += "x" + std::to_string(Acc->getSizeY());
+    str += " " + std::to_string((int)Acc->getBoundaryMode());
+    str += " " + std::to_string((int)Acc->getInterpolationMode());
+  }
+
+  return HipaccTuningDatabase::getKey(str, compilerOptions);
+}
+
+
+// size of the iteration space if it is known at compile time
+bool Rewrite::getIterationSpaceSize(HipaccKernel *K, unsigned &width, unsigned
+    &height) {
+  HipaccIterationSpace *IS = K->getIterationSpace();
+  auto ISCCE = dyn_cast_or_null<CXXConstructExpr>(IS->getDecl()->getInit());
+  auto ImgCCE =
+    dyn_cast_or_null<CXXConstructExpr>(IS->getImage()->getDecl()->getInit());
+  Expr *width_expr = nullptr, *height_expr = nullptr;
+
+  if (ISCCE && ISCCE->getNumArgs() >= 3) {
+    // IterationSpace(img, width, height[, offset_x, offset_y])
+    width_expr = ISCCE->getArg(1);
+    height_expr = ISCCE->getArg(2);
+  } else if (ImgCCE && ImgCCE->getNumArgs() >= 2) {
+    // Image(width, height[, ...])
+    width_expr = ImgCCE->getArg(0);
+    height_expr = ImgCCE->getArg(1);
   }
+
+  if (!width_expr || !height_expr || !width_expr->isEvaluatable(Context) ||
+      !height_expr->isEvaluatable(Context))
+    return false;
+
+  width = width_expr->EvaluateKnownConstInt(Context).getZExtValue();
+  height = height_expr->EvaluateKnownConstInt(Context).getZExtValue();
   return true;
 }
 
 
 void Rewrite::setKernelConfiguration(HipaccKernelClass *KC, HipaccKernel *K) {
+  // configuration found during exploration, selected for the size of the
+  // iteration space if known at compile time
+  if (compilerOptions.useTuningDatabase() && !compilerOptions.exploreConfig()) {
+    unsigned width = 0, height = 0;
+    getIterationSpaceSize(K, width, height);
+    if (auto entry = tuningDB.lookup(K->getTuningKey(), width, height)) {
+      K->setTunedConfig(*entry);
+      return;
+    }
+  }
+
+  // select memory and code generation options by the roofline cost model
+  if (compilerOptions.emitCUDA() || compilerOptions.emitOpenCL())
+    K->setCostModelConfig();
+
   #ifdef USE_JIT_ESTIMATE
   bool jit_compile = false;
   switch (compilerOptions.getTargetLang()) {
@@ -2164,16 +2496,45 @@ void Rewrite::setKernelConfiguration(HipaccKernelClass *KC, HipaccKernel *K) {
 }
 
 
+// entry function of the reduce process: the stream of pixels computed by the
+// kernel is reduced to a single value, which is returned by reference
+void Rewrite::printVivadoReduction(HipaccKernel *K, std::string typeStr,
+    llvm::raw_ostream *OS) {
+  HipaccImage *Img = K->getIterationSpace()->getImage();
+  bool vect = compilerOptions.getPixelsPerThread() > 1 ||
+    isa<VectorType>(Img->getType().getCanonicalType().getTypePtr());
+
+  *OS << "};\n\n";
+  *OS << "void " << K->getReduceName() << "(hls::stream<"
+      << createVivadoTypeStr(Img, compilerOptions.getPixelsPerThread())
+      << " > &Input, " << typeStr << " &Output"
+      << ", int IS_width, int IS_height) {\n"
+      << "    struct " << K->getReduceName() << "Kernel reduce;\n"
+      << "    reduceStream";
+  if (vect) {
+    *OS << "VECT";
+    if (Img->getType()->isRealFloatingType()) {
+      *OS << "F";
+    }
+  }
+  *OS << "<HIPACC_II_TARGET,HIPACC_MAX_WIDTH,HIPACC_MAX_HEIGHT";
+  if (vect) {
+    *OS << ",HIPACC_PPT," << Img->getTypeStr() << " ";
+  }
+  *OS << ">(Input, Output, IS_width, IS_height, reduce);\n}\n";
+}
+
+
 void Rewrite::printReductionFunction(HipaccKernelClass *KC, HipaccKernel *K,
     PrintingPolicy Policy, llvm::raw_ostream *OS) {
   FunctionDecl *fun = KC->getReduceFunction();
 
-  // preprocessor defines
-  if (!compilerOptions.exploreConfig()) {
+  // preprocessor defines, the Vivado reduction is a streaming sink process
+  if (!compilerOptions.exploreConfig() && !compilerOptions.emitVivado()) {
     *OS << "#define BS " << K->getNumThreadsReduce() << "\n"
         << "#define PPT " << K->getPixelsPerThreadReduce() << "\n";
   }
-  if (K->getIterationSpace()->isCrop()) {
+  if (K->getIterationSpace()->isCrop() && !compilerOptions.emitVivado()) {
     *OS << "#define USE_OFFSETS\n";
   }
   switch (compilerOptions.getTargetLang()) {
@@ -2234,8 +2595,13 @@ void Rewrite::printReductionFunction(HipaccKernelClass *KC, HipaccKernel *K,
       *OS << "static ";
       break;
   }
-  *OS << "inline " << fun->getReturnType().getAsString() << " "
-      << K->getReduceName() << "(";
+  if (compilerOptions.emitVivado()) {
+    *OS << "struct " << K->getReduceName() << "Kernel {\n  "
+        << fun->getReturnType().getAsString() << " operator()(";
+  } else {
+    *OS << "inline " << fun->getReturnType().getAsString() << " "
+        << K->getReduceName() << "(";
+  }
   // write kernel parameters
   size_t comma = 0;
   for (auto param : fun->params()) {
@@ -2256,6 +2622,8 @@ void Rewrite::printReductionFunction(HipaccKernelClass *KC, HipaccKernel *K,
   // instantiate reduction
   switch (compilerOptions.getTargetLang()) {
     case Language::Vivado:
+      printVivadoReduction(K, fun->getReturnType().getAsString(), OS);
+      break;
     case Language::C99: break;
     case Language::OpenCLACC:
     case Language::OpenCLCPU:
@@ -2884,10 +3252,17 @@ void Rewrite::printKernelArguments(FunctionDecl *D, HipaccKernelClass *KC,
         case Language::C99:
           if (comma++) *OS << ", ";
           if (mem_acc==READ_ONLY) *OS << "const ";
+          if (K->vectorize()) {
+            // images must not alias for vectorization
+            *OS << Acc->getImage()->getTypeStr()
+                << " (* __restrict__ " << Name << ")"
+                << "[" << Acc->getImage()->getStrideStr() << "]";
+            break;
+          }
           *OS << Acc->getImage()->getTypeStr()
               << " " << Name
               << "[" << Acc->getImage()->getSizeYStr() << "]"
-              << "[" << Acc->getImage()->getSizeXStr() << "]";
+              << "[" << Acc->getImage()->getStrideStr() << "]";
           // alternative for Pencil:
           // *OS << "[static const restrict 2048][4096]";
           break;
@@ -3028,6 +3403,13 @@ void Rewrite::printKernelArguments(FunctionDecl *D, HipaccKernelClass *KC,
     }
   }
 
+  if (compilerOptions.emitC99()) {
+    // band of rows processed by one call, see ASTTranslate::initCPU()
+    if (comma++) *OS << ", ";
+    *OS << "int gid_y_start, int gid_y_end";
+    if (K->getFusedImage()) *OS << ", int fused_row_lo";
+  }
+
   if (compilerOptions.emitVivado()) {
     switch (vivadoParam) {
       case Rewrite::VivadoParam::KernelInit:
@@ -35,11 +35,20 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <list>
+#include <map>
+#include <sstream>
+#include <string>
 #include <vector>
 #include <algorithm>
 #if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+#include <atomic>
 #include <functional>
+#include <mutex>
+#include <unordered_map>
 #endif // defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
 
 #include "hipacc_math_functions.hpp"
@@ -83,7 +92,68 @@ enum hipaccMemoryType {
     Linear1D,
     Linear2D,
     Array2D,
-    Surface
+    Surface,
+    Host
+};
+
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+typedef std::atomic<uint32_t> hipacc_refcount_t;
+#else
+typedef uint32_t hipacc_refcount_t;
+#endif // defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+
+
+// Control block shared by all copies of an image: the host copy, which is
+// allocated on first use, and the reference count. Released blocks are kept
+// in a free list, so that creating images does not allocate once blocks have
+// been released.
+class HipaccImageShared {
+    public:
+        char *host;
+        hipacc_refcount_t refcount;
+
+    private:
+        HipaccImageShared *next;
+
+        HipaccImageShared() : host(NULL), refcount(1), next(NULL) {}
+
+        static HipaccImageShared *&free_list() {
+            static HipaccImageShared *list = NULL;
+            return list;
+        }
+        #if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+        static std::mutex &free_list_mutex() {
+            static std::mutex mutex;
+            return mutex;
+        }
+        #endif // defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+
+    public:
+        static HipaccImageShared *acquire() {
+            HipaccImageShared *shared = NULL;
+            {
+                #if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+                std::lock_guard<std::mutex> lock(free_list_mutex());
+                #endif // defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+                shared = free_list();
+                if (shared) free_list() = shared->next;
+            }
+            if (!shared) return new HipaccImageShared();
+            shared->host = NULL;
+            shared->refcount = 1;
+            return shared;
+        }
+
+        static void release(HipaccImageShared *shared) {
+            delete[] shared->host;
+            shared->host = NULL;
+            #if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+            std::lock_guard<std::mutex> lock(free_list_mutex());
+            #endif // defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+            shared->next = free_list();
+            free_list() = shared;
+        }
 };
 
 
@@ -94,8 +164,15 @@ class HipaccImage {
         size_t pixel_size;
         void *mem;
         hipaccMemoryType mem_type;
-        char *host;
-        uint32_t *refcount;
+
+    private:
+        HipaccImageShared *shared;
+
+        void release() {
+            if (--shared->refcount == 0) {
+              HipaccImageShared::release(shared);
+            }
+        }
 
     public:
         HipaccImage(size_t width, size_t height, size_t stride,
@@ -107,11 +184,8 @@ class HipaccImage {
             pixel_size(pixel_size),
             mem(mem),
             mem_type(mem_type),
-            host(new char[width*height*pixel_size]),
-            refcount(new uint32_t(1))
-        {
-            std::fill(host, host + width*height*pixel_size, 0);
-        }
+            shared(HipaccImageShared::acquire())
+        {}
 
         HipaccImage(const HipaccImage &image) :
             width(image.width),
@@ -121,20 +195,37 @@ class HipaccImage {
             pixel_size(image.pixel_size),
             mem(image.mem),
             mem_type(image.mem_type),
-            host(image.host),
-            refcount(image.refcount)
+            shared(image.shared)
         {
-            ++(*refcount);
+            ++shared->refcount;
         }
 
         ~HipaccImage() {
-            --(*refcount);
-            if (host != NULL &&
-                *refcount == 0) {
-              delete refcount;
-              delete[] host;
-              host = NULL;
+            release();
+        }
+
+        HipaccImage &operator=(const HipaccImage &image) {
+            if (shared == image.shared) return *this;
+            release();
+            width = image.width;
+            height = image.height;
+            stride = image.stride;
+            alignment = image.alignment;
+            pixel_size = image.pixel_size;
+            mem = image.mem;
+            mem_type = image.mem_type;
+            shared = image.shared;
+            ++shared->refcount;
+
+            return *this;
+        }
+
+        char *get_host() {
+            if (shared->host == NULL) {
+                shared->host = new char[width*height*pixel_size];
+                std::fill(shared->host, shared->host + width*height*pixel_size, 0);
             }
+            return shared->host;
         }
 
         bool operator==(HipaccImage other) const {
@@ -167,21 +258,33 @@ class HipaccAccessor {
 
 class HipaccContextBase {
     protected:
-        std::list<HipaccImage> imgs;
+        // images indexed by their memory
+        #if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+        std::unordered_map<void *, HipaccImage> imgs;
+        std::mutex imgs_mutex;
+        #else
+        std::map<void *, HipaccImage> imgs;
+        #endif // defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
 
         HipaccContextBase() {};
         HipaccContextBase(HipaccContextBase const &);
         void operator=(HipaccContextBase const &);
 
     public:
-        void add_image(HipaccImage &img) { imgs.push_back(img); }
+        void add_image(HipaccImage &img) {
+            #if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+            std::lock_guard<std::mutex> lock(imgs_mutex);
+            #endif // defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+            // memory has to be released before it is registered again
+            bool inserted = imgs.insert(std::make_pair(img.mem, img)).second;
+            assert(inserted && "image memory registered twice");
+            (void)inserted;
+        }
         void del_image(HipaccImage &img) {
-            for (std::list<HipaccImage>::iterator i=imgs.begin(); i!=imgs.end(); ++i) {
-                if (*i == img) {
-                    imgs.erase(i);
-                    return;
-                }
-            }
+            #if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+            std::lock_guard<std::mutex> lock(imgs_mutex);
+            #endif // defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+            imgs.erase(img.mem);
         }
 };
 
@@ -218,6 +321,245 @@ typedef struct hipacc_smem_info {
 } hipacc_smem_info;
 
 
+// Per-kernel launch statistics: the generated host code records every kernel
+// launch via hipaccRecordKernel(); statistics can be exported as JSON or CSV
+// using hipaccWriteKernelStatistics() or automatically at program exit by
+// setting HIPACC_KERNEL_STATS to the name of the output file
+#define HIPACC_STATS_BUCKETS 32
+
+class HipaccKernelStatistics {
+    public:
+        size_t launches;
+        float total_time, min_time, max_time;
+        uint64_t bytes_read, bytes_written;
+        uint64_t pixels;
+        // launch latency histogram: bucket i counts launches taking less than
+        // 2^i microseconds (and at least 2^(i-1) microseconds)
+        size_t histogram[HIPACC_STATS_BUCKETS];
+
+        HipaccKernelStatistics() :
+            launches(0),
+            total_time(0.0f),
+            min_time(0.0f),
+            max_time(0.0f),
+            bytes_read(0),
+            bytes_written(0),
+            pixels(0) {
+            memset(histogram, 0, sizeof(histogram));
+        }
+
+        void add(float time, size_t read, size_t written, size_t num_pixels) {
+            if (launches == 0 || time < min_time) min_time = time;
+            if (launches == 0 || time > max_time) max_time = time;
+            ++launches;
+            total_time += time;
+            bytes_read += read;
+            bytes_written += written;
+            pixels += num_pixels;
+
+            size_t bucket = 0;
+            for (double us = time * 1.0e3; us >= 1.0 &&
+                 bucket < HIPACC_STATS_BUCKETS-1; us /= 2.0) ++bucket;
+            ++histogram[bucket];
+        }
+
+        float avg_time() const { return launches ? total_time / launches : 0.0f; }
+        // achieved bandwidth in GB/s and throughput in pixels/s
+        double bandwidth() const {
+            return total_time > 0.0f ?
+                (double)(bytes_read + bytes_written) / (total_time * 1.0e-3) * 1.0e-9 : 0.0;
+        }
+        double throughput() const {
+            return total_time > 0.0f ? (double)pixels / (total_time * 1.0e-3) : 0.0;
+        }
+};
+
+
+class HipaccStatistics {
+    private:
+        std::map<std::string, HipaccKernelStatistics> kernels;
+        #if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+        std::mutex kernels_mutex;
+        #endif // defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+
+        HipaccStatistics() {}
+        HipaccStatistics(HipaccStatistics const &);
+        void operator=(HipaccStatistics const &);
+
+        ~HipaccStatistics() {
+            const char *file = getenv("HIPACC_KERNEL_STATS");
+            if (file && !kernels.empty()) write(file);
+        }
+
+    public:
+        static HipaccStatistics &getInstance() {
+            static HipaccStatistics instance;
+
+            return instance;
+        }
+
+        void record(const std::string &name, float time, size_t read,
+                    size_t written, size_t pixels) {
+            #if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+            std::lock_guard<std::mutex> lock(kernels_mutex);
+            #endif // defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+            kernels[name].add(time, read, written, pixels);
+        }
+
+        void reset() {
+            #if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+            std::lock_guard<std::mutex> lock(kernels_mutex);
+            #endif // defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+            kernels.clear();
+        }
+
+        const HipaccKernelStatistics *get(const std::string &name) {
+            #if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+            std::lock_guard<std::mutex> lock(kernels_mutex);
+            #endif // defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+            std::map<std::string, HipaccKernelStatistics>::const_iterator
+                it = kernels.find(name);
+            return it == kernels.end() ? NULL : &it->second;
+        }
+
+        void write_json(std::ostream &os) {
+            #if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+            std::lock_guard<std::mutex> lock(kernels_mutex);
+            #endif // defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+            os << "{\n  \"kernels\": [";
+            for (std::map<std::string, HipaccKernelStatistics>::const_iterator
+                 it = kernels.begin(); it != kernels.end(); ++it) {
+                const HipaccKernelStatistics &ks = it->second;
+                os << (it == kernels.begin() ? "\n" : ",\n")
+                   << "    {\"name\": \"" << it->first << "\""
+                   << ", \"launches\": " << ks.launches
+                   << ", \"total_ms\": " << ks.total_time
+                   << ", \"min_ms\": " << ks.min_time
+                   << ", \"avg_ms\": " << ks.avg_time()
+                   << ", \"max_ms\": " << ks.max_time
+                   << ", \"bytes_read\": " << ks.bytes_read
+                   << ", \"bytes_written\": " << ks.bytes_written
+                   << ", \"gb_per_s\": " << ks.bandwidth()
+                   << ", \"pixels_per_s\": " << ks.throughput()
+                   << ", \"histogram_us_log2\": [";
+                for (size_t i=0; i<HIPACC_STATS_BUCKETS; ++i) {
+                    os << (i ? ", " : "") << ks.histogram[i];
+                }
+                os << "]}";
+            }
+            os << "\n  ]\n}\n";
+        }
+
+        void write_csv(std::ostream &os) {
+            #if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+            std::lock_guard<std::mutex> lock(kernels_mutex);
+            #endif // defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+            os << "name,launches,total_ms,min_ms,avg_ms,max_ms,bytes_read,"
+               << "bytes_written,gb_per_s,pixels_per_s";
+            for (size_t i=0; i<HIPACC_STATS_BUCKETS; ++i) {
+                os << ",hist_lt_2^" << i << "us";
+            }
+            os << "\n";
+            for (std::map<std::string, HipaccKernelStatistics>::const_iterator
+                 it = kernels.begin(); it != kernels.end(); ++it) {
+                const HipaccKernelStatistics &ks = it->second;
+                os << it->first << "," << ks.launches << "," << ks.total_time
+                   << "," << ks.min_time << "," << ks.avg_time() << ","
+                   << ks.max_time << "," << ks.bytes_read << ","
+                   << ks.bytes_written << "," << ks.bandwidth() << ","
+                   << ks.throughput();
+                for (size_t i=0; i<HIPACC_STATS_BUCKETS; ++i) {
+                    os << "," << ks.histogram[i];
+                }
+                os << "\n";
+            }
+        }
+
+        // export as CSV if the file name ends in .csv, as JSON otherwise
+        bool write(const std::string &file) {
+            std::ofstream os(file.c_str());
+            if (!os) return false;
+            if (file.size() >= 4 && file.compare(file.size()-4, 4, ".csv") == 0) {
+                write_csv(os);
+            } else {
+                write_json(os);
+            }
+            return os.good();
+        }
+};
+
+
+size_t hipaccAccessorBytes(const HipaccAccessor &Acc);
+void hipaccRecordKernel(const std::string &kernel_name,
+        const hipacc_launch_info &info, size_t bytes_read, size_t bytes_written);
+void hipaccResetKernelStatistics();
+bool hipaccWriteKernelStatistics(const std::string &file);
+
+#ifndef EXCLUDE_IMPL
+// number of bytes covered by an accessor
+size_t hipaccAccessorBytes(const HipaccAccessor &Acc) {
+    return Acc.width * Acc.height * Acc.img.pixel_size;
+}
+
+// record the last kernel launch (timing taken from last_gpu_timing)
+void hipaccRecordKernel(const std::string &kernel_name,
+        const hipacc_launch_info &info, size_t bytes_read, size_t bytes_written) {
+    HipaccStatistics::getInstance().record(kernel_name, last_gpu_timing,
+            bytes_read, bytes_written, (size_t)info.is_width * info.is_height);
+}
+
+void hipaccResetKernelStatistics() {
+    HipaccStatistics::getInstance().reset();
+}
+
+bool hipaccWriteKernelStatistics(const std::string &file) {
+    return HipaccStatistics::getInstance().write(file);
+}
+#endif // EXCLUDE_IMPL
+
+
+// Tuning database: configuration exploration records the fastest
+// configuration per kernel, target, and iteration space size; hipacc selects
+// the kernel configuration from the database when compiling with -tuning-db.
+// Each line holds one entry:
+//   <kernel hash> <target> <width>x<height> <time in ms> <key>=<value> ...
+// The database given at compile time can be overridden by HIPACC_TUNING_DB.
+bool hipaccUpdateTuningDatabase(std::string db, const std::string &kernel_key,
+        const hipacc_launch_info &info, float time, const std::string &config);
+
+#ifndef EXCLUDE_IMPL
+// add the configuration to the database unless a faster one is stored already
+bool hipaccUpdateTuningDatabase(std::string db, const std::string &kernel_key,
+        const hipacc_launch_info &info, float time, const std::string &config) {
+    if (const char *env = getenv("HIPACC_TUNING_DB")) db = env;
+    if (db.empty()) return true;
+
+    std::stringstream key;
+    key << kernel_key << " " << info.is_width << "x" << info.is_height << " ";
+
+    std::vector<std::string> lines;
+    std::string line;
+    std::ifstream is(db.c_str());
+    while (std::getline(is, line)) {
+        if (line.compare(0, key.str().size(), key.str()) == 0) {
+            if (atof(line.c_str() + key.str().size()) <= time) return true;
+            continue;
+        }
+        lines.push_back(line);
+    }
+    is.close();
+
+    std::stringstream entry;
+    entry << key.str() << time << " " << config;
+    lines.push_back(entry.str());
+
+    std::ofstream os(db.c_str());
+    for (size_t i=0; i<lines.size(); ++i) os << lines[i] << "\n";
+    return os.good();
+}
+#endif // EXCLUDE_IMPL
+
+
 
 #ifndef EXCLUDE_IMPL
 unsigned int nextPow2(unsigned int x) {
@@ -420,22 +420,13 @@ void hipaccDumpBinary(cl_program program, cl_device_id device) {
 }
 
 
-// Load OpenCL source file, build program, and create kernel
-cl_kernel hipaccBuildProgramAndKernel(std::string file_name, std::string kernel_name, bool print_progress=true, bool dump_binary=false, bool print_log=false, std::string build_options=std::string(), std::string build_includes=std::string()) {
+// Build program from OpenCL source string and create kernel
+cl_kernel hipaccBuildProgramAndKernelFromSource(std::string clString, std::string kernel_name, bool print_progress=true, bool dump_binary=false, bool print_log=false, std::string build_options=std::string(), std::string build_includes=std::string()) {
     cl_int err = CL_SUCCESS;
     cl_program program;
     cl_kernel kernel;
     HipaccContext &Ctx = HipaccContext::getInstance();
 
-    std::ifstream srcFile(file_name.c_str());
-    if (!srcFile.is_open()) {
-        std::cerr << "ERROR: Can't open OpenCL source file '" << file_name << "'!" << std::endl;
-        exit(EXIT_FAILURE);
-    }
-
-    std::string clString(std::istreambuf_iterator<char>(srcFile),
-            (std::istreambuf_iterator<char>()));
-
     const size_t length = clString.length();
     const char *c_str = clString.c_str();
 
@@ -515,12 +506,29 @@ cl_kernel hipaccBuildProgramAndKernel(std::string file_name, std::string kernel_
 }
 
 
+// Load OpenCL source file, build program, and create kernel
+cl_kernel hipaccBuildProgramAndKernel(std::string file_name, std::string kernel_name, bool print_progress=true, bool dump_binary=false, bool print_log=false, std::string build_options=std::string(), std::string build_includes=std::string()) {
+    std::ifstream srcFile(file_name.c_str());
+    if (!srcFile.is_open()) {
+        std::cerr << "ERROR: Can't open OpenCL source file '" << file_name << "'!" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    std::string clString(std::istreambuf_iterator<char>(srcFile),
+            (std::istreambuf_iterator<char>()));
+
+    return hipaccBuildProgramAndKernelFromSource(clString, kernel_name,
+            print_progress, dump_binary, print_log, build_options,
+            build_includes);
+}
+
+
 template<typename T>
 HipaccImage createImage(T *host_mem, void *mem, size_t width, size_t height, size_t stride, size_t alignment, hipaccMemoryType mem_type=Global) {
     HipaccImage img = HipaccImage(width, height, stride, alignment, sizeof(T), mem, mem_type);
     HipaccContext &Ctx = HipaccContext::getInstance();
     Ctx.add_image(img);
-    hipaccWriteMemory(img, host_mem ? host_mem : (T*)img.host);
+    hipaccWriteMemory(img, host_mem ? host_mem : (T*)img.get_host());
     return img;
 }
 
@@ -659,8 +667,8 @@ void hipaccWriteMemory(HipaccImage &img, T *host_mem, int num_device=0) {
     size_t height = img.height;
     size_t stride = img.stride;
 
-    if ((char *)host_mem != img.host)
-        std::copy(host_mem, host_mem + width*height, (T*)img.host);
+    if ((char *)host_mem != img.get_host())
+        std::copy(host_mem, host_mem + width*height, (T*)img.get_host());
 
     HipaccContext &Ctx = HipaccContext::getInstance();
     cl_int err = CL_SUCCESS;
@@ -701,7 +709,7 @@ T *hipaccReadMemory(HipaccImage &img, int num_device=0) {
         const size_t row_pitch = img.width*sizeof(T);
         const size_t slice_pitch = 0;
 
-        err = clEnqueueReadImage(Ctx.get_command_queues()[num_device], (cl_mem)img.mem, CL_FALSE, origin, region, row_pitch, slice_pitch, (T*)img.host, 0, NULL, NULL);
+        err = clEnqueueReadImage(Ctx.get_command_queues()[num_device], (cl_mem)img.mem, CL_FALSE, origin, region, row_pitch, slice_pitch, (T*)img.get_host(), 0, NULL, NULL);
         err |= clFinish(Ctx.get_command_queues()[num_device]);
         checkErr(err, "clEnqueueReadImage()");
     } else {
@@ -711,16 +719,16 @@ T *hipaccReadMemory(HipaccImage &img, int num_device=0) {
 
         if (stride > width) {
             for (size_t i=0; i<height; ++i) {
-                err |= clEnqueueReadBuffer(Ctx.get_command_queues()[num_device], (cl_mem)img.mem, CL_FALSE, i*sizeof(T)*stride, sizeof(T)*width, &((T*)img.host)[i*width], 0, NULL, NULL);
+                err |= clEnqueueReadBuffer(Ctx.get_command_queues()[num_device], (cl_mem)img.mem, CL_FALSE, i*sizeof(T)*stride, sizeof(T)*width, &((T*)img.get_host())[i*width], 0, NULL, NULL);
             }
         } else {
-            err = clEnqueueReadBuffer(Ctx.get_command_queues()[num_device], (cl_mem)img.mem, CL_FALSE, 0, sizeof(T)*width*height, (T*)img.host, 0, NULL, NULL);
+            err = clEnqueueReadBuffer(Ctx.get_command_queues()[num_device], (cl_mem)img.mem, CL_FALSE, 0, sizeof(T)*width*height, (T*)img.get_host(), 0, NULL, NULL);
         }
         err |= clFinish(Ctx.get_command_queues()[num_device]);
         checkErr(err, "clEnqueueReadBuffer()");
     }
 
-    return (T*)img.host;
+    return (T*)img.get_host();
 }
 
 
@@ -1182,7 +1190,9 @@ void hipaccKernelExploration(std::string filename, std::string kernel,
         std::vector<std::pair<size_t, void *> > args,
         std::vector<hipacc_smem_info> smems, hipacc_launch_info &info, int
         warp_size, int max_threads_per_block, int max_threads_for_kernel, int
-        max_smem_per_block, int heu_tx, int heu_ty) {
+        max_smem_per_block, int heu_tx, int heu_ty,
+        std::string tuning_db="", std::string tuning_key="", std::string
+        tuning_config="") {
     int opt_tx=warp_size, opt_ty=1;
     float opt_time = FLT_MAX;
 
@@ -1272,6 +1282,16 @@ void hipaccKernelExploration(std::string filename, std::string kernel,
     std::cerr << "<HIPACC:> Best configurations for kernel '" << kernel << "': "
               << opt_tx*opt_ty << " (" << opt_tx << "x" << opt_ty << "): "
               << opt_time << " ms" << std::endl;
+
+    if (!tuning_key.empty()) {
+        std::stringstream config;
+        config << tuning_config << " bsx=" << opt_tx << " bsy=" << opt_ty;
+        if (!hipaccUpdateTuningDatabase(tuning_db, tuning_key, info, opt_time,
+                                        config.str())) {
+            std::cerr << "<HIPACC:> Could not update tuning database '"
+                      << tuning_db << "'" << std::endl;
+        }
+    }
 }
 
 
@@ -1294,5 +1314,119 @@ HipaccImage hipaccCreatePyramidImage(HipaccImage &base, size_t width, size_t hei
   }
 }
 
+
+//
+// INTEGRAL IMAGE
+//
+
+#define HIPACC_SCAN_BS 256
+
+// OpenCL type names for the element types of integral images
+template<typename T> struct hipacc_cl_type_name;
+#define HIPACC_CL_TYPE_NAME(T, NAME) \
+template <> struct hipacc_cl_type_name<T> { \
+    static const char *name() { return NAME; } \
+};
+HIPACC_CL_TYPE_NAME(char,               "char")
+HIPACC_CL_TYPE_NAME(unsigned char,      "uchar")
+HIPACC_CL_TYPE_NAME(short,              "short")
+HIPACC_CL_TYPE_NAME(unsigned short,     "ushort")
+HIPACC_CL_TYPE_NAME(int,                "int")
+HIPACC_CL_TYPE_NAME(unsigned int,       "uint")
+HIPACC_CL_TYPE_NAME(long,               "long")
+HIPACC_CL_TYPE_NAME(unsigned long,      "ulong")
+HIPACC_CL_TYPE_NAME(long long,          "long")
+HIPACC_CL_TYPE_NAME(unsigned long long, "ulong")
+HIPACC_CL_TYPE_NAME(float,              "float")
+HIPACC_CL_TYPE_NAME(double,             "double")
+#undef HIPACC_CL_TYPE_NAME
+
+// Row scan: one work-group per row, chunks of get_local_size(0) pixels are
+// scanned in local memory and offset by the sum of all previous chunks.
+// Column scan: one work-item per column.
+static const char *hipacc_integral_image_src =
+"#ifdef cl_khr_fp64\n"
+"#pragma OPENCL EXTENSION cl_khr_fp64 : enable\n"
+"#endif\n"
+"__kernel void hipaccIntegralRows(__global const DATA_TYPE *in, __global SUM_TYPE *out,\n"
+"        const int width, const int in_stride, const int out_stride) {\n"
+"    __local SUM_TYPE smem[SCAN_BS];\n"
+"    const int lid = get_local_id(0);\n"
+"    __global const DATA_TYPE *row = in + get_group_id(1)*in_stride;\n"
+"    __global SUM_TYPE *out_row = out + (get_group_id(1)+1)*out_stride;\n"
+"    SUM_TYPE carry = 0;\n"
+"    if (lid == 0) out_row[0] = 0;\n"
+"    for (int x0=0; x0<width; x0+=SCAN_BS) {\n"
+"        int x = x0 + lid;\n"
+"        smem[lid] = x < width ? (SUM_TYPE)row[x] : (SUM_TYPE)0;\n"
+"        barrier(CLK_LOCAL_MEM_FENCE);\n"
+"        for (int offset=1; offset<SCAN_BS; offset*=2) {\n"
+"            SUM_TYPE val = lid >= offset ? smem[lid-offset] : (SUM_TYPE)0;\n"
+"            barrier(CLK_LOCAL_MEM_FENCE);\n"
+"            smem[lid] += val;\n"
+"            barrier(CLK_LOCAL_MEM_FENCE);\n"
+"        }\n"
+"        if (x < width) out_row[x+1] = carry + smem[lid];\n"
+"        carry += smem[SCAN_BS-1];\n"
+"        barrier(CLK_LOCAL_MEM_FENCE);\n"
+"    }\n"
+"}\n"
+"__kernel void hipaccIntegralCols(__global SUM_TYPE *out, const int width,\n"
+"        const int height, const int stride) {\n"
+"    const int x = get_global_id(0);\n"
+"    if (x >= width) return;\n"
+"    SUM_TYPE sum = 0;\n"
+"    out[x] = 0;\n"
+"    for (int y=1; y<height; ++y) {\n"
+"        sum += out[y*stride + x];\n"
+"        out[y*stride + x] = sum;\n"
+"    }\n"
+"}\n";
+
+
+// Integral image (summed-area table): out is one pixel larger than in and
+// out(x, y) holds the sum of all pixels of in left of x and above y
+template<typename T, typename S>
+void hipaccIntegralImage(HipaccImage &in, HipaccImage &out) {
+    assert(out.width == in.width + 1 && out.height == in.height + 1 &&
+           "Integral image has to be one pixel larger than the input image!");
+    assert(in.mem_type == Global && out.mem_type == Global &&
+           "Integral images require buffer memory!");
+
+    // build the kernels only once per type combination
+    static cl_kernel rows = NULL, cols = NULL;
+    if (rows == NULL) {
+        std::stringstream options;
+        options << "-DDATA_TYPE=" << hipacc_cl_type_name<T>::name()
+                << " -DSUM_TYPE=" << hipacc_cl_type_name<S>::name()
+                << " -DSCAN_BS=" << HIPACC_SCAN_BS;
+        rows = hipaccBuildProgramAndKernelFromSource(hipacc_integral_image_src,
+                "hipaccIntegralRows", false, false, false, options.str());
+        cols = hipaccBuildProgramAndKernelFromSource(hipacc_integral_image_src,
+                "hipaccIntegralCols", false, false, false, options.str());
+    }
+
+    int in_width = in.width, in_stride = in.stride;
+    int out_width = out.width, out_height = out.height, out_stride = out.stride;
+    size_t local_work_size[2] = { HIPACC_SCAN_BS, 1 };
+    size_t global_work_size[2] = { HIPACC_SCAN_BS, (size_t)in.height };
+
+    hipaccSetKernelArg(rows, 0, sizeof(cl_mem), &in.mem);
+    hipaccSetKernelArg(rows, 1, sizeof(cl_mem), &out.mem);
+    hipaccSetKernelArg(rows, 2, sizeof(int), &in_width);
+    hipaccSetKernelArg(rows, 3, sizeof(int), &in_stride);
+    hipaccSetKernelArg(rows, 4, sizeof(int), &out_stride);
+    hipaccEnqueueKernel(rows, global_work_size, local_work_size, false);
+
+    global_work_size[0] = (out.width + HIPACC_SCAN_BS-1) / HIPACC_SCAN_BS *
+        HIPACC_SCAN_BS;
+    global_work_size[1] = 1;
+    hipaccSetKernelArg(cols, 0, sizeof(cl_mem), &out.mem);
+    hipaccSetKernelArg(cols, 1, sizeof(int), &out_width);
+    hipaccSetKernelArg(cols, 2, sizeof(int), &out_height);
+    hipaccSetKernelArg(cols, 3, sizeof(int), &out_stride);
+    hipaccEnqueueKernel(cols, global_work_size, local_work_size, false);
+}
+
 #endif  // __HIPACC_CL_HPP__
 
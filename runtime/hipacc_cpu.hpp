@@ -30,21 +30,277 @@
 #include <stddef.h>
 #include <stdlib.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <condition_variable>
 #include <cstring>
+#include <functional>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
 
 #include "hipacc_base.hpp"
 
 class HipaccContext : public HipaccContextBase {
+    private:
+        static HipaccContext *&threadContext() {
+            static thread_local HipaccContext *context = NULL;
+            return context;
+        }
+
     public:
+        HipaccContext() {}
+
+        // context selected by the calling thread, the process-wide context
+        // otherwise
         static HipaccContext &getInstance() {
+            if (HipaccContext *context = threadContext()) return *context;
+
             static HipaccContext instance;
 
             return instance;
         }
+        static void setThreadContext(HipaccContext *context) {
+            threadContext() = context;
+        }
+};
+
+
+// Select the context used for images of the calling thread, e.g. one context
+// per pipeline; NULL selects the process-wide context
+void hipaccSetContext(HipaccContext *context) {
+    HipaccContext::setThreadContext(context);
+}
+
+
+// Scheduling of row bands to worker threads:
+// Static:  one contiguous band per thread, deterministic assignment
+// Dynamic: bands of 'chunk size' rows are fetched from a shared counter by
+//          idle threads
+enum class hipaccSchedule { Static, Dynamic };
+
+class HipaccThreadPool {
+    private:
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable cond_work, cond_done;
+        std::function<void(size_t)> job;
+        std::mutex run_mutex;
+        size_t generation, num_busy;
+        bool shutdown;
+        hipaccSchedule schedule;
+        int chunk_size;
+
+        static bool &inParallelRegion() {
+            static thread_local bool in_parallel = false;
+            return in_parallel;
+        }
+
+        void worker(size_t tid, size_t seen) {
+            while (true) {
+                std::function<void(size_t)> cur_job;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cond_work.wait(lock, [&] {
+                        return shutdown || generation != seen;
+                    });
+                    if (shutdown) return;
+                    seen = generation;
+                    cur_job = job;
+                }
+                inParallelRegion() = true;
+                cur_job(tid);
+                inParallelRegion() = false;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (--num_busy == 0) cond_done.notify_one();
+                }
+            }
+        }
+
+        void stopWorkers() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                shutdown = true;
+            }
+            cond_work.notify_all();
+            for (auto &t : workers) t.join();
+            workers.clear();
+            shutdown = false;
+        }
+
+        void startWorkers(size_t num_threads) {
+            // the calling thread acts as thread 0
+            for (size_t tid=1; tid<num_threads; ++tid) {
+                workers.emplace_back(&HipaccThreadPool::worker, this, tid,
+                                     generation);
+            }
+        }
+
+        HipaccThreadPool() :
+            generation(0), num_busy(0), shutdown(false),
+            schedule(hipaccSchedule::Static), chunk_size(0) {
+            size_t num_threads = std::thread::hardware_concurrency();
+            if (const char *env = getenv("HIPACC_NUM_THREADS")) {
+                num_threads = atoi(env);
+            }
+            if (const char *env = getenv("HIPACC_SCHEDULE")) {
+                std::string str(env);
+                if (str.compare(0, 7, "dynamic") == 0) {
+                    schedule = hipaccSchedule::Dynamic;
+                    size_t pos = str.find(',');
+                    if (pos != std::string::npos) {
+                        chunk_size = atoi(str.c_str() + pos + 1);
+                    }
+                }
+            }
+            startWorkers(std::max<size_t>(num_threads, 1));
+        }
+
+    public:
+        static HipaccThreadPool &getInstance() {
+            static HipaccThreadPool instance;
+
+            return instance;
+        }
+
+        ~HipaccThreadPool() { stopWorkers(); }
+
+        size_t getNumThreads() const { return workers.size() + 1; }
+        void setNumThreads(size_t num_threads) {
+            if (num_threads == 0) num_threads = std::thread::hardware_concurrency();
+            num_threads = std::max<size_t>(num_threads, 1);
+            if (num_threads == getNumThreads()) return;
+            stopWorkers();
+            startWorkers(num_threads);
+        }
+
+        hipaccSchedule getSchedule() const { return schedule; }
+        int getChunkSize() const { return chunk_size; }
+        void setSchedule(hipaccSchedule sched, int chunk) {
+            schedule = sched;
+            chunk_size = chunk;
+        }
+
+        // run func(tid) on all threads of the pool; nested calls from within
+        // a parallel region and calls while the pool is used by another host
+        // thread are executed by the calling thread only
+        void run(const std::function<void(size_t)> &func) {
+            std::unique_lock<std::mutex> run_lock(run_mutex, std::try_to_lock);
+            if (workers.empty() || inParallelRegion() || !run_lock.owns_lock()) {
+                for (size_t tid=0; tid<getNumThreads(); ++tid) func(tid);
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                job = func;
+                num_busy = workers.size();
+                ++generation;
+            }
+            cond_work.notify_all();
+            inParallelRegion() = true;
+            func(0);
+            inParallelRegion() = false;
+            std::unique_lock<std::mutex> lock(mutex);
+            cond_done.wait(lock, [&] { return num_busy == 0; });
+        }
 };
 
+
+// Number of threads used for kernel execution, 0 selects the number of cores
+void hipaccSetNumThreads(size_t num_threads) {
+    HipaccThreadPool::getInstance().setNumThreads(num_threads);
+}
+
+size_t hipaccGetNumThreads() {
+    return HipaccThreadPool::getInstance().getNumThreads();
+}
+
+// Schedule used for kernel execution, a chunk size of 0 selects a default
+void hipaccSetSchedule(hipaccSchedule schedule, int chunk_size=0) {
+    HipaccThreadPool::getInstance().setSchedule(schedule, chunk_size);
+}
+
+
+// Number of bands the range [lower, upper) is split into when using at most
+// max_threads threads, 0 selects all threads of the pool
+int hipaccGetNumChunks(int lower, int upper, int max_threads=0) {
+    HipaccThreadPool &pool = HipaccThreadPool::getInstance();
+    int size = upper - lower;
+    int num_threads = (int)pool.getNumThreads();
+    if (max_threads > 0) num_threads = std::min(num_threads, max_threads);
+
+    if (size <= 0) return 0;
+    if (pool.getSchedule() == hipaccSchedule::Static || num_threads == 1) {
+        return std::min(size, num_threads);
+    }
+
+    int chunk_size = pool.getChunkSize();
+    if (chunk_size <= 0) {
+        // several bands per thread to balance the load
+        chunk_size = std::max(1, size / (8*num_threads));
+    }
+    return (size + chunk_size - 1) / chunk_size;
+}
+
+
+// Execute func(chunk, lower_chunk, upper_chunk) for all bands of the range
+// [lower, upper) in parallel using at most max_threads threads. The band
+// boundaries depend only on the range, the number of threads, and the
+// schedule.
+template<typename F>
+void hipaccParallelForChunks(int lower, int upper, F func, int max_threads=0) {
+    HipaccThreadPool &pool = HipaccThreadPool::getInstance();
+    int num_chunks = hipaccGetNumChunks(lower, upper, max_threads);
+    long size = upper - lower;
+
+    auto chunk_lower = [&] (int chunk) {
+        return lower + (int)((chunk * size) / num_chunks);
+    };
+
+    if (num_chunks == 0) return;
+    if (num_chunks == 1) {
+        func(0, lower, upper);
+        return;
+    }
+
+    if (pool.getSchedule() == hipaccSchedule::Static) {
+        pool.run([&] (size_t tid) {
+            int chunk = (int)tid;
+            if (chunk < num_chunks) {
+                func(chunk, chunk_lower(chunk), chunk_lower(chunk+1));
+            }
+        });
+    } else {
+        std::atomic<int> next_chunk(0);
+        pool.run([&] (size_t tid) {
+            if (max_threads > 0 && (int)tid >= max_threads) return;
+            int chunk;
+            while ((chunk = next_chunk++) < num_chunks) {
+                func(chunk, chunk_lower(chunk), chunk_lower(chunk+1));
+            }
+        });
+    }
+}
+
+
+// Execute func(lower_band, upper_band) for bands of the range [lower, upper)
+template<typename F>
+void hipaccParallelFor(int lower, int upper, F func, int max_threads=0) {
+    hipaccParallelForChunks(lower, upper, [&] (int, int l, int u) {
+        func(l, u);
+    }, max_threads);
+}
+
 long start_time = 0L;
 long end_time = 0L;
 
@@ -61,12 +317,100 @@ void hipaccStopTiming() {
 }
 
 
+// Pool of aligned image buffers: released buffers are kept and reused for
+// images of the same size, so that pipelines processing a sequence of frames
+// do not allocate memory after the first frame
+class HipaccMemoryPool {
+    private:
+        // (size, alignment) -> unused buffers
+        std::map<std::pair<size_t, size_t>, std::vector<void *>> buffers;
+        std::mutex mutex;
+
+        HipaccMemoryPool() {}
+        HipaccMemoryPool(HipaccMemoryPool const &);
+        void operator=(HipaccMemoryPool const &);
+
+        static size_t getAlignment(size_t size, size_t alignment) {
+            // at least cache line alignment, huge page alignment for large
+            // buffers; posix_memalign requires a power of two
+            size_t align = 64;
+            while (align < alignment) align <<= 1;
+            if (size >= HUGE_PAGE_SIZE && align < HUGE_PAGE_SIZE) align = HUGE_PAGE_SIZE;
+            return align;
+        }
+
+    public:
+        static const size_t HUGE_PAGE_SIZE = 2*1024*1024;
+
+        static HipaccMemoryPool &getInstance() {
+            static HipaccMemoryPool instance;
+
+            return instance;
+        }
+
+        ~HipaccMemoryPool() {
+            clear();
+        }
+
+        void *allocate(size_t size, size_t alignment) {
+            alignment = getAlignment(size, alignment);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                std::vector<void *> &free_list = buffers[std::make_pair(size, alignment)];
+                if (!free_list.empty()) {
+                    void *mem = free_list.back();
+                    free_list.pop_back();
+                    return mem;
+                }
+            }
+
+            void *mem = NULL;
+            if (posix_memalign(&mem, alignment, size) != 0) {
+                std::cerr << "ERROR: Allocation of " << size << " bytes failed"
+                          << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            #if defined(__linux__) && defined(MADV_HUGEPAGE)
+            if (alignment >= HUGE_PAGE_SIZE) madvise(mem, size, MADV_HUGEPAGE);
+            #endif
+
+            return mem;
+        }
+
+        void release(void *mem, size_t size, size_t alignment) {
+            alignment = getAlignment(size, alignment);
+            std::lock_guard<std::mutex> lock(mutex);
+            buffers[std::make_pair(size, alignment)].push_back(mem);
+        }
+
+        // free all unused buffers
+        void clear() {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto &free_list : buffers) {
+                for (auto mem : free_list.second) free(mem);
+            }
+            buffers.clear();
+        }
+};
+
+
+// Free image buffers kept for reuse
+void hipaccClearMemoryPool() {
+    HipaccMemoryPool::getInstance().clear();
+}
+
+
 template<typename T>
 HipaccImage createImage(T *host_mem, void *mem, size_t width, size_t height, size_t stride, size_t alignment, hipaccMemoryType mem_type=Global) {
     HipaccImage img = HipaccImage(width, height, stride, alignment, sizeof(T), mem, mem_type);
     HipaccContext &Ctx = HipaccContext::getInstance();
     Ctx.add_image(img);
-    hipaccWriteMemory(img, host_mem ? host_mem : (T*)img.host);
+    if (host_mem) {
+        hipaccWriteMemory(img, host_mem);
+    } else {
+        // buffers from the pool may contain data of previous images
+        std::memset(mem, 0, sizeof(T)*stride*height);
+    }
 
     return img;
 }
@@ -79,39 +423,52 @@ HipaccImage hipaccCreateMemory(T *host_mem, size_t width, size_t height, size_t
     alignment = (int)ceilf((float)alignment/sizeof(T)) * sizeof(T);
     int stride = (int)ceilf((float)(width)/(alignment/sizeof(T))) * (alignment/sizeof(T));
 
-    T *mem = new T[stride*height];
-    return createImage(host_mem, (void *)mem, width, height, stride, alignment);
+    void *mem = HipaccMemoryPool::getInstance().allocate(sizeof(T)*stride*height, alignment);
+    return createImage(host_mem, mem, width, height, stride, alignment);
 }
 
 
 // Allocate memory without any alignment considerations
 template<typename T>
 HipaccImage hipaccCreateMemory(T *host_mem, size_t width, size_t height) {
-    T *mem = new T[width*height];
-    return createImage(host_mem, (void *)mem, width, height, width, 0);
+    void *mem = HipaccMemoryPool::getInstance().allocate(sizeof(T)*width*height, 0);
+    return createImage(host_mem, mem, width, height, width, 0);
 }
 
 
-// Release memory
+// Use host memory for the image without copies: host_mem has to stay valid
+// until the image is released, stride is given in pixels
+template<typename T>
+HipaccImage hipaccMapMemory(T *host_mem, size_t width, size_t height, size_t stride) {
+    HipaccImage img = HipaccImage(width, height, stride, 0, sizeof(T), (void *)host_mem, Host);
+    HipaccContext &Ctx = HipaccContext::getInstance();
+    Ctx.add_image(img);
+
+    return img;
+}
+
+
+// Release memory: the image is unregistered before its buffer is returned to
+// the pool, where it can be handed out for a new image
 void hipaccReleaseMemory(HipaccImage &img) {
     HipaccContext &Ctx = HipaccContext::getInstance();
-    delete[] img.mem;
     Ctx.del_image(img);
+    if (img.mem_type != Host) {
+        HipaccMemoryPool::getInstance().release(img.mem,
+                img.pixel_size*img.stride*img.height, img.alignment);
+    }
 }
 
 
 // Write to memory
 template<typename T>
 void hipaccWriteMemory(HipaccImage &img, T *host_mem) {
-    if (host_mem == NULL) return;
+    if (host_mem == NULL || host_mem == img.mem) return;
 
     size_t width  = img.width;
     size_t height = img.height;
     size_t stride = img.stride;
 
-    if ((char *)host_mem != img.host)
-        std::copy(host_mem, host_mem + width*height, (T*)img.host);
-
     if (stride > width) {
         for (size_t i=0; i<height; ++i) {
             std::memcpy(&((T*)img.mem)[i*stride], &host_mem[i*width], sizeof(T)*width);
@@ -122,22 +479,26 @@ void hipaccWriteMemory(HipaccImage &img, T *host_mem) {
 }
 
 
-// Read from memory
+// Read from memory: data is copied to the host copy of the image, which is
+// allocated on first read
 template<typename T>
 T *hipaccReadMemory(HipaccImage &img) {
+    // host memory used by the image is returned as is
+    if (img.mem_type == Host) return (T*)img.mem;
+
     size_t width  = img.width;
     size_t height = img.height;
     size_t stride = img.stride;
 
     if (stride > width) {
         for (size_t i=0; i<height; ++i) {
-            std::memcpy(&((T*)img.host)[i*width], &((T*)img.mem)[i*stride], sizeof(T)*width);
+            std::memcpy(&((T*)img.get_host())[i*width], &((T*)img.mem)[i*stride], sizeof(T)*width);
         }
     } else {
-        std::memcpy((T*)img.host, img.mem, sizeof(T)*width*height);
+        std::memcpy((T*)img.get_host(), img.mem, sizeof(T)*width*height);
     }
 
-    return (T*)img.host;
+    return (T*)img.get_host();
 }
 
 
@@ -165,6 +526,233 @@ void hipaccWriteDomainFromMask(HipaccImage &dom, T* host_mem) {
 }
 
 
+void hipaccPrepareKernelLaunch(hipacc_launch_info &info) {
+    // calculate a) first pixel that requires no border handling (left, top)
+    // and b) first pixel that requires border handling (right, bottom)
+    if (info.size_x > 0) {
+        info.bh_start_left = info.offset_x + info.size_x;
+        info.bh_start_right = info.offset_x + info.is_width - info.size_x;
+    } else {
+        info.bh_start_left = info.offset_x;
+        info.bh_start_right = info.offset_x + info.is_width;
+    }
+    if (info.size_y > 0) {
+        info.bh_start_top = info.offset_y + info.size_y;
+        info.bh_start_bottom = info.offset_y + info.is_height - info.size_y;
+    } else {
+        info.bh_start_top = info.offset_y;
+        info.bh_start_bottom = info.offset_y + info.is_height;
+    }
+
+    // the image is too small to separate left/right and top/bottom borders
+    if (info.bh_start_right < info.bh_start_left ||
+        info.bh_start_bottom < info.bh_start_top) {
+        info.bh_fall_back = 1;
+    } else {
+        info.bh_fall_back = 0;
+    }
+}
+
+
+// Launch kernel: gid_y range [lower, upper) is split into row bands, which
+// are processed by at most num_threads threads (0 selects all threads)
+template<typename F>
+void hipaccLaunchKernel(int lower, int upper, F kernel, int num_threads=0) {
+    hipaccParallelFor(lower, upper, kernel, num_threads);
+}
+
+
+// Perform exploration of the number of threads for a kernel call
+template<typename F>
+void hipaccKernelExploration(std::string kernel_name, int lower, int upper,
+        F kernel, hipacc_launch_info &info, std::string tuning_db="",
+        std::string tuning_key="", std::string tuning_config="") {
+    int max_threads = (int)hipaccGetNumThreads();
+    int opt_threads = max_threads;
+    float opt_time = FLT_MAX;
+
+    std::cerr << "<HIPACC:> Exploring number of threads for kernel '"
+              << kernel_name << "': " << max_threads << " threads available."
+              << std::endl;
+
+    for (int num_threads=1; ; num_threads=std::min(2*num_threads, max_threads)) {
+        std::vector<float> times;
+        times.reserve(HIPACC_NUM_ITERATIONS);
+        for (size_t i=0; i<HIPACC_NUM_ITERATIONS; ++i) {
+            long start = getMicroTime();
+            hipaccLaunchKernel(lower, upper, kernel, num_threads);
+            times.push_back((getMicroTime() - start) * 1.0e-3f);
+        }
+        std::sort(times.begin(), times.end());
+        float timing = times.at(HIPACC_NUM_ITERATIONS/2);
+        if (timing < opt_time) {
+            opt_time = timing;
+            opt_threads = num_threads;
+        }
+
+        std::cerr << "<HIPACC:> Kernel config: "
+                  << std::setw(3) << std::right << num_threads << " threads: "
+                  << std::setw(8) << std::fixed << std::setprecision(4)
+                  << timing << " ms" << std::endl;
+
+        if (num_threads == max_threads) break;
+    }
+    last_gpu_timing = opt_time;
+
+    std::cerr << "<HIPACC:> Best configurations for kernel '" << kernel_name
+              << "': " << opt_threads << " threads: " << opt_time << " ms"
+              << std::endl;
+
+    if (!tuning_key.empty()) {
+        std::stringstream config;
+        config << tuning_config << " threads=" << opt_threads;
+        if (!hipaccUpdateTuningDatabase(tuning_db, tuning_key, info, opt_time,
+                                        config.str())) {
+            std::cerr << "<HIPACC:> Could not update tuning database '"
+                      << tuning_db << "'" << std::endl;
+        }
+    }
+}
+
+
+// Combine num values pairwise in a tree, the result is stored in vals[0]
+template<typename T, typename F>
+T hipaccCombineTree(F reduce, T *vals, int num) {
+    for (int step=1; step<num; step*=2) {
+        for (int i=0; i+step<num; i+=2*step) {
+            vals[i] = reduce(vals[i], vals[i+step]);
+        }
+    }
+    return vals[0];
+}
+
+
+// Reduce rows [lower, upper) of the accessor: one partial result per SIMD
+// lane is computed, partial results are combined in a tree afterwards. An
+// empty range yields a value-initialized T.
+template<typename T, typename F>
+T hipaccReduceRows(F reduce, const HipaccAccessor &acc, int lower, int upper) {
+    const size_t max_lanes = 16;
+    size_t lanes = std::max<size_t>(1, std::min<size_t>(max_lanes, 32/sizeof(T)));
+    size_t width = acc.width;
+
+    if (width == 0 || lower >= upper) return T();
+    if (width < lanes) lanes = width;
+
+    T *row = (T *)acc.img.mem + (acc.offset_y + lower)*acc.img.stride + acc.offset_x;
+
+    T partial[max_lanes];
+    for (size_t i=0; i<lanes; ++i) partial[i] = row[i];
+
+    size_t x = lanes;
+    for (int y=lower; y<upper; ++y, row+=acc.img.stride, x=0) {
+        for (; x+lanes<=width; x+=lanes) {
+            for (size_t i=0; i<lanes; ++i) {
+                partial[i] = reduce(partial[i], row[x+i]);
+            }
+        }
+        for (size_t i=0; x<width; ++x, ++i) {
+            partial[i] = reduce(partial[i], row[x]);
+        }
+    }
+
+    return hipaccCombineTree(reduce, partial, (int)lanes);
+}
+
+
+// Apply reduction function to the iteration space: each band computes a
+// partial result, partial results are combined in a tree afterwards
+template<typename T, typename F>
+T hipaccApplyReduction(F reduce, const HipaccAccessor &acc) {
+    int num_chunks = hipaccGetNumChunks(0, acc.height);
+    if (num_chunks == 0 || acc.width == 0) return T();
+    std::vector<T> partial(num_chunks);
+
+    hipaccParallelForChunks(0, acc.height, [&] (int chunk, int lower, int upper) {
+        partial[chunk] = hipaccReduceRows<T>(reduce, acc, lower, upper);
+    });
+
+    return hipaccCombineTree(reduce, partial.data(), num_chunks);
+}
+
+
+// Launch kernel and reduce its output in one pass: each band is computed in
+// blocks of rows, which are reduced while they are still in the cache. At
+// most num_threads threads are used (0 selects all threads).
+#ifndef HIPACC_REDUCE_BLOCK_SIZE
+#define HIPACC_REDUCE_BLOCK_SIZE (64*1024)
+#endif
+template<typename T, typename K, typename F>
+T hipaccLaunchKernelReduce(K kernel, F reduce, const HipaccAccessor &acc,
+                           int num_threads=0) {
+    int num_chunks = hipaccGetNumChunks(0, acc.height, num_threads);
+    if (num_chunks == 0 || acc.width == 0) return T();
+    int block_rows = std::max<int>(1, HIPACC_REDUCE_BLOCK_SIZE/(acc.width*sizeof(T)));
+    std::vector<T> partial(num_chunks);
+
+    hipaccParallelForChunks(0, acc.height, [&] (int chunk, int lower, int upper) {
+        for (int y=lower; y<upper; y+=block_rows) {
+            int y_end = std::min(y + block_rows, upper);
+            kernel(acc.offset_y + y, acc.offset_y + y_end);
+            T val = hipaccReduceRows<T>(reduce, acc, y, y_end);
+            partial[chunk] = y == lower ? val : reduce(partial[chunk], val);
+        }
+    }, num_threads);
+
+    return hipaccCombineTree(reduce, partial.data(), num_chunks);
+}
+
+
+// Launch a producer kernel fused with its consumer: each band of consumer
+// rows [lower, upper) is computed in blocks of rows. The producer computes the
+// rows of the intermediate image read by a block, including halo_top and
+// halo_bottom rows, into a buffer local to the band; rows shared with the
+// previous block are kept. Row y of the consumer reads row y + offset_y of the
+// intermediate image, which has the given height and stride. The kernels are
+// called with the buffer and the first row it holds, row y of the
+// intermediate image is at (y - row_lo)*stride in the buffer.
+#ifndef HIPACC_FUSION_BLOCK_SIZE
+#define HIPACC_FUSION_BLOCK_SIZE (256*1024)
+#endif
+template<typename T, typename P, typename C>
+void hipaccLaunchKernelFused(P producer, C consumer, int stride, int height,
+                             int halo_top, int halo_bottom, int offset_y,
+                             int lower, int upper) {
+    int halo = halo_top + halo_bottom;
+    int block_rows = std::max<int>(1, HIPACC_FUSION_BLOCK_SIZE/(stride*sizeof(T)) - halo);
+
+    hipaccParallelFor(lower, upper, [&] (int l, int u) {
+        HipaccMemoryPool &pool = HipaccMemoryPool::getInstance();
+        size_t size = (size_t)(std::min(block_rows, u - l) + halo)*stride*sizeof(T);
+        T *buffer = (T *)pool.allocate(size, 0);
+        // rows [row_lo, row_hi) of the intermediate image are in the buffer
+        int row_lo = 0, row_hi = 0;
+
+        for (int y=l; y<u; y+=block_rows) {
+            int y_end = std::min(y + block_rows, u);
+            int lo = std::max(0, y + offset_y - halo_top);
+            int hi = std::min(height, y_end + offset_y + halo_bottom);
+
+            if (lo >= row_lo && lo < row_hi) {
+                std::memmove(buffer, buffer + (size_t)(lo - row_lo)*stride,
+                             (size_t)(row_hi - lo)*stride*sizeof(T));
+            } else {
+                row_hi = lo;
+            }
+            row_lo = lo;
+
+            if (row_hi < hi) {
+                producer(buffer, row_lo, row_hi, hi);
+                row_hi = hi;
+            }
+            consumer(buffer, row_lo, y, y_end);
+        }
+
+        pool.release(buffer, size, 0);
+    });
+}
+
+
 // Copy from memory region to memory region
 void hipaccCopyMemoryRegion(const HipaccAccessor &src, const HipaccAccessor &dst) {
     for (size_t i=0; i<dst.height; ++i) {
@@ -174,5 +762,38 @@ void hipaccCopyMemoryRegion(const HipaccAccessor &src, const HipaccAccessor &dst
     }
 }
 
+
+// Integral image (summed-area table): out is one pixel larger than in and
+// out(x, y) holds the sum of all pixels of in left of x and above y. Rows are
+// scanned in parallel bands of rows, columns in parallel bands of columns.
+template<typename T, typename S>
+void hipaccIntegralImage(HipaccImage &in, HipaccImage &out) {
+    assert(out.width == in.width + 1 && out.height == in.height + 1 &&
+           "Integral image has to be one pixel larger than the input image!");
+    const T *src = (const T *)in.mem;
+    S *dst = (S *)out.mem;
+
+    std::fill(dst, dst + out.width, S(0));
+    hipaccParallelFor(0, (int)in.height, [&] (int lower, int upper) {
+        for (int y=lower; y<upper; ++y) {
+            const T *row = src + y*in.stride;
+            S *out_row = dst + (y+1)*out.stride;
+            S sum = 0;
+            out_row[0] = 0;
+            for (size_t x=0; x<in.width; ++x) {
+                sum += row[x];
+                out_row[x+1] = sum;
+            }
+        }
+    });
+    hipaccParallelFor(1, (int)out.width, [&] (int lower, int upper) {
+        for (size_t y=2; y<out.height; ++y) {
+            const S *prev = dst + (y-1)*out.stride;
+            S *cur = dst + y*out.stride;
+            for (int x=lower; x<upper; ++x) cur[x] += prev[x];
+        }
+    });
+}
+
 #endif  // __HIPACC_CPU_HPP__
 
@@ -333,7 +333,7 @@ HipaccImage createImage(T *host_mem, void *mem, size_t width, size_t height, siz
     HipaccImage img = HipaccImage(width, height, stride, alignment, sizeof(T), mem, mem_type);
     HipaccContext &Ctx = HipaccContext::getInstance();
     Ctx.add_image(img);
-    hipaccWriteMemory(img, host_mem ? host_mem : (T*)img.host);
+    hipaccWriteMemory(img, host_mem ? host_mem : (T*)img.get_host());
 
     return img;
 }
@@ -421,8 +421,8 @@ void hipaccWriteMemory(HipaccImage &img, T *host_mem) {
     size_t height = img.height;
     size_t stride = img.stride;
 
-    if ((char *)host_mem != img.host)
-        std::copy(host_mem, host_mem + width*height, (T*)img.host);
+    if ((char *)host_mem != img.get_host())
+        std::copy(host_mem, host_mem + width*height, (T*)img.get_host());
 
     if (img.mem_type >= Array2D) {
         cudaError_t err = cudaMemcpyToArray((cudaArray *)img.mem, 0, 0, host_mem, sizeof(T)*width*height, cudaMemcpyHostToDevice);
@@ -447,19 +447,19 @@ T *hipaccReadMemory(HipaccImage &img) {
     size_t stride = img.stride;
 
     if (img.mem_type >= Array2D) {
-        cudaError_t err = cudaMemcpyFromArray((T*)img.host, (cudaArray *)img.mem, 0, 0, sizeof(T)*width*height, cudaMemcpyDeviceToHost);
+        cudaError_t err = cudaMemcpyFromArray((T*)img.get_host(), (cudaArray *)img.mem, 0, 0, sizeof(T)*width*height, cudaMemcpyDeviceToHost);
         checkErr(err, "cudaMemcpyFromArray()");
     } else {
         if (stride > width) {
-            cudaError_t err = cudaMemcpy2D((T*)img.host, width*sizeof(T), img.mem, stride*sizeof(T), width*sizeof(T), height, cudaMemcpyDeviceToHost);
+            cudaError_t err = cudaMemcpy2D((T*)img.get_host(), width*sizeof(T), img.mem, stride*sizeof(T), width*sizeof(T), height, cudaMemcpyDeviceToHost);
             checkErr(err, "cudaMemcpy2D()");
         } else {
-            cudaError_t err = cudaMemcpy((T*)img.host, img.mem, sizeof(T)*width*height, cudaMemcpyDeviceToHost);
+            cudaError_t err = cudaMemcpy((T*)img.get_host(), img.mem, sizeof(T)*width*height, cudaMemcpyDeviceToHost);
             checkErr(err, "cudaMemcpy()");
         }
     }
 
-    return (T*)img.host;
+    return (T*)img.get_host();
 }
 
 
@@ -1232,7 +1232,9 @@ void hipaccKernelExploration(std::string filename, std::string kernel,
         std::vector<hipacc_const_info> consts, std::vector<hipacc_tex_info*>
         texs, hipacc_launch_info &info, size_t warp_size, size_t
         max_threads_per_block, size_t max_threads_for_kernel, size_t
-        max_smem_per_block, size_t heu_tx, size_t heu_ty, int cc) {
+        max_smem_per_block, size_t heu_tx, size_t heu_ty, int cc,
+        std::string tuning_db="", std::string tuning_key="", std::string
+        tuning_config="") {
     CUresult err = CUDA_SUCCESS;
     size_t opt_tx=warp_size, opt_ty=1;
     float opt_time = FLT_MAX;
@@ -1369,11 +1371,89 @@ void hipaccKernelExploration(std::string filename, std::string kernel,
               << opt_tx*opt_ty << " (" << opt_tx << "x" << opt_ty << "): "
               << opt_time << " ms" << std::endl;
 
+    if (!tuning_key.empty()) {
+        std::stringstream config;
+        config << tuning_config << " bsx=" << opt_tx << " bsy=" << opt_ty;
+        if (!hipaccUpdateTuningDatabase(tuning_db, tuning_key, info, opt_time,
+                                        config.str())) {
+            std::cerr << "<HIPACC:> Could not update tuning database '"
+                      << tuning_db << "'" << std::endl;
+        }
+    }
+
     #ifdef USE_NVML
     nvml_err = nvmlShutdown();
     checkErrNVML(nvml_err, "nvmlShutdown()");
     #endif
 }
 
+
+//
+// INTEGRAL IMAGE
+//
+
+#define HIPACC_SCAN_BS 256
+
+// Scan one row per block: the row is processed in chunks of blockDim.x pixels,
+// each chunk is scanned in shared memory and offset by the sum of all previous
+// chunks; row y of in is written to row y+1 of out
+template<typename T, typename S>
+__global__ void hipaccIntegralRows(const T *in, S *out, int width, int
+        in_stride, int out_stride) {
+    __shared__ S smem[HIPACC_SCAN_BS];
+    const T *row = in + blockIdx.x*in_stride;
+    S *out_row = out + (blockIdx.x+1)*out_stride;
+    S carry = 0;
+
+    if (threadIdx.x == 0) out_row[0] = 0;
+    for (int x0=0; x0<width; x0+=blockDim.x) {
+        int x = x0 + threadIdx.x;
+        smem[threadIdx.x] = x < width ? (S)row[x] : (S)0;
+        __syncthreads();
+        for (int offset=1; offset<blockDim.x; offset*=2) {
+            S val = threadIdx.x >= offset ? smem[threadIdx.x-offset] : (S)0;
+            __syncthreads();
+            smem[threadIdx.x] += val;
+            __syncthreads();
+        }
+        if (x < width) out_row[x+1] = carry + smem[threadIdx.x];
+        carry += smem[blockDim.x-1];
+        __syncthreads();
+    }
+}
+
+// Scan one column per thread, accesses of neighboring threads are coalesced
+template<typename S>
+__global__ void hipaccIntegralCols(S *out, int width, int height, int stride) {
+    int x = blockIdx.x*blockDim.x + threadIdx.x;
+    if (x >= width) return;
+
+    S sum = 0;
+    out[x] = 0;
+    for (int y=1; y<height; ++y) {
+        sum += out[y*stride + x];
+        out[y*stride + x] = sum;
+    }
+}
+
+
+// Integral image (summed-area table): out is one pixel larger than in and
+// out(x, y) holds the sum of all pixels of in left of x and above y
+template<typename T, typename S>
+void hipaccIntegralImage(HipaccImage &in, HipaccImage &out) {
+    assert(out.width == in.width + 1 && out.height == in.height + 1 &&
+           "Integral image has to be one pixel larger than the input image!");
+    assert(in.mem_type <= Linear2D && out.mem_type <= Linear2D &&
+           "Integral images require linear memory!");
+
+    hipaccIntegralRows<T, S><<<in.height, HIPACC_SCAN_BS>>>((const T *)in.mem,
+            (S *)out.mem, in.width, in.stride, out.stride);
+    checkErr(cudaGetLastError(), "hipaccIntegralRows()");
+    hipaccIntegralCols<S><<<(out.width + HIPACC_SCAN_BS-1)/HIPACC_SCAN_BS,
+        HIPACC_SCAN_BS>>>((S *)out.mem, out.width, out.height, out.stride);
+    checkErr(cudaGetLastError(), "hipaccIntegralCols()");
+    checkErr(cudaThreadSynchronize(), "cudaThreadSynchronize()");
+}
+
 #endif  // __HIPACC_CU_HPP__
 
@@ -406,8 +406,8 @@ void hipaccWriteMemory(HipaccImage &img, T *host_mem) {
     size_t height = img.height;
     size_t stride = img.stride;
 
-    if ((char *)host_mem != img.host)
-        std::copy(host_mem, host_mem + width*height, (T*)img.host);
+    if ((char *)host_mem != img.get_host())
+        std::copy(host_mem, host_mem + width*height, (T*)img.get_host());
 
     if (stride > width) {
         T* buff = new T[stride * height];
@@ -433,14 +433,14 @@ T *hipaccReadMemory(HipaccImage &img) {
         T* buff = new T[stride * height];
         COPYTO(T, (Allocation *)img.mem, 0, stride * height, buff);
         for (size_t i=0; i<height; ++i) {
-            std::memcpy(&((T*)img.host)[i*width], buff + (i * stride), sizeof(T) * width);
+            std::memcpy(&((T*)img.get_host())[i*width], buff + (i * stride), sizeof(T) * width);
         }
         delete[] buff;
     } else {
-        COPYTO(T, (Allocation *)img.mem, 0, width * height, (T*)img.host);
+        COPYTO(T, (Allocation *)img.mem, 0, width * height, (T*)img.get_host());
     }
 
-    return (T*)img.host;
+    return (T*)img.get_host();
 }
 
 
@@ -491,7 +491,7 @@ HipaccImage createImage(T *host_mem, size_t width, size_t height, size_t stride,
 \
     HipaccImage img = HipaccImage(width, height, stride, alignment, sizeof(T), (void *)allocation.get()); \
     Ctx.add_image(img, allocation); \
-    hipaccWriteMemory(img, host_mem ? host_mem : (T*)img.host); \
+    hipaccWriteMemory(img, host_mem ? host_mem : (T*)img.get_host()); \
 \
     return img; \
 } \
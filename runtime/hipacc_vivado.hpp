@@ -29,8 +29,7 @@
 #include <string.h>
 #include <iostream>
 
-#include <hls_stream.h>
-#include <ap_int.h>
+#include "hipacc_vivado_emu.hpp"
 
 #include "hipacc_base.hpp"
 
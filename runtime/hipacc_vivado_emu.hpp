@@ -0,0 +1,1180 @@
+//
+// Copyright (c) 2014, University of Erlangen-Nuremberg
+// Copyright (c) 2014, Siemens AG
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef __HIPACC_VIVADO_EMU_HPP__
+#define __HIPACC_VIVADO_EMU_HPP__
+
+// Vivado HLS types used by the runtime and by hipacc_run.cc. The vendor
+// headers are used by default, so that vivado_hls can simulate and synthesize
+// the code. Defining HIPACC_VIVADO_EMU replaces hls::stream and ap_[u]int by
+// the header-only software emulation below, which compiles with any C++11
+// compiler and runs each process of the dataflow region on its own thread:
+//  - channels declared within the dataflow region are bounded lock-free
+//    single-producer/single-consumer FIFOs of the depth given by
+//    HIPACC_STREAM_DEPTH, or HIPACC_EMU_FIFO_DEPTH if none is given,
+//    all other streams (testbench side) are unbounded
+//  - the depth and high-water mark of each channel is reported after the
+//    dataflow region finished
+//  - if all processes are blocked on their FIFOs for more than
+//    HIPACC_EMU_DEADLOCK_TIMEOUT ms, the deadlock is reported and the
+//    program is aborted
+//  - ap_[u]int follow the bit-accurate semantics of the vendor types,
+//    including the widths of intermediate results and reversed ranges
+
+#ifndef HIPACC_VIVADO_EMU
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+#define HIPACC_DATAFLOW_BEGIN
+#define HIPACC_DATAFLOW_PROCESS(...) __VA_ARGS__
+#define HIPACC_DATAFLOW_END
+
+#define HIPACC_STREAM_PRAGMA(x) _Pragma(#x)
+#define HIPACC_STREAM_DEPTH(strm, n) \
+    HIPACC_STREAM_PRAGMA(HLS STREAM variable=strm depth=n)
+
+#else // HIPACC_VIVADO_EMU
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifndef HIPACC_EMU_FIFO_DEPTH
+#define HIPACC_EMU_FIFO_DEPTH 2
+#endif
+#ifndef HIPACC_EMU_DEADLOCK_TIMEOUT
+#define HIPACC_EMU_DEADLOCK_TIMEOUT 2000
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Arbitrary precision integers
+////////////////////////////////////////////////////////////////////////////////
+
+// Operations on little-endian arrays of 64-bit words in two's complement
+struct HipaccApWords {
+    static void add(uint64_t *r, const uint64_t *a, const uint64_t *b, int n) {
+        uint64_t carry = 0;
+        for (int i=0; i<n; ++i) {
+            uint64_t s = a[i] + carry;
+            carry = s < carry;
+            r[i] = s + b[i];
+            carry += r[i] < s;
+        }
+    }
+    static void sub(uint64_t *r, const uint64_t *a, const uint64_t *b, int n) {
+        uint64_t borrow = 0;
+        for (int i=0; i<n; ++i) {
+            uint64_t d = a[i] - b[i];
+            uint64_t nb = a[i] < b[i];
+            r[i] = d - borrow;
+            borrow = nb + (d < borrow);
+        }
+    }
+    static void neg(uint64_t *r, int n) {
+        uint64_t carry = 1;
+        for (int i=0; i<n; ++i) {
+            r[i] = ~r[i] + carry;
+            carry = carry && r[i] == 0;
+        }
+    }
+    // product truncated to n words
+    static void mul(uint64_t *r, const uint64_t *a, const uint64_t *b, int n) {
+        if (n == 1) {
+            r[0] = a[0] * b[0];
+            return;
+        }
+        for (int i=0; i<n; ++i) r[i] = 0;
+        for (int i=0; i<n; ++i) {
+            unsigned __int128 carry = 0;
+            for (int j=0; i+j<n; ++j) {
+                carry += (unsigned __int128)a[i] * b[j] + r[i+j];
+                r[i+j] = (uint64_t)carry;
+                carry >>= 64;
+            }
+        }
+    }
+    static void shl(uint64_t *r, const uint64_t *a, int n, int sh) {
+        int ws = sh / 64, bs = sh % 64;
+        for (int i=n-1; i>=0; --i) {
+            uint64_t w = i-ws >= 0 ? a[i-ws] << bs : 0;
+            if (bs && i-ws-1 >= 0) w |= a[i-ws-1] >> (64-bs);
+            r[i] = w;
+        }
+    }
+    static void shr(uint64_t *r, const uint64_t *a, int n, int sh, bool arith) {
+        uint64_t fill = arith && (a[n-1] >> 63) ? ~0ULL : 0ULL;
+        int ws = sh / 64, bs = sh % 64;
+        for (int i=0; i<n; ++i) {
+            uint64_t lo = i+ws < n ? a[i+ws] : fill;
+            uint64_t hi = i+ws+1 < n ? a[i+ws+1] : fill;
+            r[i] = bs ? (lo >> bs) | (hi << (64-bs)) : lo;
+        }
+    }
+    static int ucmp(const uint64_t *a, const uint64_t *b, int n) {
+        for (int i=n-1; i>=0; --i) {
+            if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+        }
+        return 0;
+    }
+    static int scmp(const uint64_t *a, const uint64_t *b, int n) {
+        if ((int64_t)a[n-1] != (int64_t)b[n-1])
+            return (int64_t)a[n-1] < (int64_t)b[n-1] ? -1 : 1;
+        return ucmp(a, b, n-1);
+    }
+    static bool is_zero(const uint64_t *a, int n) {
+        for (int i=0; i<n; ++i) if (a[i]) return false;
+        return true;
+    }
+    // unsigned division
+    template<int N>
+    static void udivmod(uint64_t *q, uint64_t *r, const uint64_t *a,
+                        const uint64_t *b) {
+        assert(!is_zero(b, N) && "division by zero");
+        if (N == 1) {
+            q[0] = a[0] / b[0];
+            r[0] = a[0] % b[0];
+            return;
+        }
+        uint64_t t[N];
+        for (int i=0; i<N; ++i) q[i] = r[i] = 0;
+        for (int bit=64*N-1; bit>=0; --bit) {
+            shl(r, r, N, 1);
+            r[0] |= (a[bit/64] >> (bit%64)) & 1;
+            if (ucmp(r, b, N) >= 0) {
+                sub(t, r, b, N);
+                for (int i=0; i<N; ++i) r[i] = t[i];
+                q[bit/64] |= 1ULL << (bit%64);
+            }
+        }
+    }
+    // r = (a >> lo) & mask(len)
+    static void extract(uint64_t *r, const uint64_t *a, int n, int lo, int len) {
+        shr(r, a, n, lo, false);
+        for (int i=0; i<n; ++i) {
+            int bits = len - 64*i;
+            if (bits <= 0) r[i] = 0;
+            else if (bits < 64) r[i] &= ~(~0ULL << bits);
+        }
+    }
+    // r[len-1:0] = a[0:len-1]
+    static void reverse(uint64_t *r, const uint64_t *a, int n, int len) {
+        if (n == 1) {
+            uint64_t w = a[0];
+            w = ((w >> 1) & 0x5555555555555555ULL) | ((w & 0x5555555555555555ULL) << 1);
+            w = ((w >> 2) & 0x3333333333333333ULL) | ((w & 0x3333333333333333ULL) << 2);
+            w = ((w >> 4) & 0x0f0f0f0f0f0f0f0fULL) | ((w & 0x0f0f0f0f0f0f0f0fULL) << 4);
+            w = __builtin_bswap64(w);
+            r[0] = w >> (64 - len);
+            return;
+        }
+        for (int i=0; i<n; ++i) r[i] = 0;
+        for (int i=0; i<len; ++i) {
+            int j = len - 1 - i;
+            r[j/64] |= ((a[i/64] >> (i%64)) & 1) << (j%64);
+        }
+    }
+    // a[lo+len-1:lo] = v[len-1:0]
+    template<int N>
+    static void insert(uint64_t *a, const uint64_t *v, int lo, int len) {
+        uint64_t m[N], t[N];
+        for (int i=0; i<N; ++i) {
+            int bits = len - 64*i;
+            m[i] = bits <= 0 ? 0 : bits < 64 ? ~(~0ULL << bits) : ~0ULL;
+            t[i] = v[i] & m[i];
+        }
+        shl(m, m, N, lo);
+        shl(t, t, N, lo);
+        for (int i=0; i<N; ++i) a[i] = (a[i] & ~m[i]) | t[i];
+    }
+};
+
+template<int W>
+struct HipaccApWord {
+    typedef typename std::conditional<W <= 8, uint8_t,
+            typename std::conditional<W <= 16, uint16_t,
+            typename std::conditional<W <= 32, uint32_t,
+            uint64_t>::type>::type>::type type;
+};
+
+// C type for implicit conversions, selected by the number of bytes
+template<int B, bool S> struct HipaccApRet { typedef unsigned long long type; };
+template<int B> struct HipaccApRet<B, true> { typedef long long type; };
+template<> struct HipaccApRet<1, false> { typedef unsigned char type; };
+template<> struct HipaccApRet<1, true> { typedef signed char type; };
+template<> struct HipaccApRet<2, false> { typedef unsigned short type; };
+template<> struct HipaccApRet<2, true> { typedef short type; };
+template<> struct HipaccApRet<3, false> { typedef unsigned int type; };
+template<> struct HipaccApRet<3, true> { typedef int type; };
+template<> struct HipaccApRet<4, false> { typedef unsigned int type; };
+template<> struct HipaccApRet<4, true> { typedef int type; };
+
+#define HIPACC_AP_MAX(a, b) ((a) > (b) ? (a) : (b))
+#define HIPACC_AP_MIN(a, b) ((a) < (b) ? (a) : (b))
+
+template<int W, bool S> class ap_int_base;
+template<int W, bool S> class ap_range_ref;
+template<int W, bool S> class ap_bit_ref;
+template<int W> class ap_int;
+template<int W> class ap_uint;
+
+template<int W, bool S>
+class ap_int_base {
+    public:
+        enum { width = W, sign_flag = S, NW = (W + 63) / 64,
+               TOP = W - 64 * ((W + 63) / 64 - 1) };
+        typedef typename HipaccApWord<W>::type word_t;
+        typedef typename HipaccApRet<(W + 7) / 8, S>::type RetType;
+
+        // result types of binary operations, see ap_int_base.h
+        template<int W2, bool S2>
+        struct RType {
+            enum {
+                mult_w = W + W2,
+                mult_s = S || S2,
+                plus_w = HIPACC_AP_MAX(W + (S2 && !S), W2 + (S && !S2)) + 1,
+                plus_s = S || S2,
+                minus_w = HIPACC_AP_MAX(W + (S2 && !S), W2 + (S && !S2)) + 1,
+                minus_s = true,
+                div_w = W + S2,
+                div_s = S || S2,
+                mod_w = HIPACC_AP_MIN(W, W2 + (!S2 && S)),
+                mod_s = S,
+                logic_w = HIPACC_AP_MAX(W + (S2 && !S), W2 + (S && !S2)),
+                logic_s = S || S2
+            };
+            typedef ap_int_base<mult_w, mult_s> mult;
+            typedef ap_int_base<plus_w, plus_s> plus;
+            typedef ap_int_base<minus_w, minus_s> minus;
+            typedef ap_int_base<div_w, div_s> div;
+            typedef ap_int_base<mod_w, mod_s> mod;
+            typedef ap_int_base<logic_w, logic_s> logic;
+        };
+
+        // storage has the size of the next C type, the upper bits are sign
+        // extended respectively cleared
+        word_t V[NW];
+
+        ap_int_base() { for (int i=0; i<NW; ++i) V[i] = 0; }
+        template<int W2, bool S2>
+        ap_int_base(const ap_int_base<W2, S2> &op) {
+            for (int i=0; i<NW; ++i) V[i] = (word_t)op.word(i);
+            normalize();
+        }
+        template<int W2, bool S2>
+        ap_int_base(const ap_range_ref<W2, S2> &ref) { *this = ref.get(); }
+        template<int W2, bool S2>
+        ap_int_base(const ap_bit_ref<W2, S2> &ref) { *this = (unsigned)ref.get(); }
+        template<typename T, typename std::enable_if<
+            std::is_arithmetic<T>::value, int>::type = 0>
+        ap_int_base(T val) {
+            from(val, std::is_integral<T>());
+        }
+
+        // word i of the value, sign extended beyond the width
+        uint64_t word(int i) const {
+            if (i >= NW) return is_neg() ? ~0ULL : 0ULL;
+            uint64_t w = (uint64_t)V[i];
+            return i == NW-1 ? extend(w) : w;
+        }
+        void load(uint64_t *w, int n) const {
+            for (int i=0; i<n; ++i) w[i] = word(i);
+        }
+        void store(const uint64_t *w) {
+            for (int i=0; i<NW; ++i) V[i] = (word_t)w[i];
+            normalize();
+        }
+
+        // conversions
+        operator RetType() const { return (RetType)word(0); }
+        bool to_bool() const { return !iszero(); }
+        char to_char() const { return (char)word(0); }
+        signed char to_schar() const { return (signed char)word(0); }
+        unsigned char to_uchar() const { return (unsigned char)word(0); }
+        short to_short() const { return (short)word(0); }
+        unsigned short to_ushort() const { return (unsigned short)word(0); }
+        int to_int() const { return (int)word(0); }
+        unsigned to_uint() const { return (unsigned)word(0); }
+        long to_long() const { return (long)word(0); }
+        unsigned long to_ulong() const { return (unsigned long)word(0); }
+        long long to_int64() const { return (long long)word(0); }
+        unsigned long long to_uint64() const { return word(0); }
+        double to_double() const {
+            uint64_t w[NW];
+            load(w, NW);
+            bool neg = is_neg();
+            if (neg) HipaccApWords::neg(w, NW);
+            double d = 0.0;
+            for (int i=NW-1; i>=0; --i) d = d * 18446744073709551616.0 + (double)w[i];
+            return neg ? -d : d;
+        }
+        float to_float() const { return (float)to_double(); }
+
+        int length() const { return W; }
+        bool is_neg() const { return S && (word(NW-1) >> 63); }
+        bool iszero() const {
+            for (int i=0; i<NW; ++i) if (word(i)) return false;
+            return true;
+        }
+        bool and_reduce() const { return ap_int_base<W, false>(*this) == ap_int_base<W, false>(-1); }
+        bool nand_reduce() const { return !and_reduce(); }
+        bool or_reduce() const { return !iszero(); }
+        bool nor_reduce() const { return iszero(); }
+        bool xor_reduce() const {
+            bool r = false;
+            for (int i=0; i<W; ++i) r ^= get_bit(i);
+            return r;
+        }
+        bool xnor_reduce() const { return !xor_reduce(); }
+
+        // bit access
+        bool get_bit(int i) const {
+            assert(i >= 0 && i < W && "bit index out of range");
+            return (word(i/64) >> (i%64)) & 1;
+        }
+        void set_bit(int i, bool val) {
+            assert(i >= 0 && i < W && "bit index out of range");
+            uint64_t w = word(i/64);
+            w = val ? w | (1ULL << (i%64)) : w & ~(1ULL << (i%64));
+            V[i/64] = (word_t)w;
+            normalize();
+        }
+        bool test(int i) const { return get_bit(i); }
+        void set(int i) { set_bit(i, true); }
+        void clear(int i) { set_bit(i, false); }
+        void invert(int i) { set_bit(i, !get_bit(i)); }
+        void reverse() {
+            ap_int_base<W, S> r;
+            for (int i=0; i<W; ++i) r.set_bit(W-1-i, get_bit(i));
+            *this = r;
+        }
+        ap_bit_ref<W, S> operator[](int i) { return ap_bit_ref<W, S>(this, i); }
+        bool operator[](int i) const { return get_bit(i); }
+        ap_bit_ref<W, S> bit(int i) { return ap_bit_ref<W, S>(this, i); }
+        bool bit(int i) const { return get_bit(i); }
+
+        // range access: range(Hi, Lo) with Hi < Lo selects the reversed range
+        ap_range_ref<W, S> range(int hi, int lo) { return ap_range_ref<W, S>(this, hi, lo); }
+        ap_range_ref<W, S> operator()(int hi, int lo) { return range(hi, lo); }
+        ap_range_ref<W, S> range() { return range(W-1, 0); }
+        ap_int_base<W, false> range(int hi, int lo) const {
+            return ap_range_ref<W, S>(const_cast<ap_int_base *>(this), hi, lo).get();
+        }
+        ap_int_base<W, false> operator()(int hi, int lo) const { return range(hi, lo); }
+
+        // unary operators
+        ap_int_base<W+1, true> operator-() const {
+            return ap_int_base<W+1, true>(0) - *this;
+        }
+        ap_int_base operator+() const { return *this; }
+        ap_int_base operator~() const {
+            uint64_t w[NW];
+            load(w, NW);
+            for (int i=0; i<NW; ++i) w[i] = ~w[i];
+            ap_int_base r;
+            r.store(w);
+            return r;
+        }
+        bool operator!() const { return iszero(); }
+
+        ap_int_base &operator++() { return *this = *this + 1; }
+        ap_int_base &operator--() { return *this = *this - 1; }
+        const ap_int_base operator++(int) { ap_int_base t = *this; ++*this; return t; }
+        const ap_int_base operator--(int) { ap_int_base t = *this; --*this; return t; }
+
+        // shift operators keep the width of the left operand, negative
+        // shift amounts shift into the opposite direction
+        ap_int_base operator<<(int sh) const {
+            if (sh < 0) return *this >> -sh;
+            uint64_t a[NW], r[NW];
+            load(a, NW);
+            if (sh >= W) { for (int i=0; i<NW; ++i) r[i] = 0; }
+            else HipaccApWords::shl(r, a, NW, sh);
+            ap_int_base t;
+            t.store(r);
+            return t;
+        }
+        ap_int_base operator>>(int sh) const {
+            if (sh < 0) return *this << -sh;
+            uint64_t a[NW], r[NW];
+            load(a, NW);
+            HipaccApWords::shr(r, a, NW, sh >= W ? W : sh, S);
+            if (sh >= W) {
+                for (int i=0; i<NW; ++i) r[i] = is_neg() ? ~0ULL : 0ULL;
+            }
+            ap_int_base t;
+            t.store(r);
+            return t;
+        }
+        template<typename T, typename std::enable_if<
+            std::is_integral<T>::value, int>::type = 0>
+        ap_int_base operator<<(T sh) const { return *this << (int)sh; }
+        template<typename T, typename std::enable_if<
+            std::is_integral<T>::value, int>::type = 0>
+        ap_int_base operator>>(T sh) const { return *this >> (int)sh; }
+        template<int W2, bool S2>
+        ap_int_base operator<<(const ap_int_base<W2, S2> &sh) const { return *this << sh.to_int(); }
+        template<int W2, bool S2>
+        ap_int_base operator>>(const ap_int_base<W2, S2> &sh) const { return *this >> sh.to_int(); }
+
+        // compound assignment, the result is truncated to the width
+        template<typename T> ap_int_base &operator+=(const T &op) { return *this = ap_int_base(*this + op); }
+        template<typename T> ap_int_base &operator-=(const T &op) { return *this = ap_int_base(*this - op); }
+        template<typename T> ap_int_base &operator*=(const T &op) { return *this = ap_int_base(*this * op); }
+        template<typename T> ap_int_base &operator/=(const T &op) { return *this = ap_int_base(*this / op); }
+        template<typename T> ap_int_base &operator%=(const T &op) { return *this = ap_int_base(*this % op); }
+        template<typename T> ap_int_base &operator&=(const T &op) { return *this = ap_int_base(*this & op); }
+        template<typename T> ap_int_base &operator|=(const T &op) { return *this = ap_int_base(*this | op); }
+        template<typename T> ap_int_base &operator^=(const T &op) { return *this = ap_int_base(*this ^ op); }
+        template<typename T> ap_int_base &operator<<=(const T &op) { return *this = *this << op; }
+        template<typename T> ap_int_base &operator>>=(const T &op) { return *this = *this >> op; }
+
+        std::string to_string(int radix=2) const {
+            assert((radix == 2 || radix == 8 || radix == 10 || radix == 16) &&
+                   "unsupported radix");
+            const int n = NW + 1;
+            uint64_t w[n], q[n], r[n], b[n];
+            load(w, n);
+            bool neg = radix == 10 && is_neg();
+            if (neg) HipaccApWords::neg(w, n);
+            for (int i=0; i<n; ++i) b[i] = 0;
+            b[0] = radix;
+            std::string digits;
+            do {
+                HipaccApWords::udivmod<n>(q, r, w, b);
+                digits.insert(digits.begin(), "0123456789abcdef"[r[0]]);
+                for (int i=0; i<n; ++i) w[i] = q[i];
+            } while (!HipaccApWords::is_zero(w, n));
+            switch (radix) {
+                case 2:  return "0b" + digits;
+                case 8:  return "0o" + digits;
+                case 16: return "0x" + digits;
+                default: return neg ? "-" + digits : digits;
+            }
+        }
+
+    private:
+        static uint64_t extend(uint64_t w) {
+            if (TOP == 64) return w;
+            uint64_t mask = ~0ULL << (TOP % 64);
+            if (S && ((w >> (TOP-1)) & 1)) return w | mask;
+            return w & ~mask;
+        }
+        void normalize() { V[NW-1] = (word_t)extend((uint64_t)V[NW-1]); }
+
+        template<typename T>
+        void from(T val, std::true_type) {
+            bool neg = std::is_signed<T>::value && (int64_t)val < 0;
+            uint64_t lo = std::is_signed<T>::value ? (uint64_t)(int64_t)val
+                                                   : (uint64_t)val;
+            V[0] = (word_t)lo;
+            for (int i=1; i<NW; ++i) V[i] = neg ? ~(word_t)0 : 0;
+            normalize();
+        }
+        // truncation towards zero, modulo 2^W
+        template<typename T>
+        void from(T val, std::false_type) {
+            double d = val;
+            uint64_t w[NW];
+            for (int i=0; i<NW; ++i) w[i] = 0;
+            bool neg = d < 0;
+            d = std::fabs(d);
+            if (d >= 1.0 && !std::isnan(d) && !std::isinf(d)) {
+                int e;
+                uint64_t mant = (uint64_t)std::ldexp(std::frexp(d, &e), 53);
+                int sh = e - 53;
+                if (sh < 0) {
+                    w[0] = mant >> -sh;
+                } else if (sh < 64*NW) {
+                    w[sh/64] = mant << (sh%64);
+                    if (sh%64 && sh/64+1 < NW) w[sh/64+1] = mant >> (64 - sh%64);
+                }
+            }
+            if (neg) HipaccApWords::neg(w, NW);
+            store(w);
+        }
+};
+
+
+// binary arithmetic and logic operators
+#define HIPACC_AP_BIN_OP(OP, RTYPE, FUNC) \
+template<int W1, bool S1, int W2, bool S2> \
+typename ap_int_base<W1, S1>::template RType<W2, S2>::RTYPE \
+operator OP(const ap_int_base<W1, S1> &a, const ap_int_base<W2, S2> &b) { \
+    typedef typename ap_int_base<W1, S1>::template RType<W2, S2>::RTYPE R; \
+    uint64_t x[R::NW], y[R::NW], z[R::NW]; \
+    a.load(x, R::NW); \
+    b.load(y, R::NW); \
+    FUNC; \
+    R r; \
+    r.store(z); \
+    return r; \
+}
+HIPACC_AP_BIN_OP(+, plus,  HipaccApWords::add(z, x, y, R::NW))
+HIPACC_AP_BIN_OP(-, minus, HipaccApWords::sub(z, x, y, R::NW))
+HIPACC_AP_BIN_OP(*, mult,  HipaccApWords::mul(z, x, y, R::NW))
+HIPACC_AP_BIN_OP(&, logic, for (int i=0; i<R::NW; ++i) z[i] = x[i] & y[i])
+HIPACC_AP_BIN_OP(|, logic, for (int i=0; i<R::NW; ++i) z[i] = x[i] | y[i])
+HIPACC_AP_BIN_OP(^, logic, for (int i=0; i<R::NW; ++i) z[i] = x[i] ^ y[i])
+#undef HIPACC_AP_BIN_OP
+
+// division truncates towards zero, the remainder has the sign of the dividend
+#define HIPACC_AP_DIV_OP(OP, RTYPE, RES) \
+template<int W1, bool S1, int W2, bool S2> \
+typename ap_int_base<W1, S1>::template RType<W2, S2>::RTYPE \
+operator OP(const ap_int_base<W1, S1> &a, const ap_int_base<W2, S2> &b) { \
+    typedef typename ap_int_base<W1, S1>::template RType<W2, S2>::RTYPE R; \
+    enum { N = (HIPACC_AP_MAX(W1, W2) + 64) / 64 }; \
+    uint64_t x[N], y[N], q[N], m[N]; \
+    a.load(x, N); \
+    b.load(y, N); \
+    bool nx = a.is_neg(), ny = b.is_neg(); \
+    if (nx) HipaccApWords::neg(x, N); \
+    if (ny) HipaccApWords::neg(y, N); \
+    HipaccApWords::udivmod<N>(q, m, x, y); \
+    if (nx != ny) HipaccApWords::neg(q, N); \
+    if (nx) HipaccApWords::neg(m, N); \
+    R r; \
+    r.store(RES); \
+    return r; \
+}
+HIPACC_AP_DIV_OP(/, div, q)
+HIPACC_AP_DIV_OP(%, mod, m)
+#undef HIPACC_AP_DIV_OP
+
+// comparison operators
+#define HIPACC_AP_REL_OP(OP) \
+template<int W1, bool S1, int W2, bool S2> \
+bool operator OP(const ap_int_base<W1, S1> &a, const ap_int_base<W2, S2> &b) { \
+    enum { N = (HIPACC_AP_MAX(W1, W2) + 64) / 64 }; \
+    uint64_t x[N], y[N]; \
+    a.load(x, N); \
+    b.load(y, N); \
+    return HipaccApWords::scmp(x, y, N) OP 0; \
+}
+HIPACC_AP_REL_OP(==)
+HIPACC_AP_REL_OP(!=)
+HIPACC_AP_REL_OP(<)
+HIPACC_AP_REL_OP(<=)
+HIPACC_AP_REL_OP(>)
+HIPACC_AP_REL_OP(>=)
+#undef HIPACC_AP_REL_OP
+
+// operators with C integer types, which behave like ap_int of their width
+#define HIPACC_AP_OP_WITH_INT(OP, RTYPE, C_TYPE, W2, S2) \
+template<int W, bool S> \
+typename ap_int_base<W, S>::template RType<W2, S2>::RTYPE \
+operator OP(const ap_int_base<W, S> &a, C_TYPE b) { \
+    return a OP ap_int_base<W2, S2>(b); \
+} \
+template<int W, bool S> \
+typename ap_int_base<W2, S2>::template RType<W, S>::RTYPE \
+operator OP(C_TYPE a, const ap_int_base<W, S> &b) { \
+    return ap_int_base<W2, S2>(a) OP b; \
+}
+#define HIPACC_AP_REL_WITH_INT(OP, C_TYPE, W2, S2) \
+template<int W, bool S> \
+bool operator OP(const ap_int_base<W, S> &a, C_TYPE b) { \
+    return a OP ap_int_base<W2, S2>(b); \
+} \
+template<int W, bool S> \
+bool operator OP(C_TYPE a, const ap_int_base<W, S> &b) { \
+    return ap_int_base<W2, S2>(a) OP b; \
+}
+// operators with C floating point types use the C conversion
+#define HIPACC_AP_OP_WITH_FLOAT(OP, C_TYPE) \
+template<int W, bool S> \
+auto operator OP(const ap_int_base<W, S> &a, C_TYPE b) \
+    -> decltype((typename ap_int_base<W, S>::RetType)a OP b) { \
+    return (typename ap_int_base<W, S>::RetType)a OP b; \
+} \
+template<int W, bool S> \
+auto operator OP(C_TYPE a, const ap_int_base<W, S> &b) \
+    -> decltype(a OP (typename ap_int_base<W, S>::RetType)b) { \
+    return a OP (typename ap_int_base<W, S>::RetType)b; \
+}
+#define HIPACC_AP_OPS_WITH_TYPE(C_TYPE, W2, S2) \
+    HIPACC_AP_OP_WITH_INT(+, plus, C_TYPE, W2, S2) \
+    HIPACC_AP_OP_WITH_INT(-, minus, C_TYPE, W2, S2) \
+    HIPACC_AP_OP_WITH_INT(*, mult, C_TYPE, W2, S2) \
+    HIPACC_AP_OP_WITH_INT(/, div, C_TYPE, W2, S2) \
+    HIPACC_AP_OP_WITH_INT(%, mod, C_TYPE, W2, S2) \
+    HIPACC_AP_OP_WITH_INT(&, logic, C_TYPE, W2, S2) \
+    HIPACC_AP_OP_WITH_INT(|, logic, C_TYPE, W2, S2) \
+    HIPACC_AP_OP_WITH_INT(^, logic, C_TYPE, W2, S2) \
+    HIPACC_AP_REL_WITH_INT(==, C_TYPE, W2, S2) \
+    HIPACC_AP_REL_WITH_INT(!=, C_TYPE, W2, S2) \
+    HIPACC_AP_REL_WITH_INT(<, C_TYPE, W2, S2) \
+    HIPACC_AP_REL_WITH_INT(<=, C_TYPE, W2, S2) \
+    HIPACC_AP_REL_WITH_INT(>, C_TYPE, W2, S2) \
+    HIPACC_AP_REL_WITH_INT(>=, C_TYPE, W2, S2)
+#define HIPACC_AP_OPS_WITH_FLOAT(C_TYPE) \
+    HIPACC_AP_OP_WITH_FLOAT(+, C_TYPE) \
+    HIPACC_AP_OP_WITH_FLOAT(-, C_TYPE) \
+    HIPACC_AP_OP_WITH_FLOAT(*, C_TYPE) \
+    HIPACC_AP_OP_WITH_FLOAT(/, C_TYPE) \
+    HIPACC_AP_OP_WITH_FLOAT(==, C_TYPE) \
+    HIPACC_AP_OP_WITH_FLOAT(!=, C_TYPE) \
+    HIPACC_AP_OP_WITH_FLOAT(<, C_TYPE) \
+    HIPACC_AP_OP_WITH_FLOAT(<=, C_TYPE) \
+    HIPACC_AP_OP_WITH_FLOAT(>, C_TYPE) \
+    HIPACC_AP_OP_WITH_FLOAT(>=, C_TYPE)
+HIPACC_AP_OPS_WITH_TYPE(bool, 1, false)
+HIPACC_AP_OPS_WITH_TYPE(char, 8, std::is_signed<char>::value)
+HIPACC_AP_OPS_WITH_TYPE(signed char, 8, true)
+HIPACC_AP_OPS_WITH_TYPE(unsigned char, 8, false)
+HIPACC_AP_OPS_WITH_TYPE(short, 8*sizeof(short), true)
+HIPACC_AP_OPS_WITH_TYPE(unsigned short, 8*sizeof(short), false)
+HIPACC_AP_OPS_WITH_TYPE(int, 8*sizeof(int), true)
+HIPACC_AP_OPS_WITH_TYPE(unsigned int, 8*sizeof(int), false)
+HIPACC_AP_OPS_WITH_TYPE(long, 8*sizeof(long), true)
+HIPACC_AP_OPS_WITH_TYPE(unsigned long, 8*sizeof(long), false)
+HIPACC_AP_OPS_WITH_TYPE(long long, 8*sizeof(long long), true)
+HIPACC_AP_OPS_WITH_TYPE(unsigned long long, 8*sizeof(long long), false)
+HIPACC_AP_OPS_WITH_FLOAT(float)
+HIPACC_AP_OPS_WITH_FLOAT(double)
+#undef HIPACC_AP_OPS_WITH_FLOAT
+#undef HIPACC_AP_OPS_WITH_TYPE
+#undef HIPACC_AP_OP_WITH_FLOAT
+#undef HIPACC_AP_REL_WITH_INT
+#undef HIPACC_AP_OP_WITH_INT
+
+template<int W, bool S>
+std::ostream &operator<<(std::ostream &os, const ap_int_base<W, S> &op) {
+    if (os.flags() & std::ios::hex) return os << op.to_string(16).substr(2);
+    if (os.flags() & std::ios::oct) return os << op.to_string(8).substr(2);
+    return os << op.to_string(10);
+}
+
+
+// reference to the bits [Hi:Lo] of an ap_[u]int; the bits are reversed if
+// Hi < Lo
+template<int W, bool S>
+class ap_range_ref {
+    private:
+        ap_int_base<W, S> &d_bv;
+        int l_index, h_index;
+
+    public:
+        ap_range_ref(ap_int_base<W, S> *bv, int h, int l) :
+            d_bv(*bv), l_index(l), h_index(h) {
+            assert(h >= 0 && h < W && l >= 0 && l < W && "range out of bounds");
+        }
+
+        int length() const {
+            return h_index >= l_index ? h_index - l_index + 1
+                                      : l_index - h_index + 1;
+        }
+
+        ap_int_base<W, false> get() const {
+            enum { NW = ap_int_base<W, S>::NW };
+            uint64_t a[NW], r[NW];
+            d_bv.load(a, NW);
+            if (h_index >= l_index) {
+                HipaccApWords::extract(r, a, NW, l_index, length());
+            } else {
+                HipaccApWords::extract(r, a, NW, h_index, length());
+                for (int i=0; i<NW; ++i) a[i] = r[i];
+                HipaccApWords::reverse(r, a, NW, length());
+            }
+            ap_int_base<W, false> ret;
+            ret.store(r);
+            return ret;
+        }
+        void set(const ap_int_base<W, false> &val) {
+            enum { NW = ap_int_base<W, S>::NW };
+            uint64_t a[NW], v[NW], r[NW];
+            d_bv.load(a, NW);
+            val.load(v, NW);
+            if (h_index >= l_index) {
+                HipaccApWords::insert<NW>(a, v, l_index, length());
+            } else {
+                HipaccApWords::reverse(r, v, NW, length());
+                HipaccApWords::insert<NW>(a, r, h_index, length());
+            }
+            d_bv.store(a);
+        }
+
+        operator unsigned long long() const { return get().to_uint64(); }
+
+        ap_range_ref &operator=(const ap_range_ref &ref) {
+            set(ref.get());
+            return *this;
+        }
+        template<int W2, bool S2>
+        ap_range_ref &operator=(const ap_range_ref<W2, S2> &ref) {
+            set(ap_int_base<W, false>(ref.get()));
+            return *this;
+        }
+        template<int W2, bool S2>
+        ap_range_ref &operator=(const ap_int_base<W2, S2> &val) {
+            set(ap_int_base<W, false>(val));
+            return *this;
+        }
+        template<typename T, typename std::enable_if<
+            std::is_arithmetic<T>::value, int>::type = 0>
+        ap_range_ref &operator=(T val) {
+            set(ap_int_base<W, false>(ap_int_base<HIPACC_AP_MAX(W, 64), true>(val)));
+            return *this;
+        }
+
+        int to_int() const { return get().to_int(); }
+        unsigned to_uint() const { return get().to_uint(); }
+        long to_long() const { return get().to_long(); }
+        unsigned long to_ulong() const { return get().to_ulong(); }
+        long long to_int64() const { return get().to_int64(); }
+        unsigned long long to_uint64() const { return get().to_uint64(); }
+        double to_double() const { return get().to_double(); }
+};
+
+
+// reference to a single bit of an ap_[u]int
+template<int W, bool S>
+class ap_bit_ref {
+    private:
+        ap_int_base<W, S> &d_bv;
+        int d_index;
+
+    public:
+        ap_bit_ref(ap_int_base<W, S> *bv, int index) : d_bv(*bv), d_index(index) {}
+
+        bool get() const { return d_bv.get_bit(d_index); }
+        operator bool() const { return get(); }
+        bool operator~() const { return !get(); }
+
+        ap_bit_ref &operator=(const ap_bit_ref &ref) {
+            d_bv.set_bit(d_index, ref.get());
+            return *this;
+        }
+        template<typename T, typename std::enable_if<
+            std::is_integral<T>::value, int>::type = 0>
+        ap_bit_ref &operator=(T val) {
+            d_bv.set_bit(d_index, val & 1);
+            return *this;
+        }
+        template<int W2, bool S2>
+        ap_bit_ref &operator=(const ap_int_base<W2, S2> &val) {
+            d_bv.set_bit(d_index, val.get_bit(0));
+            return *this;
+        }
+};
+
+
+#define HIPACC_AP_CONSTRUCTORS(TYPE) \
+        TYPE() {} \
+        template<int W2, bool S2> \
+        TYPE(const ap_int_base<W2, S2> &op) : Base(op) {} \
+        template<int W2, bool S2> \
+        TYPE(const ap_range_ref<W2, S2> &ref) : Base(ref) {} \
+        template<int W2, bool S2> \
+        TYPE(const ap_bit_ref<W2, S2> &ref) : Base(ref) {} \
+        template<typename T, typename std::enable_if< \
+            std::is_arithmetic<T>::value, int>::type = 0> \
+        TYPE(T val) : Base(val) {}
+
+template<int W>
+class ap_uint : public ap_int_base<W, false> {
+    typedef ap_int_base<W, false> Base;
+    public:
+        HIPACC_AP_CONSTRUCTORS(ap_uint)
+};
+
+template<int W>
+class ap_int : public ap_int_base<W, true> {
+    typedef ap_int_base<W, true> Base;
+    public:
+        HIPACC_AP_CONSTRUCTORS(ap_int)
+};
+#undef HIPACC_AP_CONSTRUCTORS
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Dataflow region
+////////////////////////////////////////////////////////////////////////////////
+
+class HipaccDataflow;
+
+// Channel statistics, written by the producer of the channel
+struct HipaccFifoInfo {
+    std::string name;
+    size_t depth;   // 0: unbounded
+    std::atomic<size_t> high_water;
+    std::atomic<size_t> size;
+
+    HipaccFifoInfo() : depth(0), high_water(0), size(0) {}
+
+    static int nextId() {
+        static std::atomic<int> id(0);
+        return id++;
+    }
+};
+
+// Process of a dataflow region, running on its own thread
+struct HipaccDataflowProcess {
+    std::string name;
+    std::atomic<const HipaccFifoInfo *> waits_for;
+    std::atomic<bool> waits_to_write;
+
+    explicit HipaccDataflowProcess(const std::string &name) :
+        name(name), waits_for(nullptr), waits_to_write(false) {}
+};
+
+class HipaccDataflow {
+    private:
+        std::vector<std::unique_ptr<HipaccDataflowProcess>> processes;
+        std::vector<std::thread> threads;
+        std::vector<const HipaccFifoInfo *> fifos;
+        HipaccDataflow *parent;
+        bool joined;
+
+        // progress of all processes, used to detect deadlocks
+        struct State {
+            std::atomic<int> live;
+            std::atomic<int> blocked;
+            std::atomic<unsigned long> progress;
+            std::atomic<HipaccDataflow *> region;
+            std::atomic<bool> deadlock;
+
+            State() : live(0), blocked(0), progress(0), region(nullptr),
+                      deadlock(false) {}
+        };
+        static State &state() {
+            static State s;
+            return s;
+        }
+        static HipaccDataflow *&threadRegion() {
+            static thread_local HipaccDataflow *region = nullptr;
+            return region;
+        }
+
+        void printFifos(std::ostream &os) const {
+            if (fifos.empty()) return;
+            size_t len = 0;
+            for (auto fifo : fifos) len = std::max(len, fifo->name.size());
+            os << "<HIPACC:> Dataflow FIFOs (depth, high-water mark):" << std::endl;
+            for (auto fifo : fifos) {
+                os << "<HIPACC:>   " << std::left << std::setw(len) << fifo->name
+                   << std::right << std::setw(8) << fifo->depth
+                   << std::setw(8) << fifo->high_water.load() << std::endl;
+            }
+        }
+
+        void reportDeadlock() {
+            std::ostream &os = std::cerr;
+            os << "<HIPACC:> Deadlock in dataflow region: all processes are blocked"
+               << std::endl;
+            for (auto &proc : processes) {
+                const HipaccFifoInfo *fifo = proc->waits_for.load();
+                if (!fifo) continue;
+                os << "<HIPACC:>   " << proc->name << " waits to "
+                   << (proc->waits_to_write.load() ? "write to " : "read from ")
+                   << fifo->name << " (" << fifo->size.load() << "/";
+                if (fifo->depth) os << fifo->depth;
+                else os << "unbounded";
+                os << " elements)" << std::endl;
+            }
+            printFifos(os);
+            os.flush();
+            abort();
+        }
+
+    public:
+        HipaccDataflow() : parent(threadRegion()), joined(false) {
+            threadRegion() = this;
+            state().region = this;
+        }
+        ~HipaccDataflow() { join(); }
+
+        // region whose channels are currently declared on this thread
+        static HipaccDataflow *current() { return threadRegion(); }
+        static HipaccDataflowProcess *&currentProcess() {
+            static thread_local HipaccDataflowProcess *process = nullptr;
+            return process;
+        }
+        static bool inProcess() { return currentProcess() != nullptr; }
+        static bool running() { return state().live > 0; }
+
+        void addFifo(const HipaccFifoInfo *fifo) { fifos.push_back(fifo); }
+
+        template<typename F>
+        void spawn(const char *call, F func) {
+            std::string name(call);
+            name = name.substr(0, name.find_first_of("<("));
+            processes.emplace_back(new HipaccDataflowProcess(name));
+            HipaccDataflowProcess *proc = processes.back().get();
+            ++state().live;
+            threads.emplace_back([proc, func]() mutable {
+                currentProcess() = proc;
+                func();
+                currentProcess() = nullptr;
+                --state().live;
+                ++state().progress;
+            });
+        }
+
+        void join() {
+            if (joined) return;
+            joined = true;
+            for (auto &thread : threads) thread.join();
+            threadRegion() = parent;
+            state().region = parent;
+            printFifos(std::cerr);
+        }
+
+        // block until ready() holds; detect that all processes are blocked
+        template<typename F>
+        static void wait(const HipaccFifoInfo &fifo, bool write, F ready) {
+            for (int i=0; i<64; ++i) {
+                if (ready()) return;
+            }
+
+            State &s = state();
+            HipaccDataflowProcess *proc = currentProcess();
+            if (proc) {
+                proc->waits_to_write = write;
+                proc->waits_for = &fifo;
+            }
+            ++s.blocked;
+
+            typedef std::chrono::steady_clock clock;
+            auto timeout = std::chrono::milliseconds(HIPACC_EMU_DEADLOCK_TIMEOUT);
+            auto start = clock::now();
+            unsigned long progress = s.progress;
+            for (unsigned long spin=0; !ready(); ++spin) {
+                if (spin < 1024) std::this_thread::yield();
+                else std::this_thread::sleep_for(std::chrono::microseconds(50));
+                if (clock::now() - start < timeout) continue;
+                if (s.progress == progress && s.blocked >= s.live) {
+                    HipaccDataflow *region = s.region;
+                    if (!s.deadlock.exchange(true) && region) region->reportDeadlock();
+                    // another process reports the deadlock
+                    for (;;) std::this_thread::sleep_for(timeout);
+                }
+                start = clock::now();
+                progress = s.progress;
+            }
+
+            --s.blocked;
+            ++s.progress;
+            if (proc) proc->waits_for = nullptr;
+        }
+};
+
+#define HIPACC_DATAFLOW_BEGIN HipaccDataflow _hipacc_dataflow;
+#define HIPACC_DATAFLOW_PROCESS(...) \
+    _hipacc_dataflow.spawn(#__VA_ARGS__, [&]() { __VA_ARGS__; })
+#define HIPACC_DATAFLOW_END _hipacc_dataflow.join();
+#define HIPACC_STREAM_DEPTH(strm, n) strm.set_depth(n);
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Streams
+////////////////////////////////////////////////////////////////////////////////
+
+namespace hls {
+
+// Lock-free single-producer/single-consumer queue of linked chunks. Streams
+// declared within a dataflow region are bounded by HIPACC_EMU_FIFO_DEPTH or
+// the depth set by HIPACC_STREAM_DEPTH and recycle their chunks, all other
+// streams grow on demand.
+template<typename T>
+class stream {
+    private:
+        enum { CHUNK = 64 };
+        struct Chunk {
+            T data[CHUNK];
+            Chunk *next;
+        };
+
+        HipaccFifoInfo info;
+        std::atomic<Chunk *> spare;
+
+        // producer
+        alignas(64) Chunk *w_chunk;
+        size_t w_idx, w_count, w_seen;
+        alignas(64) std::atomic<size_t> produced;
+        // consumer
+        alignas(64) Chunk *r_chunk;
+        size_t r_idx, r_count, r_seen;
+        alignas(64) std::atomic<size_t> consumed;
+
+        static std::string nextName() {
+            std::stringstream ss;
+            ss << "hls::stream." << HipaccFifoInfo::nextId();
+            return ss.str();
+        }
+
+        void init(const std::string &name) {
+            info.name = name;
+            w_chunk = r_chunk = new Chunk();
+            w_chunk->next = nullptr;
+            w_idx = w_count = w_seen = 0;
+            r_idx = r_count = r_seen = 0;
+            produced = consumed = 0;
+            spare = nullptr;
+            if (HipaccDataflow *region = HipaccDataflow::current()) {
+                info.depth = HIPACC_EMU_FIFO_DEPTH;
+                region->addFifo(&info);
+            }
+        }
+
+        bool hasSpace() {
+            if (!info.depth || w_count - w_seen < info.depth) return true;
+            w_seen = consumed.load(std::memory_order_acquire);
+            return w_count - w_seen < info.depth;
+        }
+        bool hasData() {
+            if (r_count != r_seen) return true;
+            r_seen = produced.load(std::memory_order_acquire);
+            return r_count != r_seen;
+        }
+
+        void push(const T &val) {
+            if (w_idx == CHUNK) {
+                Chunk *chunk = spare.exchange(nullptr, std::memory_order_acquire);
+                if (!chunk) chunk = new Chunk();
+                chunk->next = nullptr;
+                w_chunk->next = chunk;
+                w_chunk = chunk;
+                w_idx = 0;
+            }
+            w_chunk->data[w_idx++] = val;
+            produced.store(++w_count, std::memory_order_release);
+
+            // confirm a new high-water mark against the current read count
+            size_t fill = w_count - w_seen;
+            if (fill > info.high_water.load(std::memory_order_relaxed)) {
+                w_seen = consumed.load(std::memory_order_acquire);
+                fill = w_count - w_seen;
+                if (fill > info.high_water.load(std::memory_order_relaxed))
+                    info.high_water.store(fill, std::memory_order_relaxed);
+            }
+        }
+        void pop(T &val) {
+            if (r_idx == CHUNK) {
+                Chunk *chunk = r_chunk;
+                r_chunk = chunk->next;
+                r_idx = 0;
+                delete spare.exchange(chunk, std::memory_order_acq_rel);
+            }
+            val = r_chunk->data[r_idx++];
+            consumed.store(++r_count, std::memory_order_release);
+        }
+
+        stream(const stream &) = delete;
+        stream &operator=(const stream &) = delete;
+
+    public:
+        stream() { init(nextName()); }
+        explicit stream(const char *name) { init(name); }
+        ~stream() {
+            while (r_chunk) {
+                Chunk *next = r_chunk->next;
+                delete r_chunk;
+                r_chunk = next;
+            }
+            delete spare.load();
+        }
+
+        size_t size() const {
+            return produced.load(std::memory_order_acquire) -
+                   consumed.load(std::memory_order_acquire);
+        }
+        bool empty() const { return size() == 0; }
+        bool full() const { return info.depth && size() >= info.depth; }
+
+        // counterpart of '#pragma HLS STREAM depth=N', call before first use
+        void set_depth(size_t depth) {
+            if (info.depth && depth) info.depth = depth;
+        }
+
+        void write(const T &val) {
+            if (!hasSpace()) {
+                HipaccDataflow::wait(info, true, [this]() {
+                        info.size = size();
+                        return hasSpace();
+                    });
+            }
+            push(val);
+        }
+        bool write_nb(const T &val) {
+            if (!hasSpace()) return false;
+            push(val);
+            return true;
+        }
+        void operator<<(const T &val) { write(val); }
+
+        void read(T &val) {
+            if (!hasData()) {
+                if (!HipaccDataflow::inProcess() && !HipaccDataflow::running()) {
+                    std::cerr << "WARNING: Hls::stream '" << info.name
+                              << "' is read while empty" << std::endl;
+                    val = T();
+                    return;
+                }
+                HipaccDataflow::wait(info, false, [this]() {
+                        info.size = size();
+                        return hasData();
+                    });
+            }
+            pop(val);
+        }
+        T read() {
+            T val;
+            read(val);
+            return val;
+        }
+        bool read_nb(T &val) {
+            if (!hasData()) return false;
+            pop(val);
+            return true;
+        }
+        void operator>>(T &val) { read(val); }
+};
+
+} // namespace hls
+
+#undef HIPACC_AP_MAX
+#undef HIPACC_AP_MIN
+
+#endif // HIPACC_VIVADO_EMU
+
+#endif  // __HIPACC_VIVADO_EMU_HPP__
+
@@ -14,8 +14,7 @@
 //*********************************************************************************************************************
 #pragma once
 
-#include <ap_int.h>
-#include <hls_stream.h>
+#include "hipacc_vivado_emu.hpp"
 #include <assert.h>
 #include <typeinfo>
 #include <iostream>
@@ -50,11 +49,25 @@
 #define GDELAY_X     (KERNEL_SIZE_X/2)
 #define GDELAY_Y     (KERNEL_SIZE_Y/2)
 
+// Runtime resolution: local operators iterate over the runtime width/height
+// instead of MAX_WIDTH/MAX_HEIGHT, so smaller frames finish early. MAX_WIDTH
+// only sizes the line buffers, whose rows are reshaped into one wide memory
+// instead of one BRAM allocation per row.
+#ifdef HIPACC_RUNTIME_SIZE
+#define LOOP_WIDTH   width
+#define LOOP_HEIGHT  height
+#define PRAGMA_HLS_LINE_BUFFER(var) PRAGMA_HLS(HLS ARRAY_RESHAPE variable=var dim=1 complete)
+#else
+#define LOOP_WIDTH   MAX_WIDTH
+#define LOOP_HEIGHT  MAX_HEIGHT
+#define PRAGMA_HLS_LINE_BUFFER(var) PRAGMA_HLS(HLS ARRAY_PARTITION variable=var dim=1 complete)
+#endif
+
 // Oliver's VECT alternatives
 #define I_WIDTH_V         (BW_IN/VECT)
 #define O_WIDTH_V         (BW_OUT/VECT)
-#define KERNEL_SIZE_X_V   ((GDELAY_X>VECT) ? ((GDELAY_X%VECT)?GDELAY_X/VECT+1:GDELAY_X/VECT)*2+1 : KERNEL_SIZE_X)
-#define GDELAY_X_V        (KERNEL_SIZE_X_V/2)
+#define GDELAY_X_V        ((GDELAY_X+VECT-1)/VECT)
+#define KERNEL_SIZE_X_V   (2*GDELAY_X_V+1)
 
 #ifndef _BORDERPADDING_
 #define _BORDERPADDING_
@@ -189,378 +202,39 @@ void distribute2FIXED(
     }
   }
 }
-  
-template<int II_TARGET, int VECT, int MAX_WIDTH, int MAX_HEIGHT, int KERNEL_SIZE, typename IN>
-void distribute2(
-    hls::stream<IN> &data_in, 
-    hls::stream<IN> &data_out0, 
-    hls::stream<IN> &data_out1,
-    const int &width,
-    const int &height)
-{
-  #ifdef ASSERTION_CHECK
-    assert( width <= MAX_WIDTH); assert( height <= MAX_HEIGHT );
-    assert( (KERNEL_SIZE % 2) == 1 );
-  #endif
-  
-  IN temp;
-  int part = MAX_WIDTH/2; 
-  for(int row = 0; row < height; row++){  
-    for(int col = 0; col < width+(2*APRON*VECT); col++){
-      PRAGMA_HLS(HLS pipeline ii=II_TARGET)
-      #pragma HLS INLINE region
-      if(col<width){  
-        data_in >> temp;
-        if(col >= 0 & col < part-APRON)
-          data_out0 << temp;
-        else
-          if(col >= part-APRON & col < part+APRON){
-            data_out0 << temp;
-            data_out1 << temp;
-          }
-        else
-          data_out1 << temp;
-      }
-    }
-  }
-}
 
 // MAX_WIDTH : iterations in x-direction
 // MAX_HEIGHT : iterations in y-direction
-template<int II_TARGET, int VECT, int MAX_WIDTH, int MAX_HEIGHT, int KERNEL_SIZE, typename IN>
-void distribute4(
-    hls::stream<IN> &data_in, 
-    hls::stream<IN> &data_out0, 
-    hls::stream<IN> &data_out1, 
-    hls::stream<IN> &data_out2, 
-    hls::stream<IN> &data_out3,
+// PARTS : number of output streams, each gets width/PARTS columns plus the
+//         APRON columns overlapping with its neighbors
+template<int II_TARGET, int VECT, int PARTS, int MAX_WIDTH, int MAX_HEIGHT, int KERNEL_SIZE, typename IN>
+void distribute(
+    hls::stream<IN> &data_in,
+    hls::stream<IN> data_out[PARTS],
     const int &width,
     const int &height)
 {
-  // TODO fix this
   #ifdef ASSERTION_CHECK
     assert( width <= MAX_WIDTH ); assert( height <= MAX_HEIGHT );
     assert( (KERNEL_SIZE % 2) == 1 );
   #endif
-  
-  int part = width/4;
-  #ifdef ASSERTION_CHECK
-    assert( part <= MAX_WIDTH/4 ); 
-  #endif
-  
-  IN temp;
-  for(int row = 0; row < height; row++){  
-    for(int col = 0; col < width+2*APRON*VECT; col++){
-
-      PRAGMA_HLS(HLS pipeline ii=II_TARGET)
-      #pragma HLS INLINE region
-      if(col < width){
-        data_in >> temp;
-        
-        if(col >= 0 & col < part-APRON){
-          data_out0 << temp;
-        }
-        else if(col >= part-APRON & col < part+APRON){
-          data_out0 << temp;
-          data_out1 << temp;
-        }
-        else if(col >= part+APRON & col < (2*part)-APRON){
-          data_out1 << temp;
-        }
-        else if(col >= (2*part)-APRON & col < (2*part)+APRON){
-          data_out1 << temp;
-          data_out2 << temp;
-        }
-        else if(col >= (2*part)+APRON & col < (3*part)-APRON){
-          data_out2 << temp;
-        }
-        else if(col >= (3*part)-APRON & col < (3*part)+APRON){
-          data_out2 << temp;
-          data_out3 << temp;
-        }
-        else{
-          data_out3 << temp;
-        }
-      }
-    }
-  }
-}
 
-// MAX_WIDTH : iterations in x-direction
-// MAX_HEIGHT : iterations in y-direction
-template<int II_TARGET, int VECT, int MAX_WIDTH, int MAX_HEIGHT, int KERNEL_SIZE, typename IN>
-void distribute8(
-    hls::stream<IN> &data_in, 
-    hls::stream<IN> &data_out0, 
-    hls::stream<IN> &data_out1, 
-    hls::stream<IN> &data_out2, 
-    hls::stream<IN> &data_out3,
-    hls::stream<IN> &data_out4, 
-    hls::stream<IN> &data_out5, 
-    hls::stream<IN> &data_out6, 
-    hls::stream<IN> &data_out7,
-    const int &width,
-    const int &height)
-{
-  // TODO fix this
-  #ifdef ASSERTION_CHECK
-    assert( width <= MAX_WIDTH ); assert( height <= MAX_HEIGHT );
-    assert( (KERNEL_SIZE % 2) == 1 );
-  #endif
-  
-  int part = width/8;
+  int part = width/PARTS;
   #ifdef ASSERTION_CHECK
-    assert( part <= MAX_WIDTH/8 ); 
+    assert( part <= MAX_WIDTH/PARTS );
   #endif
-  
-  IN temp;
-  for(int row = 0; row < height; row++){  
-    for(int col = 0; col < width+2*APRON*VECT; col++){
-
-      PRAGMA_HLS(HLS pipeline ii=II_TARGET)
-      #pragma HLS INLINE region
-      if(col < width){
-        data_in >> temp;
-        
-        if(col >= 0 & col < part-APRON){
-          data_out0 << temp;
-        }
-        else if(col >= part-APRON & col < part+APRON){
-          data_out0 << temp;
-          data_out1 << temp;
-        }
-        else if(col >= part+APRON & col < (2*part)-APRON){
-          data_out1 << temp;
-        }
-        else if(col >= (2*part)-APRON & col < (2*part)+APRON){
-          data_out1 << temp;
-          data_out2 << temp;
-        }
-        else if(col >= (2*part)+APRON & col < (3*part)-APRON){
-          data_out2 << temp;
-        }
-        else if(col >= (3*part)-APRON & col < (3*part)+APRON){
-          data_out2 << temp;
-          data_out3 << temp;
-        }
-        else if(col >= (3*part)+APRON & col < (4*part)-APRON){
-          data_out3 << temp;
-        }
-        else if(col >= (4*part)-APRON & col < (4*part)+APRON){
-          data_out3 << temp;
-          data_out4 << temp;
-        }
-        else if(col >= (4*part)+APRON & col < (5*part)-APRON){
-          data_out4 << temp;
-        }
-        else if(col >= (5*part)-APRON & col < (5*part)+APRON){
-          data_out4 << temp;
-          data_out5 << temp;
-        }
-        else if(col >= (5*part)+APRON & col < (6*part)-APRON){
-          data_out5 << temp;
-        }
-        else if(col >= (6*part)-APRON & col < (6*part)+APRON){
-          data_out5 << temp;
-          data_out6 << temp;
-        }
-        else if(col >= (6*part)+APRON & col < (7*part)-APRON){
-          data_out6 << temp;
-        }
-        else if(col >= (7*part)-APRON & col < (7*part)+APRON){
-          data_out6 << temp;
-          data_out7 << temp;
-        }
-        else{
-          data_out7 << temp;
-        }
-      }
-    }
-  }
-}
 
-// MAX_WIDTH : iterations in x-direction
-// MAX_HEIGHT : iterations in y-direction
-template<int II_TARGET, int VECT, int MAX_WIDTH, int MAX_HEIGHT, int KERNEL_SIZE, typename IN>
-void distribute16(
-    hls::stream<IN> &data_in, 
-    hls::stream<IN> &data_out0, 
-    hls::stream<IN> &data_out1, 
-    hls::stream<IN> &data_out2, 
-    hls::stream<IN> &data_out3,
-    hls::stream<IN> &data_out4, 
-    hls::stream<IN> &data_out5, 
-    hls::stream<IN> &data_out6, 
-    hls::stream<IN> &data_out7,
-    hls::stream<IN> &data_out8, 
-    hls::stream<IN> &data_out9, 
-    hls::stream<IN> &data_out10, 
-    hls::stream<IN> &data_out11,
-    hls::stream<IN> &data_out12, 
-    hls::stream<IN> &data_out13, 
-    hls::stream<IN> &data_out14, 
-    hls::stream<IN> &data_out15,
-    const int &width,
-    const int &height)
-{
-  // TODO fix this
-  #ifdef ASSERTION_CHECK
-    assert( width <= MAX_WIDTH ); assert( height <= MAX_HEIGHT );
-    assert( (KERNEL_SIZE % 2) == 1 );
-  #endif
-  
-  int part = width/16;
-  #ifdef ASSERTION_CHECK
-    assert( part <= MAX_WIDTH/16 ); 
-  #endif
-  
   IN temp;
-  for(int row = 0; row < height; row++){  
+  for(int row = 0; row < height; row++){
     for(int col = 0; col < width+2*APRON*VECT; col++){
-
       PRAGMA_HLS(HLS pipeline ii=II_TARGET)
       #pragma HLS INLINE region
       if(col < width){
         data_in >> temp;
-        
-        if(col >= 0 & col < part-APRON){
-          if(row == 0) std::cout << col << "single 0" << std::endl;
-          data_out0 << temp;
-        }
-        else if(col >= part-APRON & col < part+APRON){
-          if(row == 0) std::cout << col << "double 0" << std::endl;
-          data_out0 << temp;
-          data_out1 << temp;
-        }
-        else if(col >= part+APRON & col < (2*part)-APRON){
-          if(row == 0) std::cout << col << "single 1" << std::endl;
-          data_out1 << temp;
-        }
-        else if(col >= (2*part)-APRON & col < (2*part)+APRON){
-          if(row == 0) std::cout << col << "double 1" << std::endl;
-          data_out1 << temp;
-          data_out2 << temp;
-        }
-        else if(col >= (2*part)+APRON & col < (3*part)-APRON){
-          if(row == 0) std::cout << col << "single 2" << std::endl;
-          data_out2 << temp;
-        }
-        else if(col >= (3*part)-APRON & col < (3*part)+APRON){
-          if(row == 0) std::cout << col << "double 2" << std::endl;
-          data_out2 << temp;
-          data_out3 << temp;
-        }
-        else if(col >= (3*part)+APRON & col < (4*part)-APRON){
-          if(row == 0) std::cout << col << "single 3" << std::endl;
-          data_out3 << temp;
-        }
-        else if(col >= (4*part)-APRON & col < (4*part)+APRON){
-          if(row == 0) std::cout << col << "double 3" << std::endl;
-          data_out3 << temp;
-          data_out4 << temp;
-        }
-        else if(col >= (4*part)+APRON & col < (5*part)-APRON){
-          if(row == 0) std::cout << col << "single 4" << std::endl;
-          data_out4 << temp;
-        }
-        else if(col >= (5*part)-APRON & col < (5*part)+APRON){
-          if(row == 0) std::cout << col << "double 4" << std::endl;
-          data_out4 << temp;
-          data_out5 << temp;
-        }
-        else if(col >= (5*part)+APRON & col < (6*part)-APRON){
-          if(row == 0) std::cout << col << "single 5" << std::endl;
-          data_out5 << temp;
-        }
-        else if(col >= (6*part)-APRON & col < (6*part)+APRON){
-          if(row == 0) std::cout << col << "double 5" << std::endl;
-          data_out5 << temp;
-          data_out6 << temp;
-        }
-        else if(col >= (6*part)+APRON & col < (7*part)-APRON){
-          if(row == 0) std::cout << col << "single 6" << std::endl;
-          data_out6 << temp;
-        }
-        else if(col >= (7*part)-APRON & col < (7*part)+APRON){
-          if(row == 0) std::cout << col << "double 6" << std::endl;
-          data_out6 << temp;
-          data_out7 << temp;
-        }
-        else if(col >= (7*part)+APRON & col < (8*part)-APRON){
-          if(row == 0) std::cout << col << "single 7" << std::endl;
-          data_out7 << temp;
-        }
-        else if(col >= (8*part)-APRON & col < (8*part)+APRON){
-          if(row == 0) std::cout << col << "double 7" << std::endl;
-          data_out7 << temp;
-          data_out8 << temp;
-        }
-        else if(col >= (8*part)+APRON & col < (9*part)-APRON){
-          if(row == 0) std::cout << col << "single 8" << std::endl;
-          data_out8 << temp;
-        }
-        else if(col >= (9*part)-APRON & col < (9*part)+APRON){
-          if(row == 0) std::cout << col << "double 8" << std::endl;
-          data_out8 << temp;
-          data_out9 << temp;
-        }
-        else if(col >= (9*part)+APRON & col < (10*part)-APRON){
-          if(row == 0) std::cout << col << "single 9" << std::endl;
-          data_out9 << temp;
-        }
-        else if(col >= (10*part)-APRON & col < (10*part)+APRON){
-          if(row == 0) std::cout << col << "double 9" << std::endl;
-          data_out9 << temp;
-          data_out10 << temp;
-        }
-        else if(col >= (10*part)+APRON & col < (11*part)-APRON){
-          if(row == 0) std::cout << col << "single 10" << std::endl;
-          data_out10 << temp;
-        }
-        else if(col >= (11*part)-APRON & col < (11*part)+APRON){
-          if(row == 0) std::cout << col << "double 10" << std::endl;
-          data_out10 << temp;
-          data_out11 << temp;
-        }
-        else if(col >= (11*part)+APRON & col < (12*part)-APRON){
-          if(row == 0) std::cout << col << "single 11" << std::endl;
-          data_out11 << temp;
-        }
-        else if(col >= (12*part)-APRON & col < (12*part)+APRON){
-          if(row == 0) std::cout << col << "double 11" << std::endl;
-          data_out11 << temp;
-          data_out12 << temp;
-        }
-        else if(col >= (12*part)+APRON & col < (13*part)-APRON){
-          if(row == 0) std::cout << col << "single 12" << std::endl;
-          data_out12 << temp;
-        }
-        else if(col >= (13*part)-APRON & col < (13*part)+APRON){
-          if(row == 0) std::cout << col << "double 12" << std::endl;
-          data_out12 << temp;
-          data_out13 << temp;
-        }
-        else if(col >= (13*part)+APRON & col < (14*part)-APRON){
-          if(row == 0) std::cout << col << "single 13" << std::endl;
-          data_out13 << temp;
-        }
-        else if(col >= (14*part)-APRON & col < (14*part)+APRON){
-          if(row == 0) std::cout << col << "double 13" << std::endl;
-          data_out13 << temp;
-          data_out14 << temp;
-        }
-        else if(col >= (14*part)+APRON & col < (15*part)-APRON){
-          if(row == 0) std::cout << col << "single 14" << std::endl;
-          data_out14 << temp;
-        }
-        else if(col >= (15*part)-APRON & col < (15*part)+APRON){
-          if(row == 0) std::cout << col << "double 14" << std::endl;
-          data_out14 << temp;
-          data_out15 << temp;
-        }
-        else{
-          if(row == 0) std::cout << col << "single 15" << std::endl;
-          data_out15 << temp;
+        for(int p = 0; p < PARTS; p++){
+        #pragma HLS unroll
+          if((p == 0 | col >= p*part-APRON) & (p == PARTS-1 | col < (p+1)*part+APRON))
+            data_out[p] << temp;
         }
       }
     }
@@ -1170,52 +844,6 @@ void processR(
   }
 }
 
-template<int II_TARGET, int MAX_WIDTH, int MAX_HEIGHT, typename IN, typename OUT>
-void collect4(
-    hls::stream<IN> &in0_s,
-    hls::stream<IN> &in1_s,
-    hls::stream<IN> &in2_s,
-    hls::stream<IN> &in3_s,
-    hls::stream<OUT> &out_s,
-    const int &width,
-    const int &height)
-{
-  // TODO fix this
-  #ifdef ASSERTION_CHECK
-    assert( width <= MAX_WIDTH ); assert( height <= MAX_HEIGHT );
-  #endif
-  
-  int part = width/4;
-  #ifdef ASSERTION_CHECK
-    assert( part <= MAX_WIDTH/4 ); 
-  #endif
-  
-  OUT temp;
-  for(int row = 0; row < height; row++){  
-    for(int col = 0; col < width; col++){
-      PRAGMA_HLS(HLS pipeline ii=II_TARGET)
-      #pragma HLS INLINE region
-      if(col >= 0 & col < part){
-        in0_s >> temp;
-        //if(row == 0) std::cout << col << ": single 1" << std::endl;
-      }
-      else if(col >= part & col < (2*part)){
-        in1_s >> temp;
-        //if(row == 0) std::cout << col << ": single 2" << std::endl;
-      }
-      else if(col >= (2*part) & col < (3*part)){
-        in2_s >> temp;
-        //if(row == 0) std::cout << col << ": single 3" << std::endl;
-      }
-      else{
-        in3_s >> temp;
-        //if(row == 0) std::cout << col << ": single 4" << std::endl;
-      }
-      out_s << temp;
-    }
-  }
-}
-
 template<int II_TARGET, int PART_0, int PART_1, int MAX_WIDTH, int MAX_HEIGHT, typename IN, typename OUT>
 void collect2FIXED(
     hls::stream<IN> &in0_s,
@@ -1248,2190 +876,84 @@ void collect2FIXED(
   }
 }
 
-template<int II_TARGET, int MAX_WIDTH, int MAX_HEIGHT, typename IN, typename OUT>
-void collect2(
-    hls::stream<IN> &in0_s,
-    hls::stream<IN> &in1_s,
+// PARTS : number of input streams, each provides width/PARTS columns
+template<int II_TARGET, int PARTS, int MAX_WIDTH, int MAX_HEIGHT, typename IN, typename OUT>
+void collect(
+    hls::stream<IN> in_s[PARTS],
     hls::stream<OUT> &out_s,
     const int &width,
     const int &height)
 {
-  // TODO fix this
   #ifdef ASSERTION_CHECK
     assert( width <= MAX_WIDTH ); assert( height <= MAX_HEIGHT );
   #endif
-  
-  int part = width/2;
-  #ifdef ASSERTION_CHECK
-    assert( part <= MAX_WIDTH/2 ); 
-  #endif
-  
-  OUT temp;
-  for(int row = 0; row < height; row++){  
-    for(int col = 0; col < width; col++){
-      PRAGMA_HLS(HLS pipeline ii=II_TARGET)
-      #pragma HLS INLINE region
-      if(col >= 0 & col < part)
-        in0_s >> temp;
-      else 
-        in1_s >> temp;
-      out_s << temp;
-    }
-  }
-}
 
-template<int II_TARGET, int MAX_WIDTH, int MAX_HEIGHT, typename IN, typename OUT>
-void collect8(
-    hls::stream<IN> &in0_s,
-    hls::stream<IN> &in1_s,
-    hls::stream<IN> &in2_s,
-    hls::stream<IN> &in3_s,
-    hls::stream<IN> &in4_s,
-    hls::stream<IN> &in5_s,
-    hls::stream<IN> &in6_s,
-    hls::stream<IN> &in7_s,
-    hls::stream<OUT> &out_s,
-    const int &width,
-    const int &height)
-{
-  // TODO fix this
-  #ifdef ASSERTION_CHECK
-    assert( width <= MAX_WIDTH ); assert( height <= MAX_HEIGHT );
-  #endif
-  
-  int part = width/8;
+  int part = width/PARTS;
   #ifdef ASSERTION_CHECK
-    assert( part <= MAX_WIDTH/8 ); 
+    assert( part <= MAX_WIDTH/PARTS );
   #endif
-  
-  OUT temp;
-  for(int row = 0; row < height; row++){  
-    for(int col = 0; col < width; col++){
-      PRAGMA_HLS(HLS pipeline ii=II_TARGET)
-      #pragma HLS INLINE region
-      if(col >= 0 & col < part){
-        in0_s >> temp;
-      }
-      else if(col >= part & col < (2*part)){
-        in1_s >> temp;
-      }
-      else if(col >= (2*part) & col < (3*part)){
-        in2_s >> temp;
-      }
-      else if(col >= (3*part) & col < (4*part)){
-        in3_s >> temp;
-      }
-      else if(col >= (4*part) & col < (5*part)){
-        in4_s >> temp;
-      }
-      else if(col >= (5*part) & col < (6*part)){
-        in5_s >> temp;
-      }
-      else if(col >= (6*part) & col < (7*part)){
-        in6_s >> temp;
-      }
-      else{
-        in7_s >> temp;
-      }
-      out_s << temp;
-    }
-  }
-}
 
-template<int II_TARGET, int MAX_WIDTH, int MAX_HEIGHT, typename IN, typename OUT>
-void collect16(
-    hls::stream<IN> &in0_s,
-    hls::stream<IN> &in1_s,
-    hls::stream<IN> &in2_s,
-    hls::stream<IN> &in3_s,
-    hls::stream<IN> &in4_s,
-    hls::stream<IN> &in5_s,
-    hls::stream<IN> &in6_s,
-    hls::stream<IN> &in7_s,
-    hls::stream<IN> &in8_s,
-    hls::stream<IN> &in9_s,
-    hls::stream<IN> &in10_s,
-    hls::stream<IN> &in11_s,
-    hls::stream<IN> &in12_s,
-    hls::stream<IN> &in13_s,
-    hls::stream<IN> &in14_s,
-    hls::stream<IN> &in15_s,
-    hls::stream<OUT> &out_s,
-    const int &width,
-    const int &height)
-{
-  // TODO fix this
-  #ifdef ASSERTION_CHECK
-    assert( width <= MAX_WIDTH ); assert( height <= MAX_HEIGHT );
-  #endif
-  
-  int part = width/16;
-  #ifdef ASSERTION_CHECK
-    assert( part <= MAX_WIDTH/16 ); 
-  #endif
-  
   OUT temp;
-  for(int row = 0; row < height; row++){  
-    for(int col = 0; col < width; col++){
-      PRAGMA_HLS(HLS pipeline ii=II_TARGET)
-      #pragma HLS INLINE region
-      if(col >= 0 & col < part){
-        in0_s >> temp;
-      }
-      else if(col >= part & col < (2*part)){
-        in1_s >> temp;
-      }
-      else if(col >= (2*part) & col < (3*part)){
-        in2_s >> temp;
-      }
-      else if(col >= (3*part) & col < (4*part)){
-        in3_s >> temp;
-      }
-      else if(col >= (4*part) & col < (5*part)){
-        in4_s >> temp;
-      }
-      else if(col >= (5*part) & col < (6*part)){
-        in5_s >> temp;
-      }
-      else if(col >= (6*part) & col < (7*part)){
-        in6_s >> temp;
-      }
-      else if(col >= (7*part) & col < (8*part)){
-        in7_s >> temp;
-      }
-      else if(col >= (8*part) & col < (9*part)){
-        in8_s >> temp;
-      }
-      else if(col >= (9*part) & col < (10*part)){
-        in9_s >> temp;
-      }
-      else if(col >= (10*part) & col < (11*part)){
-        in10_s >> temp;
-      }
-      else if(col >= (11*part) & col < (12*part)){
-        in11_s >> temp;
-      }
-      else if(col >= (12*part) & col < (13*part)){
-        in12_s >> temp;
-      }
-      else if(col >= (13*part) & col < (14*part)){
-        in13_s >> temp;
-      }
-      else if(col >= (14*part) & col < (15*part)){
-        in14_s >> temp;
-      }
-      else{
-        in15_s >> temp;
-      }
-      out_s << temp;
-    }
-  }
-}
-
-
-//*********************************************************************************************************************
-// LOCAL OPERATORS VECTOR
-//*********************************************************************************************************************
-struct winPos
-{
-  int win;
-  int pos;
-};
-typedef struct winPos winPos;
-
-winPos getWinCoords(int i, int kernel_x, int kernel, int vect, int offset, int col, int width, const enum BorderPadding::values borderPadding)
-{
-#pragma HLS INLINE
-  winPos temp;
-  
-  int win = i/vect;
-
-  // this will exhibit problems
-  if(col >= offset && col < kernel-1){
-    int borderWin = kernel_x-1 - col;
-    if(win >= borderWin){
-      //we are fine
-      temp.win = win;
-      temp.pos = i%vect;
-    // else
-    }else{
-      int border = borderWin*vect;
-      int d2b = border-i;
-      int pos = 0;
-      switch (borderPadding){
-        case BorderPadding::BORDER_CLAMP:
-          temp.pos = border%vect;
-          break;
-        case BorderPadding::BORDER_MIRROR:
-          temp.pos = (border + d2b - 1)%vect;
-          break;
-        case BorderPadding::BORDER_MIRROR_101:
-          temp.pos = (border+d2b)%vect;
-          break;
-        case BorderPadding::BORDER_CONST:
-          temp.pos = 0;
-          break;
-          default:
-          temp.pos = 0;
-          break;
-      }
-      temp.win = borderWin+d2b/vect;
-    }
-  }
-  // we are at the right border
-  else if(col >= width){
-    int overlap = col - (width-1);
-    int border = kernel - overlap - 1;
-    // if we are inside the defined region
-    if(win <= border){
-      //we are fine
-      temp.win = win;
-      temp.pos = i%vect;
-    }
-    else{
-      border = (border+1)*vect-1;
-      int d2b = i - border;
-      switch (borderPadding){
-        case BorderPadding::BORDER_CLAMP:
-          temp.pos = border%vect;
-          break;
-        case BorderPadding::BORDER_MIRROR:
-          temp.pos = (border - d2b + 1)%vect;
-          break;
-        case BorderPadding::BORDER_MIRROR_101:
-          temp.pos = (border - d2b)%vect;
-          break;
-        case BorderPadding::BORDER_CONST:
-          temp.pos = 0;
-          break;
-          default:
-          temp.pos = 0;
-          break;
-      }
-      temp.win = win-1;
-    }    
-  }else{
-    temp.win = win;
-    temp.pos = i%vect;
-  }
-  return temp;
-}
-
-
-//*********************************************************************************************************************
-// VECTOR FLOAT 
-//*********************************************************************************************************************
-template<int II_TARGET, int MAX_WIDTH, int MAX_HEIGHT, int KERNEL_SIZE, int VECT, typename INT, typename IN, typename OUT, class Filter>
-void processVECT2F(
-    hls::stream<IN> &in_s, 
-    hls::stream<OUT> &out_s,
-    const int &width,
-    const int &height,
-    Filter &filter,
-    const enum BorderPadding::values borderPadding)
-{
-    assert( width <= MAX_WIDTH); assert( height <= MAX_HEIGHT);
-    assert(VECT==2);
-  
-  IN lineBuff[SWIN_Y-1][MAX_WIDTH];
-  #pragma HLS ARRAY_PARTITION variable=lineBuff dim=1 complete
-  IN win[SWIN_Y][SWIN_X];
-  #pragma HLS ARRAY_PARTITION variable=win dim=0 complete
-  IN win_tmp[SWIN_Y][SWIN_X];
-  #pragma HLS ARRAY_PARTITION variable=win_tmp dim=0 complete
-  
-  INT win1[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win1 dim=0 complete
-  INT win2[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win2 dim=0 complete
-
-  IN in_pixel, out_pixel, temp_lb;
-
-  int row, col, i, j;
-
-  IMG_ROWS:
-  for(row = 0; row < MAX_HEIGHT+GROUP_DELAY_Y; ++row){
-    //std::cout << "ROW: " << row << std::endl;
-    IMG_COLS:
-    for(col = 0; col < MAX_WIDTH+GROUP_DELAY_X; ++col){
-      PRAGMA_HLS(HLS pipeline ii=II_TARGET)
-      #pragma HLS INLINE region
-      
-      //**********************************************************
-      // GET NEW INPUT
-      //**********************************************************
-      if(col < width & row < height){
-        in_s >> in_pixel;
-      }
-      //**********************************************************
-      // UPDATE THE WINDOW
-      // The line buffer behaves normally
-      //**********************************************************
-      if (col < width && row < height + GROUP_DELAY_Y)
-      {
-       for(i = 0; i < SWIN_Y; i++){
-       #pragma HLS unroll
-         for(j = 0; j < SWIN_X-1; j++){
-           win_tmp[i][j] = win_tmp[i][j+1];
-         }
-       }
-     
-
-     //**********************************************************
-     // UPDATE THE LINE BUFFER
-     // The line buffer behaves normally
-     //**********************************************************
-       LINE_BUFF_1:
-       for(i = 0; i < SWIN_Y-1; i++){
-       #pragma HLS unroll
-         if (i == 0) {
-           win_tmp[i][SWIN_X-1] = lineBuff[i][col];
-         } else {
-           temp_lb = lineBuff[i][col];
-           win_tmp[i][SWIN_X-1] = temp_lb;
-           lineBuff[i-1][col] = temp_lb;
-         }
-       }
-       
-       if (SWIN_Y > 1) {
-         lineBuff[SWIN_Y-2][col] = in_pixel;
-       }
-       win_tmp[SWIN_Y-1][SWIN_X-1] = in_pixel;
-     
-
-     //**********************************************************
-     // UPDATE THE LP WINDOW
-     // Window update includes mirroring border treatment
-     //**********************************************************
-       // X-DIRECTION
-       for(i = 0; i < SWIN_Y; i++){
-         for(j = 0; j < SWIN_X; j++){
-           int jx = getNewCoords(j,SWIN_X,GROUP_DELAY_X,col,width,borderPadding);
-           win[i][j] = win_tmp[i][jx];
-         }
-       }
-       // Y-DIRECTION
-       for(i = 0; i < SWIN_Y; i++){
-         for(j = 0; j < SWIN_X; j++){
-           int iy = getNewCoords(i,SWIN_Y,GROUP_DELAY_Y,row,height,borderPadding);
-            win[i][j] = win[iy][j];
-         }
-       }
-     
-     //**********************************************************
-     // ASSIGN WINDOWS 
-     //**********************************************************
-     // left
-       for(int j = 0; j < KERNEL_SIZE; j++){
-         winPos j1 = getWinCoords(j,KERNEL_SIZE, SWIN_X, VECT,GROUP_DELAY,col,width,borderPadding);
-         winPos j2 = getWinCoords(j+1,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         for(int i = 0; i < KERNEL_SIZE; i++){
-           win1[i][j] = i2f(win[i][j1.win]((j1.pos)*WIDTH,(j1.pos+1)*WIDTH-1));
-           win2[i][j] = i2f(win[i][j2.win]((j2.pos)*WIDTH,(j2.pos+1)*WIDTH-1));
-         }
-       }
-     }
-      //**********************************************************
-      // DO CALCULATIONS
-      //**********************************************************
-      if(row >= GROUP_DELAY_Y && col >= GROUP_DELAY_X)
-      {
-        INT outp1 = filter(win1);
-        INT outp2 = filter(win2);
-        out_pixel(0,WIDTH-1) = f2i(outp1);
-        out_pixel(WIDTH,2*WIDTH-1) = f2i(outp2); 
-        out_s << out_pixel; 
-      }
-    }
-  }
-}
-
-template<int II_TARGET, int MAX_WIDTH, int MAX_HEIGHT, int KERNEL_SIZE, int VECT, typename INT, typename IN, typename OUT, class Filter>
-void processVECT4F(
-    hls::stream<IN> &in_s, 
-    hls::stream<OUT> &out_s,
-    const int &width,
-    const int &height,
-    Filter &filter,
-    const enum BorderPadding::values borderPadding)
-{
-
-  // TODO fix this
-    assert( width <= MAX_WIDTH ); assert( height <= MAX_HEIGHT );
-    assert(VECT==4);
-  
-  IN lineBuff[SWIN_Y-1][MAX_WIDTH];
-  #pragma HLS ARRAY_PARTITION variable=lineBuff dim=1 complete
-  IN win[SWIN_Y][SWIN_X];
-  #pragma HLS ARRAY_PARTITION variable=win dim=0 complete
-  IN win_tmp[SWIN_Y][SWIN_X];
-  #pragma HLS ARRAY_PARTITION variable=win_tmp dim=0 complete
-  
-  INT win1[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win1 dim=0 complete
-  INT win2[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win2 dim=0 complete
-  INT win3[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win3 dim=0 complete
-  INT win4[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win4 dim=0 complete
-
-  IN in_pixel, out_pixel, temp_lb;
-
-  int row, col, i, j;
-
-  IMG_ROWS:
-  for(row = 0; row < MAX_HEIGHT+GROUP_DELAY_Y; ++row){
-    //std::cout << "ROW: " << row << std::endl;
-    IMG_COLS:
-    for(col = 0; col < MAX_WIDTH+GROUP_DELAY_X; ++col){
-      PRAGMA_HLS(HLS pipeline ii=II_TARGET)
-      #pragma HLS INLINE region
-      //**********************************************************
-      // GET NEW INPUT
-      //**********************************************************
-      if(col < width & row < height){
-        in_s >> in_pixel;
-      }
-
-     //**********************************************************
-     // UPDATE THE WINDOW
-     // The line buffer behaves normally
-     //**********************************************************
-     if (col < width && row < height + GROUP_DELAY_Y){
-       for(i = 0; i < SWIN_Y; i++){
-       #pragma HLS unroll
-         for(j = 0; j < SWIN_X-1; j++){
-           win_tmp[i][j] = win_tmp[i][j+1];
-         }
-       }
-     
-
-     //**********************************************************
-     // UPDATE THE LINE BUFFER
-     // The line buffer behaves normally
-     //**********************************************************
-       LINE_BUFF_1:
-       for(i = 0; i < SWIN_Y-1; i++){
-       #pragma HLS unroll
-         if (i == 0) {
-           win_tmp[i][SWIN_X-1] = lineBuff[i][col];
-         } else {
-           temp_lb = lineBuff[i][col];
-           win_tmp[i][SWIN_X-1] = temp_lb;
-           lineBuff[i-1][col] = temp_lb;
-         }
-       }
-       if (SWIN_Y > 1) {
-         lineBuff[SWIN_Y-2][col] = in_pixel;
-       }
-       win_tmp[SWIN_Y-1][SWIN_X-1] = in_pixel;
-     
-
-     //**********************************************************
-     // UPDATE THE LP WINDOW
-     // Window update includes mirroring border treatment
-     //**********************************************************
-       // X-DIRECTION
-       for(i = 0; i < SWIN_Y; i++){
-         for(j = 0; j < SWIN_X; j++){
-           int jx = getNewCoords(j,SWIN_X,GROUP_DELAY_X,col,width,borderPadding);
-           win[i][j] = win_tmp[i][jx];
-         }
-       }
-       // Y-DIRECTION
-       for(i = 0; i < SWIN_Y; i++){
-         for(j = 0; j < SWIN_X; j++){
-           int iy = getNewCoords(i,SWIN_Y,GROUP_DELAY_Y,row,height,borderPadding);
-            win[i][j] = win[iy][j];
-         }
-       }
-     
-     //**********************************************************
-     // ASSIGN WINDOWS 
-     //**********************************************************
-     // left
-       for(int j = 0; j < KERNEL_SIZE; j++){
-         winPos j1 = getWinCoords(j,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY,col,width,borderPadding);
-         winPos j2 = getWinCoords(j+1,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j3 = getWinCoords(j+2,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j4 = getWinCoords(j+3,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         for(int i = 0; i < KERNEL_SIZE; i++){
-           win1[i][j] = i2f(win[i][j1.win]((j1.pos)*WIDTH,(j1.pos+1)*WIDTH-1));
-           win2[i][j] = i2f(win[i][j2.win]((j2.pos)*WIDTH,(j2.pos+1)*WIDTH-1));
-           win3[i][j] = i2f(win[i][j3.win]((j3.pos)*WIDTH,(j3.pos+1)*WIDTH-1));
-           win4[i][j] = i2f(win[i][j4.win]((j4.pos)*WIDTH,(j4.pos+1)*WIDTH-1));
-         }
-       }
-     }
-     //**********************************************************
-     // DO CALCULATIONS
-     //**********************************************************
-     if(row >= GROUP_DELAY_Y && col >= GROUP_DELAY_X)
-     {
-       INT outp1 = filter(win1);
-       INT outp2 = filter(win2);
-       INT outp3 = filter(win3);
-       INT outp4 = filter(win4);
-       out_pixel(0,WIDTH-1)         = f2i(outp1);
-       out_pixel(WIDTH,2*WIDTH-1)   = f2i(outp2); 
-       out_pixel(2*WIDTH,3*WIDTH-1) = f2i(outp3); 
-       out_pixel(3*WIDTH,4*WIDTH-1) = f2i(outp4); 
-       out_s << out_pixel; 
-     }
-    }
-  }
-}
-
-//*********************************************************************************************************************
-// VECTOR INT 
-//*********************************************************************************************************************
-template<int II_TARGET, int MAX_WIDTH, int MAX_HEIGHT, int KERNEL_SIZE, int VECT, typename INT, typename IN, typename OUT, class Filter>
-void processVECT2(
-    hls::stream<IN> &in_s, 
-    hls::stream<OUT> &out_s,
-    const int &width,
-    const int &height,
-    Filter &filter,
-    const enum BorderPadding::values borderPadding)
-{
-  // TODO fix this
-  //#ifdef ASSERTION_CHECK
-    assert( width <= MAX_WIDTH ); assert( height <= MAX_HEIGHT );
-    assert(VECT==2);
-  //#endif
-  
-  IN lineBuff[SWIN_Y-1][MAX_WIDTH];
-  #pragma HLS ARRAY_PARTITION variable=lineBuff dim=1 complete
-  IN win[SWIN_Y][SWIN_X];
-  #pragma HLS ARRAY_PARTITION variable=win dim=0 complete
-  IN win_tmp[SWIN_Y][SWIN_X];
-  #pragma HLS ARRAY_PARTITION variable=win_tmp dim=0 complete
-  
-  INT win1[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win1 dim=0 complete
-  INT win2[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win2 dim=0 complete
-
-  IN in_pixel, out_pixel, temp_lb;
-
-  int row, col, i, j;
-
-  IMG_ROWS:
-  for(row = 0; row < MAX_HEIGHT+GROUP_DELAY_Y; ++row){
-    //std::cout << "ROW: " << row << std::endl;
-    IMG_COLS:
-    for(col = 0; col < MAX_WIDTH+GROUP_DELAY_X; ++col){
-      PRAGMA_HLS(HLS pipeline ii=II_TARGET)
-      #pragma HLS INLINE region
-      //**********************************************************
-      // GET NEW INPUT
-      //**********************************************************
-      if(col < width & row < height){
-        in_s >> in_pixel;
-      }
-
-      //**********************************************************
-      // UPDATE THE WINDOW
-      // The line buffer behaves normally
-      //**********************************************************
-      if (col < width & row < height + GROUP_DELAY_Y)
-     {
-       for(i = 0; i < SWIN_Y; i++){
-       #pragma HLS unroll
-         for(j = 0; j < SWIN_X-1; j++){
-           win_tmp[i][j] = win_tmp[i][j+1];
-         }
-       }
-     
-
-     //**********************************************************
-     // UPDATE THE LINE BUFFER
-     // The line buffer behaves normally
-     //**********************************************************
-       LINE_BUFF_1:
-       for(i = 0; i < SWIN_Y-1; i++){
-       #pragma HLS unroll
-         if (i == 0) {
-           win_tmp[i][SWIN_X-1] = lineBuff[i][col];
-         } else {
-           temp_lb = lineBuff[i][col];
-           win_tmp[i][SWIN_X-1] = temp_lb;
-           lineBuff[i-1][col] = temp_lb;
-         }
-       }
-       if (SWIN_Y > 1) {
-         lineBuff[SWIN_Y-2][col] = in_pixel;
-       }
-       win_tmp[SWIN_Y-1][SWIN_X-1] = in_pixel;
-     
-
-     //**********************************************************
-     // UPDATE THE LP WINDOW
-     // Window update includes mirroring border treatment
-     //**********************************************************
-       // X-DIRECTION
-       for(i = 0; i < SWIN_Y; i++){
-         for(j = 0; j < SWIN_X; j++){
-           int jx = getNewCoords(j,SWIN_X,GROUP_DELAY_X,col,width,borderPadding);
-           win[i][j] = win_tmp[i][jx];
-         }
-       }
-       // Y-DIRECTION
-       for(i = 0; i < SWIN_Y; i++){
-         for(j = 0; j < SWIN_X; j++){
-           int iy = getNewCoords(i,SWIN_Y,GROUP_DELAY_Y,row,height,borderPadding);
-            win[i][j] = win[iy][j];
-         }
-       }
-     
-     //**********************************************************
-     // ASSIGN WINDOWS 
-     //**********************************************************
-     // left
-       for(int j = 0; j < KERNEL_SIZE; j++){
-         winPos j1 = getWinCoords(j,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY,col,width,borderPadding);
-         winPos j2 = getWinCoords(j+1,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         for(int i = 0; i < KERNEL_SIZE; i++){
-           win1[i][j] = win[i][j1.win]((j1.pos)*WIDTH,(j1.pos+1)*WIDTH-1);
-           win2[i][j] = win[i][j2.win]((j2.pos)*WIDTH,(j2.pos+1)*WIDTH-1);
-         }
-       }
-     }
-      //**********************************************************
-      // DO CALCULATIONS
-      //**********************************************************
-      if(row >= GROUP_DELAY_Y && col >= GROUP_DELAY_X)
-      {
-        INT outp[VECT];
-        outp[0] = filter(win1);
-        outp[1] = filter(win2);
-        for(int i = 0; i < VECT; i++)
-          out_pixel(i*WIDTH,(i+1)*WIDTH-1) = outp[i];
-        out_s << out_pixel; 
-      }
-    }
-  }
-}
-  
-template<int II_TARGET, int MAX_WIDTH, int MAX_HEIGHT, int KERNEL_SIZE, int VECT, typename INT, typename IN, typename OUT, class Filter>
-void processVECT3(
-    hls::stream<IN> &in_s, 
-    hls::stream<OUT> &out_s,
-    const int &width,
-    const int &height,
-    Filter &filter,
-    const enum BorderPadding::values borderPadding)
-{
-  // TODO fix this
-  #ifdef ASSERTION_CHECK
-    assert( width <= MAX_WIDTH ); assert( height <= MAX_HEIGHT );
-    assert(VECT==3);
-  #endif
-  
-  IN lineBuff[SWIN_Y-1][MAX_WIDTH];
-  #pragma HLS ARRAY_PARTITION variable=lineBuff dim=1 complete
-  IN win[SWIN_Y][SWIN_X];
-  #pragma HLS ARRAY_PARTITION variable=win dim=0 complete
-  IN win_tmp[SWIN_Y][SWIN_X];
-  #pragma HLS ARRAY_PARTITION variable=win_tmp dim=0 complete
-  
-  INT win1[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win1 dim=0 complete
-  INT win2[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win2 dim=0 complete
-  INT win3[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win3 dim=0 complete
-
-  IN in_pixel, out_pixel, temp_lb;
-
-  int row, col, i, j;
-
-  IMG_ROWS:
-  for(row = 0; row < height+GROUP_DELAY_Y; row++){
-    //std::cout << "ROW: " << row << std::endl;
-    IMG_COLS:
-    for(col = 0; col < width+GROUP_DELAY_X; col++){
-      PRAGMA_HLS(HLS pipeline ii=II_TARGET)
-      #pragma HLS INLINE region
-      //**********************************************************
-      // GET NEW INPUT
-      //**********************************************************
-      if(col < width && row < height){
-        in_s >> in_pixel;
-      }
-
-      //**********************************************************
-      // UPDATE THE WINDOW
-      // The line buffer behaves normally
-      //**********************************************************
-      if (col < width && row < height + GROUP_DELAY_Y)
-     {
-       for(i = 0; i < SWIN_Y; i++){
-       #pragma HLS unroll
-         for(j = 0; j < SWIN_X-1; j++){
-           win_tmp[i][j] = win_tmp[i][j+1];
-         }
-       }
-     
-
-     //**********************************************************
-     // UPDATE THE LINE BUFFER
-     // The line buffer behaves normally
-     //**********************************************************
-       LINE_BUFF_1:
-       for(i = 0; i < SWIN_Y-1; i++){
-       #pragma HLS unroll
-         if (i == 0) {
-           win_tmp[i][SWIN_X-1] = lineBuff[i][col];
-         } else {
-           temp_lb = lineBuff[i][col];
-           win_tmp[i][SWIN_X-1] = temp_lb;
-           lineBuff[i-1][col] = temp_lb;
-         }
-       }
-       if (SWIN_Y > 1) {
-         lineBuff[SWIN_Y-2][col] = in_pixel;
-       }
-       win_tmp[SWIN_Y-1][SWIN_X-1] = in_pixel;
-     
-
-     //**********************************************************
-     // UPDATE THE LP WINDOW
-     // Window update includes mirroring border treatment
-     //**********************************************************
-       // X-DIRECTION
-       for(i = 0; i < SWIN_Y; i++){
-         for(j = 0; j < SWIN_X; j++){
-           int jx = getNewCoords(j,SWIN_X,GROUP_DELAY_X,col,width,borderPadding);
-           win[i][j] = win_tmp[i][jx];
-         }
-       }
-       // Y-DIRECTION
-       for(i = 0; i < SWIN_Y; i++){
-         for(j = 0; j < SWIN_X; j++){
-           int iy = getNewCoords(i,SWIN_Y,GROUP_DELAY_Y,row,height,borderPadding);
-            win[i][j] = win[iy][j];
-         }
-       }
-     
-     //**********************************************************
-     // ASSIGN WINDOWS 
-     //**********************************************************
-     // left
-       for(int j = 0; j < KERNEL_SIZE; j++){
-         winPos j1 = getWinCoords(j,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY,col,width,borderPadding);
-         winPos j2 = getWinCoords(j+1,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j3 = getWinCoords(j+2,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         for(int i = 0; i < KERNEL_SIZE; i++){
-           win1[i][j] = win[i][j1.win]((j1.pos)*WIDTH,(j1.pos+1)*WIDTH-1);
-           win2[i][j] = win[i][j2.win]((j2.pos)*WIDTH,(j2.pos+1)*WIDTH-1);
-           win3[i][j] = win[i][j3.win]((j3.pos)*WIDTH,(j3.pos+1)*WIDTH-1);
-         }
-       }
-     }
-      //**********************************************************
-      // DO CALCULATIONS
-      //**********************************************************
-      if(row >= GROUP_DELAY_Y && col >= GROUP_DELAY_X)
-      {
-        INT outp[VECT];
-        outp[0] = filter(win1);
-        outp[1] = filter(win2);
-        outp[2] = filter(win3);
-        for(int i = 0; i < VECT; i++)
-          out_pixel(i*WIDTH,(i+1)*WIDTH-1) = outp[i];
-        out_s << out_pixel; 
-      }
-    }
-  }
-}
-
-template<int II_TARGET, int MAX_WIDTH, int MAX_HEIGHT, int KERNEL_SIZE, int VECT, typename INT, typename IN, typename OUT, class Filter>
-void processMISOVECT4(
-    hls::stream<IN> &in1_s, 
-    hls::stream<IN> &in2_s, 
-    hls::stream<OUT> &out_s,
-    const int &width,
-    const int &height,
-    Filter &filter,
-    const enum BorderPadding::values borderPadding)
-{
-  // TODO fix this
-    assert( width <= MAX_WIDTH ); assert( height <= MAX_HEIGHT );
-    assert(VECT==4);
-  
-  IN lineBuff1[SWIN_Y-1][MAX_WIDTH];
-  #pragma HLS ARRAY_PARTITION variable=lineBuff1 dim=1 complete
-  IN win1[SWIN_Y][SWIN_X];
-  #pragma HLS ARRAY_PARTITION variable=win1 dim=0 complete
-  IN win1_tmp[SWIN_Y][SWIN_X];
-  #pragma HLS ARRAY_PARTITION variable=win1_tmp dim=0 complete
-
-  IN lineBuff2[SWIN_Y-1][MAX_WIDTH];
-  #pragma HLS ARRAY_PARTITION variable=lineBuff2 dim=1 complete
-  IN win2[SWIN_Y][SWIN_X];
-  #pragma HLS ARRAY_PARTITION variable=win2 dim=0 complete
-  IN win2_tmp[SWIN_Y][SWIN_X];
-  #pragma HLS ARRAY_PARTITION variable=win2_tmp dim=0 complete
-  
-  INT win1_1[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win1_1 dim=0 complete
-  INT win1_2[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win1_2 dim=0 complete
-  INT win1_3[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win1_3 dim=0 complete
-  INT win1_4[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win1_4 dim=0 complete
-  
-  INT win2_1[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win2_1 dim=0 complete
-  INT win2_2[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win2_2 dim=0 complete
-  INT win2_3[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win2_3 dim=0 complete
-  INT win2_4[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win2_4 dim=0 complete
-
-  IN temp_lb;
-  IN in_pixel1, temp_lb1;
-  IN in_pixel2, temp_lb2;
-  OUT out_pixel;
-
-  int row, col, i, j;
-
-  IMG_ROWS:
-  for(row = 0; row < MAX_HEIGHT+GROUP_DELAY_Y; ++row){
-    //std::cout << "ROW: " << row << std::endl;
-    IMG_COLS:
-    for(col = 0; col < MAX_WIDTH+GROUP_DELAY_X; ++col){
-      PRAGMA_HLS(HLS pipeline ii=II_TARGET)
-      #pragma HLS INLINE region
-      //**********************************************************
-      // GET NEW INPUT
-      //**********************************************************
-      if(col < width & row < height){
-        in1_s >> in_pixel1;
-        in2_s >> in_pixel2;
-      }
-
-      //**********************************************************
-      // UPDATE THE WINDOW
-      // The line buffer behaves normally
-      //**********************************************************
-      if (col < width & row < height + GROUP_DELAY_Y)
-     {
-       for(i = 0; i < SWIN_Y; i++){
-       #pragma HLS unroll
-         for(j = 0; j < SWIN_X-1; j++){
-           win1_tmp[i][j] = win1_tmp[i][j+1];
-           win2_tmp[i][j] = win2_tmp[i][j+1];
-         }
-       }
-     
-
-     //**********************************************************
-     // UPDATE THE LINE BUFFER
-     // The line buffer behaves normally
-     //**********************************************************
-       LINE_BUFF_1:
-       for(i = 0; i < SWIN_Y-1; i++){
-       #pragma HLS unroll
-         if (i == 0) {
-           win1_tmp[i][SWIN_X-1] = lineBuff1[i][col];
-           win2_tmp[i][SWIN_X-1] = lineBuff2[i][col];
-         } else {
-           temp_lb1 = lineBuff1[i][col];
-           temp_lb2 = lineBuff2[i][col];
-           win1_tmp[i][SWIN_X-1] = temp_lb1;
-           win2_tmp[i][SWIN_X-1] = temp_lb2;
-           lineBuff1[i-1][col] = temp_lb1;
-           lineBuff2[i-1][col] = temp_lb2;
-         }
-       }
-       if (SWIN_Y > 1) {
-         lineBuff1[SWIN_Y-2][col] = in_pixel1;
-         lineBuff2[SWIN_Y-2][col] = in_pixel2;
-       }
-       win1_tmp[SWIN_Y-1][SWIN_X-1] = in_pixel1;
-       win2_tmp[SWIN_Y-1][SWIN_X-1] = in_pixel2;
-     
-
-     //**********************************************************
-     // UPDATE THE LP WINDOW
-     // Window update includes mirroring border treatment
-     //**********************************************************
-       // X-DIRECTION
-       for(i = 0; i < SWIN_Y; i++){
-         for(j = 0; j < SWIN_X; j++){
-           int jx = getNewCoords(j,SWIN_X,GROUP_DELAY_X,col,width,borderPadding);
-           win1[i][j] = win1_tmp[i][jx];
-           win2[i][j] = win2_tmp[i][jx];
-         }
-       }
-       // Y-DIRECTION
-       for(i = 0; i < SWIN_Y; i++){
-         for(j = 0; j < SWIN_X; j++){
-           int iy = getNewCoords(i,SWIN_Y,GROUP_DELAY_Y,row,height,borderPadding);
-            win1[i][j] = win1[iy][j];
-            win2[i][j] = win2[iy][j];
-         }
-       }
-     
-     //**********************************************************
-     // ASSIGN WINDOWS 
-     //**********************************************************
-     // left
-       for(int j = 0; j < KERNEL_SIZE; j++){
-         winPos j1 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j  ,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j2 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+1,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j3 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+2,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j4 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+3,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         for(int i = 0; i < KERNEL_SIZE; i++){
-           win1_1[i][j] = win1[i][j1.win]((j1.pos)*WIDTH,(j1.pos+1)*WIDTH-1);
-           win1_2[i][j] = win1[i][j2.win]((j2.pos)*WIDTH,(j2.pos+1)*WIDTH-1);
-           win1_3[i][j] = win1[i][j3.win]((j3.pos)*WIDTH,(j3.pos+1)*WIDTH-1);
-           win1_4[i][j] = win1[i][j4.win]((j4.pos)*WIDTH,(j4.pos+1)*WIDTH-1);
-           
-           win2_1[i][j] = win2[i][j1.win]((j1.pos)*WIDTH,(j1.pos+1)*WIDTH-1);
-           win2_2[i][j] = win2[i][j2.win]((j2.pos)*WIDTH,(j2.pos+1)*WIDTH-1);
-           win2_3[i][j] = win2[i][j3.win]((j3.pos)*WIDTH,(j3.pos+1)*WIDTH-1);
-           win2_4[i][j] = win2[i][j4.win]((j4.pos)*WIDTH,(j4.pos+1)*WIDTH-1);
-         }
-       }
-     }
-      //**********************************************************
-      // DO CALCULATIONS
-      //**********************************************************
-      if(row >= GROUP_DELAY_Y && col >= GROUP_DELAY_X)
-      {
-        INT outp[VECT];
-        outp[0] = filter(win1_1,win2_1);
-        outp[1] = filter(win1_2,win2_2);
-        outp[2] = filter(win1_3,win2_3);
-        outp[3] = filter(win1_4,win2_4);
-        for(int i = 0; i < VECT; i++)
-          out_pixel(i*WIDTH,(i+1)*WIDTH-1) = outp[i];
-        out_s << out_pixel; 
-      }
-    }
-  }
-}
-
-
-  
-template<int II_TARGET, int MAX_WIDTH, int MAX_HEIGHT, int KERNEL_SIZE, int VECT, typename INT, typename IN, typename OUT, class Filter>
-void processVECT4(
-    hls::stream<IN> &in_s, 
-    hls::stream<OUT> &out_s,
-    const int &width,
-    const int &height,
-    Filter &filter,
-    const enum BorderPadding::values borderPadding)
-{
-  // TODO fix this
-    assert( width <= MAX_WIDTH ); assert( height <= MAX_HEIGHT );
-    assert(VECT==4);
-  
-  IN lineBuff[SWIN_Y-1][MAX_WIDTH];
-  #pragma HLS ARRAY_PARTITION variable=lineBuff dim=1 complete
-  IN win[SWIN_Y][SWIN_X];
-  #pragma HLS ARRAY_PARTITION variable=win dim=0 complete
-  IN win_tmp[SWIN_Y][SWIN_X];
-  #pragma HLS ARRAY_PARTITION variable=win_tmp dim=0 complete
-  
-  INT win1[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win1 dim=0 complete
-  INT win2[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win2 dim=0 complete
-  INT win3[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win3 dim=0 complete
-  INT win4[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win4 dim=0 complete
-
-  IN in_pixel, temp_lb;
-  OUT out_pixel;
-  int row, col, i, j;
-
-  IMG_ROWS:
-  for(row = 0; row < MAX_HEIGHT+GROUP_DELAY_Y; ++row){
-    //std::cout << "ROW: " << row << std::endl;
-    IMG_COLS:
-    for(col = 0; col < MAX_WIDTH+GROUP_DELAY_X; ++col){
-      PRAGMA_HLS(HLS pipeline ii=II_TARGET)
-      #pragma HLS INLINE region
-      //**********************************************************
-      // GET NEW INPUT
-      //**********************************************************
-      if(col < width & row < height){
-        in_s >> in_pixel;
-      }
-
-      //**********************************************************
-      // UPDATE THE WINDOW
-      // The line buffer behaves normally
-      //**********************************************************
-      if (col < width & row < height + GROUP_DELAY_Y)
-     {
-       for(i = 0; i < SWIN_Y; i++){
-       #pragma HLS unroll
-         for(j = 0; j < SWIN_X-1; j++){
-           win_tmp[i][j] = win_tmp[i][j+1];
-         }
-       }
-     
-
-     //**********************************************************
-     // UPDATE THE LINE BUFFER
-     // The line buffer behaves normally
-     //**********************************************************
-       LINE_BUFF_1:
-       for(i = 0; i < SWIN_Y-1; i++){
-       #pragma HLS unroll
-         if (i == 0) {
-           win_tmp[i][SWIN_X-1] = lineBuff[i][col];
-         } else {
-           temp_lb = lineBuff[i][col];
-           win_tmp[i][SWIN_X-1] = temp_lb;
-           lineBuff[i-1][col] = temp_lb;
-         }
-       }
-       if (SWIN_Y > 1) {
-         lineBuff[SWIN_Y-2][col] = in_pixel;
-       }
-       win_tmp[SWIN_Y-1][SWIN_X-1] = in_pixel;
-     
-
-     //**********************************************************
-     // UPDATE THE LP WINDOW
-     // Window update includes mirroring border treatment
-     //**********************************************************
-       // X-DIRECTION
-       for(i = 0; i < SWIN_Y; i++){
-         for(j = 0; j < SWIN_X; j++){
-           int jx = getNewCoords(j,SWIN_X,GROUP_DELAY_X,col,width,borderPadding);
-           win[i][j] = win_tmp[i][jx];
-         }
-       }
-       // Y-DIRECTION
-       for(i = 0; i < SWIN_Y; i++){
-         for(j = 0; j < SWIN_X; j++){
-           int iy = getNewCoords(i,SWIN_Y,GROUP_DELAY_Y,row,height,borderPadding);
-            win[i][j] = win[iy][j];
-         }
-       }
-     
-     //**********************************************************
-     // ASSIGN WINDOWS 
-     //**********************************************************
-     // left
-       for(int j = 0; j < KERNEL_SIZE; j++){
-         winPos j1 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j  ,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j2 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+1,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j3 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+2,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j4 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+3,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         for(int i = 0; i < KERNEL_SIZE; i++){
-           win1[i][j] = win[i][j1.win]((j1.pos)*WIDTH,(j1.pos+1)*WIDTH-1);
-           win2[i][j] = win[i][j2.win]((j2.pos)*WIDTH,(j2.pos+1)*WIDTH-1);
-           win3[i][j] = win[i][j3.win]((j3.pos)*WIDTH,(j3.pos+1)*WIDTH-1);
-           win4[i][j] = win[i][j4.win]((j4.pos)*WIDTH,(j4.pos+1)*WIDTH-1);
-         }
-       }
-     }
-      //**********************************************************
-      // DO CALCULATIONS
-      //**********************************************************
-      if(row >= GROUP_DELAY_Y && col >= GROUP_DELAY_X)
-      {
-        OUT outp[VECT];
-        outp[0] = filter(win1);
-        outp[1] = filter(win2);
-        outp[2] = filter(win3);
-        outp[3] = filter(win4);
-        for(int i = 0; i < VECT; i++)
-          out_pixel(i*O_WIDTH,(i+1)*O_WIDTH-1) = outp[i];
-        out_s << out_pixel; 
-      }
-    }
-  }
-}
-
-template<int II_TARGET, int MAX_WIDTH, int MAX_HEIGHT, int KERNEL_SIZE, int VECT, typename INT, typename IN, typename OUT, class Filter>
-void processVECT8(
-    hls::stream<IN> &in_s, 
-    hls::stream<OUT> &out_s,
-    const int &width,
-    const int &height,
-    Filter &filter,
-    const enum BorderPadding::values borderPadding)
-{
-  // TODO fix this
-    assert( width <= MAX_WIDTH ); assert( height <= MAX_HEIGHT );
-    assert(VECT==8);
- 
-  IN lineBuff[SWIN_Y-1][MAX_WIDTH];
-  #pragma HLS ARRAY_PARTITION variable=lineBuff dim=1 complete
-  IN win[SWIN_Y][SWIN_X];
-  #pragma HLS ARRAY_PARTITION variable=win dim=0 complete
-  IN win_tmp[SWIN_Y][SWIN_X];
-  #pragma HLS ARRAY_PARTITION variable=win_tmp dim=0 complete
-  
-  INT win1[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win1 dim=0 complete
-  INT win2[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win2 dim=0 complete
-  INT win3[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win3 dim=0 complete
-  INT win4[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win4 dim=0 complete
-  INT win5[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win5 dim=0 complete
-  INT win6[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win6 dim=0 complete
-  INT win7[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win7 dim=0 complete
-  INT win8[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win8 dim=0 complete
- 
-  IN in_pixel, temp_lb;
-  OUT out_pixel;
-  int row, col, i, j;
-
-  IMG_ROWS:
-  for(row = 0; row < MAX_HEIGHT+GROUP_DELAY_Y; ++row){
-    //std::cout << "ROW: " << row << std::endl;
-    IMG_COLS:
-    for(col = 0; col < MAX_WIDTH+GROUP_DELAY_X; ++col){
-      PRAGMA_HLS(HLS pipeline ii=II_TARGET)
-      #pragma HLS INLINE region
-      //**********************************************************
-      // GET NEW INPUT
-      //**********************************************************
-      if(col < width & row < height){
-        in_s >> in_pixel;
-      }
-
-      //**********************************************************
-      // UPDATE THE WINDOW
-      // The line buffer behaves normally
-      //**********************************************************
-      if (col < width+GROUP_DELAY_X & row < height + GROUP_DELAY_Y)
-      {
-        for(i = 0; i < SWIN_Y; i++){
-        #pragma HLS unroll
-          for(j = 0; j < SWIN_X-1; j++){
-            win_tmp[i][j] = win_tmp[i][j+1];
-          }
-        }
-      } 
-
-     //**********************************************************
-     // UPDATE THE LINE BUFFER
-     // The line buffer behaves normally
-     //**********************************************************
-     if (col < width & row < height + GROUP_DELAY_Y){
-       LINE_BUFF_1:
-       for(i = 0; i < SWIN_Y-1; i++){
-       #pragma HLS unroll
-         if (i == 0) {
-           win_tmp[i][SWIN_X-1] = lineBuff[i][col];
-         } else {
-           temp_lb = lineBuff[i][col];
-           win_tmp[i][SWIN_X-1] = temp_lb;
-           lineBuff[i-1][col] = temp_lb;
-         }
-       }
-       if (SWIN_Y > 1) {
-         lineBuff[SWIN_Y-2][col] = in_pixel;
-       }
-       win_tmp[SWIN_Y-1][SWIN_X-1] = in_pixel;
-      } 
-
-     //**********************************************************
-     // UPDATE THE LP WINDOW
-     // Window update includes mirroring border treatment
-     //**********************************************************
-      if (col < width+GROUP_DELAY_X & row < height + GROUP_DELAY_Y)
-      {
-       // X-DIRECTION
-       for(i = 0; i < SWIN_Y; i++){
-         for(j = 0; j < SWIN_X; j++){
-           int jx = getNewCoords(j,SWIN_X,GROUP_DELAY_X,col,width,borderPadding);
-           win[i][j] = win_tmp[i][jx];
-         }
-       }
-       // Y-DIRECTION
-       for(i = 0; i < SWIN_Y; i++){
-         for(j = 0; j < SWIN_X; j++){
-           int iy = getNewCoords(i,SWIN_Y,GROUP_DELAY_Y,row,height,borderPadding);
-            win[i][j] = win[iy][j];
-         }
-       }
-     
-     //**********************************************************
-     // ASSIGN WINDOWS 
-     //**********************************************************
-     // left
-       for(int j = 0; j < KERNEL_SIZE; j++){
-         winPos j1 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY,col,width,borderPadding);
-         winPos j2 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+1,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j3 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+2,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j4 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+3,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j5 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+4,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY,col,width,borderPadding);
-         winPos j6 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+5,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j7 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+6,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j8 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+7,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         for(int i = 0; i < KERNEL_SIZE; i++){
-           win1[i][j] = win[i][j1.win]((j1.pos)*WIDTH,(j1.pos+1)*WIDTH-1);
-           win2[i][j] = win[i][j2.win]((j2.pos)*WIDTH,(j2.pos+1)*WIDTH-1);
-           win3[i][j] = win[i][j3.win]((j3.pos)*WIDTH,(j3.pos+1)*WIDTH-1);
-           win4[i][j] = win[i][j4.win]((j4.pos)*WIDTH,(j4.pos+1)*WIDTH-1);
-           win5[i][j] = win[i][j5.win]((j5.pos)*WIDTH,(j5.pos+1)*WIDTH-1);
-           win6[i][j] = win[i][j6.win]((j6.pos)*WIDTH,(j6.pos+1)*WIDTH-1);
-           win7[i][j] = win[i][j7.win]((j7.pos)*WIDTH,(j7.pos+1)*WIDTH-1);
-           win8[i][j] = win[i][j8.win]((j8.pos)*WIDTH,(j8.pos+1)*WIDTH-1);
-         }
-       }
-     }
-      //**********************************************************
-      // DO CALCULATIONS
-      //**********************************************************
-      if(row >= GROUP_DELAY_Y && col >= GROUP_DELAY_X)
-      {
-        OUT outp[VECT];
-        outp[0] = filter(win1);
-        outp[1] = filter(win2);
-        outp[2] = filter(win3);
-        outp[3] = filter(win4);
-        outp[4] = filter(win5);
-        outp[5] = filter(win6);
-        outp[6] = filter(win7);
-        outp[7] = filter(win8);
-        for(int i = 0; i < VECT; i++)
-          out_pixel(i*O_WIDTH,(i+1)*O_WIDTH-1) = outp[i];
-        out_s << out_pixel; 
-      }
-    }
-  }
-}
-  
-template<int II_TARGET, int MAX_WIDTH, int MAX_HEIGHT, int KERNEL_SIZE, int VECT, typename INT, typename IN, typename OUT, class Filter>
-void processVECT16(
-    hls::stream<IN> &in_s, 
-    hls::stream<OUT> &out_s,
-    const int &width,
-    const int &height,
-    Filter &filter,
-    const enum BorderPadding::values borderPadding)
-{
-  // TODO fix this
-    assert( width <= MAX_WIDTH ); assert( height <= MAX_HEIGHT );
-    assert(VECT==16);
- 
-  IN lineBuff[SWIN_Y-1][MAX_WIDTH];
-  #pragma HLS ARRAY_PARTITION variable=lineBuff dim=1 complete
-  IN win[SWIN_Y][SWIN_X];
-  #pragma HLS ARRAY_PARTITION variable=win dim=0 complete
-  IN win_tmp[SWIN_Y][SWIN_X];
-  #pragma HLS ARRAY_PARTITION variable=win_tmp dim=0 complete
-  
-  INT win1[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win1 dim=0 complete
-  INT win2[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win2 dim=0 complete
-  INT win3[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win3 dim=0 complete
-  INT win4[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win4 dim=0 complete
-  INT win5[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win5 dim=0 complete
-  INT win6[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win6 dim=0 complete
-  INT win7[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win7 dim=0 complete
-  INT win8[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win8 dim=0 complete
-  INT win9[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win9 dim=0 complete
-  INT win10[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win10 dim=0 complete
-  INT win11[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win11 dim=0 complete
-  INT win12[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win12 dim=0 complete
-  INT win13[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win13 dim=0 complete
-  INT win14[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win14 dim=0 complete
-  INT win15[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win15 dim=0 complete
-  INT win16[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win16 dim=0 complete
-  
-  IN in_pixel, out_pixel, temp_lb;
-
-  int row, col, i, j;
-
-  IMG_ROWS:
-  for(row = 0; row < MAX_HEIGHT+GROUP_DELAY_Y; ++row){
-    //std::cout << "ROW: " << row << std::endl;
-    IMG_COLS:
-    for(col = 0; col < MAX_WIDTH+GROUP_DELAY_X; ++col){
-      PRAGMA_HLS(HLS pipeline ii=II_TARGET)
-      #pragma HLS INLINE region
-      //**********************************************************
-      // GET NEW INPUT
-      //**********************************************************
-      if(col < width & row < height){
-        in_s >> in_pixel;
-      }
-
-      //**********************************************************
-      // UPDATE THE WINDOW
-      // The line buffer behaves normally
-      //**********************************************************
-      if (col < width+GROUP_DELAY_X & row < height + GROUP_DELAY_Y)
-      {
-        for(i = 0; i < SWIN_Y; i++){
-        #pragma HLS unroll
-          for(j = 0; j < SWIN_X-1; j++){
-            win_tmp[i][j] = win_tmp[i][j+1];
-          }
-        }
-      } 
-
-     //**********************************************************
-     // UPDATE THE LINE BUFFER
-     // The line buffer behaves normally
-     //**********************************************************
-     if (col < width & row < height + GROUP_DELAY_Y){
-       LINE_BUFF_1:
-       for(i = 0; i < SWIN_Y-1; i++){
-       #pragma HLS unroll
-         if (i == 0) {
-           win_tmp[i][SWIN_X-1] = lineBuff[i][col];
-         } else {
-           temp_lb = lineBuff[i][col];
-           win_tmp[i][SWIN_X-1] = temp_lb;
-           lineBuff[i-1][col] = temp_lb;
-         }
-       }
-       if (SWIN_Y > 1) {
-         lineBuff[SWIN_Y-2][col] = in_pixel;
-       }
-       win_tmp[SWIN_Y-1][SWIN_X-1] = in_pixel;
-      } 
-
-     //**********************************************************
-     // UPDATE THE LP WINDOW
-     // Window update includes mirroring border treatment
-     //**********************************************************
-      if (col < width+GROUP_DELAY_X & row < height + GROUP_DELAY_Y)
-      {
-       // X-DIRECTION
-       for(i = 0; i < SWIN_Y; i++){
-         for(j = 0; j < SWIN_X; j++){
-           int jx = getNewCoords(j,SWIN_X,GROUP_DELAY_X,col,width,borderPadding);
-           win[i][j] = win_tmp[i][jx];
-         }
-       }
-       // Y-DIRECTION
-       for(i = 0; i < SWIN_Y; i++){
-         for(j = 0; j < SWIN_X; j++){
-           int iy = getNewCoords(i,SWIN_Y,GROUP_DELAY_Y,row,height,borderPadding);
-            win[i][j] = win[iy][j];
-         }
-       }
-     
-     //**********************************************************
-     // ASSIGN WINDOWS 
-     //**********************************************************
-     // left
-       for(int j = 0; j < KERNEL_SIZE; j++){
-         winPos j1 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY,col,width,borderPadding);
-         winPos j2 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+1,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j3 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+2,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j4 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+3,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j5 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+4,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY,col,width,borderPadding);
-         winPos j6 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+5,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j7 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+6,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j8 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+7,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j9 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+8,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY,col,width,borderPadding);
-         winPos j10 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+9,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j11 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+10,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j12 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+11,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j13 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+12,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j14 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+13,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j15 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+14,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j16 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+15,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         for(int i = 0; i < KERNEL_SIZE; i++){
-           win1[i][j] = win[i][j1.win]((j1.pos)*WIDTH,(j1.pos+1)*WIDTH-1);
-           win2[i][j] = win[i][j2.win]((j2.pos)*WIDTH,(j2.pos+1)*WIDTH-1);
-           win3[i][j] = win[i][j3.win]((j3.pos)*WIDTH,(j3.pos+1)*WIDTH-1);
-           win4[i][j] = win[i][j4.win]((j4.pos)*WIDTH,(j4.pos+1)*WIDTH-1);
-           win5[i][j] = win[i][j5.win]((j5.pos)*WIDTH,(j5.pos+1)*WIDTH-1);
-           win6[i][j] = win[i][j6.win]((j6.pos)*WIDTH,(j6.pos+1)*WIDTH-1);
-           win7[i][j] = win[i][j7.win]((j7.pos)*WIDTH,(j7.pos+1)*WIDTH-1);
-           win8[i][j] = win[i][j8.win]((j8.pos)*WIDTH,(j8.pos+1)*WIDTH-1);
-           win9[i][j] = win[i][j9.win]((j9.pos)*WIDTH,(j9.pos+1)*WIDTH-1);
-           win10[i][j] = win[i][j10.win]((j10.pos)*WIDTH,(j10.pos+1)*WIDTH-1);
-           win11[i][j] = win[i][j11.win]((j11.pos)*WIDTH,(j11.pos+1)*WIDTH-1);
-           win12[i][j] = win[i][j12.win]((j12.pos)*WIDTH,(j12.pos+1)*WIDTH-1);
-           win13[i][j] = win[i][j13.win]((j13.pos)*WIDTH,(j13.pos+1)*WIDTH-1);
-           win14[i][j] = win[i][j14.win]((j14.pos)*WIDTH,(j14.pos+1)*WIDTH-1);
-           win15[i][j] = win[i][j15.win]((j15.pos)*WIDTH,(j15.pos+1)*WIDTH-1);
-           win16[i][j] = win[i][j16.win]((j16.pos)*WIDTH,(j16.pos+1)*WIDTH-1);
-         }
-       }
-     }
-      //**********************************************************
-      // DO CALCULATIONS
-      //**********************************************************
-      if(row >= GROUP_DELAY_Y && col >= GROUP_DELAY_X)
-      {
-        INT outp[VECT];
-        outp[0] = filter(win1);
-        outp[1] = filter(win2);
-        outp[2] = filter(win3);
-        outp[3] = filter(win4);
-        outp[4] = filter(win5);
-        outp[5] = filter(win6);
-        outp[6] = filter(win7);
-        outp[7] = filter(win8);
-        outp[8] = filter(win9);
-        outp[9] = filter(win10);
-        outp[10] = filter(win11);
-        outp[11] = filter(win12);
-        outp[12] = filter(win13);
-        outp[13] = filter(win14);
-        outp[14] = filter(win15);
-        outp[15] = filter(win16);
-        for(int i = 0; i < VECT; i++)
-          out_pixel(i*WIDTH,(i+1)*WIDTH-1) = outp[i];
-        out_s << out_pixel; 
-      }
-    }
-  }
-}
-
-
-template<int II_TARGET, int MAX_WIDTH, int MAX_HEIGHT, int KERNEL_SIZE, int VECT, typename INT, typename IN, typename OUT, class Filter>
-void processVECT32(
-    hls::stream<IN> &in_s, 
-    hls::stream<OUT> &out_s,
-    const int &width,
-    const int &height,
-    Filter &filter,
-    const enum BorderPadding::values borderPadding)
-{
-  // TODO fix this
-    assert( width <= MAX_WIDTH ); assert( height <= MAX_HEIGHT );
-    assert(VECT==32);
- 
-  IN lineBuff[SWIN_Y-1][MAX_WIDTH];
-  #pragma HLS ARRAY_PARTITION variable=lineBuff dim=1 complete
-  IN win[SWIN_Y][SWIN_X];
-  #pragma HLS ARRAY_PARTITION variable=win dim=0 complete
-  IN win_tmp[SWIN_Y][SWIN_X];
-  #pragma HLS ARRAY_PARTITION variable=win_tmp dim=0 complete
-  
-  INT win1[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win1 dim=0 complete
-  INT win2[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win2 dim=0 complete
-  INT win3[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win3 dim=0 complete
-  INT win4[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win4 dim=0 complete
-  INT win5[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win5 dim=0 complete
-  INT win6[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win6 dim=0 complete
-  INT win7[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win7 dim=0 complete
-  INT win8[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win8 dim=0 complete
-  INT win9[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win9 dim=0 complete
-  INT win10[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win10 dim=0 complete
-  INT win11[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win11 dim=0 complete
-  INT win12[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win12 dim=0 complete
-  INT win13[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win13 dim=0 complete
-  INT win14[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win14 dim=0 complete
-  INT win15[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win15 dim=0 complete
-  INT win16[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win16 dim=0 complete
-  INT win17[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win17 dim=0 complete
-  INT win18[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win18 dim=0 complete
-  INT win19[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win19 dim=0 complete
-  INT win20[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win20 dim=0 complete
-  INT win21[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win21 dim=0 complete
-  INT win22[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win22 dim=0 complete
-  INT win23[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win23 dim=0 complete
-  INT win24[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win24 dim=0 complete
-  INT win25[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win25 dim=0 complete
-  INT win26[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win26 dim=0 complete
-  INT win27[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win27 dim=0 complete
-  INT win28[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win28 dim=0 complete
-  INT win29[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win29 dim=0 complete
-  INT win30[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win30 dim=0 complete
-  INT win31[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win31 dim=0 complete
-  INT win32[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win32 dim=0 complete
-  
-  IN in_pixel, out_pixel, temp_lb;
-
-  int row, col, i, j;
-
-  IMG_ROWS:
-  for(row = 0; row < MAX_HEIGHT+GROUP_DELAY_Y; ++row){
-    //std::cout << "ROW: " << row << std::endl;
-    IMG_COLS:
-    for(col = 0; col < MAX_WIDTH+GROUP_DELAY_X; ++col){
-      PRAGMA_HLS(HLS pipeline ii=II_TARGET)
-      #pragma HLS INLINE region
-      //**********************************************************
-      // GET NEW INPUT
-      //**********************************************************
-      if(col < width & row < height){
-        in_s >> in_pixel;
-      }
-
-      //**********************************************************
-      // UPDATE THE WINDOW
-      // The line buffer behaves normally
-      //**********************************************************
-      if (col < width+GROUP_DELAY_X & row < height + GROUP_DELAY_Y)
-      {
-        for(i = 0; i < SWIN_Y; i++){
-        #pragma HLS unroll
-          for(j = 0; j < SWIN_X-1; j++){
-            win_tmp[i][j] = win_tmp[i][j+1];
-          }
-        }
-      } 
-
-     //**********************************************************
-     // UPDATE THE LINE BUFFER
-     // The line buffer behaves normally
-     //**********************************************************
-     if (col < width & row < height + GROUP_DELAY_Y){
-       LINE_BUFF_1:
-       for(i = 0; i < SWIN_Y-1; i++){
-       #pragma HLS unroll
-         if (i == 0) {
-           win_tmp[i][SWIN_X-1] = lineBuff[i][col];
-         } else {
-           temp_lb = lineBuff[i][col];
-           win_tmp[i][SWIN_X-1] = temp_lb;
-           lineBuff[i-1][col] = temp_lb;
-         }
-       }
-       if (SWIN_Y > 1) {
-         lineBuff[SWIN_Y-2][col] = in_pixel;
-       }
-       win_tmp[SWIN_Y-1][SWIN_X-1] = in_pixel;
-      } 
-
-     //**********************************************************
-     // UPDATE THE LP WINDOW
-     // Window update includes mirroring border treatment
-     //**********************************************************
-      if (col < width+GROUP_DELAY_X & row < height + GROUP_DELAY_Y)
-      {
-       // X-DIRECTION
-       for(i = 0; i < SWIN_Y; i++){
-         for(j = 0; j < SWIN_X; j++){
-           int jx = getNewCoords(j,SWIN_X,GROUP_DELAY_X,col,width,borderPadding);
-           win[i][j] = win_tmp[i][jx];
-         }
-       }
-       // Y-DIRECTION
-       for(i = 0; i < SWIN_Y; i++){
-         for(j = 0; j < SWIN_X; j++){
-           int iy = getNewCoords(i,SWIN_Y,GROUP_DELAY_Y,row,height,borderPadding);
-            win[i][j] = win[iy][j];
-         }
-       }
-     
-     //**********************************************************
-     // ASSIGN WINDOWS 
-     //**********************************************************
-     // left
-       for(int j = 0; j < KERNEL_SIZE; j++){
-         winPos j1 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY,col,width,borderPadding);
-         winPos j2 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+1,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j3 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+2,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j4 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+3,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j5 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+4,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY,col,width,borderPadding);
-         winPos j6 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+5,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j7 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+6,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j8 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+7,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j9 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+8,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY,col,width,borderPadding);
-         winPos j10 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+9,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j11 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+10,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j12 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+11,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j13 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+12,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j14 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+13,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j15 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+14,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j16 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+15,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j17 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+16,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY,col,width,borderPadding);
-         winPos j18 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+17,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j19 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+18,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j20 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+19,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j21 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+20,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY,col,width,borderPadding);
-         winPos j22 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+21,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j23 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+22,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j24 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+23,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j25 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+24,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY,col,width,borderPadding);
-         winPos j26 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+25,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j27 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+26,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j28 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+27,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j29 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+28,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j30 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+29,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j31 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+10,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j32 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+11,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         for(int i = 0; i < KERNEL_SIZE; i++){
-           win1[i][j] = win[i][j1.win]((j1.pos)*WIDTH,(j1.pos+1)*WIDTH-1);
-           win2[i][j] = win[i][j2.win]((j2.pos)*WIDTH,(j2.pos+1)*WIDTH-1);
-           win3[i][j] = win[i][j3.win]((j3.pos)*WIDTH,(j3.pos+1)*WIDTH-1);
-           win4[i][j] = win[i][j4.win]((j4.pos)*WIDTH,(j4.pos+1)*WIDTH-1);
-           win5[i][j] = win[i][j5.win]((j5.pos)*WIDTH,(j5.pos+1)*WIDTH-1);
-           win6[i][j] = win[i][j6.win]((j6.pos)*WIDTH,(j6.pos+1)*WIDTH-1);
-           win7[i][j] = win[i][j7.win]((j7.pos)*WIDTH,(j7.pos+1)*WIDTH-1);
-           win8[i][j] = win[i][j8.win]((j8.pos)*WIDTH,(j8.pos+1)*WIDTH-1);
-           win9[i][j] = win[i][j9.win]((j9.pos)*WIDTH,(j9.pos+1)*WIDTH-1);
-           win10[i][j] = win[i][j10.win]((j10.pos)*WIDTH,(j10.pos+1)*WIDTH-1);
-           win11[i][j] = win[i][j11.win]((j11.pos)*WIDTH,(j11.pos+1)*WIDTH-1);
-           win12[i][j] = win[i][j12.win]((j12.pos)*WIDTH,(j12.pos+1)*WIDTH-1);
-           win13[i][j] = win[i][j13.win]((j13.pos)*WIDTH,(j13.pos+1)*WIDTH-1);
-           win14[i][j] = win[i][j14.win]((j14.pos)*WIDTH,(j14.pos+1)*WIDTH-1);
-           win15[i][j] = win[i][j15.win]((j15.pos)*WIDTH,(j15.pos+1)*WIDTH-1);
-           win16[i][j] = win[i][j16.win]((j16.pos)*WIDTH,(j16.pos+1)*WIDTH-1);
-           win17[i][j] = win[i][j17.win]((j17.pos)*WIDTH,(j17.pos+1)*WIDTH-1);
-           win18[i][j] = win[i][j18.win]((j18.pos)*WIDTH,(j18.pos+1)*WIDTH-1);
-           win19[i][j] = win[i][j19.win]((j19.pos)*WIDTH,(j19.pos+1)*WIDTH-1);
-           win20[i][j] = win[i][j20.win]((j20.pos)*WIDTH,(j20.pos+1)*WIDTH-1);
-           win21[i][j] = win[i][j21.win]((j21.pos)*WIDTH,(j21.pos+1)*WIDTH-1);
-           win22[i][j] = win[i][j22.win]((j22.pos)*WIDTH,(j22.pos+1)*WIDTH-1);
-           win23[i][j] = win[i][j23.win]((j23.pos)*WIDTH,(j23.pos+1)*WIDTH-1);
-           win24[i][j] = win[i][j24.win]((j24.pos)*WIDTH,(j24.pos+1)*WIDTH-1);
-           win25[i][j] = win[i][j25.win]((j25.pos)*WIDTH,(j25.pos+1)*WIDTH-1);
-           win26[i][j] = win[i][j26.win]((j26.pos)*WIDTH,(j26.pos+1)*WIDTH-1);
-           win27[i][j] = win[i][j27.win]((j27.pos)*WIDTH,(j27.pos+1)*WIDTH-1);
-           win28[i][j] = win[i][j28.win]((j28.pos)*WIDTH,(j28.pos+1)*WIDTH-1);
-           win29[i][j] = win[i][j29.win]((j29.pos)*WIDTH,(j29.pos+1)*WIDTH-1);
-           win30[i][j] = win[i][j30.win]((j30.pos)*WIDTH,(j30.pos+1)*WIDTH-1);
-           win31[i][j] = win[i][j31.win]((j31.pos)*WIDTH,(j31.pos+1)*WIDTH-1);
-           win32[i][j] = win[i][j32.win]((j32.pos)*WIDTH,(j32.pos+1)*WIDTH-1);
-         }
-       }
-     }
-      //**********************************************************
-      // DO CALCULATIONS
-      //**********************************************************
-      if(row >= GROUP_DELAY_Y && col >= GROUP_DELAY_X)
-      {
-        INT outp[VECT];
-        outp[0] = filter(win1);
-        outp[1] = filter(win2);
-        outp[2] = filter(win3);
-        outp[3] = filter(win4);
-        outp[4] = filter(win5);
-        outp[5] = filter(win6);
-        outp[6] = filter(win7);
-        outp[7] = filter(win8);
-        outp[8] = filter(win9);
-        outp[9] = filter(win10);
-        outp[10] = filter(win11);
-        outp[11] = filter(win12);
-        outp[12] = filter(win13);
-        outp[13] = filter(win14);
-        outp[14] = filter(win15);
-        outp[15] = filter(win16);
-        outp[16] = filter(win17);
-        outp[17] = filter(win18);
-        outp[18] = filter(win19);
-        outp[19] = filter(win20);
-        outp[20] = filter(win21);
-        outp[21] = filter(win22);
-        outp[22] = filter(win23);
-        outp[23] = filter(win24);
-        outp[24] = filter(win25);
-        outp[25] = filter(win26);
-        outp[26] = filter(win27);
-        outp[27] = filter(win28);
-        outp[28] = filter(win29);
-        outp[29] = filter(win30);
-        outp[30] = filter(win31);
-        outp[31] = filter(win32);
-        for(int i = 0; i < VECT; i++)
-          out_pixel(i*WIDTH,(i+1)*WIDTH-1) = outp[i];
-        out_s << out_pixel; 
-      }
-    }
-  }
-}
-
-
-template<int II_TARGET, int MAX_WIDTH, int MAX_HEIGHT, int KERNEL_SIZE, int VECT, typename INT, typename IN, typename OUT, class Filter>
-void processVECT64(
-    hls::stream<IN> &in_s, 
-    hls::stream<OUT> &out_s,
-    const int &width,
-    const int &height,
-    Filter &filter,
-    const enum BorderPadding::values borderPadding)
-{
-  // TODO fix this
-    assert( width <= MAX_WIDTH ); assert( height <= MAX_HEIGHT );
-    assert(VECT==64);
- 
-  IN lineBuff[SWIN_Y-1][MAX_WIDTH];
-  #pragma HLS ARRAY_PARTITION variable=lineBuff dim=1 complete
-  IN win[SWIN_Y][SWIN_X];
-  #pragma HLS ARRAY_PARTITION variable=win dim=0 complete
-  IN win_tmp[SWIN_Y][SWIN_X];
-  #pragma HLS ARRAY_PARTITION variable=win_tmp dim=0 complete
-  
-  INT win1[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win1 dim=0 complete
-  INT win2[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win2 dim=0 complete
-  INT win3[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win3 dim=0 complete
-  INT win4[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win4 dim=0 complete
-  INT win5[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win5 dim=0 complete
-  INT win6[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win6 dim=0 complete
-  INT win7[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win7 dim=0 complete
-  INT win8[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win8 dim=0 complete
-  INT win9[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win9 dim=0 complete
-  INT win10[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win10 dim=0 complete
-  INT win11[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win11 dim=0 complete
-  INT win12[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win12 dim=0 complete
-  INT win13[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win13 dim=0 complete
-  INT win14[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win14 dim=0 complete
-  INT win15[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win15 dim=0 complete
-  INT win16[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win16 dim=0 complete
-  INT win17[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win17 dim=0 complete
-  INT win18[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win18 dim=0 complete
-  INT win19[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win19 dim=0 complete
-  INT win20[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win20 dim=0 complete
-  INT win21[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win21 dim=0 complete
-  INT win22[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win22 dim=0 complete
-  INT win23[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win23 dim=0 complete
-  INT win24[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win24 dim=0 complete
-  INT win25[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win25 dim=0 complete
-  INT win26[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win26 dim=0 complete
-  INT win27[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win27 dim=0 complete
-  INT win28[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win28 dim=0 complete
-  INT win29[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win29 dim=0 complete
-  INT win30[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win30 dim=0 complete
-  INT win31[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win31 dim=0 complete
-  INT win32[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win32 dim=0 complete
-  INT win33[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win33 dim=0 complete
-  INT win34[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win34 dim=0 complete
-  INT win35[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win35 dim=0 complete
-  INT win36[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win36 dim=0 complete
-  INT win37[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win37 dim=0 complete
-  INT win38[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win38 dim=0 complete
-  INT win39[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win39 dim=0 complete
-  INT win40[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win40 dim=0 complete
-  INT win41[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win41 dim=0 complete
-  INT win42[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win42 dim=0 complete
-  INT win43[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win43 dim=0 complete
-  INT win44[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win44 dim=0 complete
-  INT win45[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win45 dim=0 complete
-  INT win46[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win46 dim=0 complete
-  INT win47[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win47 dim=0 complete
-  INT win48[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win48 dim=0 complete
-  INT win49[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win49 dim=0 complete
-  INT win50[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win50 dim=0 complete
-  INT win51[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win51 dim=0 complete
-  INT win52[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win52 dim=0 complete
-  INT win53[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win53 dim=0 complete
-  INT win54[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win54 dim=0 complete
-  INT win55[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win55 dim=0 complete
-  INT win56[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win56 dim=0 complete
-  INT win57[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win57 dim=0 complete
-  INT win58[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win58 dim=0 complete
-  INT win59[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win59 dim=0 complete
-  INT win60[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win60 dim=0 complete
-  INT win61[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win61 dim=0 complete
-  INT win62[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win62 dim=0 complete
-  INT win63[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win63 dim=0 complete
-  INT win64[KERNEL_SIZE][KERNEL_SIZE];
-  #pragma HLS ARRAY_PARTITION variable=win64 dim=0 complete
-  
-  IN in_pixel, out_pixel, temp_lb;
-
-  int row, col, i, j;
-
-  IMG_ROWS:
-  for(row = 0; row < MAX_HEIGHT+GROUP_DELAY_Y; ++row){
-    //std::cout << "ROW: " << row << std::endl;
-    IMG_COLS:
-    for(col = 0; col < MAX_WIDTH+GROUP_DELAY_X; ++col){
+  for(int row = 0; row < height; row++){
+    for(int col = 0; col < width; col++){
       PRAGMA_HLS(HLS pipeline ii=II_TARGET)
       #pragma HLS INLINE region
-      //**********************************************************
-      // GET NEW INPUT
-      //**********************************************************
-      if(col < width & row < height){
-        in_s >> in_pixel;
+      for(int p = 0; p < PARTS; p++){
+      #pragma HLS unroll
+        if(col >= p*part & (p == PARTS-1 | col < (p+1)*part))
+          in_s[p] >> temp;
       }
+      out_s << temp;
+    }
+  }
+}
 
-      //**********************************************************
-      // UPDATE THE WINDOW
-      // The line buffer behaves normally
-      //**********************************************************
-      if (col < width+GROUP_DELAY_X & row < height + GROUP_DELAY_Y)
-      {
-        for(i = 0; i < SWIN_Y; i++){
-        #pragma HLS unroll
-          for(j = 0; j < SWIN_X-1; j++){
-            win_tmp[i][j] = win_tmp[i][j+1];
-          }
-        }
-      } 
+//*********************************************************************************************************************
+// LOCAL OPERATORS VECTOR
+//*********************************************************************************************************************
+struct winPos
+{
+  int win;
+  int pos;
+};
+typedef struct winPos winPos;
 
-     //**********************************************************
-     // UPDATE THE LINE BUFFER
-     // The line buffer behaves normally
-     //**********************************************************
-     if (col < width & row < height + GROUP_DELAY_Y){
-       LINE_BUFF_1:
-       for(i = 0; i < SWIN_Y-1; i++){
-       #pragma HLS unroll
-         if (i == 0) {
-           win_tmp[i][SWIN_X-1] = lineBuff[i][col];
-         } else {
-           temp_lb = lineBuff[i][col];
-           win_tmp[i][SWIN_X-1] = temp_lb;
-           lineBuff[i-1][col] = temp_lb;
-         }
-       }
-       if (SWIN_Y > 1) {
-         lineBuff[SWIN_Y-2][col] = in_pixel;
-       }
-       win_tmp[SWIN_Y-1][SWIN_X-1] = in_pixel;
-      } 
+// Position of pixel i of the vectorized window after border handling.
+// The window holds the kernel_v vectors up to vector colv, pixel 0 is the
+// leftmost pixel required by the first lane of the center vector. Pixels
+// outside of the image are mapped back into the image; for BORDER_CONST the
+// window index kernel_v is returned, which holds the constant.
+winPos getWinCoords(int i, int kernel_x, int kernel_v, int vect, int colv, int width, const enum BorderPadding::values borderPadding)
+{
+#pragma HLS INLINE
+  winPos temp;
 
-     //**********************************************************
-     // UPDATE THE LP WINDOW
-     // Window update includes mirroring border treatment
-     //**********************************************************
-      if (col < width+GROUP_DELAY_X & row < height + GROUP_DELAY_Y)
-      {
-       // X-DIRECTION
-       for(i = 0; i < SWIN_Y; i++){
-         for(j = 0; j < SWIN_X; j++){
-           int jx = getNewCoords(j,SWIN_X,GROUP_DELAY_X,col,width,borderPadding);
-           win[i][j] = win_tmp[i][jx];
-         }
-       }
-       // Y-DIRECTION
-       for(i = 0; i < SWIN_Y; i++){
-         for(j = 0; j < SWIN_X; j++){
-           int iy = getNewCoords(i,SWIN_Y,GROUP_DELAY_Y,row,height,borderPadding);
-            win[i][j] = win[iy][j];
-         }
-       }
-     
-     //**********************************************************
-     // ASSIGN WINDOWS 
-     //**********************************************************
-     // left
-       for(int j = 0; j < KERNEL_SIZE; j++){
-         winPos j1 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j,  KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY,col,width,borderPadding);
-         winPos j2 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+1,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j3 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+2,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j4 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+3,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j5 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+4,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY,col,width,borderPadding);
-         winPos j6 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+5,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j7 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+6,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j8 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+7,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j9 =  getWinCoords((SRADIUS_X*VECT)-RADIUS+j+8,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j10 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+9,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j11 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+10,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j12 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+11,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j13 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+12,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j14 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+13,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j15 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+14,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j16 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+15,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j17 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+16,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j18 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+17,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j19 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+18,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j20 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+19,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j21 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+20,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j22 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+21,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j23 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+22,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j24 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+23,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j25 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+24,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j26 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+25,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j27 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+26,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j28 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+27,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j29 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+28,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j30 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+29,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j31 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+30,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j32 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+31,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j33 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+32,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j34 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+33,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j35 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+34,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j36 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+35,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j37 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+36,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j38 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+37,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j39 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+38,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j40 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+39,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j41 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+40,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j42 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+41,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j43 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+42,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j44 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+43,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j45 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+44,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j46 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+45,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j47 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+46,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j48 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+47,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j49 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+48,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j50 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+49,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j51 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+50,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j52 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+51,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j53 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+52,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j54 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+53,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j55 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+54,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j56 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+55,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j57 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+56,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j58 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+57,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j59 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+58,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j60 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+59,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j61 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+60,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j62 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+61,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j63 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+62,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY_X,col,width,borderPadding);
-         winPos j64 = getWinCoords((SRADIUS_X*VECT)-RADIUS+j+63,KERNEL_SIZE, SWIN_X,VECT,GROUP_DELAY,col,width,borderPadding);
-         for(int i = 0; i < KERNEL_SIZE; i++){
-           win1[i][j] = win[i][j1.win]((j1.pos)*WIDTH,(j1.pos+1)*WIDTH-1);
-           win2[i][j] = win[i][j2.win]((j2.pos)*WIDTH,(j2.pos+1)*WIDTH-1);
-           win3[i][j] = win[i][j3.win]((j3.pos)*WIDTH,(j3.pos+1)*WIDTH-1);
-           win4[i][j] = win[i][j4.win]((j4.pos)*WIDTH,(j4.pos+1)*WIDTH-1);
-           win5[i][j] = win[i][j5.win]((j5.pos)*WIDTH,(j5.pos+1)*WIDTH-1);
-           win6[i][j] = win[i][j6.win]((j6.pos)*WIDTH,(j6.pos+1)*WIDTH-1);
-           win7[i][j] = win[i][j7.win]((j7.pos)*WIDTH,(j7.pos+1)*WIDTH-1);
-           win8[i][j] = win[i][j8.win]((j8.pos)*WIDTH,(j8.pos+1)*WIDTH-1);
-           win9[i][j] = win[i][j9.win]((j9.pos)*WIDTH,(j9.pos+1)*WIDTH-1);
-           win10[i][j] = win[i][j10.win]((j10.pos)*WIDTH,(j10.pos+1)*WIDTH-1);
-           win11[i][j] = win[i][j11.win]((j11.pos)*WIDTH,(j11.pos+1)*WIDTH-1);
-           win12[i][j] = win[i][j12.win]((j12.pos)*WIDTH,(j12.pos+1)*WIDTH-1);
-           win13[i][j] = win[i][j13.win]((j13.pos)*WIDTH,(j13.pos+1)*WIDTH-1);
-           win14[i][j] = win[i][j14.win]((j14.pos)*WIDTH,(j14.pos+1)*WIDTH-1);
-           win15[i][j] = win[i][j15.win]((j15.pos)*WIDTH,(j15.pos+1)*WIDTH-1);
-           win16[i][j] = win[i][j16.win]((j16.pos)*WIDTH,(j16.pos+1)*WIDTH-1);
-           win17[i][j] = win[i][j17.win]((j17.pos)*WIDTH,(j17.pos+1)*WIDTH-1);
-           win18[i][j] = win[i][j18.win]((j18.pos)*WIDTH,(j18.pos+1)*WIDTH-1);
-           win19[i][j] = win[i][j19.win]((j19.pos)*WIDTH,(j19.pos+1)*WIDTH-1);
-           win20[i][j] = win[i][j20.win]((j20.pos)*WIDTH,(j20.pos+1)*WIDTH-1);
-           win21[i][j] = win[i][j21.win]((j21.pos)*WIDTH,(j21.pos+1)*WIDTH-1);
-           win22[i][j] = win[i][j22.win]((j22.pos)*WIDTH,(j22.pos+1)*WIDTH-1);
-           win23[i][j] = win[i][j23.win]((j23.pos)*WIDTH,(j23.pos+1)*WIDTH-1);
-           win24[i][j] = win[i][j24.win]((j24.pos)*WIDTH,(j24.pos+1)*WIDTH-1);
-           win25[i][j] = win[i][j25.win]((j25.pos)*WIDTH,(j25.pos+1)*WIDTH-1);
-           win26[i][j] = win[i][j26.win]((j26.pos)*WIDTH,(j26.pos+1)*WIDTH-1);
-           win27[i][j] = win[i][j27.win]((j27.pos)*WIDTH,(j27.pos+1)*WIDTH-1);
-           win28[i][j] = win[i][j28.win]((j28.pos)*WIDTH,(j28.pos+1)*WIDTH-1);
-           win29[i][j] = win[i][j29.win]((j29.pos)*WIDTH,(j29.pos+1)*WIDTH-1);
-           win30[i][j] = win[i][j30.win]((j30.pos)*WIDTH,(j30.pos+1)*WIDTH-1);
-           win31[i][j] = win[i][j31.win]((j31.pos)*WIDTH,(j31.pos+1)*WIDTH-1);
-           win32[i][j] = win[i][j32.win]((j32.pos)*WIDTH,(j32.pos+1)*WIDTH-1);
-           win33[i][j] = win[i][j33.win]((j33.pos)*WIDTH,(j33.pos+1)*WIDTH-1);
-           win34[i][j] = win[i][j34.win]((j34.pos)*WIDTH,(j34.pos+1)*WIDTH-1);
-           win35[i][j] = win[i][j35.win]((j35.pos)*WIDTH,(j35.pos+1)*WIDTH-1);
-           win36[i][j] = win[i][j36.win]((j36.pos)*WIDTH,(j36.pos+1)*WIDTH-1);
-           win37[i][j] = win[i][j37.win]((j37.pos)*WIDTH,(j37.pos+1)*WIDTH-1);
-           win38[i][j] = win[i][j38.win]((j38.pos)*WIDTH,(j38.pos+1)*WIDTH-1);
-           win39[i][j] = win[i][j39.win]((j39.pos)*WIDTH,(j39.pos+1)*WIDTH-1);
-           win40[i][j] = win[i][j40.win]((j40.pos)*WIDTH,(j40.pos+1)*WIDTH-1);
-           win41[i][j] = win[i][j41.win]((j41.pos)*WIDTH,(j41.pos+1)*WIDTH-1);
-           win42[i][j] = win[i][j42.win]((j42.pos)*WIDTH,(j42.pos+1)*WIDTH-1);
-           win43[i][j] = win[i][j43.win]((j43.pos)*WIDTH,(j43.pos+1)*WIDTH-1);
-           win44[i][j] = win[i][j44.win]((j44.pos)*WIDTH,(j44.pos+1)*WIDTH-1);
-           win45[i][j] = win[i][j45.win]((j45.pos)*WIDTH,(j45.pos+1)*WIDTH-1);
-           win46[i][j] = win[i][j46.win]((j46.pos)*WIDTH,(j46.pos+1)*WIDTH-1);
-           win47[i][j] = win[i][j47.win]((j47.pos)*WIDTH,(j47.pos+1)*WIDTH-1);
-           win48[i][j] = win[i][j48.win]((j48.pos)*WIDTH,(j48.pos+1)*WIDTH-1);
-           win49[i][j] = win[i][j49.win]((j49.pos)*WIDTH,(j49.pos+1)*WIDTH-1);
-           win50[i][j] = win[i][j50.win]((j50.pos)*WIDTH,(j50.pos+1)*WIDTH-1);
-           win51[i][j] = win[i][j51.win]((j51.pos)*WIDTH,(j51.pos+1)*WIDTH-1);
-           win52[i][j] = win[i][j52.win]((j52.pos)*WIDTH,(j52.pos+1)*WIDTH-1);
-           win53[i][j] = win[i][j53.win]((j53.pos)*WIDTH,(j53.pos+1)*WIDTH-1);
-           win54[i][j] = win[i][j54.win]((j54.pos)*WIDTH,(j54.pos+1)*WIDTH-1);
-           win55[i][j] = win[i][j55.win]((j55.pos)*WIDTH,(j55.pos+1)*WIDTH-1);
-           win56[i][j] = win[i][j56.win]((j56.pos)*WIDTH,(j56.pos+1)*WIDTH-1);
-           win57[i][j] = win[i][j57.win]((j57.pos)*WIDTH,(j57.pos+1)*WIDTH-1);
-           win58[i][j] = win[i][j58.win]((j58.pos)*WIDTH,(j58.pos+1)*WIDTH-1);
-           win59[i][j] = win[i][j59.win]((j59.pos)*WIDTH,(j59.pos+1)*WIDTH-1);
-           win60[i][j] = win[i][j60.win]((j60.pos)*WIDTH,(j60.pos+1)*WIDTH-1);
-           win61[i][j] = win[i][j61.win]((j61.pos)*WIDTH,(j61.pos+1)*WIDTH-1);
-           win62[i][j] = win[i][j62.win]((j62.pos)*WIDTH,(j62.pos+1)*WIDTH-1);
-           win63[i][j] = win[i][j63.win]((j63.pos)*WIDTH,(j63.pos+1)*WIDTH-1);
-           win64[i][j] = win[i][j64.win]((j64.pos)*WIDTH,(j64.pos+1)*WIDTH-1);
-         }
-       }
-     }
-      //**********************************************************
-      // DO CALCULATIONS
-      //**********************************************************
-      if(row >= GROUP_DELAY_Y && col >= GROUP_DELAY_X)
-      {
-        INT outp[VECT];
-        outp[0] = filter(win1);
-        outp[1] = filter(win2);
-        outp[2] = filter(win3);
-        outp[3] = filter(win4);
-        outp[4] = filter(win5);
-        outp[5] = filter(win6);
-        outp[6] = filter(win7);
-        outp[7] = filter(win8);
-        outp[8] = filter(win9);
-        outp[9] = filter(win10);
-        outp[10] = filter(win11);
-        outp[11] = filter(win12);
-        outp[12] = filter(win13);
-        outp[13] = filter(win14);
-        outp[14] = filter(win15);
-        outp[15] = filter(win16);
-        outp[16] = filter(win17);
-        outp[17] = filter(win18);
-        outp[18] = filter(win19);
-        outp[19] = filter(win20);
-        outp[20] = filter(win21);
-        outp[21] = filter(win22);
-        outp[22] = filter(win23);
-        outp[23] = filter(win24);
-        outp[24] = filter(win25);
-        outp[25] = filter(win26);
-        outp[26] = filter(win27);
-        outp[27] = filter(win28);
-        outp[28] = filter(win29);
-        outp[29] = filter(win30);
-        outp[30] = filter(win31);
-        outp[31] = filter(win32);
-        outp[32] = filter(win33);
-        outp[33] = filter(win34);
-        outp[34] = filter(win35);
-        outp[35] = filter(win36);
-        outp[36] = filter(win37);
-        outp[37] = filter(win38);
-        outp[38] = filter(win39);
-        outp[39] = filter(win40);
-        outp[40] = filter(win41);
-        outp[41] = filter(win42);
-        outp[42] = filter(win43);
-        outp[43] = filter(win44);
-        outp[44] = filter(win45);
-        outp[45] = filter(win46);
-        outp[46] = filter(win47);
-        outp[47] = filter(win48);
-        outp[48] = filter(win49);
-        outp[49] = filter(win50);
-        outp[50] = filter(win51);
-        outp[51] = filter(win52);
-        outp[52] = filter(win53);
-        outp[53] = filter(win54);
-        outp[54] = filter(win55);
-        outp[55] = filter(win56);
-        outp[56] = filter(win57);
-        outp[57] = filter(win58);
-        outp[58] = filter(win59);
-        outp[59] = filter(win60);
-        outp[60] = filter(win61);
-        outp[61] = filter(win62);
-        outp[62] = filter(win63);
-        outp[63] = filter(win64);
-        for(int i = 0; i < VECT; i++)
-          out_pixel(i*WIDTH,(i+1)*WIDTH-1) = outp[i];
-        out_s << out_pixel; 
-      }
+  // first vector in the window and image column of the pixel
+  int first = colv - (kernel_v-1);
+  int x = (colv - kernel_v/2)*vect - kernel_x/2 + i;
+
+  if(x < 0 || x >= width){
+    switch (borderPadding){
+      case BorderPadding::BORDER_CLAMP:
+        x = (x < 0) ? 0 : width-1;
+        break;
+      case BorderPadding::BORDER_MIRROR:
+        x = (x < 0) ? -x-1 : 2*width-x-1;
+        break;
+      case BorderPadding::BORDER_MIRROR_101:
+        x = (x < 0) ? -x : 2*width-x-2;
+        break;
+      case BorderPadding::BORDER_CONST:
+      default:
+        temp.win = kernel_v;
+        temp.pos = 0;
+        return temp;
     }
   }
+
+  temp.win = x/vect - first;
+  temp.pos = x%vect;
+  return temp;
 }
 
 
@@ -3645,7 +1167,7 @@ void process(
   #endif
 
   IN lineBuff[KERNEL_SIZE_Y-1][MAX_WIDTH];
-  #pragma HLS ARRAY_PARTITION variable=lineBuff dim=1 complete
+  PRAGMA_HLS_LINE_BUFFER(lineBuff)
   IN win[KERNEL_SIZE_Y][KERNEL_SIZE_X];
   #pragma HLS ARRAY_PARTITION variable=win dim=0 complete
   IN win_tmp[KERNEL_SIZE_Y][KERNEL_SIZE_X];
@@ -3656,8 +1178,10 @@ void process(
   int i, j ,row, col;
 
   process_main_loop:
-  for (int row = 0; row < MAX_HEIGHT + GDELAY_Y; row++) {
-    for (int col = 0; col < MAX_WIDTH + GDELAY_X; col++) {
+  for (int row = 0; row < LOOP_HEIGHT + GDELAY_Y; row++) {
+    PRAGMA_HLS(HLS loop_tripcount max=MAX_HEIGHT)
+    for (int col = 0; col < LOOP_WIDTH + GDELAY_X; col++) {
+      PRAGMA_HLS(HLS loop_tripcount max=MAX_WIDTH)
       PRAGMA_HLS(HLS pipeline ii=II_TARGET)
       #pragma HLS INLINE region
 
@@ -3750,7 +1274,7 @@ void processSIMO(
 #endif
   
   IN lineBuff[KERNEL_SIZE_Y-1][MAX_WIDTH];
-  #pragma HLS ARRAY_PARTITION variable=lineBuff dim=1 complete
+  PRAGMA_HLS_LINE_BUFFER(lineBuff)
   IN win[KERNEL_SIZE_Y][KERNEL_SIZE_X];
   #pragma HLS ARRAY_PARTITION variable=win dim=0 complete
   IN win_tmp[KERNEL_SIZE_Y][KERNEL_SIZE_X];
@@ -3761,9 +1285,11 @@ void processSIMO(
   int i, j ,row, col;
   
   ROW_LOOP:
-  for (int row = 0; row < MAX_HEIGHT + GDELAY_Y; row++) {
+  for (int row = 0; row < LOOP_HEIGHT + GDELAY_Y; row++) {
+    PRAGMA_HLS(HLS loop_tripcount max=MAX_HEIGHT)
     COL_LOOP:
-    for (int col = 0; col < MAX_WIDTH + GDELAY_X; col++) {
+    for (int col = 0; col < LOOP_WIDTH + GDELAY_X; col++) {
+      PRAGMA_HLS(HLS loop_tripcount max=MAX_WIDTH)
       PRAGMA_HLS(HLS pipeline ii=II_TARGET)
       #pragma HLS INLINE region
     
@@ -3857,14 +1383,14 @@ void processMISO(
   #endif
 
   IN lineBuff1[KERNEL_SIZE_Y-1][MAX_WIDTH];
-  #pragma HLS ARRAY_PARTITION variable=lineBuff1 dim=1 complete
+  PRAGMA_HLS_LINE_BUFFER(lineBuff1)
   IN win1[KERNEL_SIZE_Y][KERNEL_SIZE_X];
   #pragma HLS ARRAY_PARTITION variable=win1 dim=0 complete
   IN win1_tmp[KERNEL_SIZE_Y][KERNEL_SIZE_X];
   #pragma HLS ARRAY_PARTITION variable=win1_tmp dim=0 complete
 
   IN lineBuff2[KERNEL_SIZE_Y-1][MAX_WIDTH];
-  #pragma HLS ARRAY_PARTITION variable=lineBuff2 dim=1 complete
+  PRAGMA_HLS_LINE_BUFFER(lineBuff2)
   IN win2[KERNEL_SIZE_Y][KERNEL_SIZE_X];
   #pragma HLS ARRAY_PARTITION variable=win2 dim=0 complete
   IN win2_tmp[KERNEL_SIZE_Y][KERNEL_SIZE_X];
@@ -3877,8 +1403,10 @@ void processMISO(
   int i, j ,row, col;
 
   process_main_loop:
-  for (int row = 0; row < MAX_HEIGHT + GDELAY_Y; row++) {
-    for (int col = 0; col < MAX_WIDTH + GDELAY_X; col++) {
+  for (int row = 0; row < LOOP_HEIGHT + GDELAY_Y; row++) {
+    PRAGMA_HLS(HLS loop_tripcount max=MAX_HEIGHT)
+    for (int col = 0; col < LOOP_WIDTH + GDELAY_X; col++) {
+      PRAGMA_HLS(HLS loop_tripcount max=MAX_WIDTH)
       PRAGMA_HLS(HLS pipeline ii=II_TARGET)
       #pragma HLS INLINE region
 
@@ -4257,6 +1785,281 @@ void processPixels3(
     }
 }
 
+//*********************************************************************************************************************
+// GLOBAL OPERATORS
+//*********************************************************************************************************************
+// Sink processes reducing the whole stream to a single value (min/max/sum/...)
+// or to a histogram. The reduction is carried in HIPACC_REDUCE_PARTIALS
+// interleaved partial results, so that reduce functions with a latency of
+// several cycles (e.g. float additions) still sustain II_TARGET=1. The
+// partial results are combined once the stream has been consumed.
+#ifndef HIPACC_REDUCE_PARTIALS
+#define HIPACC_REDUCE_PARTIALS 8
+#endif
+
+// combine the partial results of the reduction
+template<typename OUT, class Reduce>
+OUT reducePartials(
+    OUT partial[HIPACC_REDUCE_PARTIALS],
+    const int &count,
+    Reduce &reduce)
+{
+  OUT result = partial[0];
+  for (int i = 1; i < HIPACC_REDUCE_PARTIALS; ++i) {
+    if (i < count)
+      result = reduce(result, partial[i]);
+  }
+  return result;
+}
+
+// combine the first count lanes of a vector in a tree of depth log2(VECT),
+// lanes beyond count hold the padding of the last vector of a row
+template<int VECT, typename INT, class Reduce>
+INT reduceLanes(
+    INT lane[VECT],
+    const int &count,
+    Reduce &reduce)
+{
+  for (int s = 1; s < VECT; s *= 2) {
+    #pragma HLS unroll
+    for (int i = 0; i + s < VECT; i += 2*s) {
+      #pragma HLS unroll
+      if (i + s < count)
+        lane[i] = reduce(lane[i], lane[i+s]);
+    }
+  }
+  return lane[0];
+}
+
+template<int II_TARGET, int MAX_WIDTH, int MAX_HEIGHT, typename IN, typename OUT, class Reduce>
+void reduceStream(
+    hls::stream<IN> &in_s,
+    OUT &result,
+    const int &width,
+    const int &height,
+    Reduce &reduce)
+{
+  assert(width <= MAX_WIDTH); assert(height <= MAX_HEIGHT);
+
+  OUT partial[HIPACC_REDUCE_PARTIALS];
+  #pragma HLS ARRAY_PARTITION variable=partial dim=0 complete
+  PRAGMA_HLS(HLS DEPENDENCE variable=partial inter distance=HIPACC_REDUCE_PARTIALS true)
+  int part = 0, count = 0;
+
+  for (int y = 0; y < height; ++y)
+    for (int x = 0; x < width; ++x) {
+      PRAGMA_HLS(HLS pipeline ii=II_TARGET)
+      const IN val = in_s.read();
+      partial[part] = (count < HIPACC_REDUCE_PARTIALS) ?
+                      (OUT)val : reduce(partial[part], val);
+      part = (part == HIPACC_REDUCE_PARTIALS-1) ? 0 : part+1;
+      if (count < HIPACC_REDUCE_PARTIALS)
+        ++count;
+    }
+
+  if (count)
+    result = reducePartials(partial, count, reduce);
+}
+
+template<int II_TARGET, int MAX_WIDTH, int MAX_HEIGHT, int VECT, typename INT, int BW_IN, class Reduce>
+void reduceStreamVECT(
+    hls::stream<ap_uint<BW_IN> > &in_s,
+    INT &result,
+    const int &width,
+    const int &height,
+    Reduce &reduce)
+{
+  assert(width <= MAX_WIDTH); assert(height <= MAX_HEIGHT);
+
+  INT partial[HIPACC_REDUCE_PARTIALS];
+  #pragma HLS ARRAY_PARTITION variable=partial dim=0 complete
+  PRAGMA_HLS(HLS DEPENDENCE variable=partial inter distance=HIPACC_REDUCE_PARTIALS true)
+  int part = 0, count = 0;
+
+  for (int y = 0; y < height; ++y)
+    for (int x = 0; x < width; x+=VECT) {
+      PRAGMA_HLS(HLS pipeline ii=II_TARGET)
+      const ap_uint<BW_IN> val = in_s.read();
+      INT lane[VECT];
+      #pragma HLS ARRAY_PARTITION variable=lane dim=0 complete
+      for(int i = 0; i < VECT; i++){
+        #pragma HLS unroll
+        lane[i] = val(i*I_WIDTH_V,(i+1)*I_WIDTH_V-1);
+      }
+      const INT lanes = reduceLanes<VECT>(lane, width - x, reduce);
+      partial[part] = (count < HIPACC_REDUCE_PARTIALS) ?
+                      lanes : reduce(partial[part], lanes);
+      part = (part == HIPACC_REDUCE_PARTIALS-1) ? 0 : part+1;
+      if (count < HIPACC_REDUCE_PARTIALS)
+        ++count;
+    }
+
+  if (count)
+    result = reducePartials(partial, count, reduce);
+}
+
+template<int II_TARGET, int MAX_WIDTH, int MAX_HEIGHT, int VECT, typename INT, int BW_IN, class Reduce>
+void reduceStreamVECTF(
+    hls::stream<ap_uint<BW_IN> > &in_s,
+    INT &result,
+    const int &width,
+    const int &height,
+    Reduce &reduce)
+{
+  assert(width <= MAX_WIDTH); assert(height <= MAX_HEIGHT);
+
+  INT partial[HIPACC_REDUCE_PARTIALS];
+  #pragma HLS ARRAY_PARTITION variable=partial dim=0 complete
+  PRAGMA_HLS(HLS DEPENDENCE variable=partial inter distance=HIPACC_REDUCE_PARTIALS true)
+  int part = 0, count = 0;
+
+  for (int y = 0; y < height; ++y)
+    for (int x = 0; x < width; x+=VECT) {
+      PRAGMA_HLS(HLS pipeline ii=II_TARGET)
+      const ap_uint<BW_IN> val = in_s.read();
+      INT lane[VECT];
+      #pragma HLS ARRAY_PARTITION variable=lane dim=0 complete
+      for(int i = 0; i < VECT; i++){
+        #pragma HLS unroll
+        lane[i] = i2f(val(i*I_WIDTH_V,(i+1)*I_WIDTH_V-1));
+      }
+      const INT lanes = reduceLanes<VECT>(lane, width - x, reduce);
+      partial[part] = (count < HIPACC_REDUCE_PARTIALS) ?
+                      lanes : reduce(partial[part], lanes);
+      part = (part == HIPACC_REDUCE_PARTIALS-1) ? 0 : part+1;
+      if (count < HIPACC_REDUCE_PARTIALS)
+        ++count;
+    }
+
+  if (count)
+    result = reducePartials(partial, count, reduce);
+}
+
+// Histogram of BINS bins, binning maps a pixel to its bin. Consecutive pixels
+// falling into the same bin are accumulated in a register and the bin written
+// last is forwarded from a second register, so that the read-modify-write of
+// the bin memory sustains II_TARGET=1: within an iteration, the bin read and
+// the bin written differ, and a bin written is read from memory two
+// iterations later at the earliest.
+template<int II_TARGET, int MAX_WIDTH, int MAX_HEIGHT, int BINS, typename IN, typename OUT, class Binning>
+void histogramStream(
+    hls::stream<IN> &in_s,
+    OUT hist[BINS],
+    const int &width,
+    const int &height,
+    Binning &binning)
+{
+  assert(width <= MAX_WIDTH); assert(height <= MAX_HEIGHT);
+
+  OUT bins[BINS];
+  #pragma HLS DEPENDENCE variable=bins intra RAW false
+  #pragma HLS DEPENDENCE variable=bins inter RAW distance=2 true
+  for (int b = 0; b < BINS; ++b) {
+    PRAGMA_HLS(HLS pipeline ii=II_TARGET)
+    bins[b] = 0;
+  }
+
+  int last = -1, prev = -1;
+  OUT acc = 0, prev_acc = 0;
+  for (int y = 0; y < height; ++y)
+    for (int x = 0; x < width; ++x) {
+      PRAGMA_HLS(HLS pipeline ii=II_TARGET)
+      const IN val = in_s.read();
+      const int bin = binning(val);
+      assert(bin >= 0 && bin < BINS);
+      if (bin == last) {
+        ++acc;
+      } else {
+        const OUT cnt = (bin == prev) ? prev_acc : bins[bin];
+        if (last >= 0)
+          bins[last] = acc;
+        prev = last;
+        prev_acc = acc;
+        acc = cnt + 1;
+        last = bin;
+      }
+    }
+  if (last >= 0)
+    bins[last] = acc;
+
+  for (int b = 0; b < BINS; ++b) {
+    PRAGMA_HLS(HLS pipeline ii=II_TARGET)
+    hist[b] = bins[b];
+  }
+}
+
+// one histogram per lane, merged once the stream has been consumed
+template<int II_TARGET, int MAX_WIDTH, int MAX_HEIGHT, int BINS, int VECT, typename INT, int BW_IN, typename OUT, class Binning>
+void histogramStreamVECT(
+    hls::stream<ap_uint<BW_IN> > &in_s,
+    OUT hist[BINS],
+    const int &width,
+    const int &height,
+    Binning &binning)
+{
+  assert(width <= MAX_WIDTH); assert(height <= MAX_HEIGHT);
+
+  OUT bins[VECT][BINS];
+  #pragma HLS ARRAY_PARTITION variable=bins dim=1 complete
+  #pragma HLS DEPENDENCE variable=bins intra RAW false
+  #pragma HLS DEPENDENCE variable=bins inter RAW distance=2 true
+  for (int b = 0; b < BINS; ++b) {
+    PRAGMA_HLS(HLS pipeline ii=II_TARGET)
+    for (int i = 0; i < VECT; i++)
+      bins[i][b] = 0;
+  }
+
+  int last[VECT], prev[VECT];
+  OUT acc[VECT], prev_acc[VECT];
+  #pragma HLS ARRAY_PARTITION variable=last dim=0 complete
+  #pragma HLS ARRAY_PARTITION variable=prev dim=0 complete
+  #pragma HLS ARRAY_PARTITION variable=acc dim=0 complete
+  #pragma HLS ARRAY_PARTITION variable=prev_acc dim=0 complete
+  for (int i = 0; i < VECT; i++) {
+    #pragma HLS unroll
+    last[i] = prev[i] = -1;
+    acc[i] = prev_acc[i] = 0;
+  }
+
+  for (int y = 0; y < height; ++y)
+    for (int x = 0; x < width; x+=VECT) {
+      PRAGMA_HLS(HLS pipeline ii=II_TARGET)
+      const ap_uint<BW_IN> val = in_s.read();
+      for(int i = 0; i < VECT; i++){
+        #pragma HLS unroll
+        // padding of the last vector of a row is not counted
+        if (x + i >= width)
+          continue;
+        const INT lane = val(i*I_WIDTH_V,(i+1)*I_WIDTH_V-1);
+        const int bin = binning(lane);
+        assert(bin >= 0 && bin < BINS);
+        if (bin == last[i]) {
+          ++acc[i];
+        } else {
+          const OUT cnt = (bin == prev[i]) ? prev_acc[i] : bins[i][bin];
+          if (last[i] >= 0)
+            bins[i][last[i]] = acc[i];
+          prev[i] = last[i];
+          prev_acc[i] = acc[i];
+          acc[i] = cnt + 1;
+          last[i] = bin;
+        }
+      }
+    }
+  for (int i = 0; i < VECT; i++) {
+    if (last[i] >= 0)
+      bins[i][last[i]] = acc[i];
+  }
+
+  for (int b = 0; b < BINS; ++b) {
+    PRAGMA_HLS(HLS pipeline ii=II_TARGET)
+    OUT sum = 0;
+    for (int i = 0; i < VECT; i++)
+      sum += bins[i][b];
+    hist[b] = sum;
+  }
+}
+
 //1:2
 template<int II_TARGET, int MAX_WIDTH, int MAX_HEIGHT, int KERNEL_SIZE_X, int KERNEL_SIZE_Y, typename IN, typename OUT1, typename OUT2>
 void splitStream(
@@ -4406,8 +2209,8 @@ void processVECT(
   assert( width <= MAX_WIDTH ); assert( height <= MAX_HEIGHT );
 
   ap_uint<BW_IN> lineBuff[KERNEL_SIZE_Y-1][MAX_WIDTH/VECT];
-  #pragma HLS ARRAY_PARTITION variable=lineBuff dim=1 complete
-  ap_uint<BW_IN> win[KERNEL_SIZE_Y][KERNEL_SIZE_X_V];
+  PRAGMA_HLS_LINE_BUFFER(lineBuff)
+  ap_uint<BW_IN> win[KERNEL_SIZE_Y][KERNEL_SIZE_X_V+1];
   #pragma HLS ARRAY_PARTITION variable=win dim=0 complete
   ap_uint<BW_IN> win_tmp[KERNEL_SIZE_Y][KERNEL_SIZE_X_V];
   #pragma HLS ARRAY_PARTITION variable=win_tmp dim=0 complete
@@ -4419,11 +2222,22 @@ void processVECT(
   ap_uint<BW_OUT> out_pixel;
   int row, col, i, j, colv;
 
+  // all columns of the vector windows are written before they are read,
+  // reset them for the compiler
+  for(i = 0; i < KERNEL_SIZE_Y; i++){
+    for(j = 0; j < KERNEL_SIZE_X+VECT-1; j++){
+    #pragma HLS unroll
+      win_vect[i][j] = 0;
+    }
+  }
+
   IMG_ROWS:
-  for(row = 0; row < MAX_HEIGHT+GDELAY_Y; ++row){
+  for(row = 0; row < LOOP_HEIGHT+GDELAY_Y; ++row){
+    PRAGMA_HLS(HLS loop_tripcount max=MAX_HEIGHT)
     //std::cout << "ROW: " << row << std::endl;
     IMG_COLS:
-    for(col = 0, colv = 0; col < MAX_WIDTH+GDELAY_X; col+=VECT, ++colv){
+    for(col = 0, colv = 0; col < LOOP_WIDTH+GDELAY_X_V*VECT; col+=VECT, ++colv){
+      PRAGMA_HLS(HLS loop_tripcount max=MAX_WIDTH/VECT)
       PRAGMA_HLS(HLS pipeline ii=II_TARGET)
       #pragma HLS INLINE region
       //**********************************************************
@@ -4437,7 +2251,7 @@ void processVECT(
       // UPDATE THE WINDOW
       // The line buffer behaves normally
       //**********************************************************
-      if (col < width & row < height + GDELAY_Y)
+      if (row < height + GDELAY_Y)
       {
         for(i = 0; i < KERNEL_SIZE_Y; i++){
         #pragma HLS unroll
@@ -4450,65 +2264,53 @@ void processVECT(
         // UPDATE THE LINE BUFFER
         // The line buffer behaves normally
         //**********************************************************
-        LINE_BUFF_1:
-        for(i = 0; i < KERNEL_SIZE_Y-1; i++){
-        #pragma HLS unroll
-          if (i == 0) {
-            win_tmp[i][KERNEL_SIZE_X_V-1] = lineBuff[i][colv];
-          } else {
-            temp_lb = lineBuff[i][colv];
-            win_tmp[i][KERNEL_SIZE_X_V-1] = temp_lb;
-            lineBuff[i-1][colv] = temp_lb;
+        if (col < width) {
+          LINE_BUFF_1:
+          for(i = 0; i < KERNEL_SIZE_Y-1; i++){
+          #pragma HLS unroll
+            if (i == 0) {
+              win_tmp[i][KERNEL_SIZE_X_V-1] = lineBuff[i][colv];
+            } else {
+              temp_lb = lineBuff[i][colv];
+              win_tmp[i][KERNEL_SIZE_X_V-1] = temp_lb;
+              lineBuff[i-1][colv] = temp_lb;
+            }
           }
+          if (KERNEL_SIZE_Y > 1) {
+            lineBuff[KERNEL_SIZE_Y-2][colv] = in_pixel;
+          }
+          win_tmp[KERNEL_SIZE_Y-1][KERNEL_SIZE_X_V-1] = in_pixel;
         }
-        if (KERNEL_SIZE_Y > 1) {
-          lineBuff[KERNEL_SIZE_Y-2][colv] = in_pixel;
-        }
-        win_tmp[KERNEL_SIZE_Y-1][KERNEL_SIZE_X_V-1] = in_pixel;
 
         //**********************************************************
         // UPDATE THE LP WINDOW
-        // Window update includes mirroring border treatment
+        // Window update includes border treatment in y-direction,
+        // the last vector holds the constant for BORDER_CONST
         //**********************************************************
-        // X-DIRECTION
-        for(i = 0; i < KERNEL_SIZE_Y; i++){
-          for(j = 0; j < KERNEL_SIZE_X_V; j++){
-            int jx = getNewCoords(j,KERNEL_SIZE_X_V,GDELAY_X,col,width,borderPadding);
-            win[i][j] = win_tmp[i][jx];
-          }
-        }
-        // Y-DIRECTION
         for(i = 0; i < KERNEL_SIZE_Y; i++){
+          int iy = getNewCoords(i,KERNEL_SIZE_Y,GDELAY_Y,row,height,borderPadding);
           for(j = 0; j < KERNEL_SIZE_X_V; j++){
-            int iy = getNewCoords(i,KERNEL_SIZE_Y,GDELAY_Y,row,height,borderPadding);
-             win[i][j] = win[iy][j];
+            win[i][j] = (iy < 0) ? ap_uint<BW_IN>(0) : win_tmp[iy][j];
           }
+          win[i][KERNEL_SIZE_X_V] = 0;
         }
 
         //**********************************************************
         // ASSIGN WINDOWS
+        // Pixel window includes border treatment in x-direction
         //**********************************************************
-        // fill original window
-        for(int j = 0; j < KERNEL_SIZE_X; j++){
-          winPos jv = getWinCoords((GDELAY_X_V*VECT)-GDELAY_X+j,KERNEL_SIZE_X, KERNEL_SIZE_X_V,VECT,GDELAY_X,col,width,borderPadding);
-          for(int i = 0; i < KERNEL_SIZE_Y; i++){
+        for(j = 0; j < KERNEL_SIZE_X+VECT-1; j++){
+          winPos jv = getWinCoords(j,KERNEL_SIZE_X,KERNEL_SIZE_X_V,VECT,colv,width,borderPadding);
+          for(i = 0; i < KERNEL_SIZE_Y; i++){
             win_vect[i][j] = win[i][jv.win]((jv.pos)*I_WIDTH_V,(jv.pos+1)*I_WIDTH_V-1);
           }
         }
-
-        // fill window extension caused by vectorization
-        for (int v = 0; v < VECT-1; v++) {
-          winPos jv = getWinCoords((GDELAY_X_V*VECT)-GDELAY_X+KERNEL_SIZE_X+v,KERNEL_SIZE_X, KERNEL_SIZE_X_V,VECT,GDELAY_X,col,width,borderPadding);
-          for(int i = 0; i < KERNEL_SIZE_Y; i++){
-            win_vect[i][KERNEL_SIZE_X+v] = win[i][jv.win]((jv.pos)*I_WIDTH_V,(jv.pos+1)*I_WIDTH_V-1);
-          }
-        }
       }
 
       //**********************************************************
       // DO CALCULATIONS
       //**********************************************************
-      if(row >= GDELAY_Y && col >= GDELAY_X)
+      if(row >= GDELAY_Y && col >= GDELAY_X_V*VECT)
       {
         for (int v = 0; v < VECT; v++) {
           INT win_small[KERNEL_SIZE_Y][KERNEL_SIZE_X];
@@ -4538,8 +2340,8 @@ void processVECTF(
   assert( width <= MAX_WIDTH ); assert( height <= MAX_HEIGHT );
 
   ap_uint<BW_IN> lineBuff[KERNEL_SIZE_Y-1][MAX_WIDTH/VECT];
-  #pragma HLS ARRAY_PARTITION variable=lineBuff dim=1 complete
-  ap_uint<BW_IN> win[KERNEL_SIZE_Y][KERNEL_SIZE_X_V];
+  PRAGMA_HLS_LINE_BUFFER(lineBuff)
+  ap_uint<BW_IN> win[KERNEL_SIZE_Y][KERNEL_SIZE_X_V+1];
   #pragma HLS ARRAY_PARTITION variable=win dim=0 complete
   ap_uint<BW_IN> win_tmp[KERNEL_SIZE_Y][KERNEL_SIZE_X_V];
   #pragma HLS ARRAY_PARTITION variable=win_tmp dim=0 complete
@@ -4551,11 +2353,22 @@ void processVECTF(
   ap_uint<BW_OUT> out_pixel;
   int row, col, i, j, colv;
 
+  // all columns of the vector windows are written before they are read,
+  // reset them for the compiler
+  for(i = 0; i < KERNEL_SIZE_Y; i++){
+    for(j = 0; j < KERNEL_SIZE_X+VECT-1; j++){
+    #pragma HLS unroll
+      win_vect[i][j] = 0;
+    }
+  }
+
   IMG_ROWS:
-  for(row = 0; row < MAX_HEIGHT+GDELAY_Y; ++row){
+  for(row = 0; row < LOOP_HEIGHT+GDELAY_Y; ++row){
+    PRAGMA_HLS(HLS loop_tripcount max=MAX_HEIGHT)
     //std::cout << "ROW: " << row << std::endl;
     IMG_COLS:
-    for(col = 0, colv = 0; col < MAX_WIDTH+GDELAY_X; col+=VECT, ++colv){
+    for(col = 0, colv = 0; col < LOOP_WIDTH+GDELAY_X_V*VECT; col+=VECT, ++colv){
+      PRAGMA_HLS(HLS loop_tripcount max=MAX_WIDTH/VECT)
       PRAGMA_HLS(HLS pipeline ii=II_TARGET)
       #pragma HLS INLINE region
       //**********************************************************
@@ -4569,7 +2382,7 @@ void processVECTF(
       // UPDATE THE WINDOW
       // The line buffer behaves normally
       //**********************************************************
-      if (col < width & row < height + GDELAY_Y)
+      if (row < height + GDELAY_Y)
       {
         for(i = 0; i < KERNEL_SIZE_Y; i++){
         #pragma HLS unroll
@@ -4582,65 +2395,53 @@ void processVECTF(
         // UPDATE THE LINE BUFFER
         // The line buffer behaves normally
         //**********************************************************
-        LINE_BUFF_1:
-        for(i = 0; i < KERNEL_SIZE_Y-1; i++){
-        #pragma HLS unroll
-          if (i == 0) {
-            win_tmp[i][KERNEL_SIZE_X_V-1] = lineBuff[i][colv];
-          } else {
-            temp_lb = lineBuff[i][colv];
-            win_tmp[i][KERNEL_SIZE_X_V-1] = temp_lb;
-            lineBuff[i-1][colv] = temp_lb;
+        if (col < width) {
+          LINE_BUFF_1:
+          for(i = 0; i < KERNEL_SIZE_Y-1; i++){
+          #pragma HLS unroll
+            if (i == 0) {
+              win_tmp[i][KERNEL_SIZE_X_V-1] = lineBuff[i][colv];
+            } else {
+              temp_lb = lineBuff[i][colv];
+              win_tmp[i][KERNEL_SIZE_X_V-1] = temp_lb;
+              lineBuff[i-1][colv] = temp_lb;
+            }
           }
+          if (KERNEL_SIZE_Y > 1) {
+            lineBuff[KERNEL_SIZE_Y-2][colv] = in_pixel;
+          }
+          win_tmp[KERNEL_SIZE_Y-1][KERNEL_SIZE_X_V-1] = in_pixel;
         }
-        if (KERNEL_SIZE_Y > 1) {
-          lineBuff[KERNEL_SIZE_Y-2][colv] = in_pixel;
-        }
-        win_tmp[KERNEL_SIZE_Y-1][KERNEL_SIZE_X_V-1] = in_pixel;
 
         //**********************************************************
         // UPDATE THE LP WINDOW
-        // Window update includes mirroring border treatment
+        // Window update includes border treatment in y-direction,
+        // the last vector holds the constant for BORDER_CONST
         //**********************************************************
-        // X-DIRECTION
-        for(i = 0; i < KERNEL_SIZE_Y; i++){
-          for(j = 0; j < KERNEL_SIZE_X_V; j++){
-            int jx = getNewCoords(j,KERNEL_SIZE_X_V,GDELAY_X,col,width,borderPadding);
-            win[i][j] = win_tmp[i][jx];
-          }
-        }
-        // Y-DIRECTION
         for(i = 0; i < KERNEL_SIZE_Y; i++){
+          int iy = getNewCoords(i,KERNEL_SIZE_Y,GDELAY_Y,row,height,borderPadding);
           for(j = 0; j < KERNEL_SIZE_X_V; j++){
-            int iy = getNewCoords(i,KERNEL_SIZE_Y,GDELAY_Y,row,height,borderPadding);
-             win[i][j] = win[iy][j];
+            win[i][j] = (iy < 0) ? ap_uint<BW_IN>(0) : win_tmp[iy][j];
           }
+          win[i][KERNEL_SIZE_X_V] = 0;
         }
 
         //**********************************************************
         // ASSIGN WINDOWS
+        // Pixel window includes border treatment in x-direction
         //**********************************************************
-        // fill original window
-        for(int j = 0; j < KERNEL_SIZE_X; j++){
-          winPos jv = getWinCoords((GDELAY_X_V*VECT)-GDELAY_X+j,KERNEL_SIZE_X, KERNEL_SIZE_X_V,VECT,GDELAY_X,col,width,borderPadding);
-          for(int i = 0; i < KERNEL_SIZE_Y; i++){
+        for(j = 0; j < KERNEL_SIZE_X+VECT-1; j++){
+          winPos jv = getWinCoords(j,KERNEL_SIZE_X,KERNEL_SIZE_X_V,VECT,colv,width,borderPadding);
+          for(i = 0; i < KERNEL_SIZE_Y; i++){
             win_vect[i][j] = i2f(win[i][jv.win]((jv.pos)*I_WIDTH_V,(jv.pos+1)*I_WIDTH_V-1));
           }
         }
-
-        // fill window extension caused by vectorization
-        for (int v = 0; v < VECT-1; v++) {
-          winPos jv = getWinCoords((GDELAY_X_V*VECT)-GDELAY_X+KERNEL_SIZE_X+v,KERNEL_SIZE_X, KERNEL_SIZE_X_V,VECT,GDELAY_X,col,width,borderPadding);
-          for(int i = 0; i < KERNEL_SIZE_Y; i++){
-            win_vect[i][KERNEL_SIZE_X+v] = i2f(win[i][jv.win]((jv.pos)*I_WIDTH_V,(jv.pos+1)*I_WIDTH_V-1));
-          }
-        }
       }
 
       //**********************************************************
       // DO CALCULATIONS
       //**********************************************************
-      if(row >= GDELAY_Y && col >= GDELAY_X)
+      if(row >= GDELAY_Y && col >= GDELAY_X_V*VECT)
       {
         for (int v = 0; v < VECT; v++) {
           INT win_small[KERNEL_SIZE_Y][KERNEL_SIZE_X];
@@ -4671,8 +2472,8 @@ void processSIMOVECT(
   assert( width <= MAX_WIDTH ); assert( height <= MAX_HEIGHT );
 
   ap_uint<BW_IN> lineBuff[KERNEL_SIZE_Y-1][MAX_WIDTH/VECT];
-  #pragma HLS ARRAY_PARTITION variable=lineBuff dim=1 complete
-  ap_uint<BW_IN> win[KERNEL_SIZE_Y][KERNEL_SIZE_X_V];
+  PRAGMA_HLS_LINE_BUFFER(lineBuff)
+  ap_uint<BW_IN> win[KERNEL_SIZE_Y][KERNEL_SIZE_X_V+1];
   #pragma HLS ARRAY_PARTITION variable=win dim=0 complete
   ap_uint<BW_IN> win_tmp[KERNEL_SIZE_Y][KERNEL_SIZE_X_V];
   #pragma HLS ARRAY_PARTITION variable=win_tmp dim=0 complete
@@ -4684,11 +2485,22 @@ void processSIMOVECT(
   ap_uint<BW_OUT> out_pixel;
   int row, col, i, j, colv;
 
+  // all columns of the vector windows are written before they are read,
+  // reset them for the compiler
+  for(i = 0; i < KERNEL_SIZE_Y; i++){
+    for(j = 0; j < KERNEL_SIZE_X+VECT-1; j++){
+    #pragma HLS unroll
+      win_vect[i][j] = 0;
+    }
+  }
+
   IMG_ROWS:
-  for(row = 0; row < MAX_HEIGHT+GDELAY_Y; ++row){
+  for(row = 0; row < LOOP_HEIGHT+GDELAY_Y; ++row){
+    PRAGMA_HLS(HLS loop_tripcount max=MAX_HEIGHT)
     //std::cout << "ROW: " << row << std::endl;
     IMG_COLS:
-    for(col = 0, colv = 0; col < MAX_WIDTH+GDELAY_X; col+=VECT, ++colv){
+    for(col = 0, colv = 0; col < LOOP_WIDTH+GDELAY_X_V*VECT; col+=VECT, ++colv){
+      PRAGMA_HLS(HLS loop_tripcount max=MAX_WIDTH/VECT)
       PRAGMA_HLS(HLS pipeline ii=II_TARGET)
       #pragma HLS INLINE region
       //**********************************************************
@@ -4702,7 +2514,7 @@ void processSIMOVECT(
       // UPDATE THE WINDOW
       // The line buffer behaves normally
       //**********************************************************
-      if (col < width & row < height + GDELAY_Y)
+      if (row < height + GDELAY_Y)
       {
         for(i = 0; i < KERNEL_SIZE_Y; i++){
         #pragma HLS unroll
@@ -4715,65 +2527,53 @@ void processSIMOVECT(
         // UPDATE THE LINE BUFFER
         // The line buffer behaves normally
         //**********************************************************
-        LINE_BUFF_1:
-        for(i = 0; i < KERNEL_SIZE_Y-1; i++){
-        #pragma HLS unroll
-          if (i == 0) {
-            win_tmp[i][KERNEL_SIZE_X_V-1] = lineBuff[i][colv];
-          } else {
-            temp_lb = lineBuff[i][colv];
-            win_tmp[i][KERNEL_SIZE_X_V-1] = temp_lb;
-            lineBuff[i-1][colv] = temp_lb;
+        if (col < width) {
+          LINE_BUFF_1:
+          for(i = 0; i < KERNEL_SIZE_Y-1; i++){
+          #pragma HLS unroll
+            if (i == 0) {
+              win_tmp[i][KERNEL_SIZE_X_V-1] = lineBuff[i][colv];
+            } else {
+              temp_lb = lineBuff[i][colv];
+              win_tmp[i][KERNEL_SIZE_X_V-1] = temp_lb;
+              lineBuff[i-1][colv] = temp_lb;
+            }
           }
+          if (KERNEL_SIZE_Y > 1) {
+            lineBuff[KERNEL_SIZE_Y-2][colv] = in_pixel;
+          }
+          win_tmp[KERNEL_SIZE_Y-1][KERNEL_SIZE_X_V-1] = in_pixel;
         }
-        if (KERNEL_SIZE_Y > 1) {
-          lineBuff[KERNEL_SIZE_Y-2][colv] = in_pixel;
-        }
-        win_tmp[KERNEL_SIZE_Y-1][KERNEL_SIZE_X_V-1] = in_pixel;
 
         //**********************************************************
         // UPDATE THE LP WINDOW
-        // Window update includes mirroring border treatment
+        // Window update includes border treatment in y-direction,
+        // the last vector holds the constant for BORDER_CONST
         //**********************************************************
-        // X-DIRECTION
-        for(i = 0; i < KERNEL_SIZE_Y; i++){
-          for(j = 0; j < KERNEL_SIZE_X_V; j++){
-            int jx = getNewCoords(j,KERNEL_SIZE_X_V,GDELAY_X,col,width,borderPadding);
-            win[i][j] = win_tmp[i][jx];
-          }
-        }
-        // Y-DIRECTION
         for(i = 0; i < KERNEL_SIZE_Y; i++){
+          int iy = getNewCoords(i,KERNEL_SIZE_Y,GDELAY_Y,row,height,borderPadding);
           for(j = 0; j < KERNEL_SIZE_X_V; j++){
-            int iy = getNewCoords(i,KERNEL_SIZE_Y,GDELAY_Y,row,height,borderPadding);
-             win[i][j] = win[iy][j];
+            win[i][j] = (iy < 0) ? ap_uint<BW_IN>(0) : win_tmp[iy][j];
           }
+          win[i][KERNEL_SIZE_X_V] = 0;
         }
 
         //**********************************************************
         // ASSIGN WINDOWS
+        // Pixel window includes border treatment in x-direction
         //**********************************************************
-        // fill original window
-        for(int j = 0; j < KERNEL_SIZE_X; j++){
-          winPos jv = getWinCoords((GDELAY_X_V*VECT)-GDELAY_X+j,KERNEL_SIZE_X, KERNEL_SIZE_X_V,VECT,GDELAY_X,col,width,borderPadding);
-          for(int i = 0; i < KERNEL_SIZE_Y; i++){
+        for(j = 0; j < KERNEL_SIZE_X+VECT-1; j++){
+          winPos jv = getWinCoords(j,KERNEL_SIZE_X,KERNEL_SIZE_X_V,VECT,colv,width,borderPadding);
+          for(i = 0; i < KERNEL_SIZE_Y; i++){
             win_vect[i][j] = win[i][jv.win]((jv.pos)*I_WIDTH_V,(jv.pos+1)*I_WIDTH_V-1);
           }
         }
-
-        // fill window extension caused by vectorization
-        for (int v = 0; v < VECT-1; v++) {
-          winPos jv = getWinCoords((GDELAY_X_V*VECT)-GDELAY_X+KERNEL_SIZE_X+v,KERNEL_SIZE_X, KERNEL_SIZE_X_V,VECT,GDELAY_X,col,width,borderPadding);
-          for(int i = 0; i < KERNEL_SIZE_Y; i++){
-            win_vect[i][KERNEL_SIZE_X+v] = win[i][jv.win]((jv.pos)*I_WIDTH_V,(jv.pos+1)*I_WIDTH_V-1);
-          }
-        }
       }
 
       //**********************************************************
       // DO CALCULATIONS
       //**********************************************************
-      if(row >= GDELAY_Y && col >= GDELAY_X)
+      if(row >= GDELAY_Y && col >= GDELAY_X_V*VECT)
       {
         for (int v = 0; v < VECT; v++) {
           INT win_small[KERNEL_SIZE_Y][KERNEL_SIZE_X];
@@ -4805,8 +2605,8 @@ void processSIMOVECTF(
   assert( width <= MAX_WIDTH ); assert( height <= MAX_HEIGHT );
 
   ap_uint<BW_IN> lineBuff[KERNEL_SIZE_Y-1][MAX_WIDTH/VECT];
-  #pragma HLS ARRAY_PARTITION variable=lineBuff dim=1 complete
-  ap_uint<BW_IN> win[KERNEL_SIZE_Y][KERNEL_SIZE_X_V];
+  PRAGMA_HLS_LINE_BUFFER(lineBuff)
+  ap_uint<BW_IN> win[KERNEL_SIZE_Y][KERNEL_SIZE_X_V+1];
   #pragma HLS ARRAY_PARTITION variable=win dim=0 complete
   ap_uint<BW_IN> win_tmp[KERNEL_SIZE_Y][KERNEL_SIZE_X_V];
   #pragma HLS ARRAY_PARTITION variable=win_tmp dim=0 complete
@@ -4818,11 +2618,22 @@ void processSIMOVECTF(
   ap_uint<BW_OUT> out_pixel;
   int row, col, i, j, colv;
 
+  // all columns of the vector windows are written before they are read,
+  // reset them for the compiler
+  for(i = 0; i < KERNEL_SIZE_Y; i++){
+    for(j = 0; j < KERNEL_SIZE_X+VECT-1; j++){
+    #pragma HLS unroll
+      win_vect[i][j] = 0;
+    }
+  }
+
   IMG_ROWS:
-  for(row = 0; row < MAX_HEIGHT+GDELAY_Y; ++row){
+  for(row = 0; row < LOOP_HEIGHT+GDELAY_Y; ++row){
+    PRAGMA_HLS(HLS loop_tripcount max=MAX_HEIGHT)
     //std::cout << "ROW: " << row << std::endl;
     IMG_COLS:
-    for(col = 0, colv = 0; col < MAX_WIDTH+GDELAY_X; col+=VECT, ++colv){
+    for(col = 0, colv = 0; col < LOOP_WIDTH+GDELAY_X_V*VECT; col+=VECT, ++colv){
+      PRAGMA_HLS(HLS loop_tripcount max=MAX_WIDTH/VECT)
       PRAGMA_HLS(HLS pipeline ii=II_TARGET)
       #pragma HLS INLINE region
       //**********************************************************
@@ -4836,7 +2647,7 @@ void processSIMOVECTF(
       // UPDATE THE WINDOW
       // The line buffer behaves normally
       //**********************************************************
-      if (col < width & row < height + GDELAY_Y)
+      if (row < height + GDELAY_Y)
       {
         for(i = 0; i < KERNEL_SIZE_Y; i++){
         #pragma HLS unroll
@@ -4849,65 +2660,53 @@ void processSIMOVECTF(
         // UPDATE THE LINE BUFFER
         // The line buffer behaves normally
         //**********************************************************
-        LINE_BUFF_1:
-        for(i = 0; i < KERNEL_SIZE_Y-1; i++){
-        #pragma HLS unroll
-          if (i == 0) {
-            win_tmp[i][KERNEL_SIZE_X_V-1] = lineBuff[i][colv];
-          } else {
-            temp_lb = lineBuff[i][colv];
-            win_tmp[i][KERNEL_SIZE_X_V-1] = temp_lb;
-            lineBuff[i-1][colv] = temp_lb;
+        if (col < width) {
+          LINE_BUFF_1:
+          for(i = 0; i < KERNEL_SIZE_Y-1; i++){
+          #pragma HLS unroll
+            if (i == 0) {
+              win_tmp[i][KERNEL_SIZE_X_V-1] = lineBuff[i][colv];
+            } else {
+              temp_lb = lineBuff[i][colv];
+              win_tmp[i][KERNEL_SIZE_X_V-1] = temp_lb;
+              lineBuff[i-1][colv] = temp_lb;
+            }
           }
+          if (KERNEL_SIZE_Y > 1) {
+            lineBuff[KERNEL_SIZE_Y-2][colv] = in_pixel;
+          }
+          win_tmp[KERNEL_SIZE_Y-1][KERNEL_SIZE_X_V-1] = in_pixel;
         }
-        if (KERNEL_SIZE_Y > 1) {
-          lineBuff[KERNEL_SIZE_Y-2][colv] = in_pixel;
-        }
-        win_tmp[KERNEL_SIZE_Y-1][KERNEL_SIZE_X_V-1] = in_pixel;
 
         //**********************************************************
         // UPDATE THE LP WINDOW
-        // Window update includes mirroring border treatment
+        // Window update includes border treatment in y-direction,
+        // the last vector holds the constant for BORDER_CONST
         //**********************************************************
-        // X-DIRECTION
-        for(i = 0; i < KERNEL_SIZE_Y; i++){
-          for(j = 0; j < KERNEL_SIZE_X_V; j++){
-            int jx = getNewCoords(j,KERNEL_SIZE_X_V,GDELAY_X,col,width,borderPadding);
-            win[i][j] = win_tmp[i][jx];
-          }
-        }
-        // Y-DIRECTION
         for(i = 0; i < KERNEL_SIZE_Y; i++){
+          int iy = getNewCoords(i,KERNEL_SIZE_Y,GDELAY_Y,row,height,borderPadding);
           for(j = 0; j < KERNEL_SIZE_X_V; j++){
-            int iy = getNewCoords(i,KERNEL_SIZE_Y,GDELAY_Y,row,height,borderPadding);
-             win[i][j] = win[iy][j];
+            win[i][j] = (iy < 0) ? ap_uint<BW_IN>(0) : win_tmp[iy][j];
           }
+          win[i][KERNEL_SIZE_X_V] = 0;
         }
 
         //**********************************************************
         // ASSIGN WINDOWS
+        // Pixel window includes border treatment in x-direction
         //**********************************************************
-        // fill original window
-        for(int j = 0; j < KERNEL_SIZE_X; j++){
-          winPos jv = getWinCoords((GDELAY_X_V*VECT)-GDELAY_X+j,KERNEL_SIZE_X, KERNEL_SIZE_X_V,VECT,GDELAY_X,col,width,borderPadding);
-          for(int i = 0; i < KERNEL_SIZE_Y; i++){
+        for(j = 0; j < KERNEL_SIZE_X+VECT-1; j++){
+          winPos jv = getWinCoords(j,KERNEL_SIZE_X,KERNEL_SIZE_X_V,VECT,colv,width,borderPadding);
+          for(i = 0; i < KERNEL_SIZE_Y; i++){
             win_vect[i][j] = i2f(win[i][jv.win]((jv.pos)*I_WIDTH_V,(jv.pos+1)*I_WIDTH_V-1));
           }
         }
-
-        // fill window extension caused by vectorization
-        for (int v = 0; v < VECT-1; v++) {
-          winPos jv = getWinCoords((GDELAY_X_V*VECT)-GDELAY_X+KERNEL_SIZE_X+v,KERNEL_SIZE_X, KERNEL_SIZE_X_V,VECT,GDELAY_X,col,width,borderPadding);
-          for(int i = 0; i < KERNEL_SIZE_Y; i++){
-            win_vect[i][KERNEL_SIZE_X+v] = i2f(win[i][jv.win]((jv.pos)*I_WIDTH_V,(jv.pos+1)*I_WIDTH_V-1));
-          }
-        }
       }
 
       //**********************************************************
       // DO CALCULATIONS
       //**********************************************************
-      if(row >= GDELAY_Y && col >= GDELAY_X)
+      if(row >= GDELAY_Y && col >= GDELAY_X_V*VECT)
       {
         for (int v = 0; v < VECT; v++) {
           INT win_small[KERNEL_SIZE_Y][KERNEL_SIZE_X];
@@ -4939,12 +2738,12 @@ void processMISOVECT(
   assert( width <= MAX_WIDTH ); assert( height <= MAX_HEIGHT );
 
   ap_uint<BW_IN> lineBuff1[KERNEL_SIZE_Y-1][MAX_WIDTH/VECT];
-  #pragma HLS ARRAY_PARTITION variable=lineBuff1 dim=1 complete
+  PRAGMA_HLS_LINE_BUFFER(lineBuff1)
   ap_uint<BW_IN> lineBuff2[KERNEL_SIZE_Y-1][MAX_WIDTH/VECT];
-  #pragma HLS ARRAY_PARTITION variable=lineBuff2 dim=1 complete
-  ap_uint<BW_IN> win1[KERNEL_SIZE_Y][KERNEL_SIZE_X_V];
+  PRAGMA_HLS_LINE_BUFFER(lineBuff2)
+  ap_uint<BW_IN> win1[KERNEL_SIZE_Y][KERNEL_SIZE_X_V+1];
   #pragma HLS ARRAY_PARTITION variable=win1 dim=0 complete
-  ap_uint<BW_IN> win2[KERNEL_SIZE_Y][KERNEL_SIZE_X_V];
+  ap_uint<BW_IN> win2[KERNEL_SIZE_Y][KERNEL_SIZE_X_V+1];
   #pragma HLS ARRAY_PARTITION variable=win2 dim=0 complete
   ap_uint<BW_IN> win1_tmp[KERNEL_SIZE_Y][KERNEL_SIZE_X_V];
   #pragma HLS ARRAY_PARTITION variable=win1_tmp dim=0 complete
@@ -4961,11 +2760,23 @@ void processMISOVECT(
   ap_uint<BW_OUT> out_pixel;
   int row, col, i, j, colv;
 
+  // all columns of the vector windows are written before they are read,
+  // reset them for the compiler
+  for(i = 0; i < KERNEL_SIZE_Y; i++){
+    for(j = 0; j < KERNEL_SIZE_X+VECT-1; j++){
+    #pragma HLS unroll
+      win1_vect[i][j] = 0;
+      win2_vect[i][j] = 0;
+    }
+  }
+
   IMG_ROWS:
-  for(row = 0; row < MAX_HEIGHT+GDELAY_Y; ++row){
+  for(row = 0; row < LOOP_HEIGHT+GDELAY_Y; ++row){
+    PRAGMA_HLS(HLS loop_tripcount max=MAX_HEIGHT)
     //std::cout << "ROW: " << row << std::endl;
     IMG_COLS:
-    for(col = 0, colv = 0; col < MAX_WIDTH+GDELAY_X; col+=VECT, ++colv){
+    for(col = 0, colv = 0; col < LOOP_WIDTH+GDELAY_X_V*VECT; col+=VECT, ++colv){
+      PRAGMA_HLS(HLS loop_tripcount max=MAX_WIDTH/VECT)
       PRAGMA_HLS(HLS pipeline ii=II_TARGET)
       #pragma HLS INLINE region
       //**********************************************************
@@ -4980,7 +2791,7 @@ void processMISOVECT(
       // UPDATE THE WINDOW
       // The line buffer behaves normally
       //**********************************************************
-      if (col < width & row < height + GDELAY_Y)
+      if (row < height + GDELAY_Y)
       {
         for(i = 0; i < KERNEL_SIZE_Y; i++){
         #pragma HLS unroll
@@ -4994,75 +2805,62 @@ void processMISOVECT(
         // UPDATE THE LINE BUFFER
         // The line buffer behaves normally
         //**********************************************************
-        LINE_BUFF_1:
-        for(i = 0; i < KERNEL_SIZE_Y-1; i++){
-        #pragma HLS unroll
-          if (i == 0) {
-            win1_tmp[i][KERNEL_SIZE_X_V-1] = lineBuff1[i][colv];
-            win2_tmp[i][KERNEL_SIZE_X_V-1] = lineBuff2[i][colv];
-          } else {
-            temp1_lb = lineBuff1[i][colv];
-            temp2_lb = lineBuff2[i][colv];
-            win1_tmp[i][KERNEL_SIZE_X_V-1] = temp1_lb;
-            win2_tmp[i][KERNEL_SIZE_X_V-1] = temp2_lb;
-            lineBuff1[i-1][colv] = temp1_lb;
-            lineBuff2[i-1][colv] = temp2_lb;
+        if (col < width) {
+          LINE_BUFF_1:
+          for(i = 0; i < KERNEL_SIZE_Y-1; i++){
+          #pragma HLS unroll
+            if (i == 0) {
+              win1_tmp[i][KERNEL_SIZE_X_V-1] = lineBuff1[i][colv];
+              win2_tmp[i][KERNEL_SIZE_X_V-1] = lineBuff2[i][colv];
+            } else {
+              temp1_lb = lineBuff1[i][colv];
+              temp2_lb = lineBuff2[i][colv];
+              win1_tmp[i][KERNEL_SIZE_X_V-1] = temp1_lb;
+              win2_tmp[i][KERNEL_SIZE_X_V-1] = temp2_lb;
+              lineBuff1[i-1][colv] = temp1_lb;
+              lineBuff2[i-1][colv] = temp2_lb;
+            }
           }
+          if (KERNEL_SIZE_Y > 1) {
+            lineBuff1[KERNEL_SIZE_Y-2][colv] = in1_pixel;
+            lineBuff2[KERNEL_SIZE_Y-2][colv] = in2_pixel;
+          }
+          win1_tmp[KERNEL_SIZE_Y-1][KERNEL_SIZE_X_V-1] = in1_pixel;
+          win2_tmp[KERNEL_SIZE_Y-1][KERNEL_SIZE_X_V-1] = in2_pixel;
         }
-        if (KERNEL_SIZE_Y > 1) {
-          lineBuff1[KERNEL_SIZE_Y-2][colv] = in1_pixel;
-          lineBuff2[KERNEL_SIZE_Y-2][colv] = in2_pixel;
-        }
-        win1_tmp[KERNEL_SIZE_Y-1][KERNEL_SIZE_X_V-1] = in1_pixel;
-        win2_tmp[KERNEL_SIZE_Y-1][KERNEL_SIZE_X_V-1] = in2_pixel;
 
         //**********************************************************
         // UPDATE THE LP WINDOW
-        // Window update includes mirroring border treatment
+        // Window update includes border treatment in y-direction,
+        // the last vector holds the constant for BORDER_CONST
         //**********************************************************
-        // X-DIRECTION
-        for(i = 0; i < KERNEL_SIZE_Y; i++){
-          for(j = 0; j < KERNEL_SIZE_X_V; j++){
-            int jx = getNewCoords(j,KERNEL_SIZE_X_V,GDELAY_X,col,width,borderPadding);
-            win1[i][j] = win1_tmp[i][jx];
-            win2[i][j] = win2_tmp[i][jx];
-          }
-        }
-        // Y-DIRECTION
         for(i = 0; i < KERNEL_SIZE_Y; i++){
+          int iy = getNewCoords(i,KERNEL_SIZE_Y,GDELAY_Y,row,height,borderPadding);
           for(j = 0; j < KERNEL_SIZE_X_V; j++){
-            int iy = getNewCoords(i,KERNEL_SIZE_Y,GDELAY_Y,row,height,borderPadding);
-             win1[i][j] = win1[iy][j];
-             win2[i][j] = win2[iy][j];
+            win1[i][j] = (iy < 0) ? ap_uint<BW_IN>(0) : win1_tmp[iy][j];
+            win2[i][j] = (iy < 0) ? ap_uint<BW_IN>(0) : win2_tmp[iy][j];
           }
+          win1[i][KERNEL_SIZE_X_V] = 0;
+          win2[i][KERNEL_SIZE_X_V] = 0;
         }
 
         //**********************************************************
         // ASSIGN WINDOWS
+        // Pixel window includes border treatment in x-direction
         //**********************************************************
-        // fill original window
-        for(int j = 0; j < KERNEL_SIZE_X; j++){
-          winPos jv = getWinCoords((GDELAY_X_V*VECT)-GDELAY_X+j,KERNEL_SIZE_X, KERNEL_SIZE_X_V,VECT,GDELAY_X,col,width,borderPadding);
-          for(int i = 0; i < KERNEL_SIZE_Y; i++){
+        for(j = 0; j < KERNEL_SIZE_X+VECT-1; j++){
+          winPos jv = getWinCoords(j,KERNEL_SIZE_X,KERNEL_SIZE_X_V,VECT,colv,width,borderPadding);
+          for(i = 0; i < KERNEL_SIZE_Y; i++){
             win1_vect[i][j] = win1[i][jv.win]((jv.pos)*I_WIDTH_V,(jv.pos+1)*I_WIDTH_V-1);
             win2_vect[i][j] = win2[i][jv.win]((jv.pos)*I_WIDTH_V,(jv.pos+1)*I_WIDTH_V-1);
           }
         }
-
-        // fill window extension caused by vectorization
-        for (int v = 0; v < VECT-1; v++) {
-          winPos jv = getWinCoords((GDELAY_X_V*VECT)-GDELAY_X+KERNEL_SIZE_X+v,KERNEL_SIZE_X, KERNEL_SIZE_X_V,VECT,GDELAY_X,col,width,borderPadding);
-          for(int i = 0; i < KERNEL_SIZE_Y; i++){
-            win1_vect[i][KERNEL_SIZE_X+v] = win1[i][jv.win]((jv.pos)*I_WIDTH_V,(jv.pos+1)*I_WIDTH_V-1);
-            win2_vect[i][KERNEL_SIZE_X+v] = win2[i][jv.win]((jv.pos)*I_WIDTH_V,(jv.pos+1)*I_WIDTH_V-1);
-          }
-        }
       }
 
       //**********************************************************
       // DO CALCULATIONS
       //**********************************************************
-      if(row >= GDELAY_Y && col >= GDELAY_X)
+      if(row >= GDELAY_Y && col >= GDELAY_X_V*VECT)
       {
         for (int v = 0; v < VECT; v++) {
           INT win1_small[KERNEL_SIZE_Y][KERNEL_SIZE_X];
@@ -5095,12 +2893,12 @@ void processMISOVECTF(
   assert( width <= MAX_WIDTH ); assert( height <= MAX_HEIGHT );
 
   ap_uint<BW_IN> lineBuff1[KERNEL_SIZE_Y-1][MAX_WIDTH/VECT];
-  #pragma HLS ARRAY_PARTITION variable=lineBuff1 dim=1 complete
+  PRAGMA_HLS_LINE_BUFFER(lineBuff1)
   ap_uint<BW_IN> lineBuff2[KERNEL_SIZE_Y-1][MAX_WIDTH/VECT];
-  #pragma HLS ARRAY_PARTITION variable=lineBuff2 dim=1 complete
-  ap_uint<BW_IN> win1[KERNEL_SIZE_Y][KERNEL_SIZE_X_V];
+  PRAGMA_HLS_LINE_BUFFER(lineBuff2)
+  ap_uint<BW_IN> win1[KERNEL_SIZE_Y][KERNEL_SIZE_X_V+1];
   #pragma HLS ARRAY_PARTITION variable=win1 dim=0 complete
-  ap_uint<BW_IN> win2[KERNEL_SIZE_Y][KERNEL_SIZE_X_V];
+  ap_uint<BW_IN> win2[KERNEL_SIZE_Y][KERNEL_SIZE_X_V+1];
   #pragma HLS ARRAY_PARTITION variable=win2 dim=0 complete
   ap_uint<BW_IN> win1_tmp[KERNEL_SIZE_Y][KERNEL_SIZE_X_V];
   #pragma HLS ARRAY_PARTITION variable=win1_tmp dim=0 complete
@@ -5117,11 +2915,23 @@ void processMISOVECTF(
   ap_uint<BW_OUT> out_pixel;
   int row, col, i, j, colv;
 
+  // all columns of the vector windows are written before they are read,
+  // reset them for the compiler
+  for(i = 0; i < KERNEL_SIZE_Y; i++){
+    for(j = 0; j < KERNEL_SIZE_X+VECT-1; j++){
+    #pragma HLS unroll
+      win1_vect[i][j] = 0;
+      win2_vect[i][j] = 0;
+    }
+  }
+
   IMG_ROWS:
-  for(row = 0; row < MAX_HEIGHT+GDELAY_Y; ++row){
+  for(row = 0; row < LOOP_HEIGHT+GDELAY_Y; ++row){
+    PRAGMA_HLS(HLS loop_tripcount max=MAX_HEIGHT)
     //std::cout << "ROW: " << row << std::endl;
     IMG_COLS:
-    for(col = 0, colv = 0; col < MAX_WIDTH+GDELAY_X; col+=VECT, ++colv){
+    for(col = 0, colv = 0; col < LOOP_WIDTH+GDELAY_X_V*VECT; col+=VECT, ++colv){
+      PRAGMA_HLS(HLS loop_tripcount max=MAX_WIDTH/VECT)
       PRAGMA_HLS(HLS pipeline ii=II_TARGET)
       #pragma HLS INLINE region
       //**********************************************************
@@ -5136,7 +2946,7 @@ void processMISOVECTF(
       // UPDATE THE WINDOW
       // The line buffer behaves normally
       //**********************************************************
-      if (col < width & row < height + GDELAY_Y)
+      if (row < height + GDELAY_Y)
       {
         for(i = 0; i < KERNEL_SIZE_Y; i++){
         #pragma HLS unroll
@@ -5150,75 +2960,62 @@ void processMISOVECTF(
         // UPDATE THE LINE BUFFER
         // The line buffer behaves normally
         //**********************************************************
-        LINE_BUFF_1:
-        for(i = 0; i < KERNEL_SIZE_Y-1; i++){
-        #pragma HLS unroll
-          if (i == 0) {
-            win1_tmp[i][KERNEL_SIZE_X_V-1] = lineBuff1[i][colv];
-            win2_tmp[i][KERNEL_SIZE_X_V-1] = lineBuff2[i][colv];
-          } else {
-            temp1_lb = lineBuff1[i][colv];
-            temp2_lb = lineBuff2[i][colv];
-            win1_tmp[i][KERNEL_SIZE_X_V-1] = temp1_lb;
-            win2_tmp[i][KERNEL_SIZE_X_V-1] = temp2_lb;
-            lineBuff1[i-1][colv] = temp1_lb;
-            lineBuff2[i-1][colv] = temp2_lb;
+        if (col < width) {
+          LINE_BUFF_1:
+          for(i = 0; i < KERNEL_SIZE_Y-1; i++){
+          #pragma HLS unroll
+            if (i == 0) {
+              win1_tmp[i][KERNEL_SIZE_X_V-1] = lineBuff1[i][colv];
+              win2_tmp[i][KERNEL_SIZE_X_V-1] = lineBuff2[i][colv];
+            } else {
+              temp1_lb = lineBuff1[i][colv];
+              temp2_lb = lineBuff2[i][colv];
+              win1_tmp[i][KERNEL_SIZE_X_V-1] = temp1_lb;
+              win2_tmp[i][KERNEL_SIZE_X_V-1] = temp2_lb;
+              lineBuff1[i-1][colv] = temp1_lb;
+              lineBuff2[i-1][colv] = temp2_lb;
+            }
           }
+          if (KERNEL_SIZE_Y > 1) {
+            lineBuff1[KERNEL_SIZE_Y-2][colv] = in1_pixel;
+            lineBuff2[KERNEL_SIZE_Y-2][colv] = in2_pixel;
+          }
+          win1_tmp[KERNEL_SIZE_Y-1][KERNEL_SIZE_X_V-1] = in1_pixel;
+          win2_tmp[KERNEL_SIZE_Y-1][KERNEL_SIZE_X_V-1] = in2_pixel;
         }
-        if (KERNEL_SIZE_Y > 1) {
-          lineBuff1[KERNEL_SIZE_Y-2][colv] = in1_pixel;
-          lineBuff2[KERNEL_SIZE_Y-2][colv] = in2_pixel;
-        }
-        win1_tmp[KERNEL_SIZE_Y-1][KERNEL_SIZE_X_V-1] = in1_pixel;
-        win2_tmp[KERNEL_SIZE_Y-1][KERNEL_SIZE_X_V-1] = in2_pixel;
 
         //**********************************************************
         // UPDATE THE LP WINDOW
-        // Window update includes mirroring border treatment
+        // Window update includes border treatment in y-direction,
+        // the last vector holds the constant for BORDER_CONST
         //**********************************************************
-        // X-DIRECTION
-        for(i = 0; i < KERNEL_SIZE_Y; i++){
-          for(j = 0; j < KERNEL_SIZE_X_V; j++){
-            int jx = getNewCoords(j,KERNEL_SIZE_X_V,GDELAY_X,col,width,borderPadding);
-            win1[i][j] = win1_tmp[i][jx];
-            win2[i][j] = win2_tmp[i][jx];
-          }
-        }
-        // Y-DIRECTION
         for(i = 0; i < KERNEL_SIZE_Y; i++){
+          int iy = getNewCoords(i,KERNEL_SIZE_Y,GDELAY_Y,row,height,borderPadding);
           for(j = 0; j < KERNEL_SIZE_X_V; j++){
-            int iy = getNewCoords(i,KERNEL_SIZE_Y,GDELAY_Y,row,height,borderPadding);
-             win1[i][j] = win1[iy][j];
-             win2[i][j] = win2[iy][j];
+            win1[i][j] = (iy < 0) ? ap_uint<BW_IN>(0) : win1_tmp[iy][j];
+            win2[i][j] = (iy < 0) ? ap_uint<BW_IN>(0) : win2_tmp[iy][j];
           }
+          win1[i][KERNEL_SIZE_X_V] = 0;
+          win2[i][KERNEL_SIZE_X_V] = 0;
         }
 
         //**********************************************************
         // ASSIGN WINDOWS
+        // Pixel window includes border treatment in x-direction
         //**********************************************************
-        // fill original window
-        for(int j = 0; j < KERNEL_SIZE_X; j++){
-          winPos jv = getWinCoords((GDELAY_X_V*VECT)-GDELAY_X+j,KERNEL_SIZE_X, KERNEL_SIZE_X_V,VECT,GDELAY_X,col,width,borderPadding);
-          for(int i = 0; i < KERNEL_SIZE_Y; i++){
+        for(j = 0; j < KERNEL_SIZE_X+VECT-1; j++){
+          winPos jv = getWinCoords(j,KERNEL_SIZE_X,KERNEL_SIZE_X_V,VECT,colv,width,borderPadding);
+          for(i = 0; i < KERNEL_SIZE_Y; i++){
             win1_vect[i][j] = i2f(win1[i][jv.win]((jv.pos)*I_WIDTH_V,(jv.pos+1)*I_WIDTH_V-1));
             win2_vect[i][j] = i2f(win2[i][jv.win]((jv.pos)*I_WIDTH_V,(jv.pos+1)*I_WIDTH_V-1));
           }
         }
-
-        // fill window extension caused by vectorization
-        for (int v = 0; v < VECT-1; v++) {
-          winPos jv = getWinCoords((GDELAY_X_V*VECT)-GDELAY_X+KERNEL_SIZE_X+v,KERNEL_SIZE_X, KERNEL_SIZE_X_V,VECT,GDELAY_X,col,width,borderPadding);
-          for(int i = 0; i < KERNEL_SIZE_Y; i++){
-            win1_vect[i][KERNEL_SIZE_X+v] = i2f(win1[i][jv.win]((jv.pos)*I_WIDTH_V,(jv.pos+1)*I_WIDTH_V-1));
-            win2_vect[i][KERNEL_SIZE_X+v] = i2f(win2[i][jv.win]((jv.pos)*I_WIDTH_V,(jv.pos+1)*I_WIDTH_V-1));
-          }
-        }
       }
 
       //**********************************************************
       // DO CALCULATIONS
       //**********************************************************
-      if(row >= GDELAY_Y && col >= GDELAY_X)
+      if(row >= GDELAY_Y && col >= GDELAY_X_V*VECT)
       {
         for (int v = 0; v < VECT; v++) {
           INT win1_small[KERNEL_SIZE_Y][KERNEL_SIZE_X];
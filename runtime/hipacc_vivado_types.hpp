@@ -45,7 +45,7 @@
 //   double4 -> ap_uint<256>
 
 
-#include "ap_int.h"
+#include "hipacc_vivado_emu.hpp"
 
 
 typedef unsigned char       uchar;
@@ -42,7 +42,11 @@ ifge = $(shell if [ $(1) -ge $(2) ]; then echo true; else echo false; fi)
 # map n output pixels to one thread -> set HIPACC_PPT to n
 # use specific configuration for kernels -> set HIPACC_CONFIG to nxm
 # generate code that explores configuration -> set HIPACC_EXPLORE to off|on
+# read/update tuning database of best configurations -> set HIPACC_TUNING_DB to file
 # generate code that times kernel execution -> set HIPACC_TIMING to off|on
+# fuse producer/consumer kernels (C/C++ only) -> set HIPACC_FUSE to off|on
+# decompose separable constant masks (C/C++ only) -> set HIPACC_SEPARATE to off|on|exact
+# use running sums for floating-point box filters -> set HIPACC_RUNNING_SUMS to off|on
 HIPACC_LMEM?=off
 HIPACC_TEX?=off
 HIPACC_VEC?=off
@@ -50,6 +54,7 @@ HIPACC_PPT?=1
 HIPACC_CONFIG?=128x1
 HIPACC_EXPLORE?=off
 HIPACC_TIMING?=off
+HIPACC_FUSE?=off
 HIPACC_TARGET?=Fermi-20
 
 
@@ -75,9 +80,21 @@ endif
 ifeq ($(HIPACC_EXPLORE),on)
     HIPACC_OPTS+= -explore-config
 endif
+ifdef HIPACC_TUNING_DB
+    HIPACC_OPTS+= -tuning-db $(HIPACC_TUNING_DB)
+endif
 ifeq ($(HIPACC_TIMING),on)
     HIPACC_OPTS+= -time-kernels
 endif
+ifeq ($(HIPACC_FUSE),on)
+    HIPACC_OPTS+= -fuse-kernels
+endif
+ifdef HIPACC_SEPARATE
+    HIPACC_OPTS+= -separate-masks $(HIPACC_SEPARATE)
+endif
+ifdef HIPACC_RUNNING_SUMS
+    HIPACC_OPTS+= -running-sums $(HIPACC_RUNNING_SUMS)
+endif
 
 # set target GPU architecture to the compute capability encoded in target
 GPU_ARCH := $(shell echo $(HIPACC_TARGET) |cut -f2 -d-)
@@ -95,6 +112,35 @@ cpu:
 	@echo 'Executing C++ binary'
 	./main_cpu
 
+# compare the C/C++ code of the opencv_* tests without and with vectorization:
+# the scalar build disables the loop vectorizer of the C/C++ compiler, the
+# vectorized build uses -vectorize on
+VEC_BENCH_TESTS ?= $(wildcard ./tests/opencv_*)
+vectorize-bench:
+	@for test in $(VEC_BENCH_TESTS); do \
+	    echo "$$test (scalar):"; \
+	    $(MAKE) -s cpu TEST_CASE=$$test HIPACC_VEC=off OFLAGS="-O3 -fno-tree-vectorize" 2>&1 | grep '^Hipacc' || exit 1; \
+	    echo "$$test (vectorized):"; \
+	    $(MAKE) -s cpu TEST_CASE=$$test HIPACC_VEC=on 2>&1 | grep '^Hipacc' || exit 1; \
+	done
+
+# checks of the C/C++ runtime, no Hipacc compiler required: image buffer
+# pool, images on caller-owned host memory, and global reductions fused
+# into the kernel launch
+CPU_TESTS      ?= ./tests/cpu
+CPU_CC          = $(CC_CC) -I$(HIPACC_DIR)/include $(OFLAGS)
+
+cpu-check:
+	@echo 'Checking image buffer pool:'
+	$(CPU_CC) -o cpu_check_memory_pool $(CPU_TESTS)/memory_pool.cc $(CC_LINK)
+	./cpu_check_memory_pool
+	@echo 'Checking images on host memory:'
+	$(CPU_CC) -o cpu_check_host_memory $(CPU_TESTS)/host_memory.cc $(CC_LINK)
+	./cpu_check_host_memory
+	@echo 'Checking fused global reductions:'
+	$(CPU_CC) -o cpu_check_reductions $(CPU_TESTS)/reductions.cc $(CC_LINK)
+	./cpu_check_reductions
+
 cuda:
 	@echo 'Executing Hipacc Compiler for CUDA:'
 	$(COMPILER) $(TEST_CASE)/main.cpp $(MYFLAGS) $(COMPILER_INC) -emit-cuda $(HIPACC_OPTS) -o main.cu
@@ -137,7 +183,57 @@ else
 	cp build_$@/main_renderscript ./main_$@
 endif
 
+# search the configuration space and store the best configuration of each
+# kernel in HIPACC_TUNING_DB; block sizes and thread counts are explored at
+# run-time, the remaining options are enumerated here
+HIPACC_TUNE_PPT?=1 2 4 8
+HIPACC_TUNE_LMEM?=off on
+HIPACC_TUNE_TEX?=off Linear2D
+HIPACC_TUNE_TILES?=32x4 64x8 128x1 128x16 256x32
+
+tune-cpu:
+	$(if $(HIPACC_TUNING_DB),,$(error HIPACC_TUNING_DB is not set))
+	@for config in $(HIPACC_TUNE_TILES); do \
+	    for ppt in $(HIPACC_TUNE_PPT); do \
+	        $(MAKE) cpu HIPACC_EXPLORE=on HIPACC_CONFIG=$$config HIPACC_PPT=$$ppt || exit 1; \
+	    done; \
+	done
+
+tune-cuda:
+	$(if $(HIPACC_TUNING_DB),,$(error HIPACC_TUNING_DB is not set))
+	@for ppt in $(HIPACC_TUNE_PPT); do \
+	    for lmem in $(HIPACC_TUNE_LMEM); do \
+	        for tex in $(HIPACC_TUNE_TEX); do \
+	            $(MAKE) cuda HIPACC_EXPLORE=on HIPACC_PPT=$$ppt HIPACC_LMEM=$$lmem HIPACC_TEX=$$tex || exit 1; \
+	        done; \
+	    done; \
+	done
+
+tune-opencl-acc tune-opencl-cpu tune-opencl-gpu:
+	$(if $(HIPACC_TUNING_DB),,$(error HIPACC_TUNING_DB is not set))
+	@for ppt in $(HIPACC_TUNE_PPT); do \
+	    for lmem in $(HIPACC_TUNE_LMEM); do \
+	        $(MAKE) $(subst tune-,,$@) HIPACC_EXPLORE=on HIPACC_PPT=$$ppt HIPACC_LMEM=$$lmem || exit 1; \
+	    done; \
+	done
+
+# round trip of the tuning database for C/C++: exploring twice must only
+# replace entries, and the stored configurations must be readable by the
+# compiler
+tune-check:
+	rm -f tune_check.db
+	$(MAKE) cpu HIPACC_EXPLORE=on HIPACC_TUNING_DB=tune_check.db
+	test -s tune_check.db
+	cut -d' ' -f1-3 tune_check.db | sort > tune_check.keys
+	$(MAKE) cpu HIPACC_EXPLORE=on HIPACC_TUNING_DB=tune_check.db
+	cut -d' ' -f1-3 tune_check.db | sort | diff - tune_check.keys
+	$(MAKE) cpu HIPACC_TUNING_DB=tune_check.db > tune_check.log 2>&1 || (cat tune_check.log; exit 1)
+	cat tune_check.log
+	! grep -q 'could not read tuning database' tune_check.log
+
 clean:
 	rm -f main_* *.cu *.cc *.cubin *.cl *.isa *.rs *.fs
+	rm -f cpu_check_*
+	rm -f tune_check.*
 	rm -rf build_*
 
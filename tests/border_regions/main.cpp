@@ -0,0 +1,325 @@
+//
+// Copyright (c) 2014, University of Erlangen-Nuremberg
+// Copyright (c) 2014, Siemens AG
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "hipacc.hpp"
+
+// variables set by Makefile
+//#define WIDTH 4096
+//#define HEIGHT 4096
+
+using namespace hipacc;
+
+// Local operators for all boundary modes. C/C++ code computes the interior,
+// the border strips, and the corners in separate loops, and falls back to
+// border handling on all sides for images smaller than the window. Covered:
+//  - a 5x5 mask on the whole image and on a 3x2 image (fall back)
+//  - a 7x3 mask, whose left/right and top/bottom strips differ in size
+//  - an iteration space and accessor inside the image, whose borders start at
+//    their offset
+// The asymmetric coefficients make any misplaced pixel change the result.
+
+
+// reference: pixel of the image for the boundary mode, 0 outside the image for
+// Boundary::CONSTANT
+int border_pixel(uchar *in, int x, int y, int width, int height, Boundary
+        mode) {
+    switch (mode) {
+        default:
+        case Boundary::CLAMP:
+            x = std::min(std::max(x, 0), width-1);
+            y = std::min(std::max(y, 0), height-1);
+            break;
+        case Boundary::REPEAT:
+            if (x < 0) x += width;
+            if (x >= width) x -= width;
+            if (y < 0) y += height;
+            if (y >= height) y -= height;
+            break;
+        case Boundary::MIRROR:
+            if (x < 0) x = -x-1;
+            if (x >= width) x = width - (x+1 - width);
+            if (y < 0) y = -y-1;
+            if (y >= height) y = height - (y+1 - height);
+            break;
+        case Boundary::CONSTANT:
+            if (x < 0 || x >= width || y < 0 || y >= height) return 0;
+            break;
+    }
+    return in[y*width + x];
+}
+
+// reference: convolution of a width x height image, the rows of in and out
+// are stride pixels apart
+void convolve(uchar *in, int *out, const int *mask, int size_x, int size_y,
+        int width, int height, int stride, Boundary mode) {
+    std::vector<uchar> img(width*height);
+    for (int y=0; y<height; ++y) {
+        std::copy(in + y*stride, in + y*stride + width, &img[y*width]);
+    }
+    for (int y=0; y<height; ++y) {
+        for (int x=0; x<width; ++x) {
+            int sum = 0;
+            for (int yf=-size_y/2; yf<=size_y/2; ++yf) {
+                for (int xf=-size_x/2; xf<=size_x/2; ++xf) {
+                    sum += mask[(yf + size_y/2)*size_x + xf + size_x/2] *
+                           border_pixel(img.data(), x + xf, y + yf, width,
+                                   height, mode);
+                }
+            }
+            out[y*stride + x] = sum;
+        }
+    }
+}
+
+bool compare(int *out, int *ref, int width, int height, const char *name) {
+    for (int i=0; i<width*height; ++i) {
+        if (out[i] != ref[i]) {
+            std::cerr << "Test FAILED for " << name << ", at (" << i%width
+                      << "," << i/width << "): " << ref[i] << " vs. "
+                      << out[i] << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+
+// Kernel description in Hipacc
+class Convolution : public Kernel<int> {
+    private:
+        Accessor<uchar> &input;
+        Mask<int> &mask;
+
+    public:
+        Convolution(IterationSpace<int> &iter, Accessor<uchar> &input,
+                Mask<int> &mask) :
+            Kernel(iter),
+            input(input),
+            mask(mask)
+        { add_accessor(&input); }
+
+        void kernel() {
+            output() = convolve(mask, Reduce::SUM, [&] () -> int {
+                    return mask() * input(mask);
+                    });
+        }
+};
+
+
+int main(int argc, const char **argv) {
+    const int width = WIDTH;
+    const int height = HEIGHT;
+    const int small_width = 3;
+    const int small_height = 2;
+    const int offset_x = width/4;
+    const int offset_y = height/4;
+    const int is_width = width/2;
+    const int is_height = height/2;
+    float timing = 0.0f;
+
+    // host memory for image of width x height pixels
+    uchar *input = new uchar[width*height];
+    uchar *input_small = new uchar[small_width*small_height];
+    int *reference = new int[width*height];
+
+    // initialize data
+    for (int y=0; y<height; ++y) {
+        for (int x=0; x<width; ++x) {
+            input[y*width + x] = (uchar)((x*31 + y*17 + x*y) % 256);
+        }
+    }
+    for (int i=0; i<small_width*small_height; ++i) {
+        input_small[i] = (uchar)(i*37 + 11);
+    }
+
+    const int coef_5x5[5][5] = {
+        {  1,  2,  3,  4,  5 },
+        {  6,  7,  8,  9, 10 },
+        { 11, 12, 13, 14, 15 },
+        { 16, 17, 18, 19, 20 },
+        { 21, 22, 23, 24, 25 }
+    };
+    const int coef_7x3[3][7] = {
+        {  1,  2,  3,  4,  5,  6,  7 },
+        {  8,  9, 10, 11, 12, 13, 14 },
+        { 15, 16, 17, 18, 19, 20, 21 }
+    };
+    Mask<int> M5x5(coef_5x5);
+    Mask<int> M7x3(coef_7x3);
+
+    Image<uchar> IN(width, height, input);
+    Image<uchar> IN_SMALL(small_width, small_height, input_small);
+    Image<int> OUT_CLAMP(width, height);
+    Image<int> OUT_REPEAT(width, height);
+    Image<int> OUT_MIRROR(width, height);
+    Image<int> OUT_CONST(width, height);
+    Image<int> OUT_7X3(width, height);
+    Image<int> OUT_CROP(width, height);
+    Image<int> OUT_SMALL_CLAMP(small_width, small_height);
+    Image<int> OUT_SMALL_REPEAT(small_width, small_height);
+    Image<int> OUT_SMALL_MIRROR(small_width, small_height);
+    Image<int> OUT_SMALL_CONST(small_width, small_height);
+
+    BoundaryCondition<uchar> BcClamp(IN, M5x5, Boundary::CLAMP);
+    Accessor<uchar> AccClamp(BcClamp);
+    BoundaryCondition<uchar> BcRepeat(IN, M5x5, Boundary::REPEAT);
+    Accessor<uchar> AccRepeat(BcRepeat);
+    BoundaryCondition<uchar> BcMirror(IN, M5x5, Boundary::MIRROR);
+    Accessor<uchar> AccMirror(BcMirror);
+    BoundaryCondition<uchar> BcConst(IN, M5x5, Boundary::CONSTANT, 0);
+    Accessor<uchar> AccConst(BcConst);
+    BoundaryCondition<uchar> Bc7x3(IN, M7x3, Boundary::MIRROR);
+    Accessor<uchar> Acc7x3(Bc7x3);
+    Accessor<uchar> AccCrop(BcClamp, is_width, is_height, offset_x, offset_y);
+    BoundaryCondition<uchar> BcSmallClamp(IN_SMALL, M5x5, Boundary::CLAMP);
+    Accessor<uchar> AccSmallClamp(BcSmallClamp);
+    BoundaryCondition<uchar> BcSmallRepeat(IN_SMALL, M5x5, Boundary::REPEAT);
+    Accessor<uchar> AccSmallRepeat(BcSmallRepeat);
+    BoundaryCondition<uchar> BcSmallMirror(IN_SMALL, M5x5, Boundary::MIRROR);
+    Accessor<uchar> AccSmallMirror(BcSmallMirror);
+    BoundaryCondition<uchar> BcSmallConst(IN_SMALL, M5x5, Boundary::CONSTANT, 0);
+    Accessor<uchar> AccSmallConst(BcSmallConst);
+
+    IterationSpace<int> IsClamp(OUT_CLAMP);
+    IterationSpace<int> IsRepeat(OUT_REPEAT);
+    IterationSpace<int> IsMirror(OUT_MIRROR);
+    IterationSpace<int> IsConst(OUT_CONST);
+    IterationSpace<int> Is7x3(OUT_7X3);
+    IterationSpace<int> IsCrop(OUT_CROP, is_width, is_height, offset_x, offset_y);
+    IterationSpace<int> IsSmallClamp(OUT_SMALL_CLAMP);
+    IterationSpace<int> IsSmallRepeat(OUT_SMALL_REPEAT);
+    IterationSpace<int> IsSmallMirror(OUT_SMALL_MIRROR);
+    IterationSpace<int> IsSmallConst(OUT_SMALL_CONST);
+
+    Convolution Clamp(IsClamp, AccClamp, M5x5);
+    Convolution Repeat(IsRepeat, AccRepeat, M5x5);
+    Convolution Mirror(IsMirror, AccMirror, M5x5);
+    Convolution Const(IsConst, AccConst, M5x5);
+    Convolution Conv7x3(Is7x3, Acc7x3, M7x3);
+    Convolution Crop(IsCrop, AccCrop, M5x5);
+    Convolution SmallClamp(IsSmallClamp, AccSmallClamp, M5x5);
+    Convolution SmallRepeat(IsSmallRepeat, AccSmallRepeat, M5x5);
+    Convolution SmallMirror(IsSmallMirror, AccSmallMirror, M5x5);
+    Convolution SmallConst(IsSmallConst, AccSmallConst, M5x5);
+
+    std::cerr << "Calculating convolutions ..." << std::endl;
+
+    Clamp.execute();
+    timing = hipacc_last_kernel_timing();
+    std::cerr << "Hipacc 5x5 CLAMP: " << timing << " ms, " << (width*height/timing)/1000 << " Mpixel/s" << std::endl;
+
+    Repeat.execute();
+    timing = hipacc_last_kernel_timing();
+    std::cerr << "Hipacc 5x5 REPEAT: " << timing << " ms, " << (width*height/timing)/1000 << " Mpixel/s" << std::endl;
+
+    Mirror.execute();
+    timing = hipacc_last_kernel_timing();
+    std::cerr << "Hipacc 5x5 MIRROR: " << timing << " ms, " << (width*height/timing)/1000 << " Mpixel/s" << std::endl;
+
+    Const.execute();
+    timing = hipacc_last_kernel_timing();
+    std::cerr << "Hipacc 5x5 CONSTANT: " << timing << " ms, " << (width*height/timing)/1000 << " Mpixel/s" << std::endl;
+
+    Conv7x3.execute();
+    timing = hipacc_last_kernel_timing();
+    std::cerr << "Hipacc 7x3 MIRROR: " << timing << " ms, " << (width*height/timing)/1000 << " Mpixel/s" << std::endl;
+
+    Crop.execute();
+    SmallClamp.execute();
+    SmallRepeat.execute();
+    SmallMirror.execute();
+    SmallConst.execute();
+
+    // get pointer to result data
+    int *output_clamp = OUT_CLAMP.data();
+    int *output_repeat = OUT_REPEAT.data();
+    int *output_mirror = OUT_MIRROR.data();
+    int *output_const = OUT_CONST.data();
+    int *output_7x3 = OUT_7X3.data();
+    int *output_crop = OUT_CROP.data();
+    int *output_small_clamp = OUT_SMALL_CLAMP.data();
+    int *output_small_repeat = OUT_SMALL_REPEAT.data();
+    int *output_small_mirror = OUT_SMALL_MIRROR.data();
+    int *output_small_const = OUT_SMALL_CONST.data();
+
+
+    std::cerr << std::endl << "Comparing results ..." << std::endl;
+    bool passed_all = true;
+
+    convolve(input, reference, &coef_5x5[0][0], 5, 5, width, height, width,
+            Boundary::CLAMP);
+    passed_all &= compare(output_clamp, reference, width, height, "5x5 CLAMP");
+    convolve(input, reference, &coef_5x5[0][0], 5, 5, width, height, width,
+            Boundary::REPEAT);
+    passed_all &= compare(output_repeat, reference, width, height, "5x5 REPEAT");
+    convolve(input, reference, &coef_5x5[0][0], 5, 5, width, height, width,
+            Boundary::MIRROR);
+    passed_all &= compare(output_mirror, reference, width, height, "5x5 MIRROR");
+    convolve(input, reference, &coef_5x5[0][0], 5, 5, width, height, width,
+            Boundary::CONSTANT);
+    passed_all &= compare(output_const, reference, width, height, "5x5 CONSTANT");
+    convolve(input, reference, &coef_7x3[0][0], 7, 3, width, height, width,
+            Boundary::MIRROR);
+    passed_all &= compare(output_7x3, reference, width, height, "7x3 MIRROR");
+
+    // pixels outside of the iteration space keep their initial value
+    std::fill(reference, reference + width*height, 0);
+    convolve(input + offset_y*width + offset_x, reference + offset_y*width +
+            offset_x, &coef_5x5[0][0], 5, 5, is_width, is_height, width,
+            Boundary::CLAMP);
+    passed_all &= compare(output_crop, reference, width, height, "5x5 CLAMP iteration space");
+
+    convolve(input_small, reference, &coef_5x5[0][0], 5, 5, small_width,
+            small_height, small_width, Boundary::CLAMP);
+    passed_all &= compare(output_small_clamp, reference, small_width, small_height, "3x2 image CLAMP");
+    convolve(input_small, reference, &coef_5x5[0][0], 5, 5, small_width,
+            small_height, small_width, Boundary::REPEAT);
+    passed_all &= compare(output_small_repeat, reference, small_width, small_height, "3x2 image REPEAT");
+    convolve(input_small, reference, &coef_5x5[0][0], 5, 5, small_width,
+            small_height, small_width, Boundary::MIRROR);
+    passed_all &= compare(output_small_mirror, reference, small_width, small_height, "3x2 image MIRROR");
+    convolve(input_small, reference, &coef_5x5[0][0], 5, 5, small_width,
+            small_height, small_width, Boundary::CONSTANT);
+    passed_all &= compare(output_small_const, reference, small_width, small_height, "3x2 image CONSTANT");
+
+    // memory cleanup
+    delete[] input;
+    delete[] input_small;
+    delete[] reference;
+
+    if (!passed_all) {
+        return EXIT_FAILURE;
+    }
+    std::cerr << "Test PASSED" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,276 @@
+//
+// Copyright (c) 2014, University of Erlangen-Nuremberg
+// Copyright (c) 2014, Siemens AG
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+#include "hipacc.hpp"
+
+// variables set by Makefile
+//#define WIDTH 4096
+//#define HEIGHT 4096
+
+using namespace hipacc;
+
+// Convolutions with constant masks, which are emitted per coefficient: taps
+// with coefficient 0 are skipped, taps with +-1 are added or subtracted, and
+// integer taps sharing a coefficient are summed up before they are
+// multiplied (by shifts for powers of two). Covered:
+//  - Sobel and Laplace masks with 0 and +-1 coefficients
+//  - a 3x3 mask of 3s and a 5x5 binomial mask, whose grouped uchar taps
+//    exceed the range of uchar
+//  - float masks, which have to be bit-exact since floating-point taps are
+//    not reassociated
+
+
+// reference: convolution of a size x size mask, clamped at the border; taps
+// are summed in mask order
+template<typename T>
+void convolve(uchar *in, T *out, const T *mask, int size, int width, int
+        height) {
+    for (int y=0; y<height; ++y) {
+        for (int x=0; x<width; ++x) {
+            T sum = 0;
+            bool first = true;
+            for (int yf=-size/2; yf<=size/2; ++yf) {
+                for (int xf=-size/2; xf<=size/2; ++xf) {
+                    int xc = std::min(std::max(x + xf, 0), width-1);
+                    int yc = std::min(std::max(y + yf, 0), height-1);
+                    T val = mask[(yf + size/2)*size + xf + size/2] *
+                            in[yc*width + xc];
+                    sum = first ? val : sum + val;
+                    first = false;
+                }
+            }
+            out[y*width + x] = sum;
+        }
+    }
+}
+
+template<typename T>
+bool compare(T *out, T *ref, int width, int height, const char *name) {
+    for (int i=0; i<width*height; ++i) {
+        if (out[i] != ref[i]) {
+            std::cerr << "Test FAILED for " << name << ", at (" << i%width
+                      << "," << i/width << "): " << ref[i] << " vs. "
+                      << out[i] << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+
+// Kernel description in Hipacc
+class ConvolutionInt : public Kernel<int> {
+    private:
+        Accessor<uchar> &input;
+        Mask<int> &mask;
+
+    public:
+        ConvolutionInt(IterationSpace<int> &iter, Accessor<uchar> &input,
+                Mask<int> &mask) :
+            Kernel(iter),
+            input(input),
+            mask(mask)
+        { add_accessor(&input); }
+
+        void kernel() {
+            output() = convolve(mask, Reduce::SUM, [&] () -> int {
+                    return mask() * input(mask);
+                    });
+        }
+};
+
+class ConvolutionFloat : public Kernel<float> {
+    private:
+        Accessor<uchar> &input;
+        Mask<float> &mask;
+
+    public:
+        ConvolutionFloat(IterationSpace<float> &iter, Accessor<uchar> &input,
+                Mask<float> &mask) :
+            Kernel(iter),
+            input(input),
+            mask(mask)
+        { add_accessor(&input); }
+
+        void kernel() {
+            output() = convolve(mask, Reduce::SUM, [&] () -> float {
+                    return mask() * input(mask);
+                    });
+        }
+};
+
+
+int main(int argc, const char **argv) {
+    const int width = WIDTH;
+    const int height = HEIGHT;
+    float timing = 0.0f;
+
+    // host memory for image of width x height pixels
+    uchar *input = new uchar[width*height];
+    int *reference = new int[width*height];
+    float *reference_float = new float[width*height];
+
+    // initialize data, covering the whole range of uchar
+    for (int y=0; y<height; ++y) {
+        for (int x=0; x<width; ++x) {
+            input[y*width + x] = (uchar)((x*73 + y*151 + x*y) % 256);
+        }
+    }
+
+    const int coef_sobel[3][3] = {
+        { -1, 0, 1 },
+        { -2, 0, 2 },
+        { -1, 0, 1 }
+    };
+    const int coef_laplace[3][3] = {
+        { 1,  1, 1 },
+        { 1, -8, 1 },
+        { 1,  1, 1 }
+    };
+    const int coef_threes[3][3] = {
+        { 3, 3, 3 },
+        { 3, 3, 3 },
+        { 3, 3, 3 }
+    };
+    const int coef_binomial[5][5] = {
+        { 1,  4,  6,  4, 1 },
+        { 4, 16, 24, 16, 4 },
+        { 6, 24, 36, 24, 6 },
+        { 4, 16, 24, 16, 4 },
+        { 1,  4,  6,  4, 1 }
+    };
+    const float coef_sobel_float[3][3] = {
+        { -1.0f, -2.0f, -1.0f },
+        {  0.0f,  0.0f,  0.0f },
+        {  1.0f,  2.0f,  1.0f }
+    };
+    const float coef_weights[3][3] = {
+        { 0.1f,  0.0f, 0.1f },
+        { 0.25f, 1.0f, 0.25f },
+        { 0.1f,  0.0f, 0.1f }
+    };
+    Mask<int> MSobel(coef_sobel);
+    Mask<int> MLaplace(coef_laplace);
+    Mask<int> MThrees(coef_threes);
+    Mask<int> MBinomial(coef_binomial);
+    Mask<float> MSobelFloat(coef_sobel_float);
+    Mask<float> MWeights(coef_weights);
+
+    Image<uchar> IN(width, height, input);
+    Image<int> OUT_SOBEL(width, height);
+    Image<int> OUT_LAPLACE(width, height);
+    Image<int> OUT_THREES(width, height);
+    Image<int> OUT_BINOMIAL(width, height);
+    Image<float> OUT_SOBEL_FLOAT(width, height);
+    Image<float> OUT_WEIGHTS(width, height);
+
+    BoundaryCondition<uchar> Bc3x3(IN, MSobel, Boundary::CLAMP);
+    Accessor<uchar> Acc3x3(Bc3x3);
+    BoundaryCondition<uchar> Bc5x5(IN, MBinomial, Boundary::CLAMP);
+    Accessor<uchar> Acc5x5(Bc5x5);
+
+    IterationSpace<int> IsSobel(OUT_SOBEL);
+    IterationSpace<int> IsLaplace(OUT_LAPLACE);
+    IterationSpace<int> IsThrees(OUT_THREES);
+    IterationSpace<int> IsBinomial(OUT_BINOMIAL);
+    IterationSpace<float> IsSobelFloat(OUT_SOBEL_FLOAT);
+    IterationSpace<float> IsWeights(OUT_WEIGHTS);
+
+    ConvolutionInt Sobel(IsSobel, Acc3x3, MSobel);
+    ConvolutionInt Laplace(IsLaplace, Acc3x3, MLaplace);
+    ConvolutionInt Threes(IsThrees, Acc3x3, MThrees);
+    ConvolutionInt Binomial(IsBinomial, Acc5x5, MBinomial);
+    ConvolutionFloat SobelFloat(IsSobelFloat, Acc3x3, MSobelFloat);
+    ConvolutionFloat Weights(IsWeights, Acc3x3, MWeights);
+
+    std::cerr << "Calculating convolutions ..." << std::endl;
+
+    Sobel.execute();
+    timing = hipacc_last_kernel_timing();
+    std::cerr << "Hipacc Sobel: " << timing << " ms, " << (width*height/timing)/1000 << " Mpixel/s" << std::endl;
+
+    Laplace.execute();
+    timing = hipacc_last_kernel_timing();
+    std::cerr << "Hipacc Laplace: " << timing << " ms, " << (width*height/timing)/1000 << " Mpixel/s" << std::endl;
+
+    Threes.execute();
+    timing = hipacc_last_kernel_timing();
+    std::cerr << "Hipacc 3x3 threes: " << timing << " ms, " << (width*height/timing)/1000 << " Mpixel/s" << std::endl;
+
+    Binomial.execute();
+    timing = hipacc_last_kernel_timing();
+    std::cerr << "Hipacc 5x5 binomial: " << timing << " ms, " << (width*height/timing)/1000 << " Mpixel/s" << std::endl;
+
+    SobelFloat.execute();
+    timing = hipacc_last_kernel_timing();
+    std::cerr << "Hipacc Sobel float: " << timing << " ms, " << (width*height/timing)/1000 << " Mpixel/s" << std::endl;
+
+    Weights.execute();
+    timing = hipacc_last_kernel_timing();
+    std::cerr << "Hipacc 3x3 weights float: " << timing << " ms, " << (width*height/timing)/1000 << " Mpixel/s" << std::endl;
+
+    // get pointer to result data
+    int *output_sobel = OUT_SOBEL.data();
+    int *output_laplace = OUT_LAPLACE.data();
+    int *output_threes = OUT_THREES.data();
+    int *output_binomial = OUT_BINOMIAL.data();
+    float *output_sobel_float = OUT_SOBEL_FLOAT.data();
+    float *output_weights = OUT_WEIGHTS.data();
+
+
+    std::cerr << std::endl << "Comparing results ..." << std::endl;
+    bool passed_all = true;
+
+    convolve(input, reference, &coef_sobel[0][0], 3, width, height);
+    passed_all &= compare(output_sobel, reference, width, height, "Sobel");
+    convolve(input, reference, &coef_laplace[0][0], 3, width, height);
+    passed_all &= compare(output_laplace, reference, width, height, "Laplace");
+    convolve(input, reference, &coef_threes[0][0], 3, width, height);
+    passed_all &= compare(output_threes, reference, width, height, "3x3 threes");
+    convolve(input, reference, &coef_binomial[0][0], 5, width, height);
+    passed_all &= compare(output_binomial, reference, width, height, "5x5 binomial");
+    convolve(input, reference_float, &coef_sobel_float[0][0], 3, width, height);
+    passed_all &= compare(output_sobel_float, reference_float, width, height, "Sobel float");
+    convolve(input, reference_float, &coef_weights[0][0], 3, width, height);
+    passed_all &= compare(output_weights, reference_float, width, height, "3x3 weights float");
+
+    // memory cleanup
+    delete[] input;
+    delete[] reference;
+    delete[] reference_float;
+
+    if (!passed_all) {
+        return EXIT_FAILURE;
+    }
+    std::cerr << "Test PASSED" << std::endl;
+
+    return EXIT_SUCCESS;
+}
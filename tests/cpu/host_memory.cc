@@ -0,0 +1,113 @@
+//
+// Copyright (c) 2014, University of Erlangen-Nuremberg
+// Copyright (c) 2014, Siemens AG
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+// Checks images of hipacc_cpu.hpp that use caller-owned host memory:
+//  - kernels read and write the host memory directly, using its row stride
+//  - writing the memory to its own image and reading the image do not copy
+//  - padding between rows is not touched
+//  - released images leave the memory to the caller, it is not handed out
+//    by the image buffer pool
+
+#include "hipacc_cpu.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+int main(int argc, const char **argv) {
+    const int width = 77, height = 33, stride = 96;
+    const int pad = -12345;
+    int errors = 0;
+
+    std::vector<int> in(stride*height, pad);
+    std::vector<int> out(stride*height, pad);
+    for (int y=0; y<height; ++y) {
+        for (int x=0; x<width; ++x) {
+            in[y*stride + x] = x*13 - y*7;
+        }
+    }
+
+    HipaccImage IN = hipaccMapMemory<int>(in.data(), width, height, stride);
+    HipaccImage OUT = hipaccMapMemory<int>(out.data(), width, height, stride);
+    if (IN.mem != in.data() || IN.stride != (size_t)stride) {
+        std::cerr << "mapped image: memory " << IN.mem << ", stride "
+                  << IN.stride << std::endl;
+        ++errors;
+    }
+
+    // no copies of the host memory
+    hipaccWriteMemory(IN, in.data());
+    if (hipaccReadMemory<int>(IN) != in.data()) {
+        std::cerr << "mapped image: read returns a copy" << std::endl;
+        ++errors;
+    }
+
+    // kernel in the form of the generated code: pointers with the row stride
+    // of the image
+    int (*input)[stride] = (int (*)[stride])IN.mem;
+    int (*output)[stride] = (int (*)[stride])OUT.mem;
+    hipaccLaunchKernel(0, height, [&] (int lower, int upper) {
+        for (int y=lower; y<upper; ++y) {
+            for (int x=0; x<width; ++x) {
+                output[y][x] = 2*input[y][x] + 1;
+            }
+        }
+    });
+
+    int *result = hipaccReadMemory<int>(OUT);
+    for (int y=0; y<height; ++y) {
+        for (int x=0; x<stride; ++x) {
+            int ref = x < width ? 2*in[y*stride + x] + 1 : pad;
+            if (result[y*stride + x] != ref) {
+                std::cerr << "kernel output: at (" << x << "," << y << "): "
+                          << result[y*stride + x] << " vs. " << ref
+                          << std::endl;
+                ++errors;
+                y = height;
+                break;
+            }
+        }
+    }
+
+    // memory of released images is not reused
+    hipaccReleaseMemory(IN);
+    hipaccReleaseMemory(OUT);
+    HipaccImage img = hipaccCreateMemory<int>(NULL, stride, height);
+    if (img.mem == in.data() || img.mem == out.data()) {
+        std::cerr << "pool: host memory handed out" << std::endl;
+        ++errors;
+    }
+    hipaccReleaseMemory(img);
+
+    if (errors) {
+        std::cerr << "Test FAILED: " << errors << " errors" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cerr << "Test PASSED" << std::endl;
+    return EXIT_SUCCESS;
+}
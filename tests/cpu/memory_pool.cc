@@ -0,0 +1,141 @@
+//
+// Copyright (c) 2014, University of Erlangen-Nuremberg
+// Copyright (c) 2014, Siemens AG
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+// Checks the image buffer pool of hipacc_cpu.hpp:
+//  - buffers are at least cache line aligned, large buffers huge page aligned
+//  - padded images keep their data when written and read
+//  - released buffers are reused for images of the same size and are
+//    zero-filled when no host data is given
+//  - copies of an image share one host copy
+
+#include "hipacc_cpu.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+bool is_aligned(void *mem, size_t alignment) {
+    return ((uintptr_t)mem) % alignment == 0;
+}
+
+bool is_zero(HipaccImage &img) {
+    int *mem = (int *)img.mem;
+    for (size_t i=0; i<img.stride*img.height; ++i) {
+        if (mem[i] != 0) return false;
+    }
+    return true;
+}
+
+
+int main(int argc, const char **argv) {
+    const int width = 100, height = 50;
+    int errors = 0;
+
+    std::vector<int> data(width*height);
+    for (int i=0; i<width*height; ++i) data[i] = i*7 - 1000;
+
+    // padded image: rows are 256 bytes aligned
+    HipaccImage img = hipaccCreateMemory<int>(NULL, width, height, 256);
+    if (!is_aligned(img.mem, 256) || img.stride != 128) {
+        std::cerr << "padded image: memory " << img.mem << ", stride "
+                  << img.stride << std::endl;
+        ++errors;
+    }
+    if (!is_zero(img)) {
+        std::cerr << "padded image: not zero-filled" << std::endl;
+        ++errors;
+    }
+
+    hipaccWriteMemory(img, data.data());
+    int *host = hipaccReadMemory<int>(img);
+    for (int i=0; i<width*height; ++i) {
+        if (host[i] != data[i]) {
+            std::cerr << "padded image: at (" << i%width << "," << i/width
+                      << "): " << host[i] << " vs. " << data[i] << std::endl;
+            ++errors;
+            break;
+        }
+    }
+
+    // copies share the host copy
+    HipaccImage copy = img;
+    if (hipaccReadMemory<int>(copy) != host) {
+        std::cerr << "image copy: host copy not shared" << std::endl;
+        ++errors;
+    }
+
+    // the released buffer holds data and is handed out again
+    void *mem = img.mem;
+    hipaccReleaseMemory(img);
+    HipaccImage reused = hipaccCreateMemory<int>(NULL, width, height, 256);
+    if (reused.mem != mem) {
+        std::cerr << "pool: buffer not reused" << std::endl;
+        ++errors;
+    }
+    if (!is_zero(reused)) {
+        std::cerr << "pool: reused buffer not zero-filled" << std::endl;
+        ++errors;
+    }
+
+    // unaligned request, still cache line aligned
+    HipaccImage small = hipaccCreateMemory<int>(data.data(), 3, 5);
+    if (!is_aligned(small.mem, 64) || small.stride != 3) {
+        std::cerr << "small image: memory " << small.mem << ", stride "
+                  << small.stride << std::endl;
+        ++errors;
+    }
+
+    // 4MB image
+    HipaccImage large = hipaccCreateMemory<int>(NULL, 1024, 1024);
+    if (!is_aligned(large.mem, HipaccMemoryPool::HUGE_PAGE_SIZE)) {
+        std::cerr << "large image: memory " << large.mem << std::endl;
+        ++errors;
+    }
+
+    hipaccReleaseMemory(reused);
+    hipaccReleaseMemory(small);
+    hipaccReleaseMemory(large);
+    hipaccClearMemoryPool();
+
+    // the pool is usable after clearing it
+    HipaccImage fresh = hipaccCreateMemory<int>(data.data(), width, height, 256);
+    if (!is_aligned(fresh.mem, 256) ||
+        hipaccReadMemory<int>(fresh)[width*height-1] != data[width*height-1]) {
+        std::cerr << "cleared pool: allocation failed" << std::endl;
+        ++errors;
+    }
+    hipaccReleaseMemory(fresh);
+
+    if (errors) {
+        std::cerr << "Test FAILED: " << errors << " errors" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cerr << "Test PASSED" << std::endl;
+    return EXIT_SUCCESS;
+}
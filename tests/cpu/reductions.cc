@@ -0,0 +1,130 @@
+//
+// Copyright (c) 2014, University of Erlangen-Nuremberg
+// Copyright (c) 2014, Siemens AG
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+// Checks the global reductions of hipacc_cpu.hpp against sequential
+// references:
+//  - hipaccLaunchKernelReduce computes and reduces the output in blocks of
+//    rows; the block size is reduced here, so that bands consist of several
+//    blocks
+//  - every row is computed exactly once, also when the number of threads is
+//    limited
+//  - widths that are not a multiple of the SIMD lanes, accessors with offset
+//  - hipaccApplyReduction on the same images
+
+#define HIPACC_REDUCE_BLOCK_SIZE 1024
+
+#include "hipacc_cpu.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+// images of width x height pixels, reduced region is the accessor
+template<typename T, typename F>
+int check_reduction(const char *name, int width, int height, int offset_x,
+        int offset_y, int acc_width, int acc_height, F reduce, T ref_init,
+        int num_threads) {
+    HipaccImage img = hipaccCreateMemory<T>(NULL, width, height, 64);
+    HipaccAccessor acc(img, acc_width, acc_height, offset_x, offset_y);
+    std::vector<int> computed(height, 0);
+
+    T *out = (T *)img.mem;
+    auto kernel = [&] (int lower, int upper) {
+        for (int y=lower; y<upper; ++y) {
+            ++computed[y];
+            for (int x=0; x<width; ++x) {
+                out[y*img.stride + x] = (T)((x*31 + y*17) % 97) - (T)40;
+            }
+        }
+    };
+
+    T ref = ref_init;
+    for (int y=offset_y; y<offset_y+acc_height; ++y) {
+        for (int x=offset_x; x<offset_x+acc_width; ++x) {
+            ref = reduce(ref, (T)((x*31 + y*17) % 97) - (T)40);
+        }
+    }
+
+    int errors = 0;
+    T fused = hipaccLaunchKernelReduce<T>(kernel, reduce, acc, num_threads);
+    T separate = hipaccApplyReduction<T>(reduce, acc);
+    if (std::fabs(fused - ref) > 1e-5*std::fabs(ref) ||
+        std::fabs(separate - ref) > 1e-5*std::fabs(ref)) {
+        std::cerr << name << " " << acc_width << "x" << acc_height << ": "
+                  << fused << ", " << separate << " vs. " << ref << std::endl;
+        ++errors;
+    }
+    for (int y=0; y<height; ++y) {
+        int expected = y >= offset_y && y < offset_y + acc_height ? 1 : 0;
+        if (computed[y] != expected) {
+            std::cerr << name << " " << acc_width << "x" << acc_height
+                      << ": row " << y << " computed " << computed[y]
+                      << " times" << std::endl;
+            ++errors;
+            break;
+        }
+    }
+
+    hipaccReleaseMemory(img);
+    return errors;
+}
+
+
+int main(int argc, const char **argv) {
+    auto sum_int = [] (int left, int right) { return left + right; };
+    auto min_int = [] (int left, int right) { return std::min(left, right); };
+    auto max_float = [] (float left, float right) { return std::max(left, right); };
+    auto sum_float = [] (float left, float right) { return left + right; };
+    int errors = 0;
+
+    for (int num_threads=0; num_threads<=1; ++num_threads) {
+        for (int width=1; width<=37; width+=6) {
+            errors += check_reduction<int>("int sum", width, 203, 0, 0,
+                    width, 203, sum_int, 0, num_threads);
+            errors += check_reduction<int>("int min", width, 203, 0, 0,
+                    width, 203, min_int, 1000, num_threads);
+            errors += check_reduction<float>("float max", width, 203, 0, 0,
+                    width, 203, max_float, -1000.0f, num_threads);
+        }
+        errors += check_reduction<int>("int sum", 300, 400, 17, 33, 251, 301,
+                sum_int, 0, num_threads);
+        errors += check_reduction<float>("float sum", 300, 400, 5, 9, 123, 2,
+                sum_float, 0.0f, num_threads);
+        errors += check_reduction<int>("int sum", 300, 3, 0, 1, 300, 1,
+                sum_int, 0, num_threads);
+    }
+
+    if (errors) {
+        std::cerr << "Test FAILED: " << errors << " errors" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cerr << "Test PASSED" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -336,6 +336,26 @@ int main(int argc, const char **argv) {
     std::cerr << "Hipacc: " << dt << " ms, " << (width*height/dt)/1000 << " Mpixel/s" << std::endl;
 
 
+    // benchmark: kernel execution including the reduction
+    const int num_iterations = 10;
+    std::cerr << std::endl << "Benchmarking global reductions ..." << std::endl;
+    time0 = time_ms();
+    for (int i=0; i<num_iterations; ++i) {
+        redSumINInt.execute();
+    }
+    time1 = time_ms();
+    dt = (time1 - time0) / num_iterations;
+    std::cerr << "Hipacc sum (img, int): " << dt << " ms, " << (width*height/dt)/1000 << " Mpixel/s" << std::endl;
+
+    time0 = time_ms();
+    for (int i=0; i<num_iterations; ++i) {
+        redSumINFloat.execute();
+    }
+    time1 = time_ms();
+    dt = (time1 - time0) / num_iterations;
+    std::cerr << "Hipacc sum (img, float): " << dt << " ms, " << (width*height/dt)/1000 << " Mpixel/s" << std::endl;
+
+
     std::cerr << std::endl << "Calculating reference ..." << std::endl;
     time0 = time_ms();
 
@@ -0,0 +1,168 @@
+//
+// Copyright (c) 2014, University of Erlangen-Nuremberg
+// Copyright (c) 2014, Siemens AG
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "hipacc.hpp"
+
+// variables set by Makefile
+//#define WIDTH 4096
+//#define HEIGHT 4096
+
+using namespace hipacc;
+
+// Images on caller-owned host memory with padded rows: compile with C/C++ as
+// target, other targets do not support Image(width, height, mem, stride). The
+// kernels read and write the host memory directly, the padding between rows
+// is not touched.
+
+#define STRIDE (WIDTH + 13)
+#define PAD -777
+
+
+// reference: 3x3 box sum, clamped at the border
+void box_sum(int *in, int *out, int width, int height, int stride) {
+    for (int y=0; y<height; ++y) {
+        for (int x=0; x<width; ++x) {
+            int sum = 0;
+            for (int yf=-1; yf<=1; ++yf) {
+                for (int xf=-1; xf<=1; ++xf) {
+                    int xc = std::min(std::max(x + xf, 0), width-1);
+                    int yc = std::min(std::max(y + yf, 0), height-1);
+                    sum += in[yc*stride + xc];
+                }
+            }
+            out[y*stride + x] = sum;
+        }
+    }
+}
+
+
+// Kernel description in Hipacc
+class BoxSum : public Kernel<int> {
+    private:
+        Accessor<int> &input;
+        Domain &dom;
+
+    public:
+        BoxSum(IterationSpace<int> &iter, Accessor<int> &input, Domain &dom) :
+            Kernel(iter),
+            input(input),
+            dom(dom)
+        { add_accessor(&input); }
+
+        void kernel() {
+            output() = reduce(dom, Reduce::SUM, [&] () -> int {
+                    return input(dom);
+                    });
+        }
+};
+
+class Scale : public Kernel<int> {
+    private:
+        Accessor<int> &input;
+
+    public:
+        Scale(IterationSpace<int> &iter, Accessor<int> &input) :
+            Kernel(iter),
+            input(input)
+        { add_accessor(&input); }
+
+        void kernel() {
+            output() = 3*input() - 1;
+        }
+};
+
+
+int main(int argc, const char **argv) {
+    const int width = WIDTH;
+    const int height = HEIGHT;
+    float timing = 0.0f;
+
+    // host memory with padded rows
+    std::vector<int> input(STRIDE*height, PAD);
+    std::vector<int> output(STRIDE*height, PAD);
+    std::vector<int> reference(STRIDE*height, PAD);
+
+    // initialize data
+    for (int y=0; y<height; ++y) {
+        for (int x=0; x<width; ++x) {
+            input[y*STRIDE + x] = (x*7 + y*11) % 101;
+        }
+    }
+
+    Domain D3x3(3, 3);
+
+    Image<int> IN(width, height, input.data(), STRIDE);
+    Image<int> OUT(width, height, output.data(), STRIDE);
+    Image<int> TMP(width, height);
+
+    BoundaryCondition<int> BcIn(IN, D3x3, Boundary::CLAMP);
+    Accessor<int> AccIn(BcIn);
+    IterationSpace<int> IsTmp(TMP);
+    BoxSum Box(IsTmp, AccIn, D3x3);
+
+    Accessor<int> AccTmp(TMP);
+    IterationSpace<int> IsOut(OUT);
+    Scale ScaleTmp(IsOut, AccTmp);
+
+    std::cerr << "Calculating Hipacc kernels ..." << std::endl;
+
+    Box.execute();
+    timing = hipacc_last_kernel_timing();
+    std::cerr << "Hipacc box sum: " << timing << " ms, " << (width*height/timing)/1000 << " Mpixel/s" << std::endl;
+
+    ScaleTmp.execute();
+    timing = hipacc_last_kernel_timing();
+    std::cerr << "Hipacc scale: " << timing << " ms, " << (width*height/timing)/1000 << " Mpixel/s" << std::endl;
+
+    // the result is in the host memory, no read of OUT required
+    int *result = output.data();
+
+
+    std::cerr << std::endl << "Comparing results ..." << std::endl;
+    box_sum(input.data(), reference.data(), width, height, STRIDE);
+    for (int y=0; y<height; ++y) {
+        for (int x=0; x<width; ++x) {
+            reference[y*STRIDE + x] = 3*reference[y*STRIDE + x] - 1;
+        }
+    }
+    for (int i=0; i<STRIDE*height; ++i) {
+        if (result[i] != reference[i]) {
+            std::cerr << "Test FAILED, at (" << i%STRIDE << "," << i/STRIDE
+                      << "): " << reference[i] << " vs. " << result[i]
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cerr << "Test PASSED" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,167 @@
+//
+// Copyright (c) 2014, University of Erlangen-Nuremberg
+// Copyright (c) 2014, Siemens AG
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <cstdlib>
+#include <iostream>
+
+#include "hipacc.hpp"
+
+// variables set by Makefile
+//#define WIDTH 4096
+//#define HEIGHT 4096
+//#define SIZE_X 5
+//#define SIZE_Y 5
+
+using namespace hipacc;
+
+
+// reference: sum of the pixels in [x0, x1] x [y0, y1] relative to each pixel,
+// pixels outside of the image do not contribute
+void box_filter(uchar *in, uint *out, int x0, int y0, int x1, int y1, int
+        width, int height) {
+    for (int y=0; y<height; ++y) {
+        for (int x=0; x<width; ++x) {
+            uint sum = 0;
+            for (int yf=y0; yf<=y1; ++yf) {
+                for (int xf=x0; xf<=x1; ++xf) {
+                    if (x+xf >= 0 && x+xf < width && y+yf >= 0 && y+yf < height)
+                        sum += in[(y+yf)*width + x+xf];
+                }
+            }
+            out[y*width + x] = sum;
+        }
+    }
+}
+
+
+// Kernel description in Hipacc
+class BoxSum : public Kernel<uint> {
+    private:
+        Accessor<uint> &sat;
+
+    public:
+        BoxSum(IterationSpace<uint> &iter, Accessor<uint> &sat) :
+            Kernel(iter),
+            sat(sat)
+        { add_accessor(&sat); }
+
+        void kernel() {
+            output() = sat.box_sum(-SIZE_X/2, -SIZE_Y/2, SIZE_X/2, SIZE_Y/2);
+        }
+};
+
+
+int main(int argc, const char **argv) {
+    const int width = WIDTH;
+    const int height = HEIGHT;
+    const int size_x = SIZE_X;
+    const int size_y = SIZE_Y;
+    float timing = 0.0f;
+
+    // host memory for image of width x height pixels
+    uchar *input = new uchar[width*height];
+    uint *reference = new uint[width*height];
+
+    // initialize data
+    for (int y=0; y<height; ++y) {
+        for (int x=0; x<width; ++x) {
+            input[y*width + x] = (uchar)((x*31 + y*17 + x*y) % 256);
+        }
+    }
+
+    // the integral image has an additional zero row and column, the
+    // Accessor has to cover the box plus one pixel right and below; CLAMP
+    // reads the zero row/column and the last row/column outside of the image
+    Image<uchar> IN(width, height, input);
+    Image<uint> SAT(width+1, height+1);
+    Image<uint> OUT(width, height);
+
+    BoundaryCondition<uint> BcSat(SAT, size_x+2, size_y+2, Boundary::CLAMP);
+    Accessor<uint> AccSat(BcSat);
+    IterationSpace<uint> IsOut(OUT);
+    BoxSum BS(IsOut, AccSat);
+
+    std::cerr << "Calculating integral image and box sums ..." << std::endl;
+
+    integral_image(IN, SAT);
+    BS.execute();
+    timing = hipacc_last_kernel_timing();
+    std::cerr << "Hipacc box sums: " << timing << " ms, " << (width*height/timing)/1000 << " Mpixel/s" << std::endl;
+
+    // get pointer to result data
+    uint *sat = SAT.data();
+    uint *output = OUT.data();
+
+
+    std::cerr << std::endl << "Comparing results ..." << std::endl;
+    bool passed_all = true;
+
+    // integral image: first row and column are zero
+    for (int y=0; y<=height && passed_all; ++y) {
+        uint row_sum = 0;
+        for (int x=0; x<=width && passed_all; ++x) {
+            if (x > 0 && y > 0) {
+                row_sum += input[(y-1)*width + x-1];
+            }
+            uint ref = y > 0 ? sat[(y-1)*(width+1) + x] + row_sum : 0;
+            if (y > 0 && x > 0 && sat[y*(width+1) + x] != ref) {
+                std::cerr << "Test FAILED for integral image, at (" << x << ","
+                          << y << "): " << ref << " vs. "
+                          << sat[y*(width+1) + x] << std::endl;
+                passed_all = false;
+            }
+            if ((x == 0 || y == 0) && sat[y*(width+1) + x] != 0) {
+                std::cerr << "Test FAILED for integral image, at (" << x << ","
+                          << y << "): 0 vs. " << sat[y*(width+1) + x]
+                          << std::endl;
+                passed_all = false;
+            }
+        }
+    }
+
+    box_filter(input, reference, -size_x/2, -size_y/2, size_x/2, size_y/2,
+            width, height);
+    for (int i=0; i<width*height && passed_all; ++i) {
+        if (output[i] != reference[i]) {
+            std::cerr << "Test FAILED for box sums, at (" << i%width << ","
+                      << i/width << "): " << reference[i] << " vs. "
+                      << output[i] << std::endl;
+            passed_all = false;
+        }
+    }
+
+    // memory cleanup
+    delete[] input;
+    delete[] reference;
+
+    if (!passed_all) {
+        return EXIT_FAILURE;
+    }
+    std::cerr << "Test PASSED" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,217 @@
+//
+// Copyright (c) 2014, University of Erlangen-Nuremberg
+// Copyright (c) 2014, Siemens AG
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+#include "hipacc.hpp"
+
+// variables set by Makefile
+//#define WIDTH 4096
+//#define HEIGHT 4096
+
+using namespace hipacc;
+
+// Producer/consumer pipelines for kernel fusion: compile with
+// -fuse-kernels (HIPACC_FUSE=on) and C/C++ as target to compute the
+// intermediate images in row blocks local to each thread instead of
+// launching the producer separately. The results are the same either way.
+
+
+// reference: convolution of a size_x x size_y mask, clamped at the border
+void convolve(int *in, int *out, const int *mask, int size_x, int size_y, int
+        width, int height) {
+    for (int y=0; y<height; ++y) {
+        for (int x=0; x<width; ++x) {
+            int sum = 0;
+            for (int yf=-size_y/2; yf<=size_y/2; ++yf) {
+                for (int xf=-size_x/2; xf<=size_x/2; ++xf) {
+                    int xc = std::min(std::max(x + xf, 0), width-1);
+                    int yc = std::min(std::max(y + yf, 0), height-1);
+                    sum += mask[(yf + size_y/2)*size_x + xf + size_x/2] *
+                           in[yc*width + xc];
+                }
+            }
+            out[y*width + x] = sum;
+        }
+    }
+}
+
+
+// Kernel description in Hipacc
+class Scale : public Kernel<int> {
+    private:
+        Accessor<uchar> &input;
+
+    public:
+        Scale(IterationSpace<int> &iter, Accessor<uchar> &input) :
+            Kernel(iter),
+            input(input)
+        { add_accessor(&input); }
+
+        void kernel() {
+            output() = 3*input() + 1;
+        }
+};
+
+class Convolution : public Kernel<int> {
+    private:
+        Accessor<int> &input;
+        Mask<int> &mask;
+
+    public:
+        Convolution(IterationSpace<int> &iter, Accessor<int> &input,
+                Mask<int> &mask) :
+            Kernel(iter),
+            input(input),
+            mask(mask)
+        { add_accessor(&input); }
+
+        void kernel() {
+            output() = convolve(mask, Reduce::SUM, [&] () -> int {
+                    return mask() * input(mask);
+                    });
+        }
+};
+
+
+int main(int argc, const char **argv) {
+    const int width = WIDTH;
+    const int height = HEIGHT;
+    float timing = 0.0f;
+
+    // host memory for image of width x height pixels
+    uchar *input = new uchar[width*height];
+    int *reference_in = new int[width*height];
+    int *reference_tmp = new int[width*height];
+    int *reference_out = new int[width*height];
+
+    // initialize data
+    for (int y=0; y<height; ++y) {
+        for (int x=0; x<width; ++x) {
+            input[y*width + x] = (uchar)((x*31 + y*17 + x*y) % 256);
+        }
+    }
+
+    const int coef5x5[5][5] = {
+        { 1,  4,  6,  4, 1 },
+        { 4, 16, 24, 16, 4 },
+        { 6, 24, -3, 24, 6 },
+        { 4, 16, 24, 16, 4 },
+        { 1,  4,  6,  4, 1 }
+    };
+    const int coef_x[1][5] = { { 1, -2, 5, -2, 1 } };
+    const int coef_y[5][1] = { { 2 }, { 7 }, { -1 }, { 7 }, { 2 } };
+    Mask<int> M5x5(coef5x5);
+    Mask<int> MX(coef_x);
+    Mask<int> MY(coef_y);
+
+    Image<uchar> IN(width, height, input);
+    Image<int> TMP(width, height);
+    Image<int> OUT(width, height);
+    Image<int> TMP_X(width, height);
+    Image<int> OUT_XY(width, height);
+
+    Accessor<uchar> AccIn(IN);
+    IterationSpace<int> IsTmp(TMP);
+    Scale ScaleIn(IsTmp, AccIn);
+
+    // consumer reading the intermediate image with a 5x5 window
+    BoundaryCondition<int> BcTmp(TMP, M5x5, Boundary::CLAMP);
+    Accessor<int> AccTmp(BcTmp);
+    IterationSpace<int> IsOut(OUT);
+    Convolution Conv5x5(IsOut, AccTmp, M5x5);
+
+    // pair of a horizontal and a vertical pass
+    BoundaryCondition<int> BcOut(OUT, MX, Boundary::CLAMP);
+    Accessor<int> AccOut(BcOut);
+    IterationSpace<int> IsTmpX(TMP_X);
+    Convolution ConvX(IsTmpX, AccOut, MX);
+
+    BoundaryCondition<int> BcTmpX(TMP_X, MY, Boundary::CLAMP);
+    Accessor<int> AccTmpX(BcTmpX);
+    IterationSpace<int> IsOutXY(OUT_XY);
+    Convolution ConvY(IsOutXY, AccTmpX, MY);
+
+    std::cerr << "Calculating pipelines ..." << std::endl;
+
+    ScaleIn.execute();
+    Conv5x5.execute();
+    timing = hipacc_last_kernel_timing();
+    std::cerr << "Hipacc scale + 5x5: " << timing << " ms, " << (width*height/timing)/1000 << " Mpixel/s" << std::endl;
+
+    ConvX.execute();
+    ConvY.execute();
+    timing = hipacc_last_kernel_timing();
+    std::cerr << "Hipacc 5x1 + 1x5: " << timing << " ms, " << (width*height/timing)/1000 << " Mpixel/s" << std::endl;
+
+    // get pointer to result data
+    int *output = OUT.data();
+    int *output_xy = OUT_XY.data();
+
+
+    std::cerr << std::endl << "Comparing results ..." << std::endl;
+    bool passed_all = true;
+
+    for (int i=0; i<width*height; ++i) {
+        reference_in[i] = 3*input[i] + 1;
+    }
+    convolve(reference_in, reference_out, &coef5x5[0][0], 5, 5, width, height);
+    for (int i=0; i<width*height && passed_all; ++i) {
+        if (output[i] != reference_out[i]) {
+            std::cerr << "Test FAILED for scale + 5x5, at (" << i%width << ","
+                      << i/width << "): " << reference_out[i] << " vs. "
+                      << output[i] << std::endl;
+            passed_all = false;
+        }
+    }
+
+    convolve(reference_out, reference_tmp, &coef_x[0][0], 5, 1, width, height);
+    convolve(reference_tmp, reference_out, &coef_y[0][0], 1, 5, width, height);
+    for (int i=0; i<width*height && passed_all; ++i) {
+        if (output_xy[i] != reference_out[i]) {
+            std::cerr << "Test FAILED for 5x1 + 1x5, at (" << i%width << ","
+                      << i/width << "): " << reference_out[i] << " vs. "
+                      << output_xy[i] << std::endl;
+            passed_all = false;
+        }
+    }
+
+    // memory cleanup
+    delete[] input;
+    delete[] reference_in;
+    delete[] reference_tmp;
+    delete[] reference_out;
+
+    if (!passed_all) {
+        return EXIT_FAILURE;
+    }
+    std::cerr << "Test PASSED" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,248 @@
+//
+// Copyright (c) 2014, University of Erlangen-Nuremberg
+// Copyright (c) 2014, Siemens AG
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "hipacc.hpp"
+
+// variables set by Makefile
+//#define WIDTH 4096
+//#define HEIGHT 4096
+
+using namespace hipacc;
+
+
+// reference: lower median of the size x size window, clamped at the border
+template<typename data_t>
+void median_filter(data_t *in, data_t *out, int size, int width, int height) {
+    std::vector<data_t> values(size*size);
+    for (int y=0; y<height; ++y) {
+        for (int x=0; x<width; ++x) {
+            int i = 0;
+            for (int yf=-size/2; yf<=size/2; ++yf) {
+                for (int xf=-size/2; xf<=size/2; ++xf) {
+                    int xc = std::min(std::max(x + xf, 0), width-1);
+                    int yc = std::min(std::max(y + yf, 0), height-1);
+                    values[i++] = in[yc*width + xc];
+                }
+            }
+            std::nth_element(values.begin(), values.begin() + (size*size-1)/2,
+                    values.end());
+            out[y*width + x] = values[(size*size-1)/2];
+        }
+    }
+}
+
+
+// Kernel description in Hipacc
+class MedianFilterMask : public Kernel<float> {
+    private:
+        Accessor<float> &input;
+        Mask<float> &mask;
+
+    public:
+        MedianFilterMask(IterationSpace<float> &iter, Accessor<float> &input,
+                Mask<float> &mask) :
+            Kernel(iter),
+            input(input),
+            mask(mask)
+        { add_accessor(&input); }
+
+        void kernel() {
+            output() = convolve(mask, Reduce::MEDIAN, [&] () -> float {
+                    return input(mask);
+                    });
+        }
+};
+
+class MedianFilterHistogram : public Kernel<uchar> {
+    private:
+        Accessor<uchar> &input;
+        Mask<uchar> &mask;
+
+    public:
+        MedianFilterHistogram(IterationSpace<uchar> &iter, Accessor<uchar>
+                &input, Mask<uchar> &mask) :
+            Kernel(iter),
+            input(input),
+            mask(mask)
+        { add_accessor(&input); }
+
+        void kernel() {
+            output() = convolve(mask, Reduce::MEDIAN, [&] () -> uchar {
+                    return input(mask);
+                    });
+        }
+};
+
+class MedianFilterDomain : public Kernel<uchar> {
+    private:
+        Accessor<uchar> &input;
+        Domain &dom;
+
+    public:
+        MedianFilterDomain(IterationSpace<uchar> &iter, Accessor<uchar> &input,
+                Domain &dom) :
+            Kernel(iter),
+            input(input),
+            dom(dom)
+        { add_accessor(&input); }
+
+        void kernel() {
+            output() = reduce(dom, Reduce::MEDIAN, [&] () -> uchar {
+                    return input(dom);
+                    });
+        }
+};
+
+
+int main(int argc, const char **argv) {
+    const int width = WIDTH;
+    const int height = HEIGHT;
+    float timing = 0.0f;
+
+    // host memory for image of width x height pixels
+    float *input_float = new float[width*height];
+    float *reference_float = new float[width*height];
+    uchar *input_uchar = new uchar[width*height];
+    uchar *reference_uchar = new uchar[width*height];
+
+    // initialize data
+    for (int y=0; y<height; ++y) {
+        for (int x=0; x<width; ++x) {
+            input_float[y*width + x] = (float)((x*7919 + y*104729) % 1000) * 0.25f;
+            input_uchar[y*width + x] = (uchar)((x*31 + y*17 + x*y) % 256);
+        }
+    }
+
+    // sorting networks for the 3x3 median (float, Mask) and the 5x5 median
+    // (8-bit, Domain), sliding histogram for the 7x7 median (8-bit, Mask;
+    // C/C++ only, other targets use a sorting network)
+    const float coef3[3][3] = { { 1, 1, 1 }, { 1, 1, 1 }, { 1, 1, 1 } };
+    const uchar coef7[7][7] = {
+        { 1, 1, 1, 1, 1, 1, 1 },
+        { 1, 1, 1, 1, 1, 1, 1 },
+        { 1, 1, 1, 1, 1, 1, 1 },
+        { 1, 1, 1, 1, 1, 1, 1 },
+        { 1, 1, 1, 1, 1, 1, 1 },
+        { 1, 1, 1, 1, 1, 1, 1 },
+        { 1, 1, 1, 1, 1, 1, 1 }
+    };
+    Mask<float> M3(coef3);
+    Mask<uchar> M7(coef7);
+    Domain D5(5, 5);
+
+    Image<float> IN_FLOAT(width, height, input_float);
+    Image<float> OUT_FLOAT(width, height);
+    Image<uchar> IN_UCHAR(width, height, input_uchar);
+    Image<uchar> OUT5(width, height);
+    Image<uchar> OUT7(width, height);
+
+    BoundaryCondition<float> BcFloat(IN_FLOAT, M3, Boundary::CLAMP);
+    Accessor<float> AccFloat(BcFloat);
+    BoundaryCondition<uchar> BcUchar5(IN_UCHAR, D5, Boundary::CLAMP);
+    Accessor<uchar> AccUchar5(BcUchar5);
+    BoundaryCondition<uchar> BcUchar7(IN_UCHAR, M7, Boundary::CLAMP);
+    Accessor<uchar> AccUchar7(BcUchar7);
+
+    IterationSpace<float> IsFloat(OUT_FLOAT);
+    IterationSpace<uchar> Is5(OUT5);
+    IterationSpace<uchar> Is7(OUT7);
+
+    MedianFilterMask MF3(IsFloat, AccFloat, M3);
+    MedianFilterDomain MF5(Is5, AccUchar5, D5);
+    MedianFilterHistogram MF7(Is7, AccUchar7, M7);
+
+    std::cerr << "Calculating median filters ..." << std::endl;
+
+    MF3.execute();
+    timing = hipacc_last_kernel_timing();
+    std::cerr << "Hipacc 3x3 (float): " << timing << " ms, " << (width*height/timing)/1000 << " Mpixel/s" << std::endl;
+
+    MF5.execute();
+    timing = hipacc_last_kernel_timing();
+    std::cerr << "Hipacc 5x5 (uchar): " << timing << " ms, " << (width*height/timing)/1000 << " Mpixel/s" << std::endl;
+
+    MF7.execute();
+    timing = hipacc_last_kernel_timing();
+    std::cerr << "Hipacc 7x7 (uchar): " << timing << " ms, " << (width*height/timing)/1000 << " Mpixel/s" << std::endl;
+
+    // get pointer to result data
+    float *output_float = OUT_FLOAT.data();
+    uchar *output5 = OUT5.data();
+    uchar *output7 = OUT7.data();
+
+
+    std::cerr << std::endl << "Comparing results ..." << std::endl;
+    bool passed_all = true;
+
+    median_filter(input_float, reference_float, 3, width, height);
+    for (int i=0; i<width*height && passed_all; ++i) {
+        if (output_float[i] != reference_float[i]) {
+            std::cerr << "Test FAILED for 3x3 median, at (" << i%width << ","
+                      << i/width << "): " << reference_float[i] << " vs. "
+                      << output_float[i] << std::endl;
+            passed_all = false;
+        }
+    }
+
+    median_filter(input_uchar, reference_uchar, 5, width, height);
+    for (int i=0; i<width*height && passed_all; ++i) {
+        if (output5[i] != reference_uchar[i]) {
+            std::cerr << "Test FAILED for 5x5 median, at (" << i%width << ","
+                      << i/width << "): " << (int)reference_uchar[i] << " vs. "
+                      << (int)output5[i] << std::endl;
+            passed_all = false;
+        }
+    }
+
+    median_filter(input_uchar, reference_uchar, 7, width, height);
+    for (int i=0; i<width*height && passed_all; ++i) {
+        if (output7[i] != reference_uchar[i]) {
+            std::cerr << "Test FAILED for 7x7 median, at (" << i%width << ","
+                      << i/width << "): " << (int)reference_uchar[i] << " vs. "
+                      << (int)output7[i] << std::endl;
+            passed_all = false;
+        }
+    }
+
+    // memory cleanup
+    delete[] input_float;
+    delete[] reference_float;
+    delete[] input_uchar;
+    delete[] reference_uchar;
+
+    if (!passed_all) {
+        return EXIT_FAILURE;
+    }
+    std::cerr << "Test PASSED" << std::endl;
+
+    return EXIT_SUCCESS;
+}
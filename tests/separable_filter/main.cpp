@@ -0,0 +1,276 @@
+//
+// Copyright (c) 2014, University of Erlangen-Nuremberg
+// Copyright (c) 2014, Siemens AG
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include "hipacc.hpp"
+
+// variables set by Makefile
+//#define WIDTH 4096
+//#define HEIGHT 4096
+#define EPS 0.001f
+
+using namespace hipacc;
+
+// Convolutions that C/C++ code can compute incrementally:
+//  - separable constant masks with column sums (-separate-masks on|exact,
+//    HIPACC_SEPARATE in the Makefile)
+//  - box masks and rectangular Domains with running sums (integer by
+//    default, floating point with -running-sums on, HIPACC_RUNNING_SUMS)
+//  - a mask that is not separable, which has to be left as it is
+// The results have to match the unrolled convolution.
+
+
+// reference: convolution of a size_x x size_y mask, clamped at the border
+template<typename in_t, typename out_t, typename mask_t>
+void convolve(in_t *in, out_t *out, const mask_t *mask, int size_x, int
+        size_y, int width, int height) {
+    for (int y=0; y<height; ++y) {
+        for (int x=0; x<width; ++x) {
+            out_t sum = 0;
+            for (int yf=-size_y/2; yf<=size_y/2; ++yf) {
+                for (int xf=-size_x/2; xf<=size_x/2; ++xf) {
+                    int xc = std::min(std::max(x + xf, 0), width-1);
+                    int yc = std::min(std::max(y + yf, 0), height-1);
+                    sum += mask[(yf + size_y/2)*size_x + xf + size_x/2] *
+                           in[yc*width + xc];
+                }
+            }
+            out[y*width + x] = sum;
+        }
+    }
+}
+
+template<typename data_t>
+bool compare(data_t *out, data_t *ref, float eps, int width, int height,
+        const char *name) {
+    for (int i=0; i<width*height; ++i) {
+        if (std::fabs((float)out[i] - (float)ref[i]) > eps) {
+            std::cerr << "Test FAILED for " << name << ", at (" << i%width
+                      << "," << i/width << "): " << ref[i] << " vs. "
+                      << out[i] << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+
+// Kernel description in Hipacc
+class ConvolutionInt : public Kernel<int> {
+    private:
+        Accessor<uchar> &input;
+        Mask<int> &mask;
+
+    public:
+        ConvolutionInt(IterationSpace<int> &iter, Accessor<uchar> &input,
+                Mask<int> &mask) :
+            Kernel(iter),
+            input(input),
+            mask(mask)
+        { add_accessor(&input); }
+
+        void kernel() {
+            output() = convolve(mask, Reduce::SUM, [&] () -> int {
+                    return mask() * input(mask);
+                    });
+        }
+};
+
+class ConvolutionFloat : public Kernel<float> {
+    private:
+        Accessor<float> &input;
+        Mask<float> &mask;
+
+    public:
+        ConvolutionFloat(IterationSpace<float> &iter, Accessor<float> &input,
+                Mask<float> &mask) :
+            Kernel(iter),
+            input(input),
+            mask(mask)
+        { add_accessor(&input); }
+
+        void kernel() {
+            output() = convolve(mask, Reduce::SUM, [&] () -> float {
+                    return mask() * input(mask);
+                    });
+        }
+};
+
+class DomainSum : public Kernel<int> {
+    private:
+        Accessor<uchar> &input;
+        Domain &dom;
+
+    public:
+        DomainSum(IterationSpace<int> &iter, Accessor<uchar> &input, Domain
+                &dom) :
+            Kernel(iter),
+            input(input),
+            dom(dom)
+        { add_accessor(&input); }
+
+        void kernel() {
+            output() = reduce(dom, Reduce::SUM, [&] () -> int {
+                    return input(dom);
+                    });
+        }
+};
+
+
+int main(int argc, const char **argv) {
+    const int width = WIDTH;
+    const int height = HEIGHT;
+    float timing = 0.0f;
+
+    // host memory for image of width x height pixels
+    uchar *input = new uchar[width*height];
+    float *input_float = new float[width*height];
+    int *reference = new int[width*height];
+    float *reference_float = new float[width*height];
+
+    // initialize data
+    for (int y=0; y<height; ++y) {
+        for (int x=0; x<width; ++x) {
+            input[y*width + x] = (uchar)((x*31 + y*17 + x*y) % 256);
+            input_float[y*width + x] = (float)((x*7919 + y*104729) % 1000) * 0.001f;
+        }
+    }
+
+    // binomial mask: separable with integral factors
+    const int coef_gauss[5][5] = {
+        { 1,  4,  6,  4, 1 },
+        { 4, 16, 24, 16, 4 },
+        { 6, 24, 36, 24, 6 },
+        { 4, 16, 24, 16, 4 },
+        { 1,  4,  6,  4, 1 }
+    };
+    // box mask: equal coefficients
+    const float coef_box[7][7] = {
+        { 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49 },
+        { 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49 },
+        { 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49 },
+        { 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49 },
+        { 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49 },
+        { 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49 },
+        { 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49, 1.0f/49 }
+    };
+    // Laplacian: not separable
+    const int coef_laplace[3][3] = {
+        { 1,  1, 1 },
+        { 1, -8, 1 },
+        { 1,  1, 1 }
+    };
+    const int coef_ones[3][5] = {
+        { 1, 1, 1, 1, 1 },
+        { 1, 1, 1, 1, 1 },
+        { 1, 1, 1, 1, 1 }
+    };
+    Mask<int> MGauss(coef_gauss);
+    Mask<float> MBox(coef_box);
+    Mask<int> MLaplace(coef_laplace);
+    Domain DRect(5, 3);
+
+    Image<uchar> IN(width, height, input);
+    Image<float> IN_FLOAT(width, height, input_float);
+    Image<int> OUT_GAUSS(width, height);
+    Image<float> OUT_BOX(width, height);
+    Image<int> OUT_LAPLACE(width, height);
+    Image<int> OUT_RECT(width, height);
+
+    BoundaryCondition<uchar> BcGauss(IN, MGauss, Boundary::CLAMP);
+    Accessor<uchar> AccGauss(BcGauss);
+    BoundaryCondition<float> BcBox(IN_FLOAT, MBox, Boundary::CLAMP);
+    Accessor<float> AccBox(BcBox);
+    BoundaryCondition<uchar> BcLaplace(IN, MLaplace, Boundary::CLAMP);
+    Accessor<uchar> AccLaplace(BcLaplace);
+    BoundaryCondition<uchar> BcRect(IN, DRect, Boundary::CLAMP);
+    Accessor<uchar> AccRect(BcRect);
+
+    IterationSpace<int> IsGauss(OUT_GAUSS);
+    IterationSpace<float> IsBox(OUT_BOX);
+    IterationSpace<int> IsLaplace(OUT_LAPLACE);
+    IterationSpace<int> IsRect(OUT_RECT);
+
+    ConvolutionInt Gauss(IsGauss, AccGauss, MGauss);
+    ConvolutionFloat Box(IsBox, AccBox, MBox);
+    ConvolutionInt Laplace(IsLaplace, AccLaplace, MLaplace);
+    DomainSum Rect(IsRect, AccRect, DRect);
+
+    std::cerr << "Calculating convolutions ..." << std::endl;
+
+    Gauss.execute();
+    timing = hipacc_last_kernel_timing();
+    std::cerr << "Hipacc 5x5 Gaussian: " << timing << " ms, " << (width*height/timing)/1000 << " Mpixel/s" << std::endl;
+
+    Box.execute();
+    timing = hipacc_last_kernel_timing();
+    std::cerr << "Hipacc 7x7 box: " << timing << " ms, " << (width*height/timing)/1000 << " Mpixel/s" << std::endl;
+
+    Laplace.execute();
+    timing = hipacc_last_kernel_timing();
+    std::cerr << "Hipacc 3x3 Laplacian: " << timing << " ms, " << (width*height/timing)/1000 << " Mpixel/s" << std::endl;
+
+    Rect.execute();
+    timing = hipacc_last_kernel_timing();
+    std::cerr << "Hipacc 5x3 Domain sum: " << timing << " ms, " << (width*height/timing)/1000 << " Mpixel/s" << std::endl;
+
+    // get pointer to result data
+    int *output_gauss = OUT_GAUSS.data();
+    float *output_box = OUT_BOX.data();
+    int *output_laplace = OUT_LAPLACE.data();
+    int *output_rect = OUT_RECT.data();
+
+
+    std::cerr << std::endl << "Comparing results ..." << std::endl;
+    bool passed_all = true;
+
+    convolve(input, reference, &coef_gauss[0][0], 5, 5, width, height);
+    passed_all &= compare(output_gauss, reference, 0, width, height, "5x5 Gaussian");
+    convolve(input_float, reference_float, &coef_box[0][0], 7, 7, width, height);
+    passed_all &= compare(output_box, reference_float, EPS, width, height, "7x7 box");
+    convolve(input, reference, &coef_laplace[0][0], 3, 3, width, height);
+    passed_all &= compare(output_laplace, reference, 0, width, height, "3x3 Laplacian");
+    convolve(input, reference, &coef_ones[0][0], 5, 3, width, height);
+    passed_all &= compare(output_rect, reference, 0, width, height, "5x3 Domain sum");
+
+    // memory cleanup
+    delete[] input;
+    delete[] input_float;
+    delete[] reference;
+    delete[] reference_float;
+
+    if (!passed_all) {
+        return EXIT_FAILURE;
+    }
+    std::cerr << "Test PASSED" << std::endl;
+
+    return EXIT_SUCCESS;
+}
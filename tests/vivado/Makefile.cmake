@@ -49,6 +49,7 @@ ifge = $(shell if [ $(1) -ge $(2) ]; then echo true; else echo false; fi)
 # use specific configuration for kernels -> set HIPACC_CONFIG to nxm
 # generate code that explores configuration -> set HIPACC_EXPLORE to off|on
 # generate code that times kernel execution -> set HIPACC_TIMING to off|on
+# iterate over the runtime image size on Vivado -> set HIPACC_RUNTIME_SIZE to off|on
 HIPACC_LMEM?=off
 HIPACC_TEX?=off
 HIPACC_VEC?=off
@@ -87,6 +88,12 @@ endif
 ifdef HIPACC_TARGET_II
     HIPACC_OPTS+= -target-II $(HIPACC_TARGET_II)
 endif
+ifeq ($(HIPACC_RUNTIME_SIZE),on)
+    HIPACC_OPTS+= -runtime-size
+endif
+ifdef HIPACC_EMU_FIFO_DEPTH
+    HIPACC_EMU_OPTS+= -DHIPACC_EMU_FIFO_DEPTH=$(HIPACC_EMU_FIFO_DEPTH)
+endif
 
 # set target GPU architecture to the compute capability encoded in target
 GPU_ARCH := $(shell echo $(HIPACC_TARGET) |cut -f2 -d-)
@@ -153,8 +160,46 @@ vivado:
 	$(COMPILER) $(TEST_CASE)/main.cpp $(MYFLAGS) $(COMPILER_INC) -emit-vivado $(HIPACC_OPTS) -o main.cc
 	vivado_hls -f script.tcl
 
+# software emulation of the dataflow pipeline, no Vivado HLS installation
+# required -> set the depth of channels without depth directive via
+# HIPACC_EMU_FIFO_DEPTH
+vivado-emu:
+	@echo 'Executing HIPAcc Compiler for Vivado HLS:'
+	$(COMPILER) $(TEST_CASE)/main.cpp $(MYFLAGS) $(COMPILER_INC) -emit-vivado $(HIPACC_OPTS) -o main.cc
+	@echo 'Compiling Vivado HLS emulation using g++:'
+	$(CC_CC) -DHIPACC_VIVADO_EMU $(HIPACC_EMU_OPTS) -Wno-unknown-pragmas -I$(HIPACC_DIR)/include $(COMMON_INC) $(MYFLAGS) $(OFLAGS) -o main_vivado main.cc hipacc_run.cc $(CC_LINK) -pthread
+	@echo 'Executing Vivado HLS emulation binary'
+	./main_vivado
+
+# checks of the runtime templates and the dataflow emulation, no Hipacc
+# compiler required: vectorized local operators (also at runtime image size),
+# streaming reductions, and a pipeline whose stream depths have to cover the
+# group delay difference of its paths (too shallow depths have to be reported
+# as deadlock)
+EMU_TESTS      ?= ./emu
+EMU_CC          = $(CC_CC) -DHIPACC_VIVADO_EMU -Wno-unknown-pragmas -I$(HIPACC_DIR)/include $(OFLAGS)
+
+emu-check:
+	@echo 'Checking vectorized local operators:'
+	$(EMU_CC) -o emu_local_operators $(EMU_TESTS)/local_operators.cc $(CC_LINK) -pthread
+	./emu_local_operators
+	$(EMU_CC) -DHIPACC_RUNTIME_SIZE -o emu_local_operators_rs $(EMU_TESTS)/local_operators.cc $(CC_LINK) -pthread
+	./emu_local_operators_rs
+	@echo 'Checking streaming reductions:'
+	$(EMU_CC) -o emu_reductions $(EMU_TESTS)/reductions.cc $(CC_LINK) -pthread
+	./emu_reductions
+	@echo 'Checking stream depths:'
+	$(EMU_CC) -o emu_stream_depth $(EMU_TESTS)/stream_depth.cc $(CC_LINK) -pthread
+	./emu_stream_depth > emu_stream_depth.log 2>&1 || (cat emu_stream_depth.log; exit 1)
+	cat emu_stream_depth.log
+	grep -q 'Dataflow FIFOs' emu_stream_depth.log
+	$(EMU_CC) -DSTREAM_DEPTH=128 -DHIPACC_EMU_DEADLOCK_TIMEOUT=500 -o emu_stream_depth_shallow $(EMU_TESTS)/stream_depth.cc $(CC_LINK) -pthread
+	! ./emu_stream_depth_shallow > emu_stream_depth.log 2>&1
+	cat emu_stream_depth.log
+	grep -q 'Deadlock in dataflow region' emu_stream_depth.log
+
 clean:
-	rm -f main_* *.cu *.cc *.cubin *.cl *.isa *.rs *.fs *.log
+	rm -f main_* emu_* *.cu *.cc *.cubin *.cl *.isa *.rs *.fs *.log
 	rm -rf hipacc_project
 	rm -rf build_*
 
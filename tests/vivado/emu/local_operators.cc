@@ -0,0 +1,273 @@
+//
+// Copyright (c) 2014, University of Erlangen-Nuremberg
+// Copyright (c) 2014, Siemens AG
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+// Checks the vectorized local operators of hipacc_vivado_filter.hpp in the
+// software emulation against a scalar reference that applies the same filter
+// to a window gathered with the border mode of the operator:
+//  - processVECT, processSIMOVECT and processMISOVECT for 8-bit pixels
+//  - processVECTF for float pixels
+// for several kernel sizes and vector widths and all border modes. Rows are
+// padded to whole vectors and the padding lanes hold garbage, as written by
+// hipaccWriteMemory. With HIPACC_RUNTIME_SIZE, frames smaller than the maximum
+// image size are processed, too.
+
+#define HIPACC_MAX_WIDTH     96
+#define HIPACC_MAX_HEIGHT    12
+#define HIPACC_II_TARGET     1
+
+#include "hipacc_vivado_types.hpp"
+#include "hipacc_vivado_filter.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+template<int SIZE>
+struct Weighted {
+    uchar operator()(uchar win[SIZE][SIZE]) {
+        uint sum = 0;
+        for (int y=0; y<SIZE; ++y)
+            for (int x=0; x<SIZE; ++x)
+                sum += win[y][x] * (x*3 + y + 1);
+        return sum;
+    }
+};
+
+template<int SIZE>
+struct WeightedXor {
+    uchar operator()(uchar win1[SIZE][SIZE], uchar win2[SIZE][SIZE]) {
+        uint sum = 0;
+        for (int y=0; y<SIZE; ++y)
+            for (int x=0; x<SIZE; ++x)
+                sum += (win1[y][x] * (x*3 + y + 1)) ^ win2[y][x];
+        return sum;
+    }
+};
+
+template<int SIZE>
+struct WeightedF {
+    float operator()(float win[SIZE][SIZE]) {
+        float sum = 0.0f;
+        for (int y=0; y<SIZE; ++y)
+            for (int x=0; x<SIZE; ++x)
+                sum += win[y][x] * (x + 2*y + 1);
+        return sum;
+    }
+};
+
+
+// index of the pixel read for coordinate x, -1 for the constant border
+int border_index(int x, int size, BorderPadding::values mode) {
+    if (x >= 0 && x < size) return x;
+    switch (mode) {
+        case BorderPadding::BORDER_CLAMP:
+            return x < 0 ? 0 : size - 1;
+        case BorderPadding::BORDER_MIRROR:
+            return x < 0 ? -x - 1 : 2*size - x - 1;
+        case BorderPadding::BORDER_MIRROR_101:
+            return x < 0 ? -x : 2*size - x - 2;
+        default:
+            return -1;
+    }
+}
+
+template<int SIZE, typename T>
+void gather_window(T win[SIZE][SIZE], const std::vector<T> &img, int width,
+        int height, int x, int y, BorderPadding::values mode) {
+    for (int dy=0; dy<SIZE; ++dy) {
+        for (int dx=0; dx<SIZE; ++dx) {
+            int xx = border_index(x + dx - SIZE/2, width, mode);
+            int yy = border_index(y + dy - SIZE/2, height, mode);
+            win[dy][dx] = (xx < 0 || yy < 0) ? T(0) : img[yy*width + xx];
+        }
+    }
+}
+
+
+int to_bits(uchar val) { return val; }
+int to_bits(float val) { return f2i(val); }
+void from_bits(uchar &val, int bits) { val = bits; }
+void from_bits(float &val, int bits) { val = i2f(bits); }
+
+// write the image row by row, each row padded to whole vectors
+template<int VECT, int BW, typename T>
+void write_stream(hls::stream<ap_uint<BW> > &strm, const std::vector<T> &img,
+        int width, int height, T pad) {
+    const int LW = BW / VECT;
+    for (int y=0; y<height; ++y) {
+        for (int x=0; x<width; x+=VECT) {
+            ap_uint<BW> vec = 0;
+            for (int l=0; l<VECT; ++l) {
+                T val = x + l < width ? img[y*width + x + l] : pad;
+                vec(l*LW, (l+1)*LW-1) = to_bits(val);
+            }
+            strm << vec;
+        }
+    }
+}
+
+// compare the stream against the reference, padding lanes are ignored
+template<int VECT, int BW, typename T>
+int compare_stream(hls::stream<ap_uint<BW> > &strm, const std::vector<T>
+        &ref, int width, int height, const char *name) {
+    const int LW = BW / VECT;
+    const int num_vecs = height * ((width + VECT - 1) / VECT);
+    if ((int)strm.size() != num_vecs) {
+        std::cerr << name << ": " << strm.size() << " vectors instead of "
+                  << num_vecs << std::endl;
+        return 1;
+    }
+
+    int errors = 0;
+    for (int y=0; y<height; ++y) {
+        for (int x=0; x<width; x+=VECT) {
+            ap_uint<BW> vec = strm.read();
+            for (int l=0; l<VECT && x + l < width; ++l) {
+                T val;
+                from_bits(val, vec(l*LW, (l+1)*LW-1));
+                if (val != ref[y*width + x + l] && errors++ < 3) {
+                    std::cerr << name << ": mismatch at (" << x + l << ","
+                              << y << "): " << +val << " vs. "
+                              << +ref[y*width + x + l] << std::endl;
+                }
+            }
+        }
+    }
+    return errors;
+}
+
+
+template<int SIZE, int VECT>
+int check_uchar(int width, int height, BorderPadding::values mode) {
+    std::vector<uchar> in1(width*height), in2(width*height);
+    std::vector<uchar> ref(width*height), ref_miso(width*height);
+    for (int i=0; i<width*height; ++i) {
+        in1[i] = (i*7 + i/width*13) & 255;
+        in2[i] = (i*5 + 3) & 255;
+    }
+
+    Weighted<SIZE> filter;
+    WeightedXor<SIZE> filter2;
+    for (int y=0; y<height; ++y) {
+        for (int x=0; x<width; ++x) {
+            uchar win1[SIZE][SIZE], win2[SIZE][SIZE];
+            gather_window<SIZE>(win1, in1, width, height, x, y, mode);
+            gather_window<SIZE>(win2, in2, width, height, x, y, mode);
+            ref[y*width + x] = filter(win1);
+            ref_miso[y*width + x] = filter2(win1, win2);
+        }
+    }
+
+    hls::stream<ap_uint<8*VECT> > in_s, in_simo_s, in1_miso_s, in2_miso_s;
+    hls::stream<ap_uint<8*VECT> > out_s, out1_simo_s, out2_simo_s, out_miso_s;
+    write_stream<VECT>(in_s, in1, width, height, (uchar)0xAB);
+    write_stream<VECT>(in_simo_s, in1, width, height, (uchar)0xAB);
+    write_stream<VECT>(in1_miso_s, in1, width, height, (uchar)0xCD);
+    write_stream<VECT>(in2_miso_s, in2, width, height, (uchar)0xEF);
+
+    processVECT<HIPACC_II_TARGET,HIPACC_MAX_WIDTH,HIPACC_MAX_HEIGHT,SIZE,SIZE,VECT,uchar,8*VECT,8*VECT>(in_s, out_s, width, height, filter, mode);
+    processSIMOVECT<HIPACC_II_TARGET,HIPACC_MAX_WIDTH,HIPACC_MAX_HEIGHT,SIZE,SIZE,VECT,uchar,8*VECT,8*VECT>(in_simo_s, out1_simo_s, out2_simo_s, width, height, filter, mode);
+    processMISOVECT<HIPACC_II_TARGET,HIPACC_MAX_WIDTH,HIPACC_MAX_HEIGHT,SIZE,SIZE,VECT,uchar,8*VECT,8*VECT>(in1_miso_s, in2_miso_s, out_miso_s, width, height, filter2, mode);
+
+    int errors = in_s.size() + in_simo_s.size() + in1_miso_s.size() + in2_miso_s.size();
+    errors += compare_stream<VECT>(out_s, ref, width, height, "processVECT");
+    errors += compare_stream<VECT>(out1_simo_s, ref, width, height, "processSIMOVECT");
+    errors += compare_stream<VECT>(out2_simo_s, ref, width, height, "processSIMOVECT");
+    errors += compare_stream<VECT>(out_miso_s, ref_miso, width, height, "processMISOVECT");
+    return errors;
+}
+
+template<int SIZE, int VECT>
+int check_float(int width, int height, BorderPadding::values mode) {
+    std::vector<float> in(width*height), ref(width*height);
+    for (int i=0; i<width*height; ++i)
+        in[i] = (i % 17) * 0.25f - 1.0f;
+
+    WeightedF<SIZE> filter;
+    for (int y=0; y<height; ++y) {
+        for (int x=0; x<width; ++x) {
+            float win[SIZE][SIZE];
+            gather_window<SIZE>(win, in, width, height, x, y, mode);
+            ref[y*width + x] = filter(win);
+        }
+    }
+
+    hls::stream<ap_uint<32*VECT> > in_s, out_s;
+    write_stream<VECT>(in_s, in, width, height, 1e30f);
+    processVECTF<HIPACC_II_TARGET,HIPACC_MAX_WIDTH,HIPACC_MAX_HEIGHT,SIZE,SIZE,VECT,float,32*VECT,32*VECT>(in_s, out_s, width, height, filter, mode);
+
+    return in_s.size() + compare_stream<VECT>(out_s, ref, width, height, "processVECTF");
+}
+
+template<int SIZE, int VECT>
+int check() {
+    #ifdef HIPACC_RUNTIME_SIZE
+    const int sizes[][2] = { { HIPACC_MAX_WIDTH, HIPACC_MAX_HEIGHT },
+                             { 61, 9 }, { 33, 12 } };
+    #else
+    const int sizes[][2] = { { HIPACC_MAX_WIDTH, HIPACC_MAX_HEIGHT } };
+    #endif
+    const BorderPadding::values modes[] = { BorderPadding::BORDER_CONST,
+        BorderPadding::BORDER_CLAMP, BorderPadding::BORDER_MIRROR,
+        BorderPadding::BORDER_MIRROR_101 };
+
+    int errors = 0;
+    for (auto &size : sizes) {
+        for (auto mode : modes) {
+            int err = check_uchar<SIZE, VECT>(size[0], size[1], mode) +
+                      check_float<SIZE, VECT>(size[0], size[1], mode);
+            if (err) {
+                std::cerr << "Test FAILED for " << SIZE << "x" << SIZE
+                          << " kernel, VECT=" << VECT << ", border mode "
+                          << mode << ", " << size[0] << "x" << size[1]
+                          << " pixels" << std::endl;
+            }
+            errors += err;
+        }
+    }
+    return errors;
+}
+
+template<int SIZE>
+int check_vect() {
+    return check<SIZE, 1>() + check<SIZE, 2>() + check<SIZE, 3>() +
+           check<SIZE, 4>() + check<SIZE, 8>() + check<SIZE, 16>();
+}
+
+
+int main(int argc, const char **argv) {
+    int errors = check_vect<1>() + check_vect<3>() + check_vect<5>() +
+                 check_vect<9>();
+
+    if (errors) {
+        std::cerr << "Test FAILED: " << errors << " errors" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cerr << "Test PASSED" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,211 @@
+//
+// Copyright (c) 2014, University of Erlangen-Nuremberg
+// Copyright (c) 2014, Siemens AG
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+// Checks the streaming reductions and histograms of hipacc_vivado_filter.hpp
+// in the software emulation against sequential references:
+//  - reduceStream, reduceStreamVECT and reduceStreamVECTF for int min and
+//    float sum, running concurrently in one dataflow region
+//  - histogramStream and histogramStreamVECT
+//  - the VECT variants for widths that are not a multiple of the vector
+//    width, with garbage in the padding lanes
+
+#define HIPACC_MAX_WIDTH     256
+#define HIPACC_MAX_HEIGHT    64
+#define HIPACC_II_TARGET     1
+#define HIPACC_PPT           4
+#define NUM_BINS             16
+
+#include "hipacc_vivado_types.hpp"
+#include "hipacc_vivado_filter.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+struct MinReduce {
+    int operator()(int left, int right) {
+        return left < right ? left : right;
+    }
+};
+struct SumReduce {
+    int operator()(int left, int right) {
+        return left + right;
+    }
+};
+struct SumReduceF {
+    float operator()(float left, float right) {
+        return left + right;
+    }
+};
+struct Binning {
+    int operator()(int val) {
+        return val & (NUM_BINS-1);
+    }
+};
+
+
+int to_bits(int val) { return val; }
+int to_bits(float val) { return f2i(val); }
+
+// write the image row by row, each row padded to whole vectors
+template<typename T>
+void write_stream(hls::stream<ap_uint<32*HIPACC_PPT> > &strm, const
+        std::vector<T> &img, int width, int height, int pad) {
+    for (int y=0; y<height; ++y) {
+        for (int x=0; x<width; x+=HIPACC_PPT) {
+            ap_uint<32*HIPACC_PPT> vec = 0;
+            for (int l=0; l<HIPACC_PPT; ++l) {
+                int bits = x + l < width ? to_bits(img[y*width + x + l]) : pad;
+                vec(l*32, l*32+31) = bits;
+            }
+            strm << vec;
+        }
+    }
+}
+
+int compare_histogram(const int *hist, const int *ref, const char *name) {
+    int errors = 0;
+    for (int b=0; b<NUM_BINS; ++b) {
+        if (hist[b] != ref[b] && errors++ < 3) {
+            std::cerr << name << ": bin " << b << ": " << hist[b] << " vs. "
+                      << ref[b] << std::endl;
+        }
+    }
+    return errors;
+}
+
+
+// all reductions of a full frame concurrently in one dataflow region
+int check_dataflow() {
+    const int width = HIPACC_MAX_WIDTH, height = HIPACC_MAX_HEIGHT;
+    std::vector<int> in(width*height);
+    std::vector<float> in_f(width*height);
+    for (int i=0; i<width*height; ++i) {
+        in[i] = (int)((i*2654435761u) % 100003) - 5000;
+        in_f[i] = (i % 97) * 0.25f;
+    }
+
+    int ref_min = in[0];
+    double ref_sum = 0;
+    int ref_hist[NUM_BINS] = { 0 };
+    for (int i=0; i<width*height; ++i) {
+        ref_min = std::min(ref_min, in[i]);
+        ref_sum += in_f[i];
+        ref_hist[in[i] & (NUM_BINS-1)]++;
+    }
+
+    hls::stream<int> min_s, hist_s;
+    hls::stream<float> sum_s;
+    hls::stream<ap_uint<32*HIPACC_PPT> > min_v, sum_v, hist_v;
+    for (int i=0; i<width*height; ++i) {
+        min_s << in[i];
+        sum_s << in_f[i];
+        hist_s << in[i];
+    }
+    write_stream(min_v, in, width, height, 0);
+    write_stream(sum_v, in_f, width, height, 0);
+    write_stream(hist_v, in, width, height, 0);
+
+    MinReduce min_reduce;
+    SumReduceF sum_reduce;
+    Binning binning;
+    int min = 0, min_vect = 0, hist[NUM_BINS], hist_vect[NUM_BINS];
+    float sum = 0, sum_vect = 0;
+    {
+        HIPACC_DATAFLOW_BEGIN
+        HIPACC_DATAFLOW_PROCESS(reduceStream<HIPACC_II_TARGET,HIPACC_MAX_WIDTH,HIPACC_MAX_HEIGHT>(min_s, min, width, height, min_reduce));
+        HIPACC_DATAFLOW_PROCESS(reduceStream<HIPACC_II_TARGET,HIPACC_MAX_WIDTH,HIPACC_MAX_HEIGHT>(sum_s, sum, width, height, sum_reduce));
+        HIPACC_DATAFLOW_PROCESS(reduceStreamVECT<HIPACC_II_TARGET,HIPACC_MAX_WIDTH,HIPACC_MAX_HEIGHT,HIPACC_PPT,int>(min_v, min_vect, width, height, min_reduce));
+        HIPACC_DATAFLOW_PROCESS(reduceStreamVECTF<HIPACC_II_TARGET,HIPACC_MAX_WIDTH,HIPACC_MAX_HEIGHT,HIPACC_PPT,float>(sum_v, sum_vect, width, height, sum_reduce));
+        HIPACC_DATAFLOW_PROCESS(histogramStream<HIPACC_II_TARGET,HIPACC_MAX_WIDTH,HIPACC_MAX_HEIGHT,NUM_BINS>(hist_s, hist, width, height, binning));
+        HIPACC_DATAFLOW_PROCESS(histogramStreamVECT<HIPACC_II_TARGET,HIPACC_MAX_WIDTH,HIPACC_MAX_HEIGHT,NUM_BINS,HIPACC_PPT,int>(hist_v, hist_vect, width, height, binning));
+        HIPACC_DATAFLOW_END
+    }
+
+    int errors = 0;
+    if (min != ref_min || min_vect != ref_min) {
+        std::cerr << "reduceStream(VECT): min " << min << ", " << min_vect
+                  << " vs. " << ref_min << std::endl;
+        ++errors;
+    }
+    if (std::fabs(sum - ref_sum) > 1e-3*ref_sum ||
+        std::fabs(sum_vect - ref_sum) > 1e-3*ref_sum) {
+        std::cerr << "reduceStream(VECTF): sum " << sum << ", " << sum_vect
+                  << " vs. " << ref_sum << std::endl;
+        ++errors;
+    }
+    errors += compare_histogram(hist, ref_hist, "histogramStream");
+    errors += compare_histogram(hist_vect, ref_hist, "histogramStreamVECT");
+    return errors;
+}
+
+// vector reductions of rows padded to whole vectors
+int check_padding(int width, int height) {
+    std::vector<int> in(width*height);
+    long ref_sum = 0;
+    int ref_hist[NUM_BINS] = { 0 };
+    for (int i=0; i<width*height; ++i) {
+        in[i] = (i*2654435761u) % 1000;
+        ref_sum += in[i];
+        ref_hist[in[i] & (NUM_BINS-1)]++;
+    }
+
+    hls::stream<ap_uint<32*HIPACC_PPT> > sum_v, hist_v;
+    write_stream(sum_v, in, width, height, 7777);
+    write_stream(hist_v, in, width, height, 7777);
+
+    SumReduce sum_reduce;
+    Binning binning;
+    int sum = 0, hist[NUM_BINS];
+    reduceStreamVECT<HIPACC_II_TARGET,HIPACC_MAX_WIDTH,HIPACC_MAX_HEIGHT,HIPACC_PPT,int>(sum_v, sum, width, height, sum_reduce);
+    histogramStreamVECT<HIPACC_II_TARGET,HIPACC_MAX_WIDTH,HIPACC_MAX_HEIGHT,NUM_BINS,HIPACC_PPT,int>(hist_v, hist, width, height, binning);
+
+    int errors = sum_v.size() + hist_v.size();
+    if (sum != ref_sum) {
+        std::cerr << "reduceStreamVECT: sum " << sum << " vs. " << ref_sum
+                  << " for width " << width << std::endl;
+        ++errors;
+    }
+    errors += compare_histogram(hist, ref_hist, "histogramStreamVECT");
+    return errors;
+}
+
+
+int main(int argc, const char **argv) {
+    int errors = check_dataflow();
+    for (int width=HIPACC_MAX_WIDTH-HIPACC_PPT-2; width<=HIPACC_MAX_WIDTH; ++width)
+        errors += check_padding(width, 16);
+
+    if (errors) {
+        std::cerr << "Test FAILED: " << errors << " errors" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cerr << "Test PASSED" << std::endl;
+    return EXIT_SUCCESS;
+}
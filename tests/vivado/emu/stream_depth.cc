@@ -0,0 +1,159 @@
+//
+// Copyright (c) 2014, University of Erlangen-Nuremberg
+// Copyright (c) 2014, Siemens AG
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+// Checks the dataflow emulation on a pipeline with paths of different group
+// delay: the input is split, filtered by a 5x5 and a 3x3 local operator, and
+// both results are combined by a point operator. The combining process reads
+// both channels in lockstep, so the channel of the 3x3 operator has to buffer
+// the difference of the group delays, one row and one pixel:
+//  - with the depth computed by the stream depth analysis (259 at a width of
+//    256 pixels), the region has to finish and match the reference
+//  - with a smaller depth (set STREAM_DEPTH and a short
+//    HIPACC_EMU_DEADLOCK_TIMEOUT), the emulation has to report the deadlock
+//    and abort
+// The FIFO depths and high-water marks are reported when the region finishes.
+
+#define HIPACC_MAX_WIDTH     256
+#define HIPACC_MAX_HEIGHT    128
+#define HIPACC_II_TARGET     1
+
+#ifndef STREAM_DEPTH
+#define STREAM_DEPTH         259
+#endif
+
+#include "hipacc_vivado_types.hpp"
+#include "hipacc_vivado_filter.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+struct Box5 {
+    uint operator()(uchar win[5][5]) {
+        uint sum = 0;
+        for (int y=0; y<5; ++y)
+            for (int x=0; x<5; ++x)
+                sum += win[y][x];
+        return sum;
+    }
+};
+struct Box3 {
+    uint operator()(uchar win[3][3]) {
+        uint sum = 0;
+        for (int y=0; y<3; ++y)
+            for (int x=0; x<3; ++x)
+                sum += win[y][x];
+        return sum;
+    }
+};
+struct Combine {
+    uint operator()(uint box5, uint box3) {
+        return box5*9 - box3;
+    }
+};
+
+void box5Kernel(hls::stream<uint> &out, hls::stream<uchar> &in, int width, int height) {
+    Box5 filter;
+    process<HIPACC_II_TARGET,HIPACC_MAX_WIDTH,HIPACC_MAX_HEIGHT,5,5>(in, out, width, height, filter, BorderPadding::BORDER_CLAMP);
+}
+void box3Kernel(hls::stream<uint> &out, hls::stream<uchar> &in, int width, int height) {
+    Box3 filter;
+    process<HIPACC_II_TARGET,HIPACC_MAX_WIDTH,HIPACC_MAX_HEIGHT,3,3>(in, out, width, height, filter, BorderPadding::BORDER_CLAMP);
+}
+void combineKernel(hls::stream<uint> &out, hls::stream<uint> &in1, hls::stream<uint> &in2, int width, int height) {
+    Combine filter;
+    processPixels2<HIPACC_II_TARGET,HIPACC_MAX_WIDTH,HIPACC_MAX_HEIGHT,1,1>(in1, in2, out, width, height, filter);
+}
+
+// same structure as the generated hipaccRun
+void hipaccRun(hls::stream<uint> &_strmOUT, hls::stream<uchar> &_strmIN) {
+#pragma HLS dataflow
+    HIPACC_DATAFLOW_BEGIN
+    hls::stream<uchar> _strmIN0("_strmIN0");
+    HIPACC_STREAM_DEPTH(_strmIN0, 2)
+    hls::stream<uchar> _strmIN1("_strmIN1");
+    HIPACC_STREAM_DEPTH(_strmIN1, 2)
+    hls::stream<uint> _strmBox5("_strmBox5");
+    HIPACC_STREAM_DEPTH(_strmBox5, 2)
+    hls::stream<uint> _strmBox3("_strmBox3");
+    HIPACC_STREAM_DEPTH(_strmBox3, STREAM_DEPTH)
+    HIPACC_DATAFLOW_PROCESS(splitStream<HIPACC_II_TARGET,HIPACC_MAX_WIDTH,HIPACC_MAX_HEIGHT,1,1>(_strmIN, _strmIN0, _strmIN1, HIPACC_MAX_WIDTH, HIPACC_MAX_HEIGHT));
+    HIPACC_DATAFLOW_PROCESS(box5Kernel(_strmBox5, _strmIN0, HIPACC_MAX_WIDTH, HIPACC_MAX_HEIGHT));
+    HIPACC_DATAFLOW_PROCESS(box3Kernel(_strmBox3, _strmIN1, HIPACC_MAX_WIDTH, HIPACC_MAX_HEIGHT));
+    HIPACC_DATAFLOW_PROCESS(combineKernel(_strmOUT, _strmBox5, _strmBox3, HIPACC_MAX_WIDTH, HIPACC_MAX_HEIGHT));
+    HIPACC_DATAFLOW_END
+}
+
+
+int main(int argc, const char **argv) {
+    const int width = HIPACC_MAX_WIDTH;
+    const int height = HIPACC_MAX_HEIGHT;
+
+    std::vector<uchar> in(width*height);
+    for (int i=0; i<width*height; ++i)
+        in[i] = (i*7 + i/width*13) & 255;
+
+    hls::stream<uchar> in_s;
+    hls::stream<uint> out_s;
+    for (int i=0; i<width*height; ++i)
+        in_s << in[i];
+
+    hipaccRun(out_s, in_s);
+
+    if ((int)out_s.size() != width*height) {
+        std::cerr << "Test FAILED: " << out_s.size() << " pixels instead of "
+                  << width*height << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    auto pixel = [&](int x, int y) -> uint {
+        x = std::min(std::max(x, 0), width-1);
+        y = std::min(std::max(y, 0), height-1);
+        return in[y*width + x];
+    };
+    for (int y=0; y<height; ++y) {
+        for (int x=0; x<width; ++x) {
+            uint box5 = 0, box3 = 0;
+            for (int dy=-2; dy<=2; ++dy)
+                for (int dx=-2; dx<=2; ++dx)
+                    box5 += pixel(x+dx, y+dy);
+            for (int dy=-1; dy<=1; ++dy)
+                for (int dx=-1; dx<=1; ++dx)
+                    box3 += pixel(x+dx, y+dy);
+            uint out = out_s.read();
+            if (out != box5*9 - box3) {
+                std::cerr << "Test FAILED, at (" << x << "," << y << "): "
+                          << out << " vs. " << box5*9 - box3 << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    std::cerr << "Test PASSED" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,175 @@
+//
+// Copyright (c) 2014, University of Erlangen-Nuremberg
+// Copyright (c) 2014, Siemens AG
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <iostream>
+
+#include <stdlib.h>
+
+#include "hipacc.hpp"
+
+
+// variables set by Makefile
+#ifndef WIDTH
+#define WIDTH  1021
+#endif
+#ifndef HEIGHT
+#define HEIGHT 509
+#endif
+
+
+using namespace hipacc;
+
+// A local operator and a global reduction on an image whose width is not a
+// multiple of the vector width. Run 'make vivado-emu' with
+// TEST_CASE=./tests/runtime_size, HIPACC_RUNTIME_SIZE=on, HIPACC_PPT=4, and
+// MYFLAGS="-DWIDTH=1021 -DHEIGHT=509", so that hipaccRun takes the image size
+// as arguments and the rows are padded to whole vectors; the padding must
+// neither show up in the output image nor in the reduction.
+
+
+// Kernel description in Hipacc
+class Gaussian : public Kernel<uchar> {
+  private:
+    Accessor<uchar> &Input;
+    Mask<int> &cMask;
+
+  public:
+    Gaussian(IterationSpace<uchar> &IS,
+            Accessor<uchar> &Input, Mask<int> &cMask)
+          : Kernel(IS),
+            Input(Input),
+            cMask(cMask) {
+      add_accessor(&Input);
+    }
+
+    void kernel() {
+      int sum = convolve(cMask, Reduce::SUM, [&] () -> int {
+          return cMask() * Input(cMask);
+      });
+      output() = (uchar)(sum >> 4);
+    }
+};
+
+class Sum : public Kernel<int> {
+  private:
+    Accessor<uchar> &Input;
+
+  public:
+    Sum(IterationSpace<int> &IS, Accessor<uchar> &Input)
+          : Kernel(IS),
+            Input(Input) {
+      add_accessor(&Input);
+    }
+
+    void kernel() {
+      output() = Input();
+    }
+
+    int reduce(int left, int right) {
+      return left + right;
+    }
+};
+
+
+/*************************************************************************
+ * Main function                                                         *
+ *************************************************************************/
+int main(int argc, const char **argv) {
+    const int width = WIDTH;
+    const int height = HEIGHT;
+
+    // host memory for image of of width x height pixels
+    uchar *host_in = (uchar *)malloc(sizeof(uchar)*width*height);
+    for (int y=0; y<height; ++y) {
+      for (int x=0; x<width; ++x) {
+        host_in[y*width + x] = (x*7 + y*13 + x*y) & 255;
+      }
+    }
+
+    const int coef[3][3] = { { 1, 2, 1 },
+                             { 2, 4, 2 },
+                             { 1, 2, 1 } };
+    Mask<int> G(coef);
+
+    // input and output image of width x height pixels
+    Image<uchar> IN(WIDTH, HEIGHT);
+    Image<uchar> OUT(WIDTH, HEIGHT);
+    Image<int> RED(WIDTH, HEIGHT);
+
+    IterationSpace<uchar> IsOut(OUT);
+    IterationSpace<int> IsRed(RED);
+
+    IN = host_in;
+
+    BoundaryCondition<uchar> BcIn(IN, G, Boundary::MIRROR);
+    Accessor<uchar> AccInMirror(BcIn);
+    Accessor<uchar> AccIn(IN);
+
+    Gaussian Gauss(IsOut, AccInMirror, G);
+    Gauss.execute();
+
+    Sum SumIn(IsRed, AccIn);
+    SumIn.execute();
+    int sum = SumIn.reduced_data();
+
+    // get results
+    uchar *host_out = OUT.data();
+
+    // compare against reference
+    int ref_sum = 0;
+    for (int y=0; y<height; ++y) {
+      for (int x=0; x<width; ++x) {
+        int ref = 0;
+        for (int yf=-1; yf<=1; ++yf) {
+          for (int xf=-1; xf<=1; ++xf) {
+            int xc = x + xf, yc = y + yf;
+            xc = xc < 0 ? -xc - 1 : (xc >= width ? 2*width - xc - 1 : xc);
+            yc = yc < 0 ? -yc - 1 : (yc >= height ? 2*height - yc - 1 : yc);
+            ref += coef[yf+1][xf+1] * host_in[yc*width + xc];
+          }
+        }
+        ref_sum += host_in[y*width + x];
+        if (host_out[y*width + x] != (uchar)(ref >> 4)) {
+          std::cerr << "Test FAILED, at (" << x << "," << y << "): "
+                    << (ref >> 4) << " vs. " << (int)host_out[y*width + x]
+                    << std::endl;
+          exit(EXIT_FAILURE);
+        }
+      }
+    }
+    if (sum != ref_sum) {
+      std::cerr << "Test FAILED for reduction: " << ref_sum << " vs. " << sum
+                << std::endl;
+      exit(EXIT_FAILURE);
+    }
+    std::cerr << "Test PASSED" << std::endl;
+
+    free(host_in);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,182 @@
+//
+// Copyright (c) 2014, University of Erlangen-Nuremberg
+// Copyright (c) 2014, Siemens AG
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <iostream>
+
+#include <stdlib.h>
+
+#include "hipacc.hpp"
+
+
+// variables set by Makefile
+#ifndef WIDTH
+#define WIDTH  256
+#endif
+#ifndef HEIGHT
+#define HEIGHT 128
+#endif
+
+
+using namespace hipacc;
+
+// The input is split into a 5x5 and a 3x3 local operator whose results are
+// combined by a point operator. The combining process consumes both streams
+// in lockstep, so the stream of the 3x3 operator has to buffer the difference
+// of the group delays (one row and one pixel). The stream depths computed by
+// Hipacc are listed above hipaccRun in hipacc_run.cc. Run with 'make
+// vivado-emu TEST_CASE=./tests/stream_depth': the emulation reports the depth
+// and high-water mark of each stream and aborts if the pipeline deadlocks.
+
+
+// Kernel description in Hipacc
+class BoxFilter : public Kernel<uint> {
+  private:
+    Accessor<uchar> &Input;
+    Mask<uint> &cMask;
+
+  public:
+    BoxFilter(IterationSpace<uint> &IS,
+            Accessor<uchar> &Input, Mask<uint> &cMask)
+          : Kernel(IS),
+            Input(Input),
+            cMask(cMask) {
+      add_accessor(&Input);
+    }
+
+    void kernel() {
+      output() = convolve(cMask, Reduce::SUM, [&] () -> uint {
+          return cMask() * Input(cMask);
+      });
+    }
+};
+
+class Combine : public Kernel<uint> {
+  private:
+    Accessor<uint> &Box5;
+    Accessor<uint> &Box3;
+
+  public:
+    Combine(IterationSpace<uint> &IS,
+            Accessor<uint> &Box5, Accessor<uint> &Box3)
+          : Kernel(IS),
+            Box5(Box5),
+            Box3(Box3) {
+      add_accessor(&Box5);
+      add_accessor(&Box3);
+    }
+
+    void kernel() {
+      output() = Box5() * 9 - Box3();
+    }
+};
+
+
+/*************************************************************************
+ * Main function                                                         *
+ *************************************************************************/
+int main(int argc, const char **argv) {
+    const int width = WIDTH;
+    const int height = HEIGHT;
+
+    // host memory for image of of width x height pixels
+    uchar *host_in = (uchar *)malloc(sizeof(uchar)*width*height);
+    for (int y=0; y<height; ++y) {
+      for (int x=0; x<width; ++x) {
+        host_in[y*width + x] = (x*7 + y*width*7 + y*13) & 255;
+      }
+    }
+
+    const uint ones5[5][5] = { { 1, 1, 1, 1, 1 },
+                               { 1, 1, 1, 1, 1 },
+                               { 1, 1, 1, 1, 1 },
+                               { 1, 1, 1, 1, 1 },
+                               { 1, 1, 1, 1, 1 } };
+    const uint ones3[3][3] = { { 1, 1, 1 },
+                               { 1, 1, 1 },
+                               { 1, 1, 1 } };
+    Mask<uint> M5(ones5);
+    Mask<uint> M3(ones3);
+
+    // input and output image of width x height pixels
+    Image<uchar> IN(WIDTH, HEIGHT);
+    Image<uint> BOX5(WIDTH, HEIGHT);
+    Image<uint> BOX3(WIDTH, HEIGHT);
+    Image<uint> OUT(WIDTH, HEIGHT);
+
+    IterationSpace<uint> IsBox5(BOX5);
+    IterationSpace<uint> IsBox3(BOX3);
+    IterationSpace<uint> IsOut(OUT);
+
+    IN = host_in;
+
+    BoundaryCondition<uchar> BcIn5(IN, M5, Boundary::CLAMP);
+    Accessor<uchar> AccIn5(BcIn5);
+    BoundaryCondition<uchar> BcIn3(IN, M3, Boundary::CLAMP);
+    Accessor<uchar> AccIn3(BcIn3);
+
+    BoxFilter Box5x5(IsBox5, AccIn5, M5);
+    Box5x5.execute();
+
+    BoxFilter Box3x3(IsBox3, AccIn3, M3);
+    Box3x3.execute();
+
+    Accessor<uint> AccBox5(BOX5);
+    Accessor<uint> AccBox3(BOX3);
+
+    Combine Comb(IsOut, AccBox5, AccBox3);
+    Comb.execute();
+
+    // get results
+    uint *host_out = OUT.data();
+
+    // compare against reference
+    for (int y=0; y<height; ++y) {
+      for (int x=0; x<width; ++x) {
+        uint box5 = 0, box3 = 0;
+        for (int yf=-2; yf<=2; ++yf) {
+          for (int xf=-2; xf<=2; ++xf) {
+            int xc = std::min(std::max(x + xf, 0), width-1);
+            int yc = std::min(std::max(y + yf, 0), height-1);
+            box5 += host_in[yc*width + xc];
+            if (abs(xf) <= 1 && abs(yf) <= 1) box3 += host_in[yc*width + xc];
+          }
+        }
+        if (host_out[y*width + x] != box5*9 - box3) {
+          std::cerr << "Test FAILED, at (" << x << "," << y << "): "
+                    << box5*9 - box3 << " vs. " << host_out[y*width + x]
+                    << std::endl;
+          exit(EXIT_FAILURE);
+        }
+      }
+    }
+    std::cerr << "Test PASSED" << std::endl;
+
+    free(host_in);
+
+    return EXIT_SUCCESS;
+}